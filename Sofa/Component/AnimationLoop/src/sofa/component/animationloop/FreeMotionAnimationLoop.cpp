@@ -44,6 +44,9 @@
 #include <sofa/simulation/CollisionVisitor.h>
 #include <sofa/simulation/SolveVisitor.h>
 #include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/TaskGraph.h>
+#include <sofa/simulation/Node.h>
+#include <sofa/core/behavior/OdeSolver.h>
 
 #include <sofa/simulation/mechanicalvisitor/MechanicalVInitVisitor.h>
 using sofa::simulation::mechanicalvisitor::MechanicalVInitVisitor;
@@ -73,11 +76,13 @@ FreeMotionAnimationLoop::FreeMotionAnimationLoop(simulation::Node* gnode)
     , d_threadSafeVisitor(initData(&d_threadSafeVisitor, false, "threadSafeVisitor", "If true, do not use realloc and free visitors in fwdInteractionForceField."))
     , d_parallelCollisionDetectionAndFreeMotion(initData(&d_parallelCollisionDetectionAndFreeMotion, false, "parallelCollisionDetectionAndFreeMotion", "If true, executes free motion step and collision detection step in parallel."))
     , d_parallelODESolving(initData(&d_parallelODESolving, false, "parallelODESolving", "If true, solves all the ODEs in parallel during the free motion step."))
+    , d_parallelTaskGraph(initData(&d_parallelTaskGraph, false, "parallelTaskGraph", "If true, the free motion of each ODE solver, the collision detection and the collision response are executed as a graph of tasks, each task starting as soon as the tasks it depends on are finished. It replaces parallelCollisionDetectionAndFreeMotion and parallelODESolving."))
     , defaultSolver(nullptr)
     , l_constraintSolver(initLink("constraintSolver", "The ConstraintSolver used in this animation loop (required)"))
 {
     d_parallelCollisionDetectionAndFreeMotion.setGroup("Multithreading");
     d_parallelODESolving.setGroup("Multithreading");
+    d_parallelTaskGraph.setGroup("Multithreading");
 }
 
 FreeMotionAnimationLoop::~FreeMotionAnimationLoop()
@@ -141,7 +146,7 @@ void FreeMotionAnimationLoop::init()
 
     auto* taskScheduler = sofa::simulation::MainTaskSchedulerFactory::createInRegistry();
     assert(taskScheduler != nullptr);
-    if (d_parallelCollisionDetectionAndFreeMotion.getValue() || d_parallelODESolving.getValue())
+    if (d_parallelCollisionDetectionAndFreeMotion.getValue() || d_parallelODESolving.getValue() || d_parallelTaskGraph.getValue())
     {
         if (taskScheduler->getThreadCount() < 1)
         {
@@ -318,7 +323,11 @@ void FreeMotionAnimationLoop::FreeMotionAndCollisionDetection(const sofa::core::
                                                               sofa::core::MultiVecDerivId freeVel,
                                                               simulation::common::MechanicalOperations* mop)
 {
-    if (!d_parallelCollisionDetectionAndFreeMotion.getValue())
+    if (d_parallelTaskGraph.getValue())
+    {
+        taskGraphFreeMotionAndCollisionDetection(params, cparams, dt, pos, freePos, freeVel, mop);
+    }
+    else if (!d_parallelCollisionDetectionAndFreeMotion.getValue())
     {
         ScopedAdvancedTimer timer("FreeMotion+CollisionDetection");
 
@@ -371,6 +380,114 @@ void FreeMotionAnimationLoop::FreeMotionAndCollisionDetection(const sofa::core::
     }
 }
 
+namespace
+{
+/// Gather the ODE solvers which are not below another ODE solver, i.e. the ones called by SolveVisitor
+class OdeSolverCollector : public simulation::Visitor
+{
+public:
+    explicit OdeSolverCollector(const sofa::core::ExecParams* params) : simulation::Visitor(params) {}
+
+    Result processNodeTopDown(simulation::Node* node) override
+    {
+        if (!node->solver.empty())
+        {
+            for (auto* solver : node->solver)
+            {
+                solvers.push_back(solver);
+            }
+            return RESULT_PRUNE;
+        }
+        return RESULT_CONTINUE;
+    }
+
+    const char* getClassName() const override { return "OdeSolverCollector"; }
+
+    std::vector<sofa::core::behavior::OdeSolver*> solvers;
+};
+}
+
+void FreeMotionAnimationLoop::taskGraphFreeMotionAndCollisionDetection(const sofa::core::ExecParams* params,
+                                                              const core::ConstraintParams& cparams, SReal dt,
+                                                              sofa::core::MultiVecId pos,
+                                                              sofa::core::MultiVecId freePos,
+                                                              sofa::core::MultiVecDerivId freeVel,
+                                                              simulation::common::MechanicalOperations* mop)
+{
+    ScopedAdvancedTimer timer("FreeMotion+CollisionDetection");
+
+    auto* taskScheduler = sofa::simulation::MainTaskSchedulerFactory::createInRegistry();
+    assert(taskScheduler != nullptr);
+
+    OdeSolverCollector odeSolvers(params);
+    gnode->execute(&odeSolvers);
+
+    sofa::simulation::TaskGraph graph;
+
+    const auto collisionReset = graph.addTask([&]()
+    {
+        preCollisionComputation(params);
+
+        ScopedAdvancedTimer collisionResetTimer("CollisionReset");
+        CollisionResetVisitor act(params);
+        act.setTags(this->getTags());
+        act.execute(getContext());
+    }, "CollisionReset");
+
+    const auto collisionDetection = graph.addTask([&]()
+    {
+        ScopedAdvancedTimer collisionDetectionTimer("CollisionDetection");
+        CollisionDetectionVisitor act(params);
+        act.setTags(this->getTags());
+        act.execute(getContext());
+    }, "CollisionDetection");
+    graph.addDependency(collisionReset, collisionDetection);
+
+    // one task per ODE solver: the solvers are independent from each other
+    std::vector<sofa::simulation::TaskGraph::TaskId> freeMotions;
+    freeMotions.reserve(odeSolvers.solvers.size());
+    for (auto* solver : odeSolvers.solvers)
+    {
+        freeMotions.push_back(graph.addTask([solver, params, dt]()
+        {
+            solver->solve(params, dt, core::VecCoordId::freePosition(), core::VecDerivId::freeVelocity());
+        }, solver->getName()));
+        graph.addDependency(collisionReset, freeMotions.back());
+    }
+
+    const auto freeMotionEnd = graph.addTask([&]()
+    {
+        mop->projectResponse(freeVel);
+        mop->propagateDx(freeVel, true);
+
+        if (cparams.constOrder() == sofa::core::ConstraintParams::POS ||
+            cparams.constOrder() == sofa::core::ConstraintParams::POS_AND_VEL)
+        {
+            MechanicalVOpVisitor freePosEqPosPlusFreeVelDt(params, freePos, pos, freeVel, dt);
+            freePosEqPosPlusFreeVelDt.setMapped(true);
+            getContext()->executeVisitor(&freePosEqPosPlusFreeVelDt);
+        }
+    }, "FreeMotionEnd");
+    graph.addDependency(collisionReset, freeMotionEnd);
+    graph.addDependencies(freeMotions, freeMotionEnd);
+
+    const auto collisionResponse = graph.addTask([&]()
+    {
+        {
+            ScopedAdvancedTimer collisionResponseTimer("CollisionResponse");
+            CollisionResponseVisitor act(params);
+            act.setTags(this->getTags());
+            act.execute(getContext());
+        }
+
+        postCollisionComputation(params);
+    }, "CollisionResponse");
+    graph.addDependency(collisionDetection, collisionResponse);
+    graph.addDependency(freeMotionEnd, collisionResponse);
+
+    graph.run(*taskScheduler);
+}
+
 void FreeMotionAnimationLoop::computeFreeMotion(const sofa::core::ExecParams* params, const core::ConstraintParams& cparams, SReal dt,
                                          sofa::core::MultiVecId pos,
                                          sofa::core::MultiVecId freePos,
@@ -59,6 +59,7 @@ public:
     Data<bool> d_threadSafeVisitor; ///< If true, do not use realloc and free visitors in fwdInteractionForceField.
     Data<bool> d_parallelCollisionDetectionAndFreeMotion; ///<If true, executes free motion and collision detection in parallel
     Data<bool> d_parallelODESolving; ///<If true, executes all free motions in parallel
+    Data<bool> d_parallelTaskGraph; ///<If true, executes the free motions and the collision pipeline as a graph of dependent tasks
 
 protected:
     FreeMotionAnimationLoop(simulation::Node* gnode);
@@ -76,6 +77,15 @@ protected:
                                          sofa::core::MultiVecDerivId freeVel,
                                          simulation::common::MechanicalOperations* mop);
 
+    /// Same as FreeMotionAndCollisionDetection, but the step is expressed as a graph of tasks:
+    /// the free motion of each ODE solver runs as soon as the collision reset is done, concurrently
+    /// with the collision detection, and the collision response waits for both.
+    void taskGraphFreeMotionAndCollisionDetection(const sofa::core::ExecParams* params, const core::ConstraintParams& cparams, SReal dt,
+                                         sofa::core::MultiVecId pos,
+                                         sofa::core::MultiVecId freePos,
+                                         sofa::core::MultiVecDerivId freeVel,
+                                         simulation::common::MechanicalOperations* mop);
+
     void computeFreeMotion(const sofa::core::ExecParams* params, const core::ConstraintParams& cparams, SReal dt,
                                          sofa::core::MultiVecId pos,
                                          sofa::core::MultiVecId freePos,
@@ -32,7 +32,7 @@
 #include <sofa/simulation/DefaultTaskScheduler.h>
 #include <sofa/helper/ScopedAdvancedTimer.h>
 #include <sofa/simulation/MainTaskSchedulerFactory.h>
-#include <sofa/simulation/ParallelForEach.h>
+#include <sofa/simulation/ParallelReduce.h>
 
 #include <sofa/simulation/mechanicalvisitor/MechanicalVOpVisitor.h>
 using sofa::simulation::mechanicalvisitor::MechanicalVOpVisitor;
@@ -370,34 +370,42 @@ void GenericConstraintSolver::buildSystem_matrixAssembly(const core::ConstraintP
     sofa::helper::ScopedAdvancedTimer getComplianceTimer("Get Compliance");
     dmsg_info() <<" computeCompliance in "  << constraintCorrections.size()<< " constraintCorrections" ;
 
-    const bool multithreading = d_multithreading.getValue();
-
-    const simulation::ForEachExecutionPolicy execution = multithreading ?
-        simulation::ForEachExecutionPolicy::PARALLEL :
-        simulation::ForEachExecutionPolicy::SEQUENTIAL;
-
-    simulation::TaskScheduler* taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
-    assert(taskScheduler);
-
-    std::mutex mutex;
-
-    simulation::forEachRange(execution, *taskScheduler, constraintCorrections.begin(), constraintCorrections.end(),
-        [&cParams, this, &multithreading, &mutex](const auto& range)
+    const auto addCompliance = [&cParams](const auto& range, ComplianceWrapper& compliance)
+    {
+        for (auto it = range.start; it != range.end; ++it)
         {
-            ComplianceWrapper compliance(current_cp->W, multithreading);
-
-            for (auto it = range.start; it != range.end; ++it)
+            core::behavior::BaseConstraintCorrection* cc = *it;
+            if (cc->isActive())
             {
-                core::behavior::BaseConstraintCorrection* cc = *it;
-                if (cc->isActive())
-                {
-                    cc->addComplianceInConstraintSpace(cParams, &compliance.matrix());
-                }
+                cc->addComplianceInConstraintSpace(cParams, &compliance.matrix());
             }
+        }
+    };
 
-            std::lock_guard guard(mutex);
-            compliance.assembleMatrix();
-        });
+    if (d_multithreading.getValue())
+    {
+        simulation::TaskScheduler* taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+        assert(taskScheduler);
+
+        // the compliances of the ranges are summed in the order of the ranges, whatever the
+        // scheduling of the tasks
+        simulation::parallelForEachRangeWithMerge(*taskScheduler, constraintCorrections.begin(), constraintCorrections.end(),
+            [this, &addCompliance](const auto& range)
+            {
+                auto compliance = std::make_unique<ComplianceWrapper>(current_cp->W, true);
+                addCompliance(range, *compliance);
+                return compliance;
+            },
+            [](const auto& /*range*/, const std::unique_ptr<ComplianceWrapper>& compliance)
+            {
+                compliance->assembleMatrix();
+            });
+    }
+    else
+    {
+        ComplianceWrapper compliance(current_cp->W, false);
+        addCompliance(simulation::Range{constraintCorrections.begin(), constraintCorrections.end()}, compliance);
+    }
 
     dmsg_info() << " computeCompliance_done "  ;
 }
@@ -76,6 +76,13 @@ public:
 
 protected:
 
+    /// The factorization runs in a thread which is not a worker thread of the task scheduler: only the solves are
+    /// computed in parallel
+    simulation::TaskScheduler* getFactorizationTaskScheduler() override
+    {
+        return nullptr;
+    }
+
     /// A second instantiation is needed to differentiate the one which is computed asynchronously, and the one which
     /// is used to solve the system in the main thread
     InvertData m_secondInvertData;
@@ -27,6 +27,7 @@
 #include <sofa/linearalgebra/SparseMatrix.h>
 #include <sofa/linearalgebra/BTDMatrix.h>
 #include <sofa/linearalgebra/BlockVector.h>
+#include <sofa/simulation/TaskScheduler.h>
 #include <cmath>
 #include <sofa/type/Mat.h>
 
@@ -39,6 +40,15 @@ namespace sofa::component::linearsolver::direct
 /// http://en.wikipedia.org/wiki/Tridiagonal_matrix_algorithm
 /// http://www.cfd-online.com/Wiki/Tridiagonal_matrix_algorithm_-_TDMA_(Thomas_algorithm)
 /// http://www4.ncsu.edu/eos/users/w/white/www/white/ma580/chap2.5.PDF
+///
+/// With multithreading, the chain of blocks is split into partitions, factorized and solved concurrently.
+/// The last block of each partition (but the last one) is a separator. Once the interior blocks of the
+/// partitions are eliminated, the separators form a small block tridiagonal system, solved sequentially.
+/// The entries of the inverse used by the constraint corrections (addJMInvJt) are then computed from
+/// the partitioned factorization, solving the system for each column of the inverse they involve.
+///
+/// References:
+/// Polizzi, E., and Sameh, A.H. (2006). A parallel hybrid banded system solver: the SPIKE algorithm. Parallel Computing 32(2)
 template<class Matrix, class Vector>
 class BTDLinearSolver : public sofa::component::linearsolver::MatrixLinearSolver<Matrix,Vector>
 {
@@ -49,6 +59,8 @@ public:
     Data<bool> d_problem; ///< display debug informations about subpartSolve computation
     Data<bool> d_subpartSolve; ///< Allows for the computation of a subpart of the system
     Data<bool> d_verification; ///< verification of the subpartSolve
+    Data<bool> d_multithreading; ///< Factorize and solve the system in parallel, on partitions of the chain of blocks
+    Data<unsigned int> d_nbPartitions; ///< Number of partitions used with multithreading (0 for one partition per thread)
 
     SOFA_ATTRIBUTE_DISABLED__BTDLINEARSOLVER_DATANAME("To fix your code, use d_verbose")
     DeprecatedAndRemoved f_verbose;
@@ -104,10 +116,14 @@ protected:
         , d_problem(initData(&d_problem, false,"showProblem", "display debug informations about subpartSolve computation") )
         , d_subpartSolve(initData(&d_subpartSolve, false,"subpartSolve", "Allows for the computation of a subpart of the system") )
         , d_verification(initData(&d_verification, false,"verification", "verification of the subpartSolve"))
+        , d_multithreading(initData(&d_multithreading, false, "multithreading", "Factorize and solve the system in parallel, using the main task scheduler. The chain of blocks is split into partitions, coupled through a reduced system solved sequentially. Worth it for long chains only. Not used with subpartSolve"))
+        , d_nbPartitions(initData(&d_nbPartitions, 0u, "nbPartitions", "Number of partitions of the chain of blocks used with multithreading (0 for one partition per thread)"))
     {
 
     }
 public:
+    void init() override;
+
     void my_identity(SubMatrix& Id, const Index size_id);
 
     void invert(SubMatrix& Inv, const BlocType& m);
@@ -159,6 +175,47 @@ public:
 
 private:
 
+    /// Task scheduler used to factorize and solve the partitions (nullptr if d_multithreading is false)
+    simulation::TaskScheduler* m_taskScheduler { nullptr };
+
+    /// Thomas factorization of the whole chain, used by the sequential solve, the partial solve and the computation of Minv
+    void invertSequential(Matrix& M);
+
+    /// Split the chain of nb blocks into partitions. Returns false if the chain is too short to be partitioned.
+    bool computePartitions(Index nb);
+
+    void invertPartitioned(Matrix& M);
+
+    void solvePartitioned(Vector& x, const Vector& b);
+
+    /// First block of each partition, followed by the number of blocks
+    type::vector<Index> m_partitionBegin;
+
+    /// Thomas factorization of the interior blocks of each partition, indexed by the global block index
+    type::vector<BlocType> m_localAlphaInv;
+    type::vector<BlocType> m_localLambda;
+    /// Blocks M(i,i-1) and M(i,i+1) of the system
+    type::vector<BlocType> m_lowerBlocks;
+    type::vector<BlocType> m_upperBlocks;
+    /// Coupling of the interior blocks of a partition with its left and right separators
+    type::vector<BlocType> m_leftSpikes;
+    type::vector<BlocType> m_rightSpikes;
+    /// Thomas factorization of the reduced system of the separators
+    type::vector<BlocType> m_reducedAlphaInv;
+    type::vector<BlocType> m_reducedLambda;
+    type::vector<BlocType> m_reducedLower;
+
+    /// True if the last factorization was partitioned: alpha_inv and lambda must be computed before they are used
+    bool m_isFactorizationPartitioned { false };
+
+    /// Columns of Minv computed from the partitioned factorization, cleared at each factorization
+    std::map<Index, Vector> m_partitionedMinvColumns;
+
+    /// Column j of Minv, computed from the partitioned factorization if it is not already known
+    const Vector& getPartitionedMinvColumn(Index j);
+
+    /// Size of the system, in both the sequential and the partitioned factorizations
+    Index getSystemSize() const;
 
     Index _indMaxNonNullForce; // point with non null force which index is the greatest and for which globalAccumulate was not proceed
 
@@ -169,8 +226,9 @@ private:
     void bwdAccumulateRHinBloc(Index indMaxBloc);   // indMaxBloc should be equal to _indMaxNonNullForce
 
 
-    /// step2=> accumulate LH globally to step down the value of current_bloc to 0
-    void bwdAccumulateLHGlobal( );
+    /// step2=> accumulate LH globally to step down the value of current_bloc to indMinBloc
+    /// (fwdRH must be valid on indMinBloc)
+    void bwdAccumulateLHGlobal(Index indMinBloc);
 
 
     /// step3=> accumulate RH globally to step up the value of current_bloc to the smallest value needed in OutBloc
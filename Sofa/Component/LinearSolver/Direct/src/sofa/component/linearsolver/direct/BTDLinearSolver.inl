@@ -22,6 +22,9 @@
 #pragma once
 #include <sofa/component/linearsolver/direct/BTDLinearSolver.h>
 #include <sofa/linearalgebra/FullMatrix.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/ParallelForEach.h>
+#include <algorithm>
 
 namespace sofa::component::linearsolver::direct
 {
@@ -65,6 +68,27 @@ namespace sofa::component::linearsolver::direct
 ///                    [  (Minv21)(-l0t)   (Minv22)(-l1t)  inva2-l2(Minv33)(-l2t) Minv32t ]
 ///                    [  (Minv31)(-l0t)   (Minv32)(-l1t)   (Minv33)(-l2t)   inva3  ]
 ///
+template<class Matrix, class Vector>
+void BTDLinearSolver<Matrix,Vector>::init()
+{
+    Inherit1::init();
+
+    if (d_multithreading.getValue())
+    {
+        msg_warning_when(d_subpartSolve.getValue()) << "multithreading is not used when subpartSolve is enabled";
+
+        m_taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+        if (m_taskScheduler->getThreadCount() == 0)
+        {
+            m_taskScheduler->init();
+        }
+    }
+    else
+    {
+        m_taskScheduler = nullptr;
+    }
+}
+
 template<class Matrix, class Vector>
 void BTDLinearSolver<Matrix,Vector>::my_identity(SubMatrix& Id, const Index size_id)
 {
@@ -109,6 +133,51 @@ void BTDLinearSolver<Matrix,Vector>::invert(SubMatrix& Inv, const BlocType& m)
 template<class Matrix, class Vector>
 void BTDLinearSolver<Matrix,Vector>::invert(Matrix& M)
 {
+    constexpr Index bsize = Matrix::getSubMatrixDim();
+    const Index nb = M.rowSize() / bsize;
+
+    m_partitionedMinvColumns.clear();
+    if (m_taskScheduler && !d_subpartSolve.getValue() && computePartitions(nb))
+    {
+        invertPartitioned(M);
+        m_isFactorizationPartitioned = true;
+    }
+    else
+    {
+        invertSequential(M);
+    }
+}
+
+template<class Matrix, class Vector>
+auto BTDLinearSolver<Matrix,Vector>::getSystemSize() const -> Index
+{
+    constexpr Index bsize = Matrix::getSubMatrixDim();
+    return m_isFactorizationPartitioned ? m_partitionBegin.back() * bsize : Minv.rowSize();
+}
+
+template<class Matrix, class Vector>
+auto BTDLinearSolver<Matrix,Vector>::getPartitionedMinvColumn(Index j) -> const Vector&
+{
+    auto it = m_partitionedMinvColumns.find(j);
+    if (it == m_partitionedMinvColumns.end())
+    {
+        const Index n = getSystemSize();
+        Vector e;
+        e.resize(n);
+        e.set(j, 1);
+
+        it = m_partitionedMinvColumns.emplace(j, Vector()).first;
+        it->second.resize(n);
+        solvePartitioned(it->second, e);
+    }
+    return it->second;
+}
+
+template<class Matrix, class Vector>
+void BTDLinearSolver<Matrix,Vector>::invertSequential(Matrix& M)
+{
+    m_isFactorizationPartitioned = false;
+
     const bool verbose = d_verbose.getValue();
 
     msg_info_when(verbose) << "BTDLinearSolver, invert Matrix = "<< M ;
@@ -177,6 +246,198 @@ void BTDLinearSolver<Matrix,Vector>::invert(Matrix& M)
     }
 }
 
+template<class Matrix, class Vector>
+bool BTDLinearSolver<Matrix,Vector>::computePartitions(Index nb)
+{
+    Index nbPartitions = d_nbPartitions.getValue() > 0 ?
+        static_cast<Index>(d_nbPartitions.getValue()) : static_cast<Index>(m_taskScheduler->getThreadCount());
+
+    // each partition has at least one interior block and a separator
+    nbPartitions = std::min(nbPartitions, nb / 2);
+    if (nbPartitions < 2)
+    {
+        return false;
+    }
+
+    m_partitionBegin.resize(nbPartitions + 1);
+    for (Index k = 0; k <= nbPartitions; ++k)
+    {
+        m_partitionBegin[k] = (k * nb) / nbPartitions;
+    }
+    return true;
+}
+
+/// The blocks of the partition k are [b_k, b_k+1). Its last block s_k = b_k+1 - 1 is a separator, except for the
+/// last partition. The interior blocks of a partition form a block tridiagonal system T_k, coupled with the
+/// separators s_k-1 and s_k only:
+///     T_k x_k = r_k - V_k x_s_k-1 - W_k x_s_k
+/// where the spikes V_k and W_k are T_k^-1 applied to the columns M(b_k, s_k-1) and M(s_k - 1, s_k).
+/// Substituting x_k in the rows of the separators gives a reduced block tridiagonal system:
+///     (A_s - B_s W_k[last] - C_s V_k+1[first]) x_s - B_s V_k[last] x_s_k-1 - C_s W_k+1[first] x_s_k+1
+///         = r_s - B_s y_k[last] - C_s y_k+1[first]
+/// with y_k = T_k^-1 r_k, B_s = M(s, s-1) and C_s = M(s, s+1).
+template<class Matrix, class Vector>
+void BTDLinearSolver<Matrix,Vector>::invertPartitioned(Matrix& M)
+{
+    constexpr Index bsize = Matrix::getSubMatrixDim();
+    const Index nb = M.rowSize() / bsize;
+    const Index nbPartitions = static_cast<Index>(m_partitionBegin.size()) - 1;
+
+    m_localAlphaInv.resize(nb);
+    m_localLambda.resize(nb);
+    m_lowerBlocks.resize(nb);
+    m_upperBlocks.resize(nb);
+    m_leftSpikes.resize(nb);
+    m_rightSpikes.resize(nb);
+
+    simulation::parallelForEach(*m_taskScheduler, static_cast<std::size_t>(0), static_cast<std::size_t>(nbPartitions),
+        [this, &M, nb, nbPartitions](const std::size_t partition)
+        {
+            const auto k = static_cast<Index>(partition);
+            const Index begin = m_partitionBegin[k];
+            const Index end = m_partitionBegin[k + 1];
+            const Index interiorEnd = (k < nbPartitions - 1) ? end - 1 : end;
+
+            for (Index i = begin; i < end; ++i)
+            {
+                if (i > 0)
+                    M.getAlignedSubMatrix(i, i - 1, bsize, bsize, m_lowerBlocks[i]);
+                if (i < nb - 1)
+                    M.getAlignedSubMatrix(i, i + 1, bsize, bsize, m_upperBlocks[i]);
+            }
+
+            // Thomas factorization of the interior blocks
+            for (Index i = begin; i < interiorEnd; ++i)
+            {
+                BlocType A;
+                M.getAlignedSubMatrix(i, i, bsize, bsize, A);
+                if (i > begin)
+                    A -= m_lowerBlocks[i] * m_localLambda[i - 1];
+
+                SubMatrix inv;
+                invert(inv, A);
+                m_localAlphaInv[i] = inv;
+
+                if (i + 1 < interiorEnd)
+                    m_localLambda[i] = m_localAlphaInv[i] * m_upperBlocks[i];
+            }
+
+            // left spike: T^-1 applied to the coupling of the first interior block with the previous separator
+            if (k > 0)
+            {
+                m_leftSpikes[begin] = m_localAlphaInv[begin] * m_lowerBlocks[begin];
+                for (Index i = begin + 1; i < interiorEnd; ++i)
+                    m_leftSpikes[i] = -(m_localAlphaInv[i] * (m_lowerBlocks[i] * m_leftSpikes[i - 1]));
+                for (Index i = interiorEnd - 2; i >= begin; --i)
+                    m_leftSpikes[i] -= m_localLambda[i] * m_leftSpikes[i + 1];
+            }
+
+            // right spike: T^-1 applied to the coupling of the last interior block with the next separator
+            if (k < nbPartitions - 1)
+            {
+                const Index last = interiorEnd - 1;
+                m_rightSpikes[last] = m_localAlphaInv[last] * m_upperBlocks[last];
+                for (Index i = last - 1; i >= begin; --i)
+                    m_rightSpikes[i] = -(m_localLambda[i] * m_rightSpikes[i + 1]);
+            }
+        }, simulation::Partitioner{simulation::Partitioner::Type::STATIC, 1});
+
+    // Thomas factorization of the reduced system of the separators
+    const Index nbSeparators = nbPartitions - 1;
+    m_reducedAlphaInv.resize(nbSeparators);
+    m_reducedLambda.resize(nbSeparators);
+    m_reducedLower.resize(nbSeparators);
+    for (Index j = 0; j < nbSeparators; ++j)
+    {
+        const Index s = m_partitionBegin[j + 1] - 1;
+
+        BlocType D;
+        M.getAlignedSubMatrix(s, s, bsize, bsize, D);
+        D -= m_lowerBlocks[s] * m_rightSpikes[s - 1] + m_upperBlocks[s] * m_leftSpikes[s + 1];
+
+        if (j > 0)
+        {
+            m_reducedLower[j] = -(m_lowerBlocks[s] * m_leftSpikes[s - 1]);
+            D -= m_reducedLower[j] * m_reducedLambda[j - 1];
+        }
+
+        SubMatrix inv;
+        invert(inv, D);
+        m_reducedAlphaInv[j] = inv;
+
+        if (j < nbSeparators - 1)
+        {
+            const BlocType reducedUpper = -(m_upperBlocks[s] * m_rightSpikes[s + 1]);
+            m_reducedLambda[j] = m_reducedAlphaInv[j] * reducedUpper;
+        }
+    }
+}
+
+template<class Matrix, class Vector>
+void BTDLinearSolver<Matrix,Vector>::solvePartitioned(Vector& x, const Vector& b)
+{
+    constexpr Index bsize = Matrix::getSubMatrixDim();
+    const Index nbPartitions = static_cast<Index>(m_partitionBegin.size()) - 1;
+    const auto interiorEnd = [this, nbPartitions](const Index k)
+    {
+        return (k < nbPartitions - 1) ? m_partitionBegin[k + 1] - 1 : m_partitionBegin[k + 1];
+    };
+    const simulation::Partitioner partitioner{simulation::Partitioner::Type::STATIC, 1};
+
+    // solve the interior blocks of each partition, ignoring the separators
+    simulation::parallelForEach(*m_taskScheduler, static_cast<std::size_t>(0), static_cast<std::size_t>(nbPartitions),
+        [this, &x, &b, &interiorEnd](const std::size_t partition)
+        {
+            const auto k = static_cast<Index>(partition);
+            const Index begin = m_partitionBegin[k];
+            const Index end = interiorEnd(k);
+
+            x.asub(begin, bsize) = m_localAlphaInv[begin] * b.asub(begin, bsize);
+            for (Index i = begin + 1; i < end; ++i)
+                x.asub(i, bsize) = m_localAlphaInv[i] * (b.asub(i, bsize) - m_lowerBlocks[i] * x.asub(i - 1, bsize));
+            for (Index i = end - 2; i >= begin; --i)
+                x.asub(i, bsize) -= m_localLambda[i] * x.asub(i + 1, bsize);
+        }, partitioner);
+
+    // solve the reduced system of the separators
+    const Index nbSeparators = nbPartitions - 1;
+    for (Index j = 0; j < nbSeparators; ++j)
+    {
+        const Index s = m_partitionBegin[j + 1] - 1;
+        typename Vector::SubVectorType g;
+        g = b.asub(s, bsize) - m_lowerBlocks[s] * x.asub(s - 1, bsize) - m_upperBlocks[s] * x.asub(s + 1, bsize);
+        if (j > 0)
+            g -= m_reducedLower[j] * x.asub(m_partitionBegin[j] - 1, bsize);
+        x.asub(s, bsize) = m_reducedAlphaInv[j] * g;
+    }
+    for (Index j = nbSeparators - 2; j >= 0; --j)
+    {
+        x.asub(m_partitionBegin[j + 1] - 1, bsize) -= m_reducedLambda[j] * x.asub(m_partitionBegin[j + 2] - 1, bsize);
+    }
+
+    // correct the interior blocks with the contributions of the separators
+    simulation::parallelForEach(*m_taskScheduler, static_cast<std::size_t>(0), static_cast<std::size_t>(nbPartitions),
+        [this, &x, nbPartitions, &interiorEnd](const std::size_t partition)
+        {
+            const auto k = static_cast<Index>(partition);
+            const Index begin = m_partitionBegin[k];
+            const Index end = interiorEnd(k);
+
+            if (k > 0)
+            {
+                const typename Vector::SubVectorType left = x.asub(begin - 1, bsize);
+                for (Index i = begin; i < end; ++i)
+                    x.asub(i, bsize) -= m_leftSpikes[i] * left;
+            }
+            if (k < nbPartitions - 1)
+            {
+                const typename Vector::SubVectorType right = x.asub(end, bsize);
+                for (Index i = begin; i < end; ++i)
+                    x.asub(i, bsize) -= m_rightSpikes[i] * right;
+            }
+        }, partitioner);
+}
+
 
 
 ///
@@ -303,6 +564,10 @@ double BTDLinearSolver<Matrix,Vector>::getMinvElement(Index i, Index j)
         // lower diagonal
         return getMinvElement(j,i);
     }
+    if (m_isFactorizationPartitioned)
+    {
+        return getPartitionedMinvColumn(j).element(i);
+    }
     computeMinvBlock(i/bsize, j/bsize);
     return Minv.element(i,j);
 }
@@ -318,6 +583,13 @@ void BTDLinearSolver<Matrix,Vector>::solve (Matrix& /*M*/, Vector& x, Vector& b)
     const Index nb = b.size() / bsize;
     if (nb == 0) return;
 
+    if (m_isFactorizationPartitioned)
+    {
+        solvePartitioned(x, b);
+        msg_info_when(verbose) << "solve, solution = "<<x;
+        return;
+    }
+
     x.asub(0,bsize) = alpha_inv[0] * b.asub(0,bsize);
     for (Index i=1; i<nb; ++i)
     {
@@ -411,6 +683,9 @@ void BTDLinearSolver<Matrix,Vector>::init_partial_solve()
 
     // Bloc that is currently being proceed => start from the end (so that we use step2 bwdAccumulateLHGlobal and accumulate potential initial forces)
     current_bloc = nb-1;
+    _indMaxNonNullForce = current_bloc;
+    // no forward contribution is computed yet: the first backward accumulation goes down to the bloc 0
+    _indMaxFwdLHComputed = 0;
 
 
     // DF represents the variation of the right hand side of the equation (Force in mechanics)
@@ -488,19 +763,21 @@ void BTDLinearSolver<Matrix,Vector>::bwdAccumulateRHinBloc(Index indMaxBloc)
 ////// STEP 2
 
 template<class Matrix, class Vector>
-void BTDLinearSolver<Matrix,Vector>::bwdAccumulateLHGlobal( )
+void BTDLinearSolver<Matrix,Vector>::bwdAccumulateLHGlobal(Index indMinBloc)
 {
     constexpr Index bsize = Matrix::getSubMatrixDim();
     _acc_lh_bloc =  bwdContributionOnLH.asub(current_bloc, bsize);
 
     const bool showProblem = d_problem.getValue();
 
-    while( current_bloc > 0)
+    while( current_bloc > indMinBloc)
     {
         dmsg_info_when(showProblem) << "bwdLH[" << current_bloc - 1 << "] = H[" << current_bloc - 1 << "][" << current_bloc << "] *( bwdLH[" << current_bloc << "] + Minv[" << current_bloc << "][" << current_bloc << "] * RH[" << current_bloc << "])";
 
-        // BwdLH += Minv*RH
-        _acc_lh_bloc +=  Minv.asub(current_bloc,current_bloc,bsize,bsize) * this->linearSystem.systemRHVector->asub(current_bloc,bsize) ;
+        // BwdLH += Minv*RH (most of the blocs of RH are null: only the ones of the constrained dofs are non null)
+        const SubVector& RHbloc = this->linearSystem.systemRHVector->asub(current_bloc,bsize);
+        if (std::any_of(RHbloc.begin(), RHbloc.end(), [](const Real v) { return v != 0; }))
+            _acc_lh_bloc +=  Minv.asub(current_bloc,current_bloc,bsize,bsize) * RHbloc;
 
         current_bloc--;
         // BwdLH(n-1) = H(n-1)(n)*BwdLH(n)
@@ -511,17 +788,22 @@ void BTDLinearSolver<Matrix,Vector>::bwdAccumulateLHGlobal( )
 
     }
 
-    // at this point, current_bloc must be equal to 0
+    // at this point, current_bloc must be equal to indMinBloc
 
-    // all the forces from RH were accumulated through bwdAccumulation:
-    _indMaxNonNullForce = 0;
+    // all the forces from RH on the blocs above current_bloc were accumulated through bwdAccumulation:
+    _indMaxNonNullForce = current_bloc;
 
-    // need to update all the value of LH during forward
-    _indMaxFwdLHComputed = 0;
+    // need to update all the value of LH above current_bloc during forward
+    _indMaxFwdLHComputed = current_bloc;
 
     // init fwdContribution
-    fwdContributionOnRH.asub(0, bsize) = 0;
+    if (current_bloc == 0)
+        fwdContributionOnRH.asub(0, bsize) = 0;
 
+    // compute the bloc which indice is current_bloc (step 3 is skipped if current_bloc is already MinIdBloc_OUT)
+    const Index b = current_bloc;
+    this->linearSystem.systemLHVector->asub(b,bsize) = Minv.asub( b, b ,bsize,bsize) * ( fwdContributionOnRH.asub(b, bsize) + this->linearSystem.systemRHVector->asub(b,bsize) ) +
+            bwdContributionOnLH.asub(b, bsize);
 
 }
 
@@ -625,7 +907,7 @@ void BTDLinearSolver<Matrix,Vector>::partial_solve(ListIndex&  Iout, ListIndex&
         bwdAccumulateRHinBloc(this->_indMaxNonNullForce );
 
         // now the fwdLH begins to be wrong when > to the indice of MinIdBloc_IN (need to be updated in step 3 or 4)
-        this->_indMaxFwdLHComputed = MinIdBloc_IN;
+        this->_indMaxFwdLHComputed = std::min(this->_indMaxFwdLHComputed, MinIdBloc_IN);
     }
 
     if (current_bloc > MinIdBloc_OUT)
@@ -633,8 +915,9 @@ void BTDLinearSolver<Matrix,Vector>::partial_solve(ListIndex&  Iout, ListIndex&
         //debug
         dmsg_info_when(showProblem) << "STEP2 (bwd GLOBAL on structure) : current_bloc ="<<current_bloc<<" > to  MinIdBloc_OUT ="<<MinIdBloc_OUT;
 
-        // step 2:
-        bwdAccumulateLHGlobal();
+        // step 2: the backward accumulation only goes down to the first bloc where fwdRH is still valid:
+        // below MinIdBloc_OUT, the blocs are not affected by the constraints (step 3 goes up from there)
+        bwdAccumulateLHGlobal(std::min(MinIdBloc_OUT, this->_indMaxFwdLHComputed));
 
         //debug
         dmsg_info_when(showProblem) << " new current_bloc = " << current_bloc;
@@ -719,7 +1002,7 @@ template<class RMatrix, class JMatrix>
 bool BTDLinearSolver<Matrix,Vector>::addJMInvJt(RMatrix& result, JMatrix& J, double fact)
 {
     const Index Jcols = J.colSize();
-    if (Jcols != Minv.rowSize())
+    if (Jcols != getSystemSize())
     {
         msg_error() << "AddJMInvJt: incompatible J matrix size.";
         return false;
@@ -729,10 +1012,10 @@ bool BTDLinearSolver<Matrix,Vector>::addJMInvJt(RMatrix& result, JMatrix& J, dou
     {
         std::stringstream tmpStr;
         tmpStr<< "C = ["<<msgendl;
-        for  (Index mr=0; mr<Minv.rowSize(); mr++)
+        for  (Index mr=0; mr<Jcols; mr++)
         {
             tmpStr<<" "<<msgendl;
-            for (Index mc=0; mc<Minv.colSize(); mc++)
+            for (Index mc=0; mc<Jcols; mc++)
             {
                 tmpStr<<" "<< getMinvElement(mr,mc);
             }
@@ -32,11 +32,20 @@ using namespace sofa::linearalgebra;
 int SparseLDLSolverClass = core::RegisterObject("Direct Linear Solver using a Sparse LDL^T factorization.")
         .add< SparseLDLSolver< CompressedRowSparseMatrix<SReal>,FullVector<SReal> > >(true)
         .add< SparseLDLSolver< CompressedRowSparseMatrix<type::Mat<3,3,SReal> >,FullVector<SReal> > >()
+#ifndef SOFA_FLOAT
+        // matrix and factorization stored in single precision, iterative refinement in double precision
+        .add< SparseLDLSolver< CompressedRowSparseMatrix<float>,FullVector<SReal> > >()
+        .add< SparseLDLSolver< CompressedRowSparseMatrix<type::Mat<3,3,float> >,FullVector<SReal> > >()
+#endif
 
 ;
 
 template class SOFA_COMPONENT_LINEARSOLVER_DIRECT_API SparseLDLSolver< CompressedRowSparseMatrix<SReal>,FullVector<SReal> >;
 template class SOFA_COMPONENT_LINEARSOLVER_DIRECT_API SparseLDLSolver< CompressedRowSparseMatrix< type::Mat<3,3,SReal> >,FullVector<SReal> >;
+#ifndef SOFA_FLOAT
+template class SOFA_COMPONENT_LINEARSOLVER_DIRECT_API SparseLDLSolver< CompressedRowSparseMatrix<float>,FullVector<SReal> >;
+template class SOFA_COMPONENT_LINEARSOLVER_DIRECT_API SparseLDLSolver< CompressedRowSparseMatrix< type::Mat<3,3,float> >,FullVector<SReal> >;
+#endif
 
 
 } // namespace sofa::component::linearsolver::direct
@@ -42,6 +42,12 @@ namespace sofa::component::linearsolver::direct
 {
 
 // Direct linear solver based on Sparse LDL^T factorization, implemented with the CSPARSE library
+//
+// If the matrix is stored in a lower precision than the vectors (e.g. single precision matrix and
+// double precision vectors), the system is assembled in the precision of the vectors, and rounded to
+// the precision of the matrix to be factorized. The solution is improved with iterative refinement:
+// the residual is computed with the assembled matrix, and the correction is obtained with the low
+// precision factorization.
 template<class TMatrix, class TVector, class TThreadManager = NoThreadManager>
 class SparseLDLSolver : public SparseLDLSolverImpl<TMatrix,TVector, TThreadManager>
 {
@@ -56,6 +62,13 @@ public :
     typedef typename Inherit::JMatrixType JMatrixType;
     typedef SparseLDLImplInvertData<type::vector<int>, type::vector<Real> > InvertData;
 
+    /// True if the matrix is stored in a lower precision than the vectors
+    static constexpr bool isMixedPrecision = !std::is_same_v<Real, typename Vector::Real>;
+
+    /// Matrix with the blocks of Matrix in the precision of the vectors, in which the system is assembled in mixed precision
+    using HighPrecisionMatrix = sofa::linearalgebra::CompressedRowSparseMatrix<std::conditional_t<Matrix::NL == 1 && Matrix::NC == 1,
+        typename Vector::Real, type::Mat<Matrix::NL, Matrix::NC, typename Vector::Real> > >;
+
     void parse( sofa::core::objectmodel::BaseObjectDescription* arg ) override;
     void solve (Matrix& M, Vector& x, Vector& b) override;
     void invert(Matrix& M) override;
@@ -63,6 +76,11 @@ public :
     bool addJMInvJtLocal(TMatrix * M, ResMatrixType * result,const JMatrixType * J, SReal fact) override;
     int numStep;
 
+    Data<unsigned int> d_refinementMaxIterations; ///< Maximum number of iterative refinement steps (mixed precision only)
+    Data<SReal> d_refinementTolerance; ///< Iterative refinement stops when the norm of the residual relative to the norm of the right-hand side is below this threshold (mixed precision only)
+
+    std::size_t getMemoryFootprint() const override;
+
     SOFA_ATTRIBUTE_DISABLED__SPARSELDLSOLVER_MATRIXEXPORT
     DeprecatedAndRemoved f_saveMatrixToFile;
 
@@ -81,14 +99,44 @@ protected :
 
     type::vector<int> Jlocal2global;
     sofa::linearalgebra::FullMatrix<Real> JLinvDinv, JLinv;
+    type::vector<double> JMinvJt; ///< upper part of J * M^-1 * J^T, computed before being added to the result
     sofa::linearalgebra::CompressedRowSparseMatrix<Real> Mfiltered;
 
     bool factorize(Matrix& M, InvertData * invertData);
+
+    /// Write the values of M in place in the matrix stored in invertData, if M has the same pattern as the
+    /// previously factorized matrix. Returns false if the pattern must be rebuilt.
+    /// If the factorization can be updated (d_maxUpdateRank), the modified values are recorded in
+    /// m_changedSlots and m_previousValues.
+    bool updateFactorizedValues(const Matrix& M, InvertData * invertData);
+
+    type::vector<int> m_changedSlots;
+    type::vector<Real> m_previousValues;
+
+    /// Record the pattern of M and the position in Mfiltered of each scalar entry of its blocks
+    void buildFactorizedSlots(const Matrix& M, InvertData * invertData);
+
+    /// In mixed precision, the system is assembled in m_highPrecisionMatrix, and rounded in the system matrix
+    void assembleSystemMatrix(const core::MechanicalParams* mparams) override;
+
+    /// Solve with the factorization computed in the precision of the matrix, and improve the
+    /// solution with iterative refinement, computing the residual with m_highPrecisionMatrix
+    void solveWithIterativeRefinement(Vector& x, const Vector& b, InvertData* invertData);
+
+    /// System matrix as assembled, before being rounded to the precision of the factorization (mixed precision only)
+    HighPrecisionMatrix m_highPrecisionMatrix;
+
+    type::vector<Real> m_lowPrecisionRHS, m_lowPrecisionSolution;
+    Vector m_residual;
 };
 
 #if  !defined(SOFA_COMPONENT_LINEARSOLVER_SPARSELDLSOLVER_CPP)
 extern template class SOFA_COMPONENT_LINEARSOLVER_DIRECT_API SparseLDLSolver< sofa::linearalgebra::CompressedRowSparseMatrix< SReal>, sofa::linearalgebra::FullVector<SReal> >;
 extern template class SOFA_COMPONENT_LINEARSOLVER_DIRECT_API SparseLDLSolver< sofa::linearalgebra::CompressedRowSparseMatrix< type::Mat<3,3,SReal> >, sofa::linearalgebra::FullVector<SReal> >;
+#ifndef SOFA_FLOAT
+extern template class SOFA_COMPONENT_LINEARSOLVER_DIRECT_API SparseLDLSolver< sofa::linearalgebra::CompressedRowSparseMatrix< float >, sofa::linearalgebra::FullVector<SReal> >;
+extern template class SOFA_COMPONENT_LINEARSOLVER_DIRECT_API SparseLDLSolver< sofa::linearalgebra::CompressedRowSparseMatrix< type::Mat<3,3,float> >, sofa::linearalgebra::FullVector<SReal> >;
+#endif
 #endif
 
 } // namespace sofa::component::linearsolver::direct
@@ -27,6 +27,7 @@
 #include <sofa/helper/system/thread/CTime.h>
 #include <sofa/core/objectmodel/BaseContext.h>
 #include <sofa/core/behavior/LinearSolver.h>
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iomanip>      // std::setprecision
@@ -37,7 +38,17 @@ namespace sofa::component::linearsolver::direct
 
 template<class TMatrix, class TVector, class TThreadManager>
 SparseLDLSolver<TMatrix,TVector,TThreadManager>::SparseLDLSolver()
-    : numStep(0){}
+    : numStep(0)
+    , d_refinementMaxIterations(initData(&d_refinementMaxIterations, 5u, "refinementMaxIterations", "Maximum number of iterative refinement steps, when the matrix is stored in a lower precision than the vectors"))
+    , d_refinementTolerance(initData(&d_refinementTolerance, 1e-10_sreal, "refinementTolerance", "Iterative refinement stops when the norm of the residual relative to the norm of the right-hand side is below this threshold"))
+{
+    if constexpr (!isMixedPrecision)
+    {
+        // no iterative refinement
+        this->removeData(&d_refinementMaxIterations);
+        this->removeData(&d_refinementTolerance);
+    }
+}
 
 template <class TMatrix, class TVector, class TThreadManager>
 void SparseLDLSolver<TMatrix, TVector, TThreadManager>::parse(sofa::core::objectmodel::BaseObjectDescription* arg)
@@ -53,7 +64,7 @@ void SparseLDLSolver<TMatrix, TVector, TThreadManager>::parse(sofa::core::object
         }
 
         static const char* blocksType =
-        sofa::linearalgebra::CompressedRowSparseMatrix<sofa::type::Mat<3, 3, SReal> >::Name();
+        sofa::linearalgebra::CompressedRowSparseMatrix<sofa::type::Mat<3, 3, Real> >::Name();
 
         msg_advice(header) << "Template is empty\n"
                            << "By default " << this->getClassName() << " uses blocks with a single scalar (to handle all cases of simulations).\n"
@@ -72,15 +83,117 @@ template<class TMatrix, class TVector, class TThreadManager>
 void SparseLDLSolver<TMatrix,TVector,TThreadManager>::solve (Matrix& M, Vector& z, Vector& r)
 {
     sofa::helper::ScopedAdvancedTimer solveTimer("solve");
-    Inherit::solve_cpu(z.ptr(), r.ptr(), (InvertData *) this->getMatrixInvertData(&M));
+    if constexpr (!isMixedPrecision)
+    {
+        Inherit::solve_cpu(z.ptr(), r.ptr(), (InvertData *) this->getMatrixInvertData(&M));
+    }
+    else
+    {
+        solveWithIterativeRefinement(z, r, (InvertData *) this->getMatrixInvertData(&M));
+    }
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+void SparseLDLSolver<TMatrix,TVector,TThreadManager>::assembleSystemMatrix(const core::MechanicalParams* mparams)
+{
+    if constexpr (!isMixedPrecision)
+    {
+        Inherit::assembleSystemMatrix(mparams);
+    }
+    else
+    {
+        auto& linearSystem = this->linearSystem;
+        simulation::common::MechanicalOperations mops(mparams, this->getContext());
+
+        linearSystem.matrixAccessor.setGlobalMatrix(&m_highPrecisionMatrix);
+        linearSystem.matrixAccessor.clear();
+        mops.getMatrixDimension(&linearSystem.matrixAccessor);
+        linearSystem.matrixAccessor.setupMatrices();
+
+        const auto n = linearSystem.matrixAccessor.getGlobalDimension();
+        this->resizeSystem(n);
+        m_highPrecisionMatrix.resize(n, n);
+        m_highPrecisionMatrix.clear();
+        mops.addMBK_ToMatrix(&(linearSystem.matrixAccessor), mparams->mFactor(), sofa::core::mechanicalparams::bFactor(mparams), mparams->kFactor());
+        linearSystem.matrixAccessor.computeGlobalMatrix();
+        m_highPrecisionMatrix.compress();
+
+        // the factorization is computed in the precision of the system matrix
+        linearSystem.systemMatrix->clear();
+        m_highPrecisionMatrix.addTo(linearSystem.systemMatrix);
+    }
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+void SparseLDLSolver<TMatrix,TVector,TThreadManager>::solveWithIterativeRefinement(Vector& x, const Vector& b, InvertData* invertData)
+{
+    using VecIndex = typename Vector::Index;
+    const VecIndex n = b.size();
+    m_lowPrecisionRHS.resize(n);
+    m_lowPrecisionSolution.resize(n);
+
+    // solution of M * lowPrecisionSolution = rhs using the low precision factorization
+    const auto lowPrecisionSolve = [this, n, invertData](const Vector& rhs)
+    {
+        for (VecIndex i = 0; i < n; ++i)
+        {
+            m_lowPrecisionRHS[i] = static_cast<Real>(rhs[i]);
+        }
+        Inherit::solve_cpu(m_lowPrecisionSolution.data(), m_lowPrecisionRHS.data(), invertData);
+    };
+
+    lowPrecisionSolve(b);
+    x.resize(n);
+    for (VecIndex i = 0; i < n; ++i)
+    {
+        x[i] = m_lowPrecisionSolution[i];
+    }
+
+    const SReal normB = b.norm();
+    if (normB == 0)
+    {
+        return;
+    }
+
+    if (m_highPrecisionMatrix.rowSize() != static_cast<typename HighPrecisionMatrix::Index>(n))
+    {
+        msg_warning() << "The system matrix has not been assembled by this solver: the solution is not refined";
+        return;
+    }
+
+    const unsigned int maxIterations = d_refinementMaxIterations.getValue();
+    const SReal tolerance = d_refinementTolerance.getValue();
+
+    unsigned int nbIterations = 0;
+    SReal relativeResidual = 0;
+    for (;;)
+    {
+        // residual computed with the matrix as assembled, before its rounding: r = b - M * x
+        m_highPrecisionMatrix.mul(m_residual, x);
+        m_residual.eq(b, m_residual, -1);
+
+        relativeResidual = m_residual.norm() / normB;
+        if (relativeResidual <= tolerance || nbIterations == maxIterations)
+        {
+            break;
+        }
+
+        lowPrecisionSolve(m_residual);
+        for (VecIndex i = 0; i < n; ++i)
+        {
+            x[i] += m_lowPrecisionSolution[i];
+        }
+        ++nbIterations;
+    }
+
+    msg_info() << "Iterative refinement: " << nbIterations << " iteration(s), relative residual " << relativeResidual;
 }
 
 template <class TMatrix, class TVector, class TThreadManager>
 bool SparseLDLSolver<TMatrix, TVector, TThreadManager>::factorize(
     Matrix& M, InvertData * invertData)
 {
-    Mfiltered.copyNonZeros(M);
-    Mfiltered.compress();
+    M.compress();
 
     int n = M.colSize();
 
@@ -90,6 +203,23 @@ bool SparseLDLSolver<TMatrix, TVector, TThreadManager>::factorize(
         return true;
     }
 
+    // same pattern as the previous step: the factorization is modified with the values that changed, or only the
+    // numeric factorization is computed, in the existing buffers
+    if (updateFactorizedValues(M, invertData))
+    {
+        if (!Inherit::updownFactorization(invertData, m_changedSlots, m_previousValues))
+        {
+            Inherit::refactorize(invertData);
+        }
+
+        numStep++;
+
+        return false;
+    }
+
+    Mfiltered.copyNonZeros(M);
+    Mfiltered.compress();
+
     int * M_colptr = (int *)Mfiltered.getRowBegin().data();
     int * M_rowind = (int *)Mfiltered.getColsIndex().data();
     Real * M_values = (Real *)Mfiltered.getColsValue().data();
@@ -102,17 +232,134 @@ bool SparseLDLSolver<TMatrix, TVector, TThreadManager>::factorize(
 
     Inherit::factorize(n,M_colptr,M_rowind,M_values, invertData);
 
+    buildFactorizedSlots(M, invertData);
+
     numStep++;
 
     return false;
 }
 
+template <class TMatrix, class TVector, class TThreadManager>
+bool SparseLDLSolver<TMatrix, TVector, TThreadManager>::updateFactorizedValues(
+    const Matrix& M, InvertData * invertData)
+{
+    using traits = typename Matrix::traits;
+
+    if (invertData->M_slots.empty() || invertData->n != static_cast<int>(M.colSize())
+        || !this->isSymbolicFactorizationReusable(invertData))
+    {
+        return false;
+    }
+
+    const auto sameIndices = [](const type::vector<int>& recorded, const typename Matrix::VecIndex& indices)
+    {
+        return std::equal(recorded.begin(), recorded.end(), indices.begin(), indices.end(),
+            [](int r, sofa::Index i) { return r == static_cast<int>(i); });
+    };
+    if (!sameIndices(invertData->M_rowIndex, M.getRowIndex())
+        || !sameIndices(invertData->M_rowBegin, M.getRowBegin())
+        || !sameIndices(invertData->M_colsIndex, M.getColsIndex()))
+    {
+        return false;
+    }
+
+    const bool recordChanges = this->d_maxUpdateRank.getValue() > 0;
+    m_changedSlots.clear();
+    m_previousValues.clear();
+
+    const auto& blocks = M.getColsValue();
+    const int * slot = invertData->M_slots.data();
+    Real * values = invertData->P_values.data();
+    for (const auto& block : blocks)
+    {
+        for (sofa::Index a = 0; a < traits::NL; ++a)
+        {
+            for (sofa::Index b = 0; b < traits::NC; ++b, ++slot)
+            {
+                const Real v = traits::v(block, a, b);
+                if (*slot >= 0)
+                {
+                    if (recordChanges && values[*slot] != v)
+                    {
+                        m_changedSlots.push_back(*slot);
+                        m_previousValues.push_back(values[*slot]);
+                    }
+                    values[*slot] = v;
+                }
+                else if (v != 0)
+                {
+                    // this entry was zero, and filtered out of the factorized matrix
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+template <class TMatrix, class TVector, class TThreadManager>
+void SparseLDLSolver<TMatrix, TVector, TThreadManager>::buildFactorizedSlots(
+    const Matrix& M, InvertData * invertData)
+{
+    using traits = typename Matrix::traits;
+
+    invertData->M_slots.clear();
+    if (!this->d_precomputeSymbolicDecomposition.getValue() || Mfiltered.getRowIndex().size() != (std::size_t)invertData->n)
+    {
+        return;
+    }
+
+    const auto& rowIndex = M.getRowIndex();
+    const auto& rowBegin = M.getRowBegin();
+    const auto& colsIndex = M.getColsIndex();
+    invertData->M_rowIndex.assign(rowIndex.begin(), rowIndex.end());
+    invertData->M_rowBegin.assign(rowBegin.begin(), rowBegin.end());
+    invertData->M_colsIndex.assign(colsIndex.begin(), colsIndex.end());
+    invertData->M_slots.resize(colsIndex.size() * traits::NL * traits::NC);
+
+    // all the rows are in Mfiltered: the scalar row r starts at filteredRowBegin[r]
+    const auto& filteredRowBegin = Mfiltered.getRowBegin();
+    const auto& filteredColsIndex = Mfiltered.getColsIndex();
+    for (std::size_t rowId = 0; rowId < rowIndex.size(); ++rowId)
+    {
+        for (sofa::Index a = 0; a < traits::NL; ++a)
+        {
+            const sofa::Index row = rowIndex[rowId] * traits::NL + a;
+            sofa::Index p = filteredRowBegin[row];
+            const sofa::Index end = filteredRowBegin[row + 1];
+            for (sofa::Index xj = rowBegin[rowId]; xj < rowBegin[rowId + 1]; ++xj)
+            {
+                for (sofa::Index b = 0; b < traits::NC; ++b)
+                {
+                    const sofa::Index col = colsIndex[xj] * traits::NC + b;
+                    while (p < end && filteredColsIndex[p] < col) ++p;
+                    invertData->M_slots[(xj * traits::NL + a) * traits::NC + b] = (p < end && filteredColsIndex[p] == col) ? static_cast<int>(p) : -1;
+                }
+            }
+        }
+    }
+}
+
 template<class TMatrix, class TVector, class TThreadManager>
 void SparseLDLSolver<TMatrix,TVector,TThreadManager>::invert(Matrix& M)
 {
     factorize(M, (InvertData *) this->getMatrixInvertData(&M));
 }
 
+template<class TMatrix, class TVector, class TThreadManager>
+std::size_t SparseLDLSolver<TMatrix,TVector,TThreadManager>::getMemoryFootprint() const
+{
+    std::size_t footprint = Inherit::getMemoryFootprint();
+    footprint += Mfiltered.getMemoryFootprint() + JLinvDinv.getMemoryFootprint() + JLinv.getMemoryFootprint();
+    footprint += (Jlocal2global.capacity() + m_changedSlots.capacity()) * sizeof(int) + m_previousValues.capacity() * sizeof(Real)
+        + JMinvJt.capacity() * sizeof(double);
+    if constexpr (isMixedPrecision)
+    {
+        footprint += m_highPrecisionMatrix.getMemoryFootprint();
+    }
+    return footprint;
+}
+
 template <class TMatrix, class TVector, class TThreadManager>
 bool SparseLDLSolver<TMatrix, TVector, TThreadManager>::doAddJMInvJtLocal(ResMatrixType* result, const JMatrixType* J, SReal fact, InvertData* data)
 {
@@ -146,8 +393,8 @@ bool SparseLDLSolver<TMatrix, TVector, TThreadManager>::doAddJMInvJtLocal(ResMat
         }
     }
 
-    //Solve the lower triangular system
-    for (unsigned c = 0; c < JlocalRowSize; c++) {
+    //Solve the lower triangular system and apply the diagonal, each line independently
+    this->forEachIndex(JlocalRowSize, [this, data](std::size_t c) {
         Real* line = JLinv[c];
 
         for (int j=0; j<data->n; j++) {
@@ -157,29 +404,32 @@ bool SparseLDLSolver<TMatrix, TVector, TThreadManager>::doAddJMInvJtLocal(ResMat
                 line[j] -= val * line[col];
             }
         }
-    }
 
-    //apply diagonal
-    for (unsigned j = 0; j < JlocalRowSize; j++) {
-        Real* lineD = JLinv[j];
-        Real* lineM = JLinvDinv[j];
+        Real* lineM = JLinvDinv[c];
         for (unsigned i = 0; i < (unsigned)data->n; i++) {
-            lineM[i] = lineD[i] * data->invD[i];
+            lineM[i] = line[i] * data->invD[i];
         }
-    }
+    });
 
-    for (unsigned j = 0; j < JlocalRowSize; j++) {
-        Real* lineJ = JLinvDinv[j];
-        int globalRowJ = Jlocal2global[j];
+    JMinvJt.resize(JlocalRowSize * JlocalRowSize);
+    this->forEachIndex(JlocalRowSize, [this, data, fact, JlocalRowSize](std::size_t j) {
+        const Real* lineJ = JLinvDinv[j];
         for (unsigned i = j; i < JlocalRowSize; i++) {
-            Real* lineI = JLinv[i];
-            int globalRowI = Jlocal2global[i];
+            const Real* lineI = JLinv[i];
 
             double acc = 0.0;
             for (unsigned k = 0; k < (unsigned)data->n; k++) {
                 acc += lineJ[k] * lineI[k];
             }
-            acc *= fact;
+            JMinvJt[j * JlocalRowSize + i] = acc * fact;
+        }
+    });
+
+    for (unsigned j = 0; j < JlocalRowSize; j++) {
+        int globalRowJ = Jlocal2global[j];
+        for (unsigned i = j; i < JlocalRowSize; i++) {
+            int globalRowI = Jlocal2global[i];
+            const double acc = JMinvJt[j * JlocalRowSize + i];
             result->add(globalRowJ, globalRowI, acc);
             if (globalRowI != globalRowJ) result->add(globalRowI, globalRowJ, acc);
         }
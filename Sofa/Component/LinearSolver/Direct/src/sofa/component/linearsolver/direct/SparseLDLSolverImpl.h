@@ -26,7 +26,15 @@
 #include <sofa/component/linearsolver/iterative/MatrixLinearSolver.h>
 #include <sofa/component/linearsolver/direct/SparseCommon.h>
 #include <sofa/helper/OptionsGroup.h>
+#include <sofa/simulation/TaskScheduler.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/ParallelForEach.h>
 #include <csparse.h>
+#include <Eigen/Dense>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
 extern "C" {
 #include <metis.h>
 }
@@ -46,6 +54,36 @@ public :
     VecReal P_values,L_values,LT_values,invD;
     type::vector<int> Parent;
     bool new_factorization_needed;
+
+    /// Supernodes, used by the supernodal factorization: the columns of the supernode s are [superPtr[s], superPtr[s+1]),
+    /// superOf gives the supernode of each column, and superValuesPtr the offset of the dense storage of each supernode
+    type::vector<int> superPtr, superOf;
+    type::vector<std::size_t> superValuesPtr;
+
+    /// Partition of the etree in independent subtrees and top nodes, used by the parallel factorization and solve
+    type::vector<int> subtreePtr, subtreeNodes, topNodes;
+
+    /// Position in L_values of each entry of LT_values, to transpose the factor without rebuilding its pattern
+    type::vector<int> LT_map;
+
+    /// Block pattern of the matrix given to the solver, and position in P_values of each scalar entry of its blocks
+    /// (-1 if the entry was filtered out), to update P_values in place as long as the pattern does not change
+    type::vector<int> M_rowIndex, M_rowBegin, M_colsIndex, M_slots;
+
+    /// Accumulated rank of the updates and downdates applied to the factorization since it was computed
+    unsigned int updateRank { 0 };
+
+    std::size_t getMemoryFootprint() const override
+    {
+        const auto indices = P_rowind.capacity() + P_colptr.capacity() + L_rowind.capacity() + L_colptr.capacity()
+            + LT_rowind.capacity() + LT_colptr.capacity() + perm.capacity() + invperm.capacity();
+        const auto values = P_values.capacity() + L_values.capacity() + LT_values.capacity() + invD.capacity();
+        return indices * sizeof(typename VecInt::value_type) + values * sizeof(typename VecReal::value_type)
+            + (Parent.capacity() + superPtr.capacity() + superOf.capacity()) * sizeof(int)
+            + (subtreePtr.capacity() + subtreeNodes.capacity() + topNodes.capacity() + LT_map.capacity()) * sizeof(int)
+            + (M_rowIndex.capacity() + M_rowBegin.capacity() + M_colsIndex.capacity() + M_slots.capacity()) * sizeof(int)
+            + superValuesPtr.capacity() * sizeof(std::size_t);
+    }
 };
 
 inline void CSPARSE_symbolic (int n,int * M_colptr,int * M_rowind,int * colptr,int * perm,int * invperm,int * Parent, int * Flag, int * Lnz)
@@ -78,16 +116,129 @@ inline void CSPARSE_symbolic (int n,int * M_colptr,int * M_rowind,int * colptr,i
     for (int k = 0 ; k < n ; k++) colptr[k+1] = colptr[k] + Lnz[k] ;
 }
 
-template<class Real>
-inline void CSPARSE_numeric(int n,int * M_colptr,int * M_rowind,Real * M_values,int * colptr,int * rowind,Real * values,Real * D,int * perm,int * invperm,int * Parent, int * Flag, int * Lnz, int * Pattern, Real * Y)
+// compute the row indices of each column of L, in increasing order, colptr being given by CSPARSE_symbolic
+inline void CSPARSE_pattern(int n,int * M_colptr,int * M_rowind,int * colptr,int * rowind,int * perm,int * invperm,int * Parent, int * Flag, int * Lnz)
+{
+    for (int k = 0 ; k < n ; k++)
+    {
+        Flag [k] = k ;		    // mark node k as visited
+        Lnz [k] = 0 ;		    // count of nonzeros in column k of L
+        int kk = perm[k];  // kth original, or permuted, column
+        for (int p = M_colptr[kk] ; p < M_colptr[kk+1] ; p++)
+        {
+            int i = invperm[M_rowind[p]];
+            if (i < k)
+            {
+                // the nonzeros of the kth row of L are the nodes on the paths from i to k in the etree
+                for ( ; Flag [i] != k ; i = Parent [i])
+                {
+                    rowind[colptr[i] + Lnz[i]++] = k ;	// L (k,i) is nonzero
+                    Flag [i] = k ;
+                }
+            }
+        }
+    }
+}
+
+// partition the columns of L in supernodes: sets of contiguous columns, each column being the parent of the previous one in
+// the etree, stored with the pattern of the last column of the supernode. Columns are merged even if it adds explicit
+// zeros to the factor (relaxed supernodes), as long as the proportion of zeros remains small.
+// The dense storage of a supernode is the block of rows made of its diagonal block and of the pattern of its last column,
+// stored column-major. The pattern of the factor is replaced by the pattern of the supernodes in colptr and rowind.
+template<class VecInt>
+inline void LDL_supernodes(int n,VecInt& colptr,VecInt& rowind,const int * Parent,type::vector<int>& superPtr,type::vector<int>& superOf,type::vector<std::size_t>& superValuesPtr)
+{
+    // maximum proportion of explicit zeros according to the number of columns of the supernode
+    const auto acceptZeros = [](std::size_t nbCols, std::size_t nbZeros, std::size_t nbEntries)
+    {
+        if (nbZeros == 0 || nbCols <= 4) return true;
+        if (nbCols <= 16) return nbZeros < 0.8 * nbEntries;
+        if (nbCols <= 48) return nbZeros < 0.1 * nbEntries;
+        return nbZeros < 0.05 * nbEntries;
+    };
+
+    superPtr.clear();
+    superPtr.push_back(0);
+    superOf.resize(n);
+    for (int j = 0 ; j < n ; j++)
+    {
+        const int first = superPtr.back();
+        if (j > first)
+        {
+            bool merge = Parent[j-1] == j;
+            if (merge)
+            {
+                // entries of the columns [first, j] stored with the pattern of the column j
+                const std::size_t nbCols = j - first + 1;
+                const std::size_t nbEntries = nbCols * (nbCols - 1) / 2 + nbCols * (colptr[j+1] - colptr[j]);
+                const std::size_t nbNonZeros = colptr[j+1] - colptr[first];
+                merge = acceptZeros(nbCols, nbEntries - nbNonZeros, nbEntries);
+            }
+            if (!merge)
+            {
+                superPtr.push_back(j);
+            }
+        }
+        superOf[j] = (int)superPtr.size() - 1;
+    }
+    superPtr.push_back(n);
+
+    const int nbSupernodes = (int)superPtr.size() - 1;
+
+    // pattern of the supernodes
+    VecInt superColptr;
+    superColptr.resize(n + 1);
+    superColptr[0] = 0;
+    for (int s = 0 ; s < nbSupernodes ; s++)
+    {
+        const int last = superPtr[s+1] - 1;
+        const int nbBelow = colptr[last+1] - colptr[last];
+        for (int j = superPtr[s] ; j <= last ; j++)
+        {
+            superColptr[j+1] = superColptr[j] + (last - j) + nbBelow;
+        }
+    }
+
+    VecInt superRowind;
+    superRowind.resize(superColptr[n]);
+    for (int s = 0 ; s < nbSupernodes ; s++)
+    {
+        const int last = superPtr[s+1] - 1;
+        for (int j = superPtr[s] ; j <= last ; j++)
+        {
+            int p = superColptr[j];
+            for (int i = j + 1 ; i <= last ; i++) superRowind[p++] = i;
+            for (int q = colptr[last] ; q < colptr[last+1] ; q++) superRowind[p++] = rowind[q];
+        }
+    }
+    colptr.swap(superColptr);
+    rowind.swap(superRowind);
+
+    superValuesPtr.resize(nbSupernodes + 1);
+    superValuesPtr[0] = 0;
+    for (int s = 0 ; s < nbSupernodes ; s++)
+    {
+        const int first = superPtr[s];
+        const std::size_t nbCols = superPtr[s+1] - first;
+        const std::size_t nbRows = 1 + colptr[first+1] - colptr[first];
+        superValuesPtr[s+1] = superValuesPtr[s] + nbRows * nbCols;
+    }
+}
+
+// numeric factorization of the rows row(0), ..., row(nbRows-1) of L, in this order. All the columns of L required by
+// these rows must be either already computed, or among these rows. Pattern is a stack of size stackSize, which must be
+// larger than the number of nonzeros of the rows. Returns false if a null pivot is encountered.
+template<class Real, class RowIndex>
+inline bool CSPARSE_numeric_rows(const RowIndex& row,int nbRows,int stackSize,int * M_colptr,int * M_rowind,Real * M_values,int * colptr,int * rowind,Real * values,Real * D,int * perm,int * invperm,int * Parent, int * Flag, int * Lnz, int * Pattern, Real * Y)
 {
     Real yi, l_ki ;
     int i, p, kk, len, top ;
 
-    for (int k = 0 ; k < n ; k++)
+    for (int r = 0 ; r < nbRows ; r++)
     {
+        const int k = row(r);
         Y [k] = 0.0 ;		    // Y(0:k) is now all zero 
-        top = n ;		    // stack for pattern is empty 
+        top = stackSize ;	    // stack for pattern is empty 
         Flag [k] = k ;		    // mark node k as visited 
         Lnz [k] = 0 ;		    // count of nonzeros in column k of L 
         kk = perm[k];  // kth original, or permuted, column 
@@ -108,9 +259,9 @@ inline void CSPARSE_numeric(int n,int * M_colptr,int * M_rowind,Real * M_values,
         // compute numerical values kth row of L (a sparse triangular solve) 
         D[k] = Y [k] ;		    // get D(k,k) and clear Y(k) 
         Y[k] = 0.0 ;
-        for ( ; top < n ; top++)
+        for ( ; top < stackSize ; top++)
         {
-            i = Pattern [top] ;	    // Pattern [top:n-1] is pattern of L(:,k) 
+            i = Pattern [top] ;	    // Pattern [top:stackSize-1] is pattern of L(:,k) 
             yi = Y [i] ;	    // get and clear Y(i) 
             Y [i] = 0.0 ;
             for (p = colptr[i] ; p < colptr[i] + Lnz [i] ; p++)
@@ -127,9 +278,125 @@ inline void CSPARSE_numeric(int n,int * M_colptr,int * M_rowind,Real * M_values,
         if (D[k] == 0.0)
         {
             msg_error("SparseLDLSolver") << "Failed to factorize, D(k,k) is zero" ;
-            return;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Rank-one modification L D L^T + sigma w w^T of a factorization, with sigma = 1 (update) or -1 (downdate), following
+// the method C1 of Gill, Golub, Murray and Saunders as used by Davis and Hager. w is zero except on {f} and the pattern
+// of the column f of L: the modification follows the path from f to the root in the etree, and does not change the
+// pattern of L. invD holds the inverse of the diagonal. w is used as workspace, and is zero on return.
+// Returns false if a pivot vanishes: the factorization must then be computed again.
+template<class Real>
+inline bool LDL_rank1(int n,int f,Real sigma,const int * colptr,const int * rowind,Real * values,Real * invD,const int * Parent,Real * w)
+{
+    Real alpha = sigma;
+    for (int j = f; j != -1; j = Parent[j])
+    {
+        const Real p = w[j];
+        if (p == 0) continue;
+        w[j] = 0;
+
+        const Real d = 1 / invD[j];
+        const Real dbar = d + alpha * p * p;
+        if (!(std::abs(dbar) > std::numeric_limits<Real>::epsilon() * std::abs(d)))
+        {
+            std::fill(w, w + n, Real(0));
+            return false;
+        }
+        const Real beta = p * alpha / dbar;
+        alpha *= d / dbar;
+        invD[j] = 1 / dbar;
+
+        for (int q = colptr[j]; q < colptr[j+1]; q++)
+        {
+            const int i = rowind[q];
+            w[i] -= p * values[q];
+            values[q] += beta * w[i];
+        }
+    }
+    return true;
+}
+
+template<class Real>
+inline void CSPARSE_numeric(int n,int * M_colptr,int * M_rowind,Real * M_values,int * colptr,int * rowind,Real * values,Real * D,int * perm,int * invperm,int * Parent, int * Flag, int * Lnz, int * Pattern, Real * Y)
+{
+    CSPARSE_numeric_rows<Real>([](int r) { return r; }, n, n, M_colptr, M_rowind, M_values, colptr, rowind, values, D, perm, invperm, Parent, Flag, Lnz, Pattern, Y);
+}
+
+// split the etree into independent subtrees, that can be factorized concurrently, and a set of top nodes, ancestors of
+// the subtrees. The subtrees are split until the work of each one is lower than a fraction of the total work, so that
+// they can be balanced among nbThreads threads. The nodes of the subtree t are subtreeNodes[subtreePtr[t]] to
+// subtreeNodes[subtreePtr[t+1]-1], sorted in increasing order, as well as topNodes. The subtrees are sorted by
+// decreasing work.
+inline void LDL_etreePartition(int n,const int * colptr,const int * Parent,int nbThreads,type::vector<int>& subtreePtr,type::vector<int>& subtreeNodes,type::vector<int>& topNodes)
+{
+    // work of a subtree: about the sum of the squares of the column counts of L
+    type::vector<double> work(n, 0.0);
+    type::vector<int> head(n, -1), next(n, -1);
+    type::vector<int> roots;
+    double totalWork = 0;
+    for (int j = 0 ; j < n ; j++)
+    {
+        const double count = colptr[j+1] - colptr[j];
+        work[j] += count * count + 1;
+        totalWork += count * count + 1;
+        if (Parent[j] == -1)
+        {
+            roots.push_back(j);
+        }
+        else
+        {
+            work[Parent[j]] += work[j];
+            next[j] = head[Parent[j]];
+            head[Parent[j]] = j;
         }
     }
+
+    // split the largest subtree until all the subtrees are small enough
+    const double maxWork = totalWork / (4.0 * std::max(1, nbThreads));
+    const auto lighter = [&work](int a, int b) { return work[a] < work[b]; };
+    type::vector<char> isTop(n, 0);
+    std::make_heap(roots.begin(), roots.end(), lighter);
+    while (!roots.empty() && work[roots.front()] > maxWork)
+    {
+        std::pop_heap(roots.begin(), roots.end(), lighter);
+        const int r = roots.back();
+        roots.pop_back();
+        isTop[r] = 1;
+        for (int c = head[r] ; c != -1 ; c = next[c])
+        {
+            roots.push_back(c);
+            std::push_heap(roots.begin(), roots.end(), lighter);
+        }
+    }
+    std::sort(roots.begin(), roots.end(), [&work](int a, int b) { return work[a] > work[b]; });
+
+    // owner subtree of each node, -1 for the top nodes
+    type::vector<int> owner(n, -1);
+    for (std::size_t t = 0 ; t < roots.size() ; t++) owner[roots[t]] = (int)t;
+    for (int j = n - 1 ; j >= 0 ; j--)
+    {
+        if (!isTop[j] && owner[j] == -1 && Parent[j] != -1) owner[j] = owner[Parent[j]];
+    }
+
+    subtreePtr.assign(roots.size() + 1, 0);
+    for (int j = 0 ; j < n ; j++)
+    {
+        if (owner[j] != -1) subtreePtr[owner[j] + 1]++;
+    }
+    for (std::size_t t = 0 ; t < roots.size() ; t++) subtreePtr[t+1] += subtreePtr[t];
+
+    subtreeNodes.resize(subtreePtr.back());
+    topNodes.clear();
+    type::vector<int> position(subtreePtr.begin(), subtreePtr.end() - 1);
+    for (int j = 0 ; j < n ; j++)
+    {
+        if (owner[j] != -1) subtreeNodes[position[owner[j]]++] = j;
+        else topNodes.push_back(j);
+    }
 }
 
 template<class TMatrix, class TVector, class TThreadManager>
@@ -149,13 +416,100 @@ protected :
     Data<bool> d_precomputeSymbolicDecomposition; ///< If true the solver will reuse the precomputed symbolic decomposition. Otherwise it will recompute it at each step.
     Data<bool> d_applyPermutation; ///< If true the solver will apply a fill-reducing permutation to the matrix of the system.
     Data<int> d_L_nnz; ///< Number of non-zero values in the lower triangular matrix of the factorization. The lower, the faster the system is solved.
+    Data<sofa::helper::OptionsGroup> d_factorizationMethod; ///< Method used for the numeric factorization
+    Data<bool> d_multithreading; ///< Factorize and solve in parallel the independent subtrees of the elimination tree
+    Data<unsigned int> d_maxUpdateRank; ///< Maximum accumulated rank of the updates and downdates of the factorization before it is computed again
 
     SparseLDLSolverImpl() : Inherit()
     , d_precomputeSymbolicDecomposition(initData(&d_precomputeSymbolicDecomposition, true ,"precomputeSymbolicDecomposition", "If true the solver will reuse the precomputed symbolic decomposition. Otherwise it will recompute it at each step."))
     , d_applyPermutation(initData(&d_applyPermutation, true ,"applyPermutation", "If true the solver will apply a fill-reducing permutation to the matrix of the system."))
     , d_L_nnz(initData(&d_L_nnz, 0, "L_nnz", "Number of non-zero values in the lower triangular matrix of the factorization. The lower, the faster the system is solved.", true, true))
+    , d_factorizationMethod(initData(&d_factorizationMethod, sofa::helper::OptionsGroup{{"UpLooking", "Supernodal"}}, "factorizationMethod",
+        "Method used for the numeric factorization:\n"
+        "-UpLooking: the factor is computed row by row with sparse scalar operations\n"
+        "-Supernodal: the columns sharing the same pattern are grouped into supernodes, factorized with dense block operations. "
+        "Faster on large 3D meshes, where the factor contains large dense blocks."))
+    , d_multithreading(initData(&d_multithreading, false, "multithreading", "Factorize and solve in parallel the independent subtrees of the elimination tree, using the main task scheduler. "
+        "Only the up-looking factorization is computed in parallel."))
+    , d_maxUpdateRank(initData(&d_maxUpdateRank, 0u, "maxUpdateRank", "If non-zero, when the pattern of the matrix does not change, the factorization is modified with rank-one "
+        "updates and downdates driven by the entries that changed, instead of being computed again, as long as the accumulated rank of "
+        "these modifications does not exceed this value. Each modified column of the permuted lower triangle counts for a rank of 2 "
+        "(1 if only its diagonal entry changes)."))
     {}
 
+public:
+    void init() override
+    {
+        Inherit::init();
+
+        if (d_multithreading.getValue())
+        {
+            m_taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+            if (m_taskScheduler->getThreadCount() == 0)
+            {
+                m_taskScheduler->init();
+            }
+        }
+        else
+        {
+            m_taskScheduler = nullptr;
+        }
+    }
+
+    /// Add the work buffers of the factorization, kept from one factorization to the next, to the footprint of the
+    /// factorization: the dense storage of the supernodes and their updates, and the buffers of the rank-one updates
+    std::size_t getMemoryFootprint() const override
+    {
+        const auto reals = Tmp.capacity() + Y.capacity() + superValues.capacity() + update.capacity() + updateW.capacity()
+            + updownW.capacity();
+        const auto indices = xadj.capacity() + adj.capacity() + t_xadj.capacity() + t_adj.capacity() + Lnz.capacity()
+            + Flag.capacity() + Pattern.capacity() + tran_countvec.capacity() + relativeRow.capacity() + superHead.capacity()
+            + superLink.capacity() + superNext.capacity();
+        return Inherit::getMemoryFootprint() + reals * sizeof(Real) + indices * sizeof(int)
+            + updownEntries.capacity() * sizeof(UpdownEntry);
+    }
+
+protected:
+    /// Task scheduler used to factorize and solve in parallel (nullptr if d_multithreading is false)
+    simulation::TaskScheduler* m_taskScheduler { nullptr };
+
+    /// Task scheduler used by the numeric factorization. The factorization must be called from the main thread, or
+    /// from a worker thread of the task scheduler.
+    virtual simulation::TaskScheduler* getFactorizationTaskScheduler()
+    {
+        return m_taskScheduler;
+    }
+
+    /// Apply f to the indices [0, n), in parallel if multithreading is enabled
+    template<class F>
+    void forEachIndex(std::size_t n, const F& f)
+    {
+        if (m_taskScheduler)
+        {
+            simulation::parallelForEach(*m_taskScheduler, static_cast<std::size_t>(0), n, f,
+                simulation::Partitioner{simulation::Partitioner::Type::AUTO, 1});
+        }
+        else
+        {
+            for (std::size_t i = 0; i < n; ++i) f(i);
+        }
+    }
+
+    bool isFactorizationSupernodal() const
+    {
+        return d_factorizationMethod.getValue().getSelectedId() == 1;
+    }
+
+    /// true if the symbolic factorization stored in data can be reused for a matrix with the same pattern
+    template<class VecInt,class VecReal>
+    bool isSymbolicFactorizationReusable(const SparseLDLImplInvertData<VecInt,VecReal> * data) const
+    {
+        return d_precomputeSymbolicDecomposition.getValue()
+            && !data->P_colptr.empty() && data->LT_map.size() == (std::size_t)data->L_nnz
+            && isFactorizationSupernodal() != data->superPtr.empty()
+            && (!m_taskScheduler || !data->subtreePtr.empty());
+    }
+
     template<class VecInt,class VecReal>
     void solve_cpu(Real * x,const Real * b,SparseLDLImplInvertData<VecInt,VecReal> * data) {
         int n = data->n;
@@ -170,23 +524,50 @@ protected :
 
         Tmp.clear();
         Tmp.fastResize(n);
+        Real * tmp = Tmp.data();
 
-        for (int j = 0 ; j < n ; j++) {
+        // the row j depends on its descendants in the etree in the forward substitution, and on its ancestors in the
+        // backward substitution
+        const auto forward = [=](int j) {
             Real acc = b[perm[j]];
             for (int p = LT_colptr [j] ; p < LT_colptr[j+1] ; p++) {
-                acc -= LT_values[p] * Tmp[LT_rowind[p]];
+                acc -= LT_values[p] * tmp[LT_rowind[p]];
             }
-            Tmp[j] = acc;
-        }
+            tmp[j] = acc;
+        };
 
-        for (int j = n-1 ; j >= 0 ; j--) {
-            Tmp[j] *= invD[j];
+        const auto backward = [=](int j) {
+            tmp[j] *= invD[j];
 
             for (int p = L_colptr[j] ; p < L_colptr[j+1] ; p++) {
-                Tmp[j] -= L_values[p] * Tmp[L_rowind[p]];
+                tmp[j] -= L_values[p] * tmp[L_rowind[p]];
             }
 
-            x[perm[j]] = Tmp[j];
+            x[perm[j]] = tmp[j];
+        };
+
+        const std::size_t nbSubtrees = data->subtreePtr.empty() ? 0 : data->subtreePtr.size() - 1;
+        if (m_taskScheduler && nbSubtrees > 1)
+        {
+            // the subtrees are independent, the top nodes are processed sequentially
+            const int * subtreePtr = data->subtreePtr.data();
+            const int * subtreeNodes = data->subtreeNodes.data();
+            const auto& topNodes = data->topNodes;
+
+            forEachIndex(nbSubtrees, [=](std::size_t t) {
+                for (int q = subtreePtr[t] ; q < subtreePtr[t+1] ; q++) forward(subtreeNodes[q]);
+            });
+            for (const int j : topNodes) forward(j);
+
+            for (auto it = topNodes.rbegin() ; it != topNodes.rend() ; ++it) backward(*it);
+            forEachIndex(nbSubtrees, [=](std::size_t t) {
+                for (int q = subtreePtr[t+1] - 1 ; q >= subtreePtr[t] ; q--) backward(subtreeNodes[q]);
+            });
+        }
+        else
+        {
+            for (int j = 0 ; j < n ; j++) forward(j);
+            for (int j = n-1 ; j >= 0 ; j--) backward(j);
         }
     }
 
@@ -228,16 +609,190 @@ protected :
         CSPARSE_symbolic(n,M_colptr,M_rowind,colptr,perm,invperm,Parent,Flag.data(),Lnz.data());
     }
 
+    void LDL_pattern(int n,int * M_colptr,int * M_rowind,int * colptr,int * rowind,int * perm,int * invperm,int * Parent) {
+        CSPARSE_pattern(n,M_colptr,M_rowind,colptr,rowind,perm,invperm,Parent,Flag.data(),Lnz.data());
+    }
+
+    /// Left-looking supernodal numeric factorization: each supernode is assembled in a dense block, updated by the
+    /// supernodes of its subtree in the etree with dense matrix products, and factorized with dense operations.
+    /// The result is stored in the same sparse format as the up-looking factorization.
+    template<class VecInt,class VecReal>
+    void LDL_numeric_supernodal(int n,int * M_colptr,int * M_rowind,Real * M_values,SparseLDLImplInvertData<VecInt,VecReal> * data) {
+        using DenseMap = Eigen::Map<Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic> >;
+
+        const int * colptr = data->L_colptr.data();
+        const int * rowind = data->L_rowind.data();
+        Real * values = data->L_values.data();
+        Real * D = data->invD.data();
+        const int * perm = data->perm.data();
+        const int * invperm = data->invperm.data();
+        const int * superPtr = data->superPtr.data();
+        const int * superOf = data->superOf.data();
+        const std::size_t * superValuesPtr = data->superValuesPtr.data();
+        const int nbSupernodes = (int)data->superPtr.size() - 1;
+
+        superValues.clear();
+        superValues.resize(superValuesPtr[nbSupernodes]);
+        relativeRow.resize(n);
+        superHead.assign(nbSupernodes, -1);
+        superLink.resize(nbSupernodes);
+        superNext.resize(nbSupernodes);
+
+        for (int s = 0 ; s < nbSupernodes ; s++)
+        {
+            const int first = superPtr[s];
+            const int last = superPtr[s+1];
+            const int nbCols = last - first;
+            const int nbRows = 1 + colptr[first+1] - colptr[first];
+            // the global row of the local row r > 0 is rows[r - 1]
+            const int * rows = rowind + colptr[first];
+            DenseMap B(superValues.data() + superValuesPtr[s], nbRows, nbCols);
+
+            relativeRow[first] = 0;
+            for (int r = 1 ; r < nbRows ; r++) relativeRow[rows[r - 1]] = r;
+
+            // scatter the lower part of the columns of A
+            for (int j = first ; j < last ; j++)
+            {
+                const int kk = perm[j];
+                for (int p = M_colptr[kk] ; p < M_colptr[kk+1] ; p++)
+                {
+                    const int i = invperm[M_rowind[p]];
+                    if (i >= j) B(relativeRow[i], j - first) += M_values[p];
+                }
+            }
+
+            // updates from the supernodes having rows in the columns of s
+            for (int d = superHead[s] ; d != -1 ; )
+            {
+                const int nextD = superLink[d];
+                const int firstD = superPtr[d];
+                const int nbColsD = superPtr[d+1] - firstD;
+                const int nbRowsD = 1 + colptr[firstD+1] - colptr[firstD];
+                const int * rowsD = rowind + colptr[firstD];
+                const DenseMap Ld(superValues.data() + superValuesPtr[d], nbRowsD, nbColsD);
+
+                // rows [begin, end) of d are in the columns of s, rows [begin, nbRowsD) in the pattern of s
+                const int begin = superNext[d];
+                int end = begin;
+                while (end < nbRowsD && rowsD[end - 1] < last) ++end;
+
+                // the workspaces are only reallocated when they grow
+                updateW.resize(std::max<std::size_t>(updateW.size(), (std::size_t)(end - begin) * nbColsD));
+                update.resize(std::max<std::size_t>(update.size(), (std::size_t)(nbRowsD - begin) * (end - begin)));
+                DenseMap W(updateW.data(), end - begin, nbColsD);
+                DenseMap U(update.data(), nbRowsD - begin, end - begin);
+                W.noalias() = Ld.block(begin, 0, end - begin, nbColsD) * Ld.diagonal().asDiagonal();
+                U.noalias() = Ld.block(begin, 0, nbRowsD - begin, nbColsD) * W.transpose();
+
+                for (int c = 0 ; c < end - begin ; c++)
+                {
+                    const int col = rowsD[begin + c - 1] - first;
+                    for (int r = c ; r < nbRowsD - begin ; r++)
+                    {
+                        B(relativeRow[rowsD[begin + r - 1]], col) -= U(r, c);
+                    }
+                }
+
+                // d will update the supernode of its next row
+                if (end < nbRowsD)
+                {
+                    superNext[d] = end;
+                    const int target = superOf[rowsD[end - 1]];
+                    superLink[d] = superHead[target];
+                    superHead[target] = d;
+                }
+                d = nextD;
+            }
+
+            // dense factorization of the diagonal block
+            for (int j = 0 ; j < nbCols ; j++)
+            {
+                const Real dj = B(j, j);
+                if (dj == 0.0)
+                {
+                    msg_error("SparseLDLSolver") << "Failed to factorize, D(k,k) is zero" ;
+                    return;
+                }
+                for (int i = j + 1 ; i < nbCols ; i++) B(i, j) /= dj;
+                for (int k = j + 1 ; k < nbCols ; k++)
+                {
+                    const Real lkj = B(k, j) * dj;
+                    for (int i = k ; i < nbCols ; i++) B(i, k) -= B(i, j) * lkj;
+                }
+            }
+
+            // block below the diagonal: L21 = A21 * L11^-T * D^-1
+            if (nbRows > nbCols)
+            {
+                auto B21 = B.bottomRows(nbRows - nbCols);
+                B.topRows(nbCols).template triangularView<Eigen::UnitLower>().transpose().template solveInPlace<Eigen::OnTheRight>(B21);
+                B21 = B21 * B.diagonal().cwiseInverse().asDiagonal();
+
+                superNext[s] = nbCols;
+                const int target = superOf[rows[nbCols - 1]];
+                superLink[s] = superHead[target];
+                superHead[target] = s;
+            }
+
+            // store in the column format of L
+            for (int c = 0 ; c < nbCols ; c++)
+            {
+                const int j = first + c;
+                D[j] = B(c, c);
+                Real * column = values + colptr[j];
+                for (int r = c + 1 ; r < nbRows ; r++) column[r - c - 1] = B(r, c);
+            }
+        }
+    }
+
     void LDL_numeric(int n,int * M_colptr,int * M_rowind,Real * M_values,int * colptr,int * rowind,Real * values,Real * D,int * perm,int * invperm,int * Parent) {
         Y.resize(n);
 
         CSPARSE_numeric<Real>(n,M_colptr,M_rowind,M_values,colptr,rowind,values,D,perm,invperm,Parent,Flag.data(),Lnz.data(),Pattern.data(),Y.data());
     }
 
+    /// Up-looking numeric factorization, where the rows of the independent subtrees of the etree are computed in
+    /// parallel, and then the rows of the top nodes. The subtrees access disjoint parts of the workspaces.
+    template<class VecInt,class VecReal>
+    void LDL_numeric_parallel(simulation::TaskScheduler& taskScheduler,int n,int * M_colptr,int * M_rowind,Real * M_values,int * colptr,int * rowind,Real * values,Real * D,SparseLDLImplInvertData<VecInt,VecReal> * data) {
+        Y.resize(n);
+
+        int * perm = data->perm.data();
+        int * invperm = data->invperm.data();
+        int * Parent = data->Parent.data();
+        const int * subtreePtr = data->subtreePtr.data();
+        const int * subtreeNodes = data->subtreeNodes.data();
+        const int * topNodes = data->topNodes.data();
+        const std::size_t nbSubtrees = data->subtreePtr.size() - 1;
+
+        std::atomic<bool> success { true };
+        simulation::parallelForEach(taskScheduler, static_cast<std::size_t>(0), nbSubtrees, [&](std::size_t t)
+        {
+            const int begin = subtreePtr[t];
+            const int size = subtreePtr[t+1] - begin;
+            const int * nodes = subtreeNodes + begin;
+            // the pattern of a row has less nonzeros than the subtree has nodes
+            if (!CSPARSE_numeric_rows<Real>([nodes](int r) { return nodes[r]; }, size, size, M_colptr, M_rowind, M_values, colptr, rowind, values, D,
+                                            perm, invperm, Parent, Flag.data(), Lnz.data(), Pattern.data() + begin, Y.data()))
+            {
+                success = false;
+            }
+        }, simulation::Partitioner{simulation::Partitioner::Type::AUTO, 1});
+
+        if (success)
+        {
+            CSPARSE_numeric_rows<Real>([topNodes](int r) { return topNodes[r]; }, (int)data->topNodes.size(), n, M_colptr, M_rowind, M_values, colptr, rowind, values, D,
+                                       perm, invperm, Parent, Flag.data(), Lnz.data(), Pattern.data(), Y.data());
+        }
+    }
+
     template<class VecInt,class VecReal>
     void factorize(int n,int * M_colptr, int * M_rowind, Real * M_values, SparseLDLImplInvertData<VecInt,VecReal> * data) {
         data->new_factorization_needed = data->P_colptr.size() == 0 || data->P_rowind.size() == 0 || compareMatrixShape(n, M_colptr, M_rowind, data->n,
                                                                                                                                          (int *) data->P_colptr.data(),(int *) data->P_rowind.data());
+        // the pattern of the factor depends on the factorization method
+        data->new_factorization_needed |= isFactorizationSupernodal() == data->superPtr.empty();
 
         data->n = n;
         data->P_nnz = M_colptr[data->n];
@@ -278,30 +833,74 @@ protected :
             data->L_values.clear();data->L_values.fastResize(data->L_nnz);
             data->LT_rowind.clear();data->LT_rowind.fastResize(data->L_nnz);
             data->LT_values.clear();data->LT_values.fastResize(data->L_nnz);
+
+            data->superPtr.clear();
+            if (isFactorizationSupernodal())
+            {
+                LDL_pattern(data->n,M_colptr,M_rowind,data->L_colptr.data(),data->L_rowind.data(),
+                            data->perm.data(),data->invperm.data(),data->Parent.data());
+                LDL_supernodes(data->n,data->L_colptr,data->L_rowind,data->Parent.data(),data->superPtr,data->superOf,data->superValuesPtr);
+                msg_info() << data->superPtr.size() - 1 << " supernodes for " << data->n << " columns, "
+                           << data->L_colptr[data->n] - data->L_nnz << " explicit zeros added to the factor";
+
+                data->L_nnz = data->L_colptr[data->n];
+                d_L_nnz.setValue(data->L_nnz);
+                data->L_values.clear();data->L_values.fastResize(data->L_nnz);
+                data->LT_rowind.clear();data->LT_rowind.fastResize(data->L_nnz);
+                data->LT_values.clear();data->LT_values.fastResize(data->L_nnz);
+            }
         }
 
+        if (m_taskScheduler && (data->subtreePtr.empty() || data->new_factorization_needed || !d_precomputeSymbolicDecomposition.getValue()))
+        {
+            LDL_etreePartition(data->n,data->L_colptr.data(),data->Parent.data(),(int)m_taskScheduler->getThreadCount(),
+                               data->subtreePtr,data->subtreeNodes,data->topNodes);
+        }
+
+        numericFactorization(M_colptr,M_rowind,M_values,data);
+    }
+
+    /// Numeric factorization of the matrix stored in data, whose values P_values have been updated in place: the
+    /// symbolic factorization, the pattern of the factor and the buffers are reused, nothing is allocated.
+    template<class VecInt,class VecReal>
+    void refactorize(SparseLDLImplInvertData<VecInt,VecReal> * data) {
+        data->new_factorization_needed = false;
+        numericFactorization(data->P_colptr.data(),data->P_rowind.data(),data->P_values.data(),data);
+    }
+
+    template<class VecInt,class VecReal>
+    void numericFactorization(int * M_colptr, int * M_rowind, Real * M_values, SparseLDLImplInvertData<VecInt,VecReal> * data) {
         Real * D = data->invD.data();
         int * rowind = data->L_rowind.data();
         int * colptr = data->L_colptr.data();
         Real * values = data->L_values.data();
         int * tran_rowind = data->LT_rowind.data();
         int * tran_colptr = data->LT_colptr.data();
-        Real * tran_values = data->LT_values.data();
 
         //Numeric Factorization
         {
             sofa::helper::ScopedAdvancedTimer factorizationTimer("numeric_factorization");
-            LDL_numeric(data->n,M_colptr,M_rowind,M_values,colptr,rowind,values,D,
-                        data->perm.data(),data->invperm.data(),data->Parent.data());
+            simulation::TaskScheduler* taskScheduler = getFactorizationTaskScheduler();
+            if (isFactorizationSupernodal())
+            {
+                LDL_numeric_supernodal(data->n,M_colptr,M_rowind,M_values,data);
+            }
+            else if (taskScheduler && data->subtreePtr.size() > 2)
+            {
+                LDL_numeric_parallel(*taskScheduler,data->n,M_colptr,M_rowind,M_values,colptr,rowind,values,D,data);
+            }
+            else
+            {
+                LDL_numeric(data->n,M_colptr,M_rowind,M_values,colptr,rowind,values,D,
+                            data->perm.data(),data->invperm.data(),data->Parent.data());
+            }
 
             //inverse the diagonal
             for (int i=0;i<data->n;i++) D[i] = 1.0/D[i];
         }
 
-        // split the bloc diag in data->Bdiag
-
-        if (data->new_factorization_needed  || !d_precomputeSymbolicDecomposition.getValue() ) {
-            //Compute transpose in tran_colptr, tran_rowind, tran_values, tran_D
+        if (data->new_factorization_needed || !d_precomputeSymbolicDecomposition.getValue() || data->LT_map.size() != (std::size_t)data->L_nnz) {
+            //Compute the pattern of the transpose in tran_colptr, tran_rowind
             tran_countvec.clear();
             tran_countvec.resize(data->n);
 
@@ -311,20 +910,146 @@ protected :
             //Now we make a scan to build tran_colptr
             tran_colptr[0] = 0;
             for (int j=0;j<data->n;j++) tran_colptr[j+1] = tran_colptr[j] + tran_countvec[j];
+
+            //we clear tran_countvec because we use it now to store how many values are written on each line
+            tran_countvec.clear();
+            tran_countvec.resize(data->n);
+
+            data->LT_map.clear();data->LT_map.fastResize(data->L_nnz);
+            for (int j=0;j<data->n;j++) {
+              for (int i=colptr[j];i<colptr[j+1];i++) {
+                int line = rowind[i];
+                tran_rowind[tran_colptr[line] + tran_countvec[line]] = j;
+                data->LT_map[tran_colptr[line] + tran_countvec[line]] = i;
+                tran_countvec[line]++;
+              }
+            }
+        }
+
+        //the pattern of the factor only depends on the symbolic factorization: the values are gathered from L
+        updateTransposedValues(data);
+        data->updateRank = 0;
+    }
+
+    template<class VecInt,class VecReal>
+    void updateTransposedValues(SparseLDLImplInvertData<VecInt,VecReal> * data) {
+        Real * tran_values = data->LT_values.data();
+        const Real * values = data->L_values.data();
+        const int * LT_map = data->LT_map.data();
+        for (int i=0;i<data->L_nnz;i++) tran_values[i] = values[LT_map[i]];
+    }
+
+    /// Modify the factorization stored in data with rank-one updates and downdates, after its values P_values have been
+    /// updated in place: changedSlots are the positions in P_values of the modified values, and previousValues their
+    /// values in the factorized matrix.
+    /// The lower triangle of the permuted difference is split in columns: the column j, with half of its diagonal entry,
+    /// is a vector c giving e_j c^T + c e_j^T = (u u^T - v v^T) / 2, where u and v are zero outside of the pattern of the
+    /// column j of L, so that the pattern of L does not change.
+    /// Returns false if the factorization must be computed again: the accumulated rank of the modifications would exceed
+    /// d_maxUpdateRank, or a pivot vanishes.
+    template<class VecInt,class VecReal>
+    bool updownFactorization(SparseLDLImplInvertData<VecInt,VecReal> * data, const type::vector<int>& changedSlots, const type::vector<Real>& previousValues) {
+        const unsigned int maxRank = d_maxUpdateRank.getValue();
+        if (maxRank == 0 || !isSymbolicFactorizationReusable(data))
+        {
+            return false;
         }
 
-        //we clear tran_countvec because we use it now to store how many values are written on each line
-        tran_countvec.clear();
-        tran_countvec.resize(data->n);
+        sofa::helper::ScopedAdvancedTimer updownTimer("updown_factorization");
+        const int n = data->n;
+        const int * P_colptr = data->P_colptr.data();
+        const int * P_rowind = data->P_rowind.data();
+        const Real * P_values = data->P_values.data();
+        const int * invperm = data->invperm.data();
 
-        for (int j=0;j<data->n;j++) {
-          for (int i=colptr[j];i<colptr[j+1];i++) {
-            int line = rowind[i];
-            tran_rowind[tran_colptr[line] + tran_countvec[line]] = j;
-            tran_values[tran_colptr[line] + tran_countvec[line]] = values[i];
-            tran_countvec[line]++;
-          }
+        // the numeric factorization uses the entries (i,j) of the permuted matrix such that j <= i
+        updownEntries.clear();
+        for (std::size_t k = 0; k < changedSlots.size(); ++k)
+        {
+            const int p = changedSlots[k];
+            const int row = static_cast<int>(std::upper_bound(P_colptr, P_colptr + n + 1, p) - P_colptr) - 1;
+            const int i = invperm[row];
+            const int j = invperm[P_rowind[p]];
+            if (j <= i)
+            {
+                updownEntries.push_back({j, i, P_values[p] - previousValues[k]});
+            }
+        }
+        std::sort(updownEntries.begin(), updownEntries.end(), [](const UpdownEntry& a, const UpdownEntry& b)
+        {
+            return a.col < b.col || (a.col == b.col && a.row < b.row);
+        });
+
+        const auto isDiagonalOnly = [this](std::size_t begin, std::size_t end)
+        {
+            return end - begin == 1 && updownEntries[begin].row == updownEntries[begin].col;
+        };
+        const auto nextColumn = [this](std::size_t begin)
+        {
+            std::size_t end = begin;
+            while (end < updownEntries.size() && updownEntries[end].col == updownEntries[begin].col) ++end;
+            return end;
+        };
+
+        unsigned int rank = 0;
+        for (std::size_t begin = 0, end; begin < updownEntries.size(); begin = end)
+        {
+            end = nextColumn(begin);
+            rank += isDiagonalOnly(begin, end) ? 1 : 2;
+        }
+        if (data->updateRank + rank > maxRank)
+        {
+            return false;
+        }
+
+        updownW.resize(n);
+        Real * w = updownW.data();
+        const int * colptr = data->L_colptr.data();
+        const int * rowind = data->L_rowind.data();
+        Real * values = data->L_values.data();
+        Real * invD = data->invD.data();
+        const int * Parent = data->Parent.data();
+
+        for (std::size_t begin = 0, end; begin < updownEntries.size(); begin = end)
+        {
+            end = nextColumn(begin);
+            const int j = updownEntries[begin].col;
+
+            if (isDiagonalOnly(begin, end))
+            {
+                const Real delta = updownEntries[begin].delta;
+                w[j] = std::sqrt(std::abs(delta));
+                if (!LDL_rank1(n, j, delta > 0 ? Real(1) : Real(-1), colptr, rowind, values, invD, Parent, w))
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            const auto c = [this, j](std::size_t k)
+            {
+                return updownEntries[k].row == j ? updownEntries[k].delta / 2 : updownEntries[k].delta;
+            };
+            Real norm = 0;
+            for (std::size_t k = begin; k < end; ++k) norm += c(k) * c(k);
+            // u and v have the same norm when the weight of e_j is the square root of the norm of c
+            const Real alpha = std::sqrt(std::sqrt(norm));
+            const Real scale = 1 / std::sqrt(Real(2));
+
+            for (const Real sigma : {Real(1), Real(-1)})
+            {
+                w[j] = alpha * scale;
+                for (std::size_t k = begin; k < end; ++k) w[updownEntries[k].row] += sigma * c(k) * scale / alpha;
+                if (!LDL_rank1(n, j, sigma, colptr, rowind, values, invD, Parent, w))
+                {
+                    return false;
+                }
+            }
         }
+
+        data->updateRank += rank;
+        updateTransposedValues(data);
+        return true;
     }
 
     type::vector<Real> Tmp;
@@ -333,6 +1058,14 @@ protected : //the following variables are used during the factorization they can
     type::vector<Real> Y;
     type::vector<int> Lnz,Flag,Pattern;
     type::vector<int> tran_countvec;
+
+    type::vector<Real> superValues; ///< dense storage of the supernodes
+    type::vector<Real> update, updateW; ///< dense update of a supernode by a descendant
+    type::vector<int> relativeRow, superHead, superLink, superNext;
+
+    struct UpdownEntry { int col, row; Real delta; };
+    type::vector<UpdownEntry> updownEntries; ///< lower triangle of the permuted difference between the new and the factorized matrices
+    type::vector<Real> updownW; ///< vector of the rank-one modification
 };
 
 } // namespace sofa::component::linearsolver::direct
@@ -0,0 +1,182 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/testing/BaseTest.h>
+#include <sofa/component/linearsolver/direct/BTDLinearSolver.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <random>
+
+namespace
+{
+
+using MatrixType = sofa::linearalgebra::BTDMatrix<6, SReal>;
+using VectorType = sofa::linearalgebra::BlockVector<6, SReal>;
+using Solver = sofa::component::linearsolver::direct::BTDLinearSolver<MatrixType, VectorType>;
+
+/// Fill a symmetric, diagonally dominant block tridiagonal matrix with random values, multiplied by scale
+void fillMatrix(MatrixType& matrix, sofa::Index nbBlocks, SReal scale = 1)
+{
+    constexpr sofa::Index bsize = 6;
+    matrix.resize(nbBlocks * bsize, nbBlocks * bsize);
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<SReal> distribution(-1, 1);
+
+    for (sofa::Index b = 0; b < nbBlocks; ++b)
+    {
+        for (sofa::Index i = 0; i < bsize; ++i)
+        {
+            for (sofa::Index j = i; j < bsize; ++j)
+            {
+                const SReal v = scale * ((i == j) ? 4 * bsize : distribution(generator));
+                matrix.add(b * bsize + i, b * bsize + j, v);
+                if (i != j)
+                {
+                    matrix.add(b * bsize + j, b * bsize + i, v);
+                }
+            }
+        }
+
+        if (b + 1 < nbBlocks)
+        {
+            for (sofa::Index i = 0; i < bsize; ++i)
+            {
+                for (sofa::Index j = 0; j < bsize; ++j)
+                {
+                    const SReal v = scale * distribution(generator);
+                    matrix.add(b * bsize + i, (b + 1) * bsize + j, v);
+                    matrix.add((b + 1) * bsize + j, b * bsize + i, v);
+                }
+            }
+        }
+    }
+}
+
+/// Max norm of b - M * x, only the tridiagonal band of blocks being non-zero
+SReal residual(const MatrixType& matrix, const VectorType& x, const VectorType& b)
+{
+    using Index = MatrixType::Index;
+    constexpr Index bsize = 6;
+    const Index n = matrix.rowSize();
+    SReal maxError = 0;
+    for (Index i = 0; i < n; ++i)
+    {
+        const Index bi = i / bsize;
+        const Index jBegin = (bi > 0) ? (bi - 1) * bsize : 0;
+        const Index jEnd = std::min<Index>(n, (bi + 2) * bsize);
+        SReal r = b.element(i);
+        for (Index j = jBegin; j < jEnd; ++j)
+        {
+            r -= matrix.element(i, j) * x.element(j);
+        }
+        maxError = std::max(maxError, std::abs(r));
+    }
+    return maxError;
+}
+
+void solveSystem(Solver::SPtr solver, MatrixType& matrix, VectorType& x, VectorType& b)
+{
+    solver->init();
+    solver->invert(matrix);
+    x.resize(matrix.rowSize());
+    solver->solve(matrix, x, b);
+}
+
+}
+
+TEST(BTDLinearSolver, partitionedSolveMatchesSequential)
+{
+    constexpr sofa::Index nbBlocks = 41;
+
+    MatrixType matrix;
+    fillMatrix(matrix, nbBlocks);
+
+    VectorType b;
+    b.resize(matrix.rowSize());
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<SReal> distribution(-1, 1);
+    for (VectorType::Index i = 0; i < b.size(); ++i)
+    {
+        b.set(i, distribution(generator));
+    }
+
+    VectorType xSequential;
+    Solver::SPtr sequential = sofa::core::objectmodel::New<Solver>();
+    solveSystem(sequential, matrix, xSequential, b);
+    EXPECT_LT(residual(matrix, xSequential, b), 1e-10);
+
+    for (const unsigned int nbPartitions : {2u, 3u, 4u, 7u})
+    {
+        sofa::simulation::MainTaskSchedulerFactory::createInRegistry()->init(2);
+
+        VectorType xPartitioned;
+        Solver::SPtr partitioned = sofa::core::objectmodel::New<Solver>();
+        partitioned->d_multithreading.setValue(true);
+        partitioned->d_nbPartitions.setValue(nbPartitions);
+        solveSystem(partitioned, matrix, xPartitioned, b);
+
+        EXPECT_LT(residual(matrix, xPartitioned, b), 1e-10) << "nbPartitions = " << nbPartitions;
+        for (VectorType::Index i = 0; i < b.size(); ++i)
+        {
+            EXPECT_NEAR(xPartitioned.element(i), xSequential.element(i), 1e-10) << "nbPartitions = " << nbPartitions;
+        }
+    }
+}
+
+/// The fixture installs the message handler checking the warnings
+class BTDLinearSolver_test : public sofa::testing::BaseTest
+{
+};
+
+TEST_F(BTDLinearSolver_test, complianceFromPartitionedFactorization)
+{
+    constexpr sofa::Index nbBlocks = 21;
+
+    sofa::simulation::MainTaskSchedulerFactory::createInRegistry()->init(2);
+    Solver::SPtr partitioned = sofa::core::objectmodel::New<Solver>();
+    partitioned->d_multithreading.setValue(true);
+    partitioned->d_nbPartitions.setValue(3);
+    partitioned->init();
+
+    // the second factorization, of another matrix, must not reuse the columns of the inverse of the first one
+    for (const SReal scale : {1., 2.})
+    {
+        MatrixType scaled;
+        fillMatrix(scaled, nbBlocks, scale);
+
+        Solver::SPtr sequential = sofa::core::objectmodel::New<Solver>();
+        sequential->init();
+        sequential->invert(scaled);
+
+        // the entries of the inverse are computed from the partitioned factorization
+        EXPECT_MSG_NOEMIT(Warning);
+        partitioned->invert(scaled);
+        const Solver::Index n = scaled.rowSize();
+        for (Solver::Index i = 0; i < n; i += 7)
+        {
+            for (Solver::Index j = 0; j <= i; j += 5)
+            {
+                EXPECT_NEAR(partitioned->getMinvElement(i, j), sequential->getMinvElement(i, j), 1e-10);
+                EXPECT_NEAR(partitioned->getMinvElement(j, i), sequential->getMinvElement(i, j), 1e-10);
+            }
+        }
+    }
+}
@@ -0,0 +1,145 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/component/linearsolver/direct/SparseLDLSolver.h>
+#include <sofa/helper/logging/Messaging.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <sstream>
+
+namespace sofa
+{
+
+/**
+ * Micro-benchmark of the numeric factorization of SparseLDLSolver, comparing the up-looking and the
+ * supernodal methods on the matrix of a regular grid of 3D nodes, where each node interacts with its
+ * 26 neighbors. The symbolic factorization is computed once, and reused for the measured factorizations.
+ *
+ * The matrix is kept small so that the benchmark can run along with the other tests.
+ * Increase gridSize to get more representative figures.
+ */
+namespace
+{
+
+using Matrix = linearalgebra::CompressedRowSparseMatrix<SReal>;
+using Vector = linearalgebra::FullVector<SReal>;
+using Solver = component::linearsolver::direct::SparseLDLSolver<Matrix, Vector>;
+
+void generateGridMatrix(Matrix& matrix, const sofa::Index gridSize)
+{
+    const auto index = [gridSize](sofa::Index i, sofa::Index j, sofa::Index k)
+    {
+        return (k * gridSize + j) * gridSize + i;
+    };
+
+    const sofa::Index nbNodes = gridSize * gridSize * gridSize;
+    matrix.resize(3 * nbNodes, 3 * nbNodes);
+
+    for (sofa::Index k = 0; k < gridSize; ++k)
+    for (sofa::Index j = 0; j < gridSize; ++j)
+    for (sofa::Index i = 0; i < gridSize; ++i)
+    {
+        const auto node = index(i, j, k);
+        for (sofa::Index dk = (k > 0 ? k - 1 : k); dk <= std::min(k + 1, gridSize - 1); ++dk)
+        for (sofa::Index dj = (j > 0 ? j - 1 : j); dj <= std::min(j + 1, gridSize - 1); ++dj)
+        for (sofa::Index di = (i > 0 ? i - 1 : i); di <= std::min(i + 1, gridSize - 1); ++di)
+        {
+            const auto neighbor = index(di, dj, dk);
+            for (sofa::Index a = 0; a < 3; ++a)
+            for (sofa::Index b = 0; b < 3; ++b)
+            {
+                matrix.add(3 * node + a, 3 * neighbor + b, neighbor == node ? (a == b ? 100 : 1) : -1);
+            }
+        }
+    }
+    matrix.compress();
+}
+
+template<class Function>
+double bestTimeOf(const int nbRepetitions, const Function& function)
+{
+    double bestTime = std::numeric_limits<double>::max();
+    for (int r = 0; r < nbRepetitions; ++r)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const auto end = std::chrono::steady_clock::now();
+        bestTime = std::min(bestTime, std::chrono::duration<double>(end - start).count());
+    }
+    return bestTime;
+}
+
+}
+
+TEST(SparseLDLSolverBenchmark, factorization)
+{
+    constexpr sofa::Index gridSize = 10;
+    constexpr int nbRepetitions = 3;
+
+    Matrix matrix;
+    generateGridMatrix(matrix, gridSize);
+
+    Vector b(matrix.rowSize());
+    for (Vector::Index i = 0; i < b.size(); ++i)
+    {
+        b[i] = static_cast<SReal>(i % 7) - 3;
+    }
+
+    std::stringstream report;
+    report << matrix.rowSize() << " rows, " << matrix.getColsValue().size() << " non-zeros" << msgendl;
+    report << "method | factorization (ms) | speedup" << msgendl;
+
+    Vector reference(b.size());
+    double referenceTime = 0;
+    for (const char* method : {"UpLooking", "Supernodal"})
+    {
+        Solver::SPtr solver = core::objectmodel::New<Solver>();
+        ASSERT_TRUE(solver->findData("factorizationMethod")->read(method));
+        solver->init();
+        solver->invert(matrix); // symbolic factorization
+
+        const double time = bestTimeOf(nbRepetitions, [&]() { solver->invert(matrix); });
+
+        Vector x(b.size());
+        solver->solve(matrix, x, b);
+        if (referenceTime == 0)
+        {
+            referenceTime = time;
+            reference = x;
+        }
+        else
+        {
+            for (Vector::Index i = 0; i < x.size(); ++i)
+            {
+                ASSERT_NEAR(x[i], reference[i], 1e-8);
+            }
+        }
+
+        report << method << " | " << 1000 * time << " | " << referenceTime / time << msgendl;
+    }
+
+    msg_info("SparseLDLSolverBenchmark") << report.str();
+}
+
+} // namespace sofa
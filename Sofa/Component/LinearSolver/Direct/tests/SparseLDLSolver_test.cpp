@@ -25,6 +25,7 @@
 #include <sofa/simulation/Node.h>
 #include <sofa/simulation/graph/DAGSimulation.h>
 #include <sofa/simulation/graph/SimpleApi.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
 
 #include <sofa/testing/NumericTest.h>
 
@@ -272,3 +273,427 @@ TEST(SparseLDLSolver, TopologyChangeEmptyMState)
     sofa::simulation::getSimulation()->unload(root);
 }
 
+
+namespace
+{
+/// Symmetric positive definite matrix with the pattern of a regular grid of 3D nodes, each node interacting with its
+/// 26 neighbors
+void generateGridMatrix(sofa::linearalgebra::CompressedRowSparseMatrix<SReal>& matrix, const sofa::Index gridSize)
+{
+    const auto index = [gridSize](sofa::Index i, sofa::Index j, sofa::Index k)
+    {
+        return (k * gridSize + j) * gridSize + i;
+    };
+
+    const sofa::Index nbNodes = gridSize * gridSize * gridSize;
+    matrix.resize(3 * nbNodes, 3 * nbNodes);
+
+    for (sofa::Index k = 0; k < gridSize; ++k)
+    for (sofa::Index j = 0; j < gridSize; ++j)
+    for (sofa::Index i = 0; i < gridSize; ++i)
+    {
+        const auto node = index(i, j, k);
+        for (sofa::Index dk = (k > 0 ? k - 1 : k); dk <= std::min(k + 1, gridSize - 1); ++dk)
+        for (sofa::Index dj = (j > 0 ? j - 1 : j); dj <= std::min(j + 1, gridSize - 1); ++dj)
+        for (sofa::Index di = (i > 0 ? i - 1 : i); di <= std::min(i + 1, gridSize - 1); ++di)
+        {
+            const auto neighbor = index(di, dj, dk);
+            for (sofa::Index a = 0; a < 3; ++a)
+            for (sofa::Index b = 0; b < 3; ++b)
+            {
+                if (neighbor == node)
+                {
+                    matrix.add(3 * node + a, 3 * node + b, a == b ? 100 : 1);
+                }
+                else
+                {
+                    matrix.add(3 * node + a, 3 * neighbor + b, -1 - static_cast<SReal>((a + b) % 3) / 4);
+                }
+            }
+        }
+    }
+    matrix.compress();
+}
+}
+
+TEST(SparseLDLSolver, SupernodalFactorization)
+{
+    using MatrixType = sofa::linearalgebra::CompressedRowSparseMatrix<SReal>;
+    using VectorType = sofa::linearalgebra::FullVector<SReal>;
+    using Solver = sofa::component::linearsolver::direct::SparseLDLSolver<MatrixType, VectorType>;
+
+    MatrixType matrix;
+    generateGridMatrix(matrix, 5);
+
+    Solver::SPtr upLooking = sofa::core::objectmodel::New<Solver>();
+    upLooking->init();
+    upLooking->invert(matrix);
+
+    Solver::SPtr supernodal = sofa::core::objectmodel::New<Solver>();
+    ASSERT_TRUE(supernodal->findData("factorizationMethod")->read("Supernodal"));
+    supernodal->init();
+
+    VectorType b(matrix.rowSize());
+    for (sofa::Index i = 0; i < b.size(); ++i)
+    {
+        b[i] = static_cast<SReal>(i % 7) - 3;
+    }
+
+    // the second factorization reuses the symbolic factorization
+    for (unsigned int step = 0; step < 2; ++step)
+    {
+        supernodal->invert(matrix);
+
+        auto* expected = dynamic_cast<Solver::InvertData*>(upLooking->getMatrixInvertData(&matrix));
+        auto* actual = dynamic_cast<Solver::InvertData*>(supernodal->getMatrixInvertData(&matrix));
+        ASSERT_NE(expected, nullptr);
+        ASSERT_NE(actual, nullptr);
+
+        EXPECT_GT(actual->superPtr.size(), 1u);
+        EXPECT_LT(actual->superPtr.size(), static_cast<std::size_t>(actual->n) + 1);
+        EXPECT_EQ(actual->perm, expected->perm);
+        ASSERT_GE(actual->L_nnz, expected->L_nnz);
+
+        // the pattern of the supernodal factor contains the pattern of the exact factor, the other entries being zeros
+        for (int j = 0; j < actual->n; ++j)
+        {
+            int q = expected->L_colptr[j];
+            for (int p = actual->L_colptr[j]; p < actual->L_colptr[j + 1]; ++p)
+            {
+                if (q < expected->L_colptr[j + 1] && expected->L_rowind[q] == actual->L_rowind[p])
+                {
+                    EXPECT_NEAR(actual->L_values[p], expected->L_values[q], 1e-12);
+                    ++q;
+                }
+                else
+                {
+                    EXPECT_NEAR(actual->L_values[p], 0, 1e-12);
+                }
+            }
+            EXPECT_EQ(q, expected->L_colptr[j + 1]);
+        }
+        for (int i = 0; i < actual->n; ++i)
+        {
+            EXPECT_NEAR(actual->invD[i], expected->invD[i], 1e-12);
+        }
+
+        VectorType xExpected(b.size()), xActual(b.size());
+        upLooking->solve(matrix, xExpected, b);
+        supernodal->solve(matrix, xActual, b);
+        for (sofa::Index i = 0; i < b.size(); ++i)
+        {
+            EXPECT_NEAR(xActual[i], xExpected[i], 1e-10);
+        }
+    }
+}
+
+TEST(SparseLDLSolver, SupernodalMemoryFootprint)
+{
+    using MatrixType = sofa::linearalgebra::CompressedRowSparseMatrix<SReal>;
+    using VectorType = sofa::linearalgebra::FullVector<SReal>;
+    using Solver = sofa::component::linearsolver::direct::SparseLDLSolver<MatrixType, VectorType>;
+
+    MatrixType matrix;
+    generateGridMatrix(matrix, 5);
+
+    Solver::SPtr upLooking = sofa::core::objectmodel::New<Solver>();
+    upLooking->init();
+    upLooking->invert(matrix);
+
+    Solver::SPtr supernodal = sofa::core::objectmodel::New<Solver>();
+    ASSERT_TRUE(supernodal->findData("factorizationMethod")->read("Supernodal"));
+    supernodal->init();
+    supernodal->invert(matrix);
+
+    auto* upLookingData = dynamic_cast<Solver::InvertData*>(upLooking->getMatrixInvertData(&matrix));
+    auto* supernodalData = dynamic_cast<Solver::InvertData*>(supernodal->getMatrixInvertData(&matrix));
+    ASSERT_NE(upLookingData, nullptr);
+    ASSERT_NE(supernodalData, nullptr);
+    ASSERT_FALSE(supernodalData->superValuesPtr.empty());
+
+    // the supernodal factorization keeps the dense storage of the supernodes in addition to the factor
+    const std::size_t superValuesSize = supernodalData->superValuesPtr.back() * sizeof(SReal);
+    const std::size_t extraFactorSize = static_cast<std::size_t>(supernodalData->L_nnz - upLookingData->L_nnz) * 2 * sizeof(SReal);
+    EXPECT_GE(supernodal->getMemoryFootprint(), upLooking->getMemoryFootprint() + superValuesSize + extraFactorSize);
+}
+
+TEST(SparseLDLSolver, ParallelFactorization)
+{
+    using MatrixType = sofa::linearalgebra::CompressedRowSparseMatrix<SReal>;
+    using VectorType = sofa::linearalgebra::FullVector<SReal>;
+    using Solver = sofa::component::linearsolver::direct::SparseLDLSolver<MatrixType, VectorType>;
+
+    sofa::simulation::MainTaskSchedulerFactory::createInRegistry()->init(2);
+
+    MatrixType matrix;
+    generateGridMatrix(matrix, 6);
+
+    Solver::SPtr sequential = sofa::core::objectmodel::New<Solver>();
+    sequential->init();
+    sequential->invert(matrix);
+
+    Solver::SPtr parallel = sofa::core::objectmodel::New<Solver>();
+    ASSERT_TRUE(parallel->findData("multithreading")->read("true"));
+    parallel->init();
+
+    VectorType b(matrix.rowSize());
+    for (sofa::Index i = 0; i < b.size(); ++i)
+    {
+        b[i] = static_cast<SReal>(i % 5) - 2;
+    }
+
+    // the second factorization reuses the symbolic factorization and the partition of the elimination tree
+    for (unsigned int step = 0; step < 2; ++step)
+    {
+        parallel->invert(matrix);
+
+        auto* expected = dynamic_cast<Solver::InvertData*>(sequential->getMatrixInvertData(&matrix));
+        auto* actual = dynamic_cast<Solver::InvertData*>(parallel->getMatrixInvertData(&matrix));
+        ASSERT_NE(expected, nullptr);
+        ASSERT_NE(actual, nullptr);
+
+        EXPECT_GT(actual->subtreePtr.size(), 2u);
+        EXPECT_EQ(actual->subtreeNodes.size() + actual->topNodes.size(), static_cast<std::size_t>(actual->n));
+        EXPECT_EQ(actual->L_colptr, expected->L_colptr);
+        EXPECT_EQ(actual->L_rowind, expected->L_rowind);
+        for (int p = 0; p < actual->L_nnz; ++p)
+        {
+            EXPECT_NEAR(actual->L_values[p], expected->L_values[p], 1e-12);
+        }
+        for (int i = 0; i < actual->n; ++i)
+        {
+            EXPECT_NEAR(actual->invD[i], expected->invD[i], 1e-12);
+        }
+
+        VectorType xExpected(b.size()), xActual(b.size());
+        sequential->solve(matrix, xExpected, b);
+        parallel->solve(matrix, xActual, b);
+        for (sofa::Index i = 0; i < b.size(); ++i)
+        {
+            EXPECT_NEAR(xActual[i], xExpected[i], 1e-10);
+        }
+    }
+}
+
+namespace
+{
+template<class Solver>
+class SparseLDLSolverTester : public Solver
+{
+public:
+    using Solver::Mfiltered;
+    using Solver::m_highPrecisionMatrix;
+};
+
+/// Compare the factorization of the solver with a factorization of the matrix computed from scratch
+template<class Solver>
+void checkFactorizationFromScratch(Solver* solver, typename Solver::Matrix& matrix, SReal tolerance)
+{
+    using InvertData = typename Solver::InvertData;
+    using VectorType = typename Solver::Vector;
+
+    typename Solver::SPtr reference = sofa::core::objectmodel::New<Solver>();
+    reference->init();
+    reference->invert(matrix);
+    auto* expected = dynamic_cast<InvertData*>(reference->getMatrixInvertData(&matrix));
+    auto* actual = dynamic_cast<InvertData*>(solver->getMatrixInvertData(&matrix));
+    ASSERT_NE(expected, nullptr);
+    ASSERT_NE(actual, nullptr);
+
+    EXPECT_EQ(actual->L_colptr, expected->L_colptr);
+    EXPECT_EQ(actual->L_rowind, expected->L_rowind);
+    EXPECT_EQ(actual->LT_rowind, expected->LT_rowind);
+    for (int p = 0; p < actual->L_nnz; ++p)
+    {
+        EXPECT_NEAR(actual->L_values[p], expected->L_values[p], tolerance);
+        EXPECT_NEAR(actual->LT_values[p], expected->LT_values[p], tolerance);
+    }
+    for (int i = 0; i < actual->n; ++i)
+    {
+        EXPECT_NEAR(actual->invD[i], expected->invD[i], tolerance);
+    }
+
+    VectorType b(matrix.rowSize());
+    for (sofa::Index i = 0; i < b.size(); ++i)
+    {
+        b[i] = static_cast<SReal>(i % 3) - 1;
+    }
+    VectorType xExpected(b.size()), xActual(b.size());
+    reference->solve(matrix, xExpected, b);
+    solver->solve(matrix, xActual, b);
+    for (sofa::Index i = 0; i < b.size(); ++i)
+    {
+        EXPECT_NEAR(xActual[i], xExpected[i], 100 * tolerance);
+    }
+}
+}
+
+TEST(SparseLDLSolver, InPlaceRefactorization)
+{
+    using MatrixType = sofa::linearalgebra::CompressedRowSparseMatrix<SReal>;
+    using VectorType = sofa::linearalgebra::FullVector<SReal>;
+    using Solver = sofa::component::linearsolver::direct::SparseLDLSolver<MatrixType, VectorType>;
+    using Tester = SparseLDLSolverTester<Solver>;
+
+    MatrixType matrix;
+    generateGridMatrix(matrix, 4);
+    const sofa::Index last = matrix.rowSize() - 1;
+
+    // explicit zeros, filtered out of the factorized matrix
+    matrix.add(0, last, 0);
+    matrix.add(last, 0, 0);
+    matrix.compress();
+
+    Solver::SPtr solver = sofa::core::objectmodel::New<Tester>();
+    const Tester* tester = static_cast<Tester*>(solver.get());
+    solver->init();
+    solver->invert(matrix);
+
+    auto* data = dynamic_cast<Solver::InvertData*>(solver->getMatrixInvertData(&matrix));
+    ASSERT_NE(data, nullptr);
+    ASSERT_FALSE(data->M_slots.empty());
+    const int P_nnz = data->P_nnz;
+
+    // same pattern, new values: the values are updated in place, without filtering the matrix again
+    for (sofa::Index i = 0; i < matrix.rowSize(); ++i)
+    {
+        matrix.add(i, i, 10 + static_cast<SReal>(i % 4));
+    }
+    matrix.add(0, 1, 0.5);
+    matrix.add(1, 0, 0.5);
+    solver->invert(matrix);
+
+    EXPECT_EQ(data->P_nnz, P_nnz);
+    EXPECT_DOUBLE_EQ(tester->Mfiltered.element(0, 0), 100);
+    checkFactorizationFromScratch(solver.get(), matrix, 1e-12);
+
+    // an entry filtered out is now non-zero: the matrix is filtered again
+    matrix.add(0, last, 0.5);
+    matrix.add(last, 0, 0.5);
+    solver->invert(matrix);
+
+    EXPECT_EQ(data->P_nnz, P_nnz + 2);
+    EXPECT_DOUBLE_EQ(tester->Mfiltered.element(0, 0), 110);
+    EXPECT_DOUBLE_EQ(tester->Mfiltered.element(0, last), 0.5);
+    checkFactorizationFromScratch(solver.get(), matrix, 1e-12);
+}
+
+TEST(SparseLDLSolver, LowRankUpdate)
+{
+    using MatrixType = sofa::linearalgebra::CompressedRowSparseMatrix<SReal>;
+    using VectorType = sofa::linearalgebra::FullVector<SReal>;
+    using Solver = sofa::component::linearsolver::direct::SparseLDLSolver<MatrixType, VectorType>;
+
+    MatrixType matrix;
+    generateGridMatrix(matrix, 4);
+
+    Solver::SPtr solver = sofa::core::objectmodel::New<Solver>();
+    ASSERT_TRUE(solver->findData("maxUpdateRank")->read("150"));
+    solver->init();
+    solver->invert(matrix);
+
+    auto* data = dynamic_cast<Solver::InvertData*>(solver->getMatrixInvertData(&matrix));
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(data->updateRank, 0u);
+
+    // unchanged matrix: nothing to update
+    solver->invert(matrix);
+    EXPECT_EQ(data->updateRank, 0u);
+    checkFactorizationFromScratch(solver.get(), matrix, 1e-12);
+
+    // stiffer diagonal block of a node, and a softer coupling between two nodes: updates and downdates
+    for (sofa::Index a = 0; a < 3; ++a)
+    {
+        matrix.add(30 + a, 30 + a, 20);
+    }
+    matrix.add(30, 31, -2);
+    matrix.add(31, 30, -2);
+    matrix.add(0, 3, 0.5);
+    matrix.add(3, 0, 0.5);
+    matrix.add(3, 3, -10);
+    solver->invert(matrix);
+
+    const unsigned int rank = data->updateRank;
+    EXPECT_GT(rank, 0u);
+    EXPECT_LE(rank, 150u);
+    checkFactorizationFromScratch(solver.get(), matrix, 1e-10);
+
+    // the rank of the modifications is accumulated
+    matrix.add(100, 100, 5);
+    solver->invert(matrix);
+    EXPECT_EQ(data->updateRank, rank + 1);
+    checkFactorizationFromScratch(solver.get(), matrix, 1e-10);
+
+    // too many modifications: the factorization is computed again
+    for (sofa::Index i = 0; i < matrix.rowSize(); ++i)
+    {
+        matrix.add(i, i, 1);
+    }
+    solver->invert(matrix);
+    EXPECT_EQ(data->updateRank, 0u);
+    checkFactorizationFromScratch(solver.get(), matrix, 1e-12);
+}
+
+TEST(SparseLDLSolver, RefinementDataOnlyInMixedPrecision)
+{
+    using Solver = sofa::component::linearsolver::direct::SparseLDLSolver<sofa::linearalgebra::CompressedRowSparseMatrix<SReal>, sofa::linearalgebra::FullVector<SReal> >;
+    const Solver::SPtr solver = sofa::core::objectmodel::New<Solver>();
+    EXPECT_EQ(solver->findData("refinementMaxIterations"), nullptr);
+    EXPECT_EQ(solver->findData("refinementTolerance"), nullptr);
+
+#ifndef SOFA_FLOAT
+    using MixedSolver = sofa::component::linearsolver::direct::SparseLDLSolver<sofa::linearalgebra::CompressedRowSparseMatrix<float>, sofa::linearalgebra::FullVector<SReal> >;
+    const MixedSolver::SPtr mixedSolver = sofa::core::objectmodel::New<MixedSolver>();
+    EXPECT_NE(mixedSolver->findData("refinementMaxIterations"), nullptr);
+    EXPECT_NE(mixedSolver->findData("refinementTolerance"), nullptr);
+#endif
+}
+
+#ifndef SOFA_FLOAT
+/// The residual of the refinement is computed with the matrix in double precision: the solution is the one of the
+/// system in double precision, not of the system rounded to single precision
+TEST(SparseLDLSolver, MixedPrecisionRefinement)
+{
+    using MatrixType = sofa::linearalgebra::CompressedRowSparseMatrix<float>;
+    using VectorType = sofa::linearalgebra::FullVector<SReal>;
+    using Solver = sofa::component::linearsolver::direct::SparseLDLSolver<MatrixType, VectorType>;
+    using Tester = SparseLDLSolverTester<Solver>;
+
+    const Solver::SPtr solver = sofa::core::objectmodel::New<Tester>();
+    Tester* tester = static_cast<Tester*>(solver.get());
+    ASSERT_TRUE(solver->findData("refinementMaxIterations")->read("20"));
+    ASSERT_TRUE(solver->findData("refinementTolerance")->read("1e-14"));
+    solver->init();
+
+    // values that are not representable in single precision
+    const sofa::Index n = 50;
+    auto& highPrecisionMatrix = tester->m_highPrecisionMatrix;
+    highPrecisionMatrix.resize(n, n);
+    for (sofa::Index i = 0; i < n; ++i)
+    {
+        highPrecisionMatrix.add(i, i, 4 + 1e-9 * i);
+        if (i + 1 < n)
+        {
+            highPrecisionMatrix.add(i, i + 1, -1.000000123);
+            highPrecisionMatrix.add(i + 1, i, -1.000000123);
+        }
+    }
+    highPrecisionMatrix.compress();
+
+    MatrixType matrix(n, n);
+    highPrecisionMatrix.addTo(&matrix);
+    matrix.compress();
+    solver->invert(matrix);
+
+    VectorType b(n), x(n), residual;
+    for (sofa::Index i = 0; i < n; ++i)
+    {
+        b[i] = static_cast<SReal>(i % 3) - 1;
+    }
+    solver->solve(matrix, x, b);
+
+    highPrecisionMatrix.mul(residual, x);
+    residual.eq(b, residual, -1);
+    EXPECT_LT(residual.norm() / b.norm(), 1e-12);
+}
+#endif
@@ -74,6 +74,11 @@ int CGLinearSolverClass = core::RegisterObject("Linear system solver using the c
         .add< CGLinearSolver< CompressedRowSparseMatrix<Mat<4,4,SReal> >, FullVector<SReal> > >()
         .add< CGLinearSolver< CompressedRowSparseMatrix<Mat<6,6,SReal> >, FullVector<SReal> > >()
         .add< CGLinearSolver< CompressedRowSparseMatrix<Mat<8,8,SReal> >, FullVector<SReal> > >()
+#ifndef SOFA_FLOAT
+        // matrix stored in single precision, iterations computed in double precision
+        .add< CGLinearSolver< CompressedRowSparseMatrix<float>, FullVector<SReal> > >()
+        .add< CGLinearSolver< CompressedRowSparseMatrix<Mat<3,3,float> >, FullVector<SReal> > >()
+#endif
 
         .addAlias("CGSolver")
         .addAlias("ConjugateGradient")
@@ -88,6 +93,10 @@ template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API CGLinearSolver< Compres
 template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API CGLinearSolver< CompressedRowSparseMatrix<type::Mat<4,4,SReal> >, FullVector<SReal> >;
 template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API CGLinearSolver< CompressedRowSparseMatrix<type::Mat<6,6,SReal> >, FullVector<SReal> >;
 template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API CGLinearSolver< CompressedRowSparseMatrix<type::Mat<8,8,SReal> >, FullVector<SReal> >;
+#ifndef SOFA_FLOAT
+template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API CGLinearSolver< CompressedRowSparseMatrix<float>, FullVector<SReal> >;
+template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API CGLinearSolver< CompressedRowSparseMatrix<type::Mat<3,3,float> >, FullVector<SReal> >;
+#endif
 
 
 } // namespace sofa::component::linearsolver::iterative
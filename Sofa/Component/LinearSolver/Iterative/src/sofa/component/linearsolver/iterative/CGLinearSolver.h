@@ -23,7 +23,9 @@
 #include <sofa/component/linearsolver/iterative/config.h>
 
 #include <sofa/component/linearsolver/iterative/MatrixLinearSolver.h>
+#include <sofa/component/linearsolver/iterative/LinearizedOperatorSnapshot.h>
 #include <sofa/helper/map.h>
+#include <sofa/simulation/TaskScheduler.h>
 
 namespace sofa::component::linearsolver::iterative
 {
@@ -38,13 +40,17 @@ public:
     typedef TMatrix Matrix;
     typedef TVector Vector;
     typedef sofa::component::linearsolver::MatrixLinearSolver<TMatrix,TVector> Inherit;
-    using Real = typename Matrix::Real;
+    /// The iterations are computed in the precision of the vectors, which can be higher than the
+    /// precision used to store the matrix
+    using Real = typename Vector::Real;
 
     Data<unsigned> d_maxIter; ///< maximum number of iterations of the Conjugate Gradient solution
     Data<Real> d_tolerance; ///< desired precision of the Conjugate Gradient Solution (ratio of current residual norm over initial residual norm)
     Data<Real> d_smallDenominatorThreshold; ///< minimum value of the denominator in the conjugate Gradient solution
     Data<bool> d_warmStart; ///< Use previous solution as initial solution
     Data<std::map < std::string, sofa::type::vector<Real> > > d_graph; ///< Graph of residuals at each iteration
+    Data<bool> d_multithreading; ///< Compute the matrix-vector products in parallel (CompressedRowSparseMatrix only)
+    Data<bool> d_snapshotOperators; ///< Snapshot the linearized operators of the components once per linear system, and apply them without visitor (GraphScattered only)
 
 protected:
 
@@ -57,9 +63,19 @@ protected:
     /// It computes: x += p*alpha, r -= q*alpha
     inline void cgstep_alpha(const core::ExecParams* params, Vector& x, Vector& r, Vector& p, Vector& q, Real alpha);
 
+    /// Computes res = A * vec, in parallel if the matrix is a CompressedRowSparseMatrix and d_multithreading is true,
+    /// and with the snapshot of the operators if the matrix is a GraphScatteredMatrix and d_snapshotOperators is true
+    void multiply(Matrix& A, Vector& res, Vector& vec);
+
     int timeStepCount{0};
     bool equilibriumReached{false};
 
+    /// Task scheduler used to compute the matrix-vector products in parallel (nullptr if d_multithreading is false)
+    simulation::TaskScheduler* m_taskScheduler { nullptr };
+
+    /// Operators of the components, snapshotted by setSystemMBKMatrix if d_snapshotOperators is true
+    LinearizedOperatorSnapshot m_operatorSnapshot;
+
 public:
     void init() override;
     void reinit() override {};
@@ -110,6 +126,10 @@ extern template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API CGLinearSolver<
 extern template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API CGLinearSolver< linearalgebra::CompressedRowSparseMatrix<type::Mat<4,4,SReal> >, linearalgebra::FullVector<SReal> >;
 extern template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API CGLinearSolver< linearalgebra::CompressedRowSparseMatrix<type::Mat<6,6,SReal> >, linearalgebra::FullVector<SReal> >;
 extern template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API CGLinearSolver< linearalgebra::CompressedRowSparseMatrix<type::Mat<8,8,SReal> >, linearalgebra::FullVector<SReal> >;
+#ifndef SOFA_FLOAT
+extern template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API CGLinearSolver< linearalgebra::CompressedRowSparseMatrix<float>, linearalgebra::FullVector<SReal> >;
+extern template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API CGLinearSolver< linearalgebra::CompressedRowSparseMatrix<type::Mat<3,3,float> >, linearalgebra::FullVector<SReal> >;
+#endif
 
 
 #endif
@@ -25,6 +25,8 @@
 
 #include <sofa/helper/AdvancedTimer.h>
 #include <sofa/helper/ScopedAdvancedTimer.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/ParallelSparseMatrixVectorProduct.h>
 using sofa::helper::ScopedAdvancedTimer ;
 
 namespace sofa::component::linearsolver::iterative
@@ -38,6 +40,10 @@ CGLinearSolver<TMatrix,TVector>::CGLinearSolver()
     , d_smallDenominatorThreshold( initData(&d_smallDenominatorThreshold,(Real)1e-5,"threshold","Minimum value of the denominator (pT A p)^ in the conjugate Gradient solution") )
     , d_warmStart( initData(&d_warmStart,false,"warmStart","Use previous solution as initial solution") )
     , d_graph( initData(&d_graph,"graph","Graph of residuals at each iteration") )
+    , d_multithreading( initData(&d_multithreading, false, "multithreading", "Compute the matrix-vector products in parallel, using the main task scheduler. Only for assembled matrices of type CompressedRowSparseMatrix") )
+    , d_snapshotOperators( initData(&d_snapshotOperators, false, "snapshotOperators", "Snapshot the linearized operators of the force fields and masses once per linear system (e.g. the rotated element stiffness matrices of TetrahedronFEMForceField), "
+                                                                                      "and apply them at each iteration directly on the state vectors, without traversing the scene graph. Only for the matrix-free type GraphScattered. "
+                                                                                      "The mechanical mappings are not supported: the component is invalid if its context contains any.") )
 {
     d_graph.setWidget("graph");
     d_maxIter.setRequired(true);
@@ -64,8 +70,65 @@ void CGLinearSolver<TMatrix,TVector>::init()
         d_smallDenominatorThreshold.setValue(1e-5);
     }
 
+    if (d_multithreading.getValue())
+    {
+        m_taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+        if (m_taskScheduler->getThreadCount() == 0)
+        {
+            m_taskScheduler->init();
+        }
+    }
+    else
+    {
+        m_taskScheduler = nullptr;
+    }
+
     timeStepCount = 0;
     equilibriumReached = false;
+
+    if constexpr (std::is_same_v<Matrix, GraphScatteredMatrix>)
+    {
+        if (d_snapshotOperators.getValue() && !LinearizedOperatorSnapshot::isSupported(this->getContext()))
+        {
+            msg_error() << "The operators cannot be snapshotted in a context containing mechanical mappings. "
+                           "Set " << d_snapshotOperators.getName() << " to false, or remove the mappings.";
+            sofa::core::objectmodel::BaseObject::d_componentState.setValue(sofa::core::objectmodel::ComponentState::Invalid);
+            return;
+        }
+    }
+
+    sofa::core::objectmodel::BaseObject::d_componentState.setValue(sofa::core::objectmodel::ComponentState::Valid);
+}
+
+namespace details
+{
+template<class Matrix>
+struct IsCompressedRowSparseMatrix : std::false_type {};
+
+template<class TBlock, class TVecBlock, class TVecIndex>
+struct IsCompressedRowSparseMatrix<linearalgebra::CompressedRowSparseMatrix<TBlock, TVecBlock, TVecIndex> > : std::true_type {};
+}
+
+template<class TMatrix, class TVector>
+void CGLinearSolver<TMatrix,TVector>::multiply(Matrix& A, Vector& res, Vector& vec)
+{
+    if constexpr (details::IsCompressedRowSparseMatrix<Matrix>::value)
+    {
+        if (m_taskScheduler)
+        {
+            simulation::parallelMul(*m_taskScheduler, A, res, vec);
+            return;
+        }
+    }
+    else if constexpr (std::is_same_v<Matrix, GraphScatteredMatrix>)
+    {
+        if (!m_operatorSnapshot.empty())
+        {
+            m_operatorSnapshot.apply(res, vec);
+            return;
+        }
+    }
+    res = A * vec;
 }
 
 /// Clear graph and clean the RHS / LHS vectors
@@ -87,6 +150,22 @@ void CGLinearSolver<TMatrix,TVector>::setSystemMBKMatrix(const sofa::core::Mecha
 {
     sofa::helper::ScopedAdvancedTimer timer("CG-setSystemMBKMatrix");
     Inherit::setSystemMBKMatrix(mparams);
+
+    if constexpr (std::is_same_v<Matrix, GraphScatteredMatrix>)
+    {
+        m_operatorSnapshot.clear();
+        if (d_snapshotOperators.getValue() && this->isComponentStateValid())
+        {
+            sofa::helper::ScopedAdvancedTimer snapshotTimer("CG-snapshotOperators");
+            if (!m_operatorSnapshot.build(this->getContext(), mparams))
+            {
+                // e.g. a mechanical mapping has been added after the initialization
+                msg_error() << "The operators cannot be snapshotted in a context containing mechanical mappings. "
+                               "Set " << d_snapshotOperators.getName() << " to false, or remove the mappings.";
+                sofa::core::objectmodel::BaseObject::d_componentState.setValue(sofa::core::objectmodel::ComponentState::Invalid);
+            }
+        }
+    }
 }
 
 /// Solve iteratively the linear system Ax=b following a conjugate gradient descent
@@ -115,7 +194,7 @@ void CGLinearSolver<TMatrix,TVector>::solve(Matrix& A, Vector& x, Vector& b)
     /// Compute the initial residual r depending on the warmStart option
     if( d_warmStart.getValue() )
     {
-        r = A * x;
+        multiply(A, r, x);
         r.eq( b, r, -1.0 );   // initial residual r = b - Ax;
     }
     else
@@ -225,7 +304,7 @@ void CGLinearSolver<TMatrix,TVector>::solve(Matrix& A, Vector& x, Vector& b)
             /// 2) The matrix is not assembled (e.g. GraphScattered): visitors run and call addMBKdx on force
             /// fields (usually force fields implement addDForce). This method performs the matrix-vector product and
             /// store it in another vector without building explicitly the matrix. Projective constraints are also applied.
-            q = A*p;
+            multiply(A, q, p);
             msg_info() << "q = A p : " << q;
 
             /// Compute the denominator : pT A p
@@ -301,7 +380,7 @@ void CGLinearSolver<TMatrix,TVector>::solve(Matrix& A, Vector& x, Vector& b)
         if( timeStepCount==0 )
         {
             p = r;
-            q = A*p;
+            multiply(A, q, p);
             const auto den = p.dot(q);
 
             if(den != 0.0)
@@ -0,0 +1,127 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/component/linearsolver/iterative/LinearizedOperatorSnapshot.h>
+
+#include <sofa/core/BaseMapping.h>
+#include <sofa/core/behavior/BaseForceField.h>
+#include <sofa/core/behavior/BaseMechanicalState.h>
+#include <sofa/core/behavior/BaseProjectiveConstraintSet.h>
+
+namespace sofa::component::linearsolver::iterative
+{
+
+namespace
+{
+
+/// Operator of a force field without flat snapshot: addMBKdx is called directly, without visitor
+class ForceFieldOperator : public core::behavior::LinearizedOperator
+{
+public:
+    ForceFieldOperator(core::behavior::BaseForceField* forceField, const core::MechanicalParams& mparams)
+        : m_forceField(forceField), m_mparams(mparams)
+    {
+    }
+
+    void addMultiply(core::MultiVecDerivId df, core::ConstMultiVecDerivId dx) override
+    {
+        m_mparams.setDx(dx);
+        m_forceField->addMBKdx(&m_mparams, df);
+    }
+
+protected:
+    core::behavior::BaseForceField* m_forceField;
+    core::MechanicalParams m_mparams;
+};
+
+}
+
+bool LinearizedOperatorSnapshot::isSupported(core::objectmodel::BaseContext* context)
+{
+    for (const auto* mapping : context->getObjects<core::BaseMapping>(core::objectmodel::BaseContext::SearchDown))
+    {
+        if (mapping->isMechanical())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LinearizedOperatorSnapshot::build(core::objectmodel::BaseContext* context, const core::MechanicalParams* mparams)
+{
+    clear();
+
+    if (!isSupported(context))
+    {
+        return false;
+    }
+
+    m_mparams = *mparams;
+    context->getObjects<core::behavior::BaseMechanicalState>(&m_states, core::objectmodel::BaseContext::SearchDown);
+    context->getObjects<core::behavior::BaseProjectiveConstraintSet>(&m_projectiveConstraints, core::objectmodel::BaseContext::SearchDown);
+
+    // the stiffness of the compliant force fields is not part of the operator
+    core::MechanicalParams mparamsWithoutStiffness = *mparams;
+    mparamsWithoutStiffness.setKFactor(0);
+
+    for (auto* forceField : context->getObjects<core::behavior::BaseForceField>(core::objectmodel::BaseContext::SearchDown))
+    {
+        const core::MechanicalParams& forceFieldParams = forceField->isCompliance.getValue() ? mparamsWithoutStiffness : *mparams;
+        if (auto* provider = dynamic_cast<core::behavior::LinearizedOperatorProvider*>(forceField))
+        {
+            if (auto linearizedOperator = provider->createLinearizedOperator(&forceFieldParams))
+            {
+                m_operators.push_back(std::move(linearizedOperator));
+                ++m_nbFlatOperators;
+                continue;
+            }
+        }
+        m_operators.push_back(std::make_shared<ForceFieldOperator>(forceField, forceFieldParams));
+    }
+    return true;
+}
+
+void LinearizedOperatorSnapshot::clear()
+{
+    m_states.clear();
+    m_operators.clear();
+    m_projectiveConstraints.clear();
+    m_nbFlatOperators = 0;
+}
+
+void LinearizedOperatorSnapshot::apply(core::MultiVecDerivId res, core::ConstMultiVecDerivId x)
+{
+    for (auto* state : m_states)
+    {
+        state->resetForce(&m_mparams, res.getId(state));
+    }
+    for (const auto& linearizedOperator : m_operators)
+    {
+        linearizedOperator->addMultiply(res, x);
+    }
+    for (auto* constraint : m_projectiveConstraints)
+    {
+        constraint->projectResponse(&m_mparams, res);
+    }
+}
+
+} // namespace sofa::component::linearsolver::iterative
@@ -0,0 +1,70 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/linearsolver/iterative/config.h>
+
+#include <sofa/core/behavior/LinearizedOperator.h>
+#include <sofa/core/MechanicalParams.h>
+#include <sofa/core/objectmodel/BaseContext.h>
+#include <sofa/type/vector.h>
+
+namespace sofa::component::linearsolver::iterative
+{
+
+/**
+ * Matrix-free operator (m M + b B + k K) of the components of a context, snapshotted once per linear system.
+ *
+ * The force fields implementing core::behavior::LinearizedOperatorProvider provide a flat snapshot of their operator
+ * (e.g. the rotated element stiffness matrices of TetrahedronFEMForceField). The other ones are applied with a direct
+ * call to addMBKdx. The product is then computed without traversing the scene graph, which is only supported if the
+ * context does not contain mechanical mappings (see isSupported).
+ */
+class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API LinearizedOperatorSnapshot
+{
+public:
+    /// True if the operators of the components under the context can be snapshotted, i.e. if the context does not
+    /// contain mechanical mappings: the mapped states would require to propagate dx and to accumulate df through them
+    static bool isSupported(core::objectmodel::BaseContext* context);
+
+    /// Snapshot the operators of the components under the context, with the factors of mparams.
+    /// Returns false if it is not supported for the context: the snapshot is then empty.
+    bool build(core::objectmodel::BaseContext* context, const core::MechanicalParams* mparams);
+
+    void clear();
+
+    bool empty() const { return m_states.empty(); }
+
+    /// res = (m M + b B + k K) x, projected by the projective constraints
+    void apply(core::MultiVecDerivId res, core::ConstMultiVecDerivId x);
+
+    /// Number of components providing a flat snapshot of their operator
+    std::size_t getNbFlatOperators() const { return m_nbFlatOperators; }
+
+protected:
+    core::MechanicalParams m_mparams;
+    type::vector<core::behavior::BaseMechanicalState*> m_states;
+    type::vector<std::shared_ptr<core::behavior::LinearizedOperator> > m_operators;
+    type::vector<core::behavior::BaseProjectiveConstraintSet*> m_projectiveConstraints;
+    std::size_t m_nbFlatOperators { 0 };
+};
+
+} // namespace sofa::component::linearsolver::iterative
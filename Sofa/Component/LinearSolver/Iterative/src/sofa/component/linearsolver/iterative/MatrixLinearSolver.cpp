@@ -92,6 +92,12 @@ void MatrixLinearSolver<GraphScatteredMatrix,GraphScatteredVector,NoThreadManage
 {
 }
 
+template<>
+void MatrixLinearSolver<GraphScatteredMatrix,GraphScatteredVector,NoThreadManager>::assembleSystemMatrix(const core::MechanicalParams* /*mparams*/)
+{
+    // the matrix is not assembled: its products are computed by the mechanical components (see setSystemMBKMatrix)
+}
+
 template<>
 void MatrixLinearSolver<GraphScatteredMatrix,GraphScatteredVector,NoThreadManager>::setSystemRHVector(core::MultiVecDerivId v)
 {
@@ -166,4 +172,10 @@ template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API MatrixLinearSolver< Dia
 template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API MatrixLinearSolver< BlockDiagonalMatrix<3,SReal>, FullVector<SReal>, NoThreadManager >;
 template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API MatrixLinearSolver< RotationMatrix<SReal>, FullVector<SReal>, NoThreadManager >;
 
+// Matrix stored in single precision, vectors in double precision
+#ifndef SOFA_FLOAT
+template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API MatrixLinearSolver< CompressedRowSparseMatrix<float>, FullVector<SReal>, NoThreadManager >;
+template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API MatrixLinearSolver< CompressedRowSparseMatrix<type::Mat<3,3,float> >, FullVector<SReal>, NoThreadManager >;
+#endif
+
 } // namespace sofa::component::linearsolver
@@ -48,6 +48,9 @@ class MatrixInvertData
 {
 public:
     virtual ~MatrixInvertData() = default;
+
+    /// @return the number of bytes allocated by the factorization, or 0 if unknown
+    virtual std::size_t getMemoryFootprint() const { return 0; }
 };
 
 template<class Matrix, class Vector>
@@ -182,12 +185,17 @@ public:
     MatrixLinearSolver();
     ~MatrixLinearSolver() override ;
 
+    Data<bool> d_reuseMatrixPattern; ///< Reuse the sparsity pattern of the assembled matrix from a time step to the next one (CompressedRowSparseMatrix only)
+
     /// Reset the current linear system.
     void resetSystem() override;
 
     /// Reset the current linear system.
     void resizeSystem(Size n);
 
+    /// Add the memory allocated by the system matrix, the system vectors and the factorization to the footprint of the Data
+    std::size_t getMemoryFootprint() const override;
+
     /// Set the linear system matrix, combining the mechanical M,B,K matrices using the given coefficients
     ///
     /// Note that this automatically resizes the linear system to the number of active degrees of freedoms
@@ -354,6 +362,13 @@ protected:
 
     SReal currentMFactor, currentBFactor, currentKFactor;
 
+    /// Apply d_reuseMatrixPattern to the system matrix, if it supports the reuse of its pattern
+    void applyMatrixPatternReuse();
+
+    /// Resize the system, and assemble the system matrix combining the mechanical M,B,K matrices using the
+    /// coefficients of mparams
+    virtual void assembleSystemMatrix(const core::MechanicalParams* mparams);
+
 };
 
 //////////////////////////////////////////////////////////////
@@ -390,6 +405,9 @@ void MatrixLinearSolver<GraphScatteredMatrix,GraphScatteredVector,NoThreadManage
 template<> SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API
 void MatrixLinearSolver<GraphScatteredMatrix,GraphScatteredVector,NoThreadManager>::rebuildSystem(SReal massFactor, SReal forceFactor);
 
+template<> SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API
+void MatrixLinearSolver<GraphScatteredMatrix,GraphScatteredVector,NoThreadManager>::assembleSystemMatrix(const core::MechanicalParams* mparams);
+
 template<> SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API
 void MatrixLinearSolver<GraphScatteredMatrix,GraphScatteredVector,NoThreadManager>::setSystemRHVector(core::MultiVecDerivId v);
 
@@ -451,6 +469,10 @@ extern template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API MatrixLinearSolv
 extern template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API MatrixLinearSolver< linearalgebra::DiagonalMatrix<SReal>, linearalgebra::FullVector<SReal>, NoThreadManager >;
 extern template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API MatrixLinearSolver< linearalgebra::BlockDiagonalMatrix<3,SReal>, linearalgebra::FullVector<SReal>, NoThreadManager >;
 extern template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API MatrixLinearSolver< linearalgebra::RotationMatrix<SReal>, linearalgebra::FullVector<SReal>, NoThreadManager >;
+#ifndef SOFA_FLOAT
+extern template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API MatrixLinearSolver< linearalgebra::CompressedRowSparseMatrix<float>, linearalgebra::FullVector<SReal>, NoThreadManager >;
+extern template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API MatrixLinearSolver< linearalgebra::CompressedRowSparseMatrix<type::Mat<3,3,float> >, linearalgebra::FullVector<SReal>, NoThreadManager >;
+#endif
 #endif
 
 
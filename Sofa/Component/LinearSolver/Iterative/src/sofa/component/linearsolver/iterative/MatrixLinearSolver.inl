@@ -40,6 +40,11 @@ namespace sofa::component::linearsolver
 template<class Matrix, class Vector>
 MatrixLinearSolver<Matrix,Vector>::MatrixLinearSolver()
     : Inherit()
+    , d_reuseMatrixPattern(initData(&d_reuseMatrixPattern, false, "reuseMatrixPattern",
+        "If true, the sparsity pattern of the assembled matrix is frozen after the first time steps and the "
+        "matrix values are written directly at their location, instead of rebuilding the sparse structure at "
+        "each assembly. The pattern is rebuilt automatically if it changes (e.g. topological changes). "
+        "Only supported by CompressedRowSparseMatrix."))
     , invertData()
     , linearSystem()
     , currentMFactor(), currentBFactor(), currentKFactor()
@@ -79,12 +84,52 @@ void MatrixLinearSolver<Matrix,Vector>::resetSystem()
     linearSystem.solutionVecId = core::MultiVecDerivId::null();
 }
 
+namespace details
+{
+template<class Matrix, class = void>
+struct HasPatternReuse : std::false_type {};
+
+template<class Matrix>
+struct HasPatternReuse<Matrix, std::void_t<decltype(std::declval<Matrix&>().setPatternReuse(true))> > : std::true_type {};
+}
+
+template<class Matrix, class Vector>
+void MatrixLinearSolver<Matrix,Vector>::applyMatrixPatternReuse()
+{
+    if constexpr (details::HasPatternReuse<Matrix>::value)
+    {
+        linearSystem.systemMatrix->setPatternReuse(d_reuseMatrixPattern.getValue());
+    }
+}
+
+template<class Matrix, class Vector>
+std::size_t MatrixLinearSolver<Matrix,Vector>::getMemoryFootprint() const
+{
+    std::size_t footprint = Inherit::getMemoryFootprint();
+    if constexpr (std::is_base_of_v<linearalgebra::BaseMatrix, Matrix>)
+    {
+        if (linearSystem.systemMatrix)
+            footprint += linearSystem.systemMatrix->getMemoryFootprint();
+    }
+    if constexpr (std::is_base_of_v<linearalgebra::BaseVector, Vector>)
+    {
+        if (linearSystem.systemRHVector)
+            footprint += linearSystem.systemRHVector->getMemoryFootprint();
+        if (linearSystem.systemLHVector)
+            footprint += linearSystem.systemLHVector->getMemoryFootprint();
+    }
+    if (invertData)
+        footprint += invertData->getMemoryFootprint();
+    return footprint;
+}
+
 template<class Matrix, class Vector>
 void MatrixLinearSolver<Matrix,Vector>::resizeSystem(Size n)
 {
     if (!this->frozen)
     {
         if (!linearSystem.systemMatrix) linearSystem.systemMatrix = createMatrix();
+        applyMatrixPatternReuse();
         linearSystem.systemMatrix->resize(n, n);
     }
 
@@ -120,32 +165,37 @@ void MatrixLinearSolver<Matrix,Vector>::setSystemMBKMatrix(const core::Mechanica
     if (!this->frozen)
     {
         linearSystem.matrixAccessor.setDoPrintInfo(this->f_printLog.getValue() ) ;
-
-        simulation::common::MechanicalOperations mops(mparams, this->getContext());
-
-        // Create the matrix if not yet done
-        if (!linearSystem.systemMatrix) linearSystem.systemMatrix = createMatrix();
-
-        linearSystem.matrixAccessor.setGlobalMatrix(linearSystem.systemMatrix);
-        linearSystem.matrixAccessor.clear();
-
-        // The following operation traverses the BaseMechanicalState of the current context tree,
-        // and accumulate the number of degrees of freedom to get the total number of degrees of
-        // freedom, which is the size of the linear system.
-        // During the accumulation, it also prepares the indices to parts of the matrix associated
-        // to each BaseMechanicalState. Each BaseMechanicalState will then write to this submatrix
-        // based on the provided index.
-        mops.getMatrixDimension(&linearSystem.matrixAccessor);
-
-        linearSystem.matrixAccessor.setupMatrices();
-        resizeSystem(linearSystem.matrixAccessor.getGlobalDimension());
-        linearSystem.systemMatrix->clear();
-        mops.addMBK_ToMatrix(&(linearSystem.matrixAccessor), mparams->mFactor(), sofa::core::mechanicalparams::bFactor(mparams), mparams->kFactor());
-        linearSystem.matrixAccessor.computeGlobalMatrix();
+        assembleSystemMatrix(mparams);
     }
 
 }
 
+template<class Matrix, class Vector>
+void MatrixLinearSolver<Matrix,Vector>::assembleSystemMatrix(const core::MechanicalParams* mparams)
+{
+    simulation::common::MechanicalOperations mops(mparams, this->getContext());
+
+    // Create the matrix if not yet done
+    if (!linearSystem.systemMatrix) linearSystem.systemMatrix = createMatrix();
+
+    linearSystem.matrixAccessor.setGlobalMatrix(linearSystem.systemMatrix);
+    linearSystem.matrixAccessor.clear();
+
+    // The following operation traverses the BaseMechanicalState of the current context tree,
+    // and accumulate the number of degrees of freedom to get the total number of degrees of
+    // freedom, which is the size of the linear system.
+    // During the accumulation, it also prepares the indices to parts of the matrix associated
+    // to each BaseMechanicalState. Each BaseMechanicalState will then write to this submatrix
+    // based on the provided index.
+    mops.getMatrixDimension(&linearSystem.matrixAccessor);
+
+    linearSystem.matrixAccessor.setupMatrices();
+    resizeSystem(linearSystem.matrixAccessor.getGlobalDimension());
+    linearSystem.systemMatrix->clear();
+    mops.addMBK_ToMatrix(&(linearSystem.matrixAccessor), mparams->mFactor(), sofa::core::mechanicalparams::bFactor(mparams), mparams->kFactor());
+    linearSystem.matrixAccessor.computeGlobalMatrix();
+}
+
 template<class Matrix, class Vector>
 void MatrixLinearSolver<Matrix,Vector>::rebuildSystem(SReal massFactor, SReal forceFactor)
 {
@@ -155,16 +205,7 @@ void MatrixLinearSolver<Matrix,Vector>::rebuildSystem(SReal massFactor, SReal fo
     mparams.setKFactor(this->currentKFactor*forceFactor);
     if (!this->frozen)
     {
-        simulation::common::MechanicalOperations mops(&mparams, this->getContext());
-        if (!linearSystem.systemMatrix) linearSystem.systemMatrix = createMatrix();
-        linearSystem.matrixAccessor.setGlobalMatrix(linearSystem.systemMatrix);
-        linearSystem.matrixAccessor.clear();
-        mops.getMatrixDimension(&(linearSystem.matrixAccessor));
-        linearSystem.matrixAccessor.setupMatrices();
-        resizeSystem(linearSystem.matrixAccessor.getGlobalDimension());
-        linearSystem.systemMatrix->clear();
-        mops.addMBK_ToMatrix(&(linearSystem.matrixAccessor), mparams.mFactor(), mparams.bFactor(), mparams.kFactor());
-        linearSystem.matrixAccessor.computeGlobalMatrix();
+        assembleSystemMatrix(&mparams);
     }
 
     this->invertSystem();
@@ -0,0 +1,162 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/linearsolver/preconditioner/config.h>
+
+#include <sofa/component/linearsolver/iterative/MatrixLinearSolver.h>
+#include <sofa/component/linearsolver/preconditioner/ScalarCRSMatrix.h>
+#include <sofa/linearalgebra/CompressedRowSparseMatrix.h>
+#include <sofa/linearalgebra/FullVector.h>
+
+namespace sofa::component::linearsolver::preconditioner
+{
+
+/// Algebraic multigrid preconditioner, based on smoothed aggregation.
+/// The nodes (the blocks of the matrix) are grouped in aggregates of strongly connected nodes. The tentative
+/// prolongator represents exactly the near null space of the matrix on each aggregate, and it is smoothed by a damped
+/// Jacobi iteration. The near null space is made of the 6 rigid body modes, computed from the rest positions of the
+/// Vec3 mechanical state of the context when the matrix is its system, and of the rigid translations otherwise.
+/// The modes are orthonormalized on each aggregate, and their coordinates in the orthonormal basis are the near null
+/// space of the next level.
+/// The coarse matrices are computed by Galerkin products, and the coarsest one is factorized.
+/// The preconditioner applies a V-cycle, with forward Gauss-Seidel pre-smoothing and backward Gauss-Seidel
+/// post-smoothing, such that it is symmetric and can be used with a conjugate gradient.
+/// The aggregates and the patterns of the hierarchy are computed when the pattern of the matrix changes. While it
+/// does not change, the next setups only recompute the values of the hierarchy.
+template<class TMatrix, class TVector, class TThreadManager = NoThreadManager>
+class AMGPreconditioner : public sofa::component::linearsolver::MatrixLinearSolver<TMatrix,TVector,TThreadManager>
+{
+public:
+    SOFA_CLASS(SOFA_TEMPLATE3(AMGPreconditioner,TMatrix,TVector,TThreadManager),SOFA_TEMPLATE3(sofa::component::linearsolver::MatrixLinearSolver,TMatrix,TVector,TThreadManager));
+
+    typedef TMatrix Matrix;
+    typedef TVector Vector;
+    typedef TThreadManager ThreadManager;
+    typedef SReal Real;
+    typedef sofa::component::linearsolver::MatrixLinearSolver<TMatrix,TVector,TThreadManager> Inherit;
+
+    Data<SReal> d_strengthThreshold; ///< Two nodes are strongly connected if the norm of their coupling block is larger than this threshold times the geometric mean of the norms of their diagonal blocks
+    Data<unsigned int> d_maxCoarsestSize; ///< The coarsening stops when the number of rows is lower than this size
+    Data<unsigned int> d_maxLevels; ///< Maximum number of levels of the hierarchy
+    Data<unsigned int> d_nbSmoothingSteps; ///< Number of Gauss-Seidel iterations before and after the coarse correction
+
+protected:
+    AMGPreconditioner();
+
+public:
+    void solve (Matrix& M, Vector& x, Vector& b) override;
+    void invert(Matrix& M) override;
+
+    struct Level
+    {
+        ScalarCRSMatrix<Real> A; ///< matrix of the level
+        ScalarCRSMatrix<Real> T; ///< tentative prolongator from the next level
+        ScalarCRSMatrix<Real> P; ///< smoothed prolongator from the next level
+        ScalarCRSMatrix<Real> R; ///< restriction to the next level, transpose of P
+        ScalarCRSMatrix<Real> AP; ///< product A * P
+        type::vector<sofa::Index> R_map; ///< position in P of the values of R
+        type::vector<sofa::Index> P_tentativePosition; ///< position in P of each entry of T
+
+        type::vector<Real> invDiag;
+        type::vector<Real> x, b, r;
+
+        std::size_t getMemoryFootprint() const
+        {
+            return A.getMemoryFootprint() + T.getMemoryFootprint() + P.getMemoryFootprint() + R.getMemoryFootprint()
+                + AP.getMemoryFootprint() + (R_map.capacity() + P_tentativePosition.capacity()) * sizeof(sofa::Index)
+                + (invDiag.capacity() + x.capacity() + b.capacity() + r.capacity()) * sizeof(Real);
+        }
+    };
+
+    class AMGInvertData : public MatrixInvertData
+    {
+    public :
+        type::vector<Level> levels;
+
+        /// Dense L D L^T factorization of the matrix of the coarsest level, L being stored in the lower triangle
+        type::vector<Real> coarseFactor, coarseInvD;
+
+        std::size_t getMemoryFootprint() const override
+        {
+            std::size_t footprint = (coarseFactor.capacity() + coarseInvD.capacity()) * sizeof(Real);
+            for (const auto& level : levels)
+            {
+                footprint += level.getMemoryFootprint();
+            }
+            return footprint;
+        }
+    };
+
+    MatrixInvertData * createInvertData() override
+    {
+        return new AMGInvertData();
+    }
+
+protected:
+    /// Compute the aggregates and the patterns of the hierarchy from the matrix of the first level
+    void buildHierarchy(AMGInvertData* data);
+
+    /// Compute the values of the hierarchy from the values of the matrix of the first level
+    void computeHierarchy(AMGInvertData* data);
+
+    /// Allocate the vectors of the level, and compute the inverse of the diagonal of its matrix
+    void prepareLevel(Level& level);
+
+    /// Compute the values of the prolongator and of the restriction of a level, and the matrix of the next level
+    void computeLevel(Level& fine, Level& coarse);
+
+    /// Rigid body modes of the rest positions of the Vec3 mechanical state of the context, stored by rows with 6
+    /// columns. Returns false if there is no such state, or if the matrix is not its system.
+    bool computeRigidBodyModes(sofa::Index nbRows, type::vector<Real>& modes) const;
+
+    /// Compute the tentative prolongator of the level, which interpolates the near null space nullSpace (nbModes
+    /// columns stored by rows) on each aggregate, and replace nullSpace by its coordinates on the next level
+    void computeTentativeProlongator(Level& fine, sofa::Index blockSize, sofa::Index nbModes,
+                                     const type::vector<sofa::Index>& aggregates, sofa::Index nbAggregates,
+                                     type::vector<Real>& nullSpace);
+
+    /// Group the nodes of A, made of blockSize rows, in aggregates of strongly connected nodes.
+    /// Returns the number of aggregates.
+    sofa::Index aggregate(const ScalarCRSMatrix<Real>& A, sofa::Index blockSize, type::vector<sofa::Index>& aggregates);
+
+    /// Approximation of the spectral radius of D^-1 A, by power iterations
+    Real estimateSpectralRadius(Level& level);
+
+    void factorizeCoarsest(AMGInvertData* data);
+    void solveCoarsest(AMGInvertData* data);
+
+    /// Gauss-Seidel iterations on x for the system A x = b of the level
+    void smoothForward(Level& level);
+    void smoothBackward(Level& level);
+
+    /// Approximate solution of the system of the level l, from levels[l].b to levels[l].x
+    void vcycle(AMGInvertData* data, std::size_t l);
+
+    type::vector<sofa::Index> m_marker, m_position;
+};
+
+#if !defined(SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_AMGPRECONDITIONER_CPP)
+extern template class SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_API AMGPreconditioner< linearalgebra::CompressedRowSparseMatrix<SReal>, linearalgebra::FullVector<SReal> >;
+extern template class SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_API AMGPreconditioner< linearalgebra::CompressedRowSparseMatrix< type::Mat<3, 3, SReal> >, linearalgebra::FullVector<SReal> >;
+#endif // !defined(SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_AMGPRECONDITIONER_CPP)
+
+} // namespace sofa::component::linearsolver::preconditioner
@@ -0,0 +1,714 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/linearsolver/preconditioner/AMGPreconditioner.h>
+#include <sofa/core/behavior/MechanicalState.h>
+#include <sofa/defaulttype/VecTypes.h>
+#include <sofa/helper/ScopedAdvancedTimer.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+namespace sofa::component::linearsolver::preconditioner
+{
+
+template<class TMatrix, class TVector, class TThreadManager>
+AMGPreconditioner<TMatrix,TVector,TThreadManager>::AMGPreconditioner()
+    : d_strengthThreshold(initData(&d_strengthThreshold, 0.08_sreal, "strengthThreshold", "Two nodes are strongly connected if the norm of their coupling block is larger than this threshold times the geometric mean of the norms of their diagonal blocks"))
+    , d_maxCoarsestSize(initData(&d_maxCoarsestSize, 500u, "maxCoarsestSize", "The coarsening stops when the number of rows is lower than this size. The system of the coarsest level is then solved with a dense factorization"))
+    , d_maxLevels(initData(&d_maxLevels, 10u, "maxLevels", "Maximum number of levels of the hierarchy"))
+    , d_nbSmoothingSteps(initData(&d_nbSmoothingSteps, 1u, "nbSmoothingSteps", "Number of Gauss-Seidel iterations before and after the coarse correction"))
+{
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+void AMGPreconditioner<TMatrix,TVector,TThreadManager>::invert(Matrix& M)
+{
+    sofa::helper::ScopedAdvancedTimer setupTimer("AMGSetup");
+
+    auto* data = static_cast<AMGInvertData*>(this->getMatrixInvertData(&M));
+
+    M.compress();
+    if (data->levels.empty())
+    {
+        data->levels.resize(1);
+    }
+
+    if (data->levels.front().A.copyFrom(M))
+    {
+        buildHierarchy(data);
+    }
+    else
+    {
+        computeHierarchy(data);
+    }
+    factorizeCoarsest(data);
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+void AMGPreconditioner<TMatrix,TVector,TThreadManager>::buildHierarchy(AMGInvertData* data)
+{
+    const unsigned int maxLevels = std::max(d_maxLevels.getValue(), 1u);
+    const sofa::Index maxCoarsestSize = d_maxCoarsestSize.getValue();
+
+    data->levels.resize(1);
+    prepareLevel(data->levels.front());
+
+    // near null space of the first level: the rigid body modes, or the translations of the nodes
+    sofa::Index blockSize = 3;
+    sofa::Index nbModes = 6;
+    type::vector<Real> nullSpace;
+    if (!computeRigidBodyModes(data->levels.front().A.nbRows, nullSpace))
+    {
+        blockSize = Matrix::traits::NL;
+        nbModes = blockSize;
+        nullSpace.assign(static_cast<std::size_t>(data->levels.front().A.nbRows) * nbModes, 0);
+        for (sofa::Index i = 0; i < data->levels.front().A.nbRows; ++i)
+        {
+            nullSpace[i * nbModes + i % blockSize] = 1;
+        }
+    }
+
+    type::vector<sofa::Index> aggregates;
+    while (data->levels.size() < maxLevels && data->levels.back().A.nbRows > maxCoarsestSize)
+    {
+        Level& fine = data->levels.back();
+        const sofa::Index nbAggregates = aggregate(fine.A, blockSize, aggregates);
+        if (nbAggregates * nbModes >= fine.A.nbRows)
+        {
+            break;
+        }
+
+        computeTentativeProlongator(fine, blockSize, nbModes, aggregates, nbAggregates, nullSpace);
+        const auto& T = fine.T;
+
+        // the smoothed prolongator (I - omega D^-1 A) T has the pattern of A T
+        multiplySymbolic(fine.A, T, fine.P, m_marker);
+        fine.P_tentativePosition.resize(T.colsIndex.size());
+        for (sofa::Index i = 0; i < T.nbRows; ++i)
+        {
+            const auto first = fine.P.colsIndex.begin() + fine.P.rowBegin[i];
+            const auto last = fine.P.colsIndex.begin() + fine.P.rowBegin[i + 1];
+            for (sofa::Index q = T.rowBegin[i]; q < T.rowBegin[i + 1]; ++q)
+            {
+                const auto it = std::lower_bound(first, last, T.colsIndex[q]);
+                fine.P_tentativePosition[q] = (it != last && *it == T.colsIndex[q])
+                    ? static_cast<sofa::Index>(it - fine.P.colsIndex.begin()) : std::numeric_limits<sofa::Index>::max();
+            }
+        }
+
+        transposeSymbolic(fine.P, fine.R, fine.R_map);
+        multiplySymbolic(fine.A, fine.P, fine.AP, m_marker);
+
+        Level coarse;
+        multiplySymbolic(fine.R, fine.AP, coarse.A, m_marker);
+        computeLevel(fine, coarse);
+        prepareLevel(coarse);
+        data->levels.push_back(std::move(coarse));
+
+        // the nodes of the next level are the aggregates, with a coordinate per mode
+        blockSize = nbModes;
+    }
+
+    msg_info() << "Hierarchy of " << data->levels.size() << " levels, with " << [data]()
+    {
+        std::stringstream sizes;
+        for (const auto& level : data->levels)
+        {
+            sizes << level.A.nbRows << " ";
+        }
+        return sizes.str();
+    }() << "rows";
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+bool AMGPreconditioner<TMatrix,TVector,TThreadManager>::computeRigidBodyModes(sofa::Index nbRows, type::vector<Real>& modes) const
+{
+    using State = core::behavior::MechanicalState<defaulttype::Vec3Types>;
+    const auto* state = dynamic_cast<const State*>(this->getContext()->getMechanicalState());
+    if (state == nullptr || state->getSize() == 0 || 3 * static_cast<sofa::Index>(state->getSize()) != nbRows)
+    {
+        return false;
+    }
+
+    const auto& x0 = state->read(core::ConstVecCoordId::restPosition())->getValue();
+    if (x0.size() != state->getSize())
+    {
+        return false;
+    }
+
+    // the positions are relative to their center, for the conditioning of the orthonormalization
+    State::Coord center;
+    for (const auto& x : x0)
+    {
+        center += x;
+    }
+    center /= static_cast<Real>(x0.size());
+
+    // translations along x, y and z, and rotations around x, y and z
+    modes.resize(static_cast<std::size_t>(nbRows) * 6);
+    for (std::size_t i = 0; i < x0.size(); ++i)
+    {
+        const State::Coord p = x0[i] - center;
+        const Real nodeModes[18] {
+            1, 0, 0, 0, p[2], -p[1],
+            0, 1, 0, -p[2], 0, p[0],
+            0, 0, 1, p[1], -p[0], 0 };
+        std::copy(nodeModes, nodeModes + 18, modes.begin() + i * 18);
+    }
+    return true;
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+void AMGPreconditioner<TMatrix,TVector,TThreadManager>::computeTentativeProlongator(
+    Level& fine, sofa::Index blockSize, sofa::Index nbModes, const type::vector<sofa::Index>& aggregates,
+    sofa::Index nbAggregates, type::vector<Real>& nullSpace)
+{
+    const sofa::Index nbNodes = fine.A.nbRows / blockSize;
+    const Real tolerance = std::sqrt(std::numeric_limits<Real>::epsilon());
+
+    // nodes of each aggregate
+    type::vector<sofa::Index> aggregateBegin(nbAggregates + 1, 0), aggregateNodes(nbNodes);
+    for (const sofa::Index a : aggregates)
+    {
+        ++aggregateBegin[a + 1];
+    }
+    for (sofa::Index a = 0; a < nbAggregates; ++a)
+    {
+        aggregateBegin[a + 1] += aggregateBegin[a];
+    }
+    m_position.assign(aggregateBegin.begin(), aggregateBegin.end() - 1);
+    for (sofa::Index I = 0; I < nbNodes; ++I)
+    {
+        aggregateNodes[m_position[aggregates[I]]++] = I;
+    }
+
+    // modified Gram-Schmidt orthonormalization of the modes restricted to each aggregate: Q R = B.
+    // Q, computed in place of B, is the tentative prolongator, and R is the near null space of the next level.
+    // The modes which are dependent on the aggregate (e.g. the rotation around the line of two nodes) are dropped.
+    type::vector<Real>& Q = nullSpace;
+    type::vector<Real> R(static_cast<std::size_t>(nbAggregates) * nbModes * nbModes, 0);
+    type::vector<bool> isModeKept(static_cast<std::size_t>(nbAggregates) * nbModes, false);
+    const auto dotModes = [&](sofa::Index a, sofa::Index j, sofa::Index k)
+    {
+        Real d = 0;
+        for (sofa::Index n = aggregateBegin[a]; n < aggregateBegin[a + 1]; ++n)
+        {
+            for (sofa::Index i = aggregateNodes[n] * blockSize; i < (aggregateNodes[n] + 1) * blockSize; ++i)
+            {
+                d += Q[i * nbModes + j] * Q[i * nbModes + k];
+            }
+        }
+        return d;
+    };
+    const auto updateMode = [&](sofa::Index a, sofa::Index k, Real scale, sofa::Index j, Real factor)
+    {
+        for (sofa::Index n = aggregateBegin[a]; n < aggregateBegin[a + 1]; ++n)
+        {
+            for (sofa::Index i = aggregateNodes[n] * blockSize; i < (aggregateNodes[n] + 1) * blockSize; ++i)
+            {
+                Q[i * nbModes + k] = scale * (Q[i * nbModes + k] - factor * Q[i * nbModes + j]);
+            }
+        }
+    };
+
+    for (sofa::Index a = 0; a < nbAggregates; ++a)
+    {
+        Real* Ra = &R[static_cast<std::size_t>(a) * nbModes * nbModes];
+        for (sofa::Index k = 0; k < nbModes; ++k)
+        {
+            const Real initialNorm = std::sqrt(dotModes(a, k, k));
+            for (sofa::Index j = 0; j < k; ++j)
+            {
+                if (isModeKept[a * nbModes + j])
+                {
+                    Ra[j * nbModes + k] = dotModes(a, j, k);
+                    updateMode(a, k, 1, j, Ra[j * nbModes + k]);
+                }
+            }
+
+            const Real norm = std::sqrt(dotModes(a, k, k));
+            isModeKept[a * nbModes + k] = initialNorm > 0 && norm > tolerance * initialNorm;
+            Ra[k * nbModes + k] = isModeKept[a * nbModes + k] ? norm : 0;
+            updateMode(a, k, isModeKept[a * nbModes + k] ? 1 / norm : 0, k, 0);
+        }
+    }
+
+    auto& T = fine.T;
+    T.nbRows = fine.A.nbRows;
+    T.nbCols = nbAggregates * nbModes;
+    T.rowBegin.resize(T.nbRows + 1);
+    T.colsIndex.clear();
+    T.values.clear();
+    T.rowBegin[0] = 0;
+    for (sofa::Index i = 0; i < T.nbRows; ++i)
+    {
+        const sofa::Index a = aggregates[i / blockSize];
+        for (sofa::Index k = 0; k < nbModes; ++k)
+        {
+            if (isModeKept[a * nbModes + k])
+            {
+                T.colsIndex.push_back(a * nbModes + k);
+                T.values.push_back(Q[i * nbModes + k]);
+            }
+        }
+        T.rowBegin[i + 1] = static_cast<sofa::Index>(T.colsIndex.size());
+    }
+
+    nullSpace = std::move(R);
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+void AMGPreconditioner<TMatrix,TVector,TThreadManager>::computeHierarchy(AMGInvertData* data)
+{
+    for (std::size_t l = 0; l < data->levels.size(); ++l)
+    {
+        prepareLevel(data->levels[l]);
+        if (l + 1 < data->levels.size())
+        {
+            computeLevel(data->levels[l], data->levels[l + 1]);
+        }
+    }
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+void AMGPreconditioner<TMatrix,TVector,TThreadManager>::prepareLevel(Level& level)
+{
+    const sofa::Index n = level.A.nbRows;
+    level.x.resize(n);
+    level.b.resize(n);
+    level.r.resize(n);
+    level.invDiag.resize(n);
+    for (sofa::Index i = 0; i < n; ++i)
+    {
+        const Real d = level.A.diagonal(i);
+        level.invDiag[i] = (d != 0) ? 1 / d : 0;
+    }
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+void AMGPreconditioner<TMatrix,TVector,TThreadManager>::computeLevel(Level& fine, Level& coarse)
+{
+    constexpr sofa::Index none = std::numeric_limits<sofa::Index>::max();
+
+    // P = (I - omega D^-1 A) T, with omega = 4 / (3 rho(D^-1 A))
+    const Real omega = 4 / (3 * estimateSpectralRadius(fine));
+    auto& P = fine.P;
+    multiplyNumeric(fine.A, fine.T, P, m_position);
+    for (sofa::Index i = 0; i < P.nbRows; ++i)
+    {
+        const Real f = -omega * fine.invDiag[i];
+        for (sofa::Index p = P.rowBegin[i]; p < P.rowBegin[i + 1]; ++p)
+        {
+            P.values[p] *= f;
+        }
+        for (sofa::Index q = fine.T.rowBegin[i]; q < fine.T.rowBegin[i + 1]; ++q)
+        {
+            if (fine.P_tentativePosition[q] != none)
+            {
+                P.values[fine.P_tentativePosition[q]] += fine.T.values[q];
+            }
+        }
+    }
+
+    // Galerkin product R A P
+    transposeNumeric(P, fine.R, fine.R_map);
+    multiplyNumeric(fine.A, P, fine.AP, m_position);
+    multiplyNumeric(fine.R, fine.AP, coarse.A, m_position);
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+auto AMGPreconditioner<TMatrix,TVector,TThreadManager>::estimateSpectralRadius(Level& level) -> Real
+{
+    static constexpr unsigned int nbIterations = 15;
+    const sofa::Index n = level.A.nbRows;
+    auto& x = level.x;
+    auto& y = level.r;
+
+    // arbitrary initial vector, with components on all the eigenvectors
+    for (sofa::Index i = 0; i < n; ++i)
+    {
+        x[i] = static_cast<Real>((i * 7919) % 101) / 101 - 0.5;
+    }
+
+    Real rho = 0;
+    for (unsigned int it = 0; it < nbIterations; ++it)
+    {
+        Real norm = 0;
+        for (sofa::Index i = 0; i < n; ++i)
+        {
+            norm += x[i] * x[i];
+        }
+        norm = std::sqrt(norm);
+        if (norm == 0)
+        {
+            break;
+        }
+        for (sofa::Index i = 0; i < n; ++i)
+        {
+            x[i] /= norm;
+        }
+
+        level.A.multiply(x, y);
+        rho = 0;
+        for (sofa::Index i = 0; i < n; ++i)
+        {
+            y[i] *= level.invDiag[i];
+            rho += y[i] * y[i];
+        }
+        rho = std::sqrt(rho);
+        std::swap(x, y);
+    }
+    return (rho > 0) ? rho : 1;
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+sofa::Index AMGPreconditioner<TMatrix,TVector,TThreadManager>::aggregate(
+    const ScalarCRSMatrix<Real>& A, sofa::Index blockSize, type::vector<sofa::Index>& aggregates)
+{
+    constexpr sofa::Index none = std::numeric_limits<sofa::Index>::max();
+    const sofa::Index nbNodes = A.nbRows / blockSize;
+    const Real theta = d_strengthThreshold.getValue();
+
+    // Frobenius norms of the blocks coupling the nodes
+    type::vector<Real> diagonalNorm(nbNodes, 0), coupling(nbNodes, 0);
+    type::vector<sofa::Index> neighbors;
+    type::vector<sofa::Index> strongBegin(nbNodes + 1, 0), strongNeighbors;
+    m_marker.assign(nbNodes, none);
+
+    for (sofa::Index i = 0; i < A.nbRows; ++i)
+    {
+        for (sofa::Index p = A.rowBegin[i]; p < A.rowBegin[i + 1]; ++p)
+        {
+            if (A.colsIndex[p] / blockSize == i / blockSize)
+            {
+                diagonalNorm[i / blockSize] += A.values[p] * A.values[p];
+            }
+        }
+    }
+
+    for (sofa::Index I = 0; I < nbNodes; ++I)
+    {
+        neighbors.clear();
+        for (sofa::Index i = I * blockSize; i < (I + 1) * blockSize; ++i)
+        {
+            for (sofa::Index p = A.rowBegin[i]; p < A.rowBegin[i + 1]; ++p)
+            {
+                const sofa::Index J = A.colsIndex[p] / blockSize;
+                if (J == I)
+                {
+                    continue;
+                }
+                if (m_marker[J] != I)
+                {
+                    m_marker[J] = I;
+                    coupling[J] = 0;
+                    neighbors.push_back(J);
+                }
+                coupling[J] += A.values[p] * A.values[p];
+            }
+        }
+        for (const sofa::Index J : neighbors)
+        {
+            // the norms are squared
+            if (coupling[J] > theta * theta * std::sqrt(diagonalNorm[I] * diagonalNorm[J]))
+            {
+                strongNeighbors.push_back(J);
+            }
+        }
+        strongBegin[I + 1] = static_cast<sofa::Index>(strongNeighbors.size());
+    }
+
+    aggregates.assign(nbNodes, none);
+    sofa::Index nbAggregates = 0;
+
+    // 1. a node and all its strong neighbors form an aggregate, if none of them is aggregated yet
+    for (sofa::Index I = 0; I < nbNodes; ++I)
+    {
+        if (aggregates[I] != none)
+        {
+            continue;
+        }
+        const auto first = strongNeighbors.begin() + strongBegin[I];
+        const auto last = strongNeighbors.begin() + strongBegin[I + 1];
+        if (std::all_of(first, last, [&aggregates](sofa::Index J) { return aggregates[J] == none; }))
+        {
+            aggregates[I] = nbAggregates;
+            std::for_each(first, last, [&aggregates, nbAggregates](sofa::Index J) { aggregates[J] = nbAggregates; });
+            ++nbAggregates;
+        }
+    }
+
+    // 2. the remaining nodes join the aggregate of one of their strong neighbors
+    const type::vector<sofa::Index> firstAggregates = aggregates;
+    for (sofa::Index I = 0; I < nbNodes; ++I)
+    {
+        if (aggregates[I] != none)
+        {
+            continue;
+        }
+        for (sofa::Index p = strongBegin[I]; p < strongBegin[I + 1]; ++p)
+        {
+            if (firstAggregates[strongNeighbors[p]] != none)
+            {
+                aggregates[I] = firstAggregates[strongNeighbors[p]];
+                break;
+            }
+        }
+    }
+
+    // 3. the nodes without aggregated neighbors form new aggregates with their remaining strong neighbors
+    for (sofa::Index I = 0; I < nbNodes; ++I)
+    {
+        if (aggregates[I] != none)
+        {
+            continue;
+        }
+        aggregates[I] = nbAggregates;
+        for (sofa::Index p = strongBegin[I]; p < strongBegin[I + 1]; ++p)
+        {
+            if (aggregates[strongNeighbors[p]] == none)
+            {
+                aggregates[strongNeighbors[p]] = nbAggregates;
+            }
+        }
+        ++nbAggregates;
+    }
+
+    return nbAggregates;
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+void AMGPreconditioner<TMatrix,TVector,TThreadManager>::factorizeCoarsest(AMGInvertData* data)
+{
+    const auto& A = data->levels.back().A;
+    const sofa::Index n = A.nbRows;
+    auto& F = data->coarseFactor;
+    auto& invD = data->coarseInvD;
+
+    if (n > d_maxCoarsestSize.getValue())
+    {
+        // the coarsening stopped early: the system is solved with Gauss-Seidel iterations
+        F.clear();
+        invD.clear();
+        return;
+    }
+
+    // lower triangle of the matrix
+    F.assign(static_cast<std::size_t>(n) * n, 0);
+    for (sofa::Index i = 0; i < n; ++i)
+    {
+        for (sofa::Index p = A.rowBegin[i]; p < A.rowBegin[i + 1] && A.colsIndex[p] <= i; ++p)
+        {
+            F[i * n + A.colsIndex[p]] = A.values[p];
+        }
+    }
+
+    // L D L^T factorization. The null pivots, due to the null space of a floating object, are ignored.
+    invD.resize(n);
+    type::vector<Real>& w = data->levels.back().r;
+    for (sofa::Index j = 0; j < n; ++j)
+    {
+        Real d = F[j * n + j];
+        const Real ajj = d;
+        for (sofa::Index k = 0; k < j; ++k)
+        {
+            w[k] = F[j * n + k] * F[k * n + k];
+            d -= F[j * n + k] * w[k];
+        }
+
+        if (!(d > n * std::numeric_limits<Real>::epsilon() * std::abs(ajj)))
+        {
+            F[j * n + j] = 0;
+            invD[j] = 0;
+            for (sofa::Index i = j + 1; i < n; ++i)
+            {
+                F[i * n + j] = 0;
+            }
+            continue;
+        }
+
+        F[j * n + j] = d;
+        invD[j] = 1 / d;
+        for (sofa::Index i = j + 1; i < n; ++i)
+        {
+            Real s = F[i * n + j];
+            for (sofa::Index k = 0; k < j; ++k)
+            {
+                s -= F[i * n + k] * w[k];
+            }
+            F[i * n + j] = s / d;
+        }
+    }
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+void AMGPreconditioner<TMatrix,TVector,TThreadManager>::solveCoarsest(AMGInvertData* data)
+{
+    Level& level = data->levels.back();
+    const sofa::Index n = level.A.nbRows;
+    auto& x = level.x;
+
+    if (data->coarseInvD.size() != n)
+    {
+        std::fill(x.begin(), x.end(), 0);
+        for (unsigned int s = 0; s < std::max(d_nbSmoothingSteps.getValue(), 1u); ++s)
+        {
+            smoothForward(level);
+            smoothBackward(level);
+        }
+        return;
+    }
+
+    const auto& F = data->coarseFactor;
+    const auto& invD = data->coarseInvD;
+    for (sofa::Index i = 0; i < n; ++i)
+    {
+        Real xi = level.b[i];
+        for (sofa::Index k = 0; k < i; ++k)
+        {
+            xi -= F[i * n + k] * x[k];
+        }
+        x[i] = xi;
+    }
+    for (sofa::Index i = 0; i < n; ++i)
+    {
+        x[i] *= invD[i];
+    }
+    for (sofa::Index i = n; i-- > 0;)
+    {
+        Real xi = x[i];
+        for (sofa::Index k = i + 1; k < n; ++k)
+        {
+            xi -= F[k * n + i] * x[k];
+        }
+        x[i] = xi;
+    }
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+void AMGPreconditioner<TMatrix,TVector,TThreadManager>::smoothForward(Level& level)
+{
+    const auto& A = level.A;
+    for (sofa::Index i = 0; i < A.nbRows; ++i)
+    {
+        Real s = level.b[i];
+        for (sofa::Index p = A.rowBegin[i]; p < A.rowBegin[i + 1]; ++p)
+        {
+            if (A.colsIndex[p] != i)
+            {
+                s -= A.values[p] * level.x[A.colsIndex[p]];
+            }
+        }
+        level.x[i] = s * level.invDiag[i];
+    }
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+void AMGPreconditioner<TMatrix,TVector,TThreadManager>::smoothBackward(Level& level)
+{
+    const auto& A = level.A;
+    for (sofa::Index i = A.nbRows; i-- > 0;)
+    {
+        Real s = level.b[i];
+        for (sofa::Index p = A.rowBegin[i]; p < A.rowBegin[i + 1]; ++p)
+        {
+            if (A.colsIndex[p] != i)
+            {
+                s -= A.values[p] * level.x[A.colsIndex[p]];
+            }
+        }
+        level.x[i] = s * level.invDiag[i];
+    }
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+void AMGPreconditioner<TMatrix,TVector,TThreadManager>::vcycle(AMGInvertData* data, std::size_t l)
+{
+    if (l + 1 == data->levels.size())
+    {
+        solveCoarsest(data);
+        return;
+    }
+
+    Level& level = data->levels[l];
+    Level& coarse = data->levels[l + 1];
+    const unsigned int nbSmoothingSteps = d_nbSmoothingSteps.getValue();
+
+    std::fill(level.x.begin(), level.x.end(), 0);
+    for (unsigned int s = 0; s < nbSmoothingSteps; ++s)
+    {
+        smoothForward(level);
+    }
+
+    // restriction of the residual
+    level.A.multiply(level.x, level.r);
+    for (sofa::Index i = 0; i < level.A.nbRows; ++i)
+    {
+        level.r[i] = level.b[i] - level.r[i];
+    }
+    level.R.multiply(level.r, coarse.b);
+
+    vcycle(data, l + 1);
+
+    // coarse correction
+    const auto& P = level.P;
+    for (sofa::Index i = 0; i < P.nbRows; ++i)
+    {
+        Real xi = level.x[i];
+        for (sofa::Index p = P.rowBegin[i]; p < P.rowBegin[i + 1]; ++p)
+        {
+            xi += P.values[p] * coarse.x[P.colsIndex[p]];
+        }
+        level.x[i] = xi;
+    }
+
+    for (unsigned int s = 0; s < nbSmoothingSteps; ++s)
+    {
+        smoothBackward(level);
+    }
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+void AMGPreconditioner<TMatrix,TVector,TThreadManager>::solve(Matrix& M, Vector& x, Vector& b)
+{
+    auto* data = static_cast<AMGInvertData*>(this->getMatrixInvertData(&M));
+    if (data->levels.empty())
+    {
+        return;
+    }
+
+    Level& fine = data->levels.front();
+    const sofa::Index n = fine.A.nbRows;
+    for (sofa::Index i = 0; i < n; ++i)
+    {
+        fine.b[i] = b[i];
+    }
+    vcycle(data, 0);
+    for (sofa::Index i = 0; i < n; ++i)
+    {
+        x[i] = fine.x[i];
+    }
+}
+
+} // namespace sofa::component::linearsolver::preconditioner
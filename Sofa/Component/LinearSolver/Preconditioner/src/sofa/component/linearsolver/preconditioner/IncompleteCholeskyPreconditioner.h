@@ -0,0 +1,122 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/linearsolver/preconditioner/config.h>
+
+#include <sofa/component/linearsolver/iterative/MatrixLinearSolver.h>
+#include <sofa/component/linearsolver/preconditioner/ScalarCRSMatrix.h>
+#include <sofa/linearalgebra/CompressedRowSparseMatrix.h>
+#include <sofa/linearalgebra/FullVector.h>
+#include <sofa/helper/OptionsGroup.h>
+
+namespace sofa::component::linearsolver::preconditioner
+{
+
+/// Preconditioner based on an incomplete Cholesky factorization L D L^T of the system matrix, L being unit lower
+/// triangular:
+/// - IC0: L has the pattern of the lower triangle of the matrix, the other fill-in entries are dropped,
+/// - ICT: the fill-in entries are dropped if they are small compared to the norm of the column of the matrix
+///   (dropTolerance), and each column of L keeps at most fillFactor times the number of entries of the column of the
+///   matrix, the largest ones.
+/// The pattern of the factor is computed when the pattern of the matrix changes. While it does not change, the next
+/// factorizations only recompute the values on this pattern.
+/// If the factorization breaks down (non-positive pivot), it is computed again with a shifted diagonal.
+template<class TMatrix, class TVector, class TThreadManager = NoThreadManager>
+class IncompleteCholeskyPreconditioner : public sofa::component::linearsolver::MatrixLinearSolver<TMatrix,TVector,TThreadManager>
+{
+public:
+    SOFA_CLASS(SOFA_TEMPLATE3(IncompleteCholeskyPreconditioner,TMatrix,TVector,TThreadManager),SOFA_TEMPLATE3(sofa::component::linearsolver::MatrixLinearSolver,TMatrix,TVector,TThreadManager));
+
+    typedef TMatrix Matrix;
+    typedef TVector Vector;
+    typedef TThreadManager ThreadManager;
+    typedef SReal Real;
+    typedef sofa::component::linearsolver::MatrixLinearSolver<TMatrix,TVector,TThreadManager> Inherit;
+
+    Data<sofa::helper::OptionsGroup> d_method; ///< Dropping strategy of the fill-in entries
+    Data<SReal> d_dropTolerance; ///< ICT: fill-in entries smaller than this tolerance times the norm of the column of the matrix are dropped
+    Data<SReal> d_fillFactor; ///< ICT: maximum ratio between the number of entries of a column of the factor and of the matrix
+
+protected:
+    IncompleteCholeskyPreconditioner();
+
+public:
+    void solve (Matrix& M, Vector& x, Vector& b) override;
+    void invert(Matrix& M) override;
+
+    class IncompleteCholeskyInvertData : public MatrixInvertData
+    {
+    public :
+        ScalarCRSMatrix<Real> A; ///< scalar copy of the system matrix
+
+        /// Unit lower triangular factor, stored by columns without its diagonal, and inverse of the diagonal
+        type::vector<sofa::Index> L_colptr, L_rowind;
+        type::vector<Real> L_values, invD;
+
+        /// Method used to compute the pattern of L, -1 if it must be computed again
+        int patternMethod { -1 };
+
+        std::size_t getMemoryFootprint() const override
+        {
+            return A.getMemoryFootprint() + (L_colptr.capacity() + L_rowind.capacity()) * sizeof(sofa::Index)
+                + (L_values.capacity() + invD.capacity()) * sizeof(Real);
+        }
+    };
+
+    MatrixInvertData * createInvertData() override
+    {
+        return new IncompleteCholeskyInvertData();
+    }
+
+protected:
+    bool isThresholdMethod() const;
+
+    /// Factorization on the pattern of L stored in data. Returns false if it breaks down.
+    bool factorizeOnPattern(IncompleteCholeskyInvertData* data, Real shift);
+
+    /// Factorization computing the pattern of L by dropping the small fill-in entries. Returns false if it breaks down.
+    bool factorizeWithThreshold(IncompleteCholeskyInvertData* data, Real shift);
+
+    /// Compute the updates of the column j from the previous columns k of L such that L(j,k) != 0.
+    /// add(i, value) is called for each value to subtract from the row i. Returns the value to subtract from the diagonal.
+    template<class AddUpdate>
+    Real updateColumn(IncompleteCholeskyInvertData* data, sofa::Index j, const AddUpdate& add);
+
+    /// Insert the column j of L in the linked list of the row of its first entry
+    void linkColumn(IncompleteCholeskyInvertData* data, sofa::Index j);
+
+    /// Linked lists of the columns k of L to apply on a column j: the first column of the list of j is m_head[j],
+    /// and the next one of the column k is m_link[k]. m_next[k] is the position, in the column k, of the entry of
+    /// the next row to update.
+    type::vector<sofa::Index> m_head, m_link, m_next;
+
+    type::vector<Real> m_work; ///< dense column being computed
+    type::vector<sofa::Index> m_position; ///< position in L of the entries of the column being computed
+    type::vector<sofa::Index> m_pattern; ///< rows of the column being computed
+};
+
+#if !defined(SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_INCOMPLETECHOLESKYPRECONDITIONER_CPP)
+extern template class SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_API IncompleteCholeskyPreconditioner< linearalgebra::CompressedRowSparseMatrix<SReal>, linearalgebra::FullVector<SReal> >;
+extern template class SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_API IncompleteCholeskyPreconditioner< linearalgebra::CompressedRowSparseMatrix< type::Mat<3, 3, SReal> >, linearalgebra::FullVector<SReal> >;
+#endif // !defined(SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_INCOMPLETECHOLESKYPRECONDITIONER_CPP)
+
+} // namespace sofa::component::linearsolver::preconditioner
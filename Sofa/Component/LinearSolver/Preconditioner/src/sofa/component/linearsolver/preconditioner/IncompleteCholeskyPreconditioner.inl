@@ -0,0 +1,409 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/linearsolver/preconditioner/IncompleteCholeskyPreconditioner.h>
+#include <sofa/helper/ScopedAdvancedTimer.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace sofa::component::linearsolver::preconditioner
+{
+
+template<class TMatrix, class TVector, class TThreadManager>
+IncompleteCholeskyPreconditioner<TMatrix,TVector,TThreadManager>::IncompleteCholeskyPreconditioner()
+    : d_method(initData(&d_method, sofa::helper::OptionsGroup{{"IC0", "ICT"}}, "method",
+        "Dropping strategy of the fill-in entries:\n"
+        "-IC0: the factor has the pattern of the lower triangle of the matrix\n"
+        "-ICT: the fill-in entries are dropped if they are smaller than dropTolerance times the norm of the column of the matrix, "
+        "and each column of the factor keeps at most fillFactor times the number of entries of the column of the matrix"))
+    , d_dropTolerance(initData(&d_dropTolerance, 1e-3_sreal, "dropTolerance", "ICT: fill-in entries smaller than this tolerance times the norm of the column of the matrix are dropped"))
+    , d_fillFactor(initData(&d_fillFactor, 2_sreal, "fillFactor", "ICT: maximum ratio between the number of entries of a column of the factor and of the lower triangle of the matrix"))
+{
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+bool IncompleteCholeskyPreconditioner<TMatrix,TVector,TThreadManager>::isThresholdMethod() const
+{
+    return d_method.getValue().getSelectedId() == 1;
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+void IncompleteCholeskyPreconditioner<TMatrix,TVector,TThreadManager>::invert(Matrix& M)
+{
+    sofa::helper::ScopedAdvancedTimer factorizationTimer("IncompleteCholesky");
+
+    auto* data = static_cast<IncompleteCholeskyInvertData*>(this->getMatrixInvertData(&M));
+    const int method = static_cast<int>(d_method.getValue().getSelectedId());
+
+    M.compress();
+    const bool patternChanged = data->A.copyFrom(M);
+    const auto& A = data->A;
+    const sofa::Index n = A.nbRows;
+
+    if (patternChanged || data->patternMethod != method)
+    {
+        data->patternMethod = -1;
+        if (!isThresholdMethod())
+        {
+            // the pattern of L is the strict lower triangle of the matrix, i.e. the strict upper triangle of its rows
+            data->L_colptr.resize(n + 1);
+            data->L_colptr[0] = 0;
+            data->L_rowind.clear();
+            for (sofa::Index j = 0; j < n; ++j)
+            {
+                for (sofa::Index q = A.rowBegin[j]; q < A.rowBegin[j + 1]; ++q)
+                {
+                    if (A.colsIndex[q] > j)
+                    {
+                        data->L_rowind.push_back(A.colsIndex[q]);
+                    }
+                }
+                data->L_colptr[j + 1] = static_cast<sofa::Index>(data->L_rowind.size());
+            }
+            data->L_values.resize(data->L_rowind.size());
+            data->patternMethod = method;
+        }
+    }
+
+    static constexpr unsigned int maxNbAttempts = 20;
+    Real shift = 0;
+    bool success = false;
+    for (unsigned int attempt = 0; attempt < maxNbAttempts && !success; ++attempt)
+    {
+        if (attempt > 0)
+        {
+            shift = (shift == 0) ? 1e-3 : 2 * shift;
+        }
+        success = (data->patternMethod == -1) ? factorizeWithThreshold(data, shift) : factorizeOnPattern(data, shift);
+    }
+
+    if (success)
+    {
+        data->patternMethod = method;
+        msg_info_when(shift > 0) << "The incomplete factorization broke down: it has been computed with the diagonal scaled by " << 1 + shift;
+    }
+    else
+    {
+        msg_error() << "The incomplete factorization broke down: the preconditioner is replaced by a Jacobi preconditioner";
+        data->L_colptr.assign(n + 1, 0);
+        data->L_rowind.clear();
+        data->L_values.clear();
+        data->invD.resize(n);
+        for (sofa::Index i = 0; i < n; ++i)
+        {
+            const Real d = A.diagonal(i);
+            data->invD[i] = (d != 0) ? 1 / std::abs(d) : 1;
+        }
+        data->patternMethod = -1;
+    }
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+template<class AddUpdate>
+auto IncompleteCholeskyPreconditioner<TMatrix,TVector,TThreadManager>::updateColumn(
+    IncompleteCholeskyInvertData* data, sofa::Index j, const AddUpdate& add) -> Real
+{
+    constexpr sofa::Index none = std::numeric_limits<sofa::Index>::max();
+    const sofa::Index* colptr = data->L_colptr.data();
+    const sofa::Index* rowind = data->L_rowind.data();
+    const Real* values = data->L_values.data();
+    const Real* D = data->invD.data(); // the diagonal is inverted at the end of the factorization
+
+    Real diagonalUpdate = 0;
+    sofa::Index k = m_head[j];
+    m_head[j] = none;
+    while (k != none)
+    {
+        const sofa::Index nextColumn = m_link[k];
+        const sofa::Index p = m_next[k];
+        const Real f = values[p] * D[k];
+        diagonalUpdate += values[p] * f;
+
+        const sofa::Index end = colptr[k + 1];
+        for (sofa::Index q = p + 1; q < end; ++q)
+        {
+            add(rowind[q], values[q] * f);
+        }
+
+        // the column k is now applied to the row of its next entry
+        m_next[k] = p + 1;
+        if (p + 1 < end)
+        {
+            const sofa::Index r = rowind[p + 1];
+            m_link[k] = m_head[r];
+            m_head[r] = k;
+        }
+        k = nextColumn;
+    }
+    return diagonalUpdate;
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+void IncompleteCholeskyPreconditioner<TMatrix,TVector,TThreadManager>::linkColumn(
+    IncompleteCholeskyInvertData* data, sofa::Index j)
+{
+    const sofa::Index begin = data->L_colptr[j];
+    m_next[j] = begin;
+    if (begin < data->L_colptr[j + 1])
+    {
+        const sofa::Index r = data->L_rowind[begin];
+        m_link[j] = m_head[r];
+        m_head[r] = j;
+    }
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+bool IncompleteCholeskyPreconditioner<TMatrix,TVector,TThreadManager>::factorizeOnPattern(
+    IncompleteCholeskyInvertData* data, Real shift)
+{
+    constexpr sofa::Index none = std::numeric_limits<sofa::Index>::max();
+    const auto& A = data->A;
+    const sofa::Index n = A.nbRows;
+
+    m_head.assign(n, none);
+    m_link.resize(n);
+    m_next.resize(n);
+    m_position.assign(n, none);
+    data->invD.resize(n);
+
+    const sofa::Index* colptr = data->L_colptr.data();
+    const sofa::Index* rowind = data->L_rowind.data();
+    Real* values = data->L_values.data();
+    Real* D = data->invD.data();
+
+    for (sofa::Index j = 0; j < n; ++j)
+    {
+        for (sofa::Index p = colptr[j]; p < colptr[j + 1]; ++p)
+        {
+            m_position[rowind[p]] = p;
+            values[p] = 0;
+        }
+
+        // column j of the matrix, restricted to the pattern of L
+        Real d = 0;
+        for (sofa::Index q = A.rowBegin[j]; q < A.rowBegin[j + 1]; ++q)
+        {
+            const sofa::Index i = A.colsIndex[q];
+            if (i == j)
+            {
+                d += A.values[q] * (1 + shift);
+            }
+            else if (i > j && m_position[i] != none)
+            {
+                values[m_position[i]] += A.values[q];
+            }
+        }
+        const Real ajj = d;
+
+        d -= updateColumn(data, j, [this, values](sofa::Index i, Real update)
+        {
+            const sofa::Index p = m_position[i];
+            if (p != none)
+            {
+                values[p] -= update;
+            }
+        });
+
+        for (sofa::Index p = colptr[j]; p < colptr[j + 1]; ++p)
+        {
+            m_position[rowind[p]] = none;
+        }
+
+        if (!(d > std::numeric_limits<Real>::epsilon() * ajj))
+        {
+            return false;
+        }
+
+        D[j] = d;
+        for (sofa::Index p = colptr[j]; p < colptr[j + 1]; ++p)
+        {
+            values[p] /= d;
+        }
+        linkColumn(data, j);
+    }
+
+    for (sofa::Index j = 0; j < n; ++j)
+    {
+        D[j] = 1 / D[j];
+    }
+    return true;
+}
+
+template<class TMatrix, class TVector, class TThreadManager>
+bool IncompleteCholeskyPreconditioner<TMatrix,TVector,TThreadManager>::factorizeWithThreshold(
+    IncompleteCholeskyInvertData* data, Real shift)
+{
+    constexpr sofa::Index none = std::numeric_limits<sofa::Index>::max();
+    const auto& A = data->A;
+    const sofa::Index n = A.nbRows;
+    const Real dropTolerance = d_dropTolerance.getValue();
+    const Real fillFactor = d_fillFactor.getValue();
+
+    m_head.assign(n, none);
+    m_link.resize(n);
+    m_next.resize(n);
+    m_position.assign(n, none); // used as a marker of the rows of the column being computed
+    m_work.assign(n, 0);
+    data->invD.resize(n);
+    data->L_colptr.resize(n + 1);
+    data->L_colptr[0] = 0;
+    data->L_rowind.clear();
+    data->L_values.clear();
+
+    const auto addRow = [this](sofa::Index i)
+    {
+        if (m_position[i] == none)
+        {
+            m_position[i] = 0;
+            m_pattern.push_back(i);
+        }
+    };
+    const auto clearRow = [this](sofa::Index i)
+    {
+        m_work[i] = 0;
+        m_position[i] = none;
+    };
+
+    for (sofa::Index j = 0; j < n; ++j)
+    {
+        m_pattern.clear();
+
+        // column j of the matrix
+        Real d = 0;
+        Real norm = 0;
+        std::size_t nbEntries = 0;
+        for (sofa::Index q = A.rowBegin[j]; q < A.rowBegin[j + 1]; ++q)
+        {
+            const sofa::Index i = A.colsIndex[q];
+            const Real a = A.values[q];
+            if (i == j)
+            {
+                d += a * (1 + shift);
+            }
+            else if (i > j)
+            {
+                addRow(i);
+                m_work[i] += a;
+                norm += a * a;
+                ++nbEntries;
+            }
+        }
+        const Real ajj = d;
+
+        d -= updateColumn(data, j, [this, &addRow](sofa::Index i, Real update)
+        {
+            addRow(i);
+            m_work[i] -= update;
+        });
+
+        if (!(d > std::numeric_limits<Real>::epsilon() * ajj))
+        {
+            std::for_each(m_pattern.begin(), m_pattern.end(), clearRow);
+            return false;
+        }
+        data->invD[j] = d;
+
+        // drop the small entries, and keep the largest ones
+        const Real threshold = dropTolerance * std::sqrt(norm);
+        m_pattern.erase(std::remove_if(m_pattern.begin(), m_pattern.end(), [this, threshold, &clearRow](sofa::Index i)
+        {
+            if (std::abs(m_work[i]) <= threshold)
+            {
+                clearRow(i);
+                return true;
+            }
+            return false;
+        }), m_pattern.end());
+
+        const auto maxNbEntries = static_cast<std::size_t>(std::ceil(fillFactor * static_cast<Real>(nbEntries)));
+        if (m_pattern.size() > maxNbEntries)
+        {
+            std::nth_element(m_pattern.begin(), m_pattern.begin() + maxNbEntries, m_pattern.end(), [this](sofa::Index a, sofa::Index b)
+            {
+                return std::abs(m_work[a]) > std::abs(m_work[b]);
+            });
+            std::for_each(m_pattern.begin() + maxNbEntries, m_pattern.end(), clearRow);
+            m_pattern.resize(maxNbEntries);
+        }
+        std::sort(m_pattern.begin(), m_pattern.end());
+
+        for (const sofa::Index i : m_pattern)
+        {
+            data->L_rowind.push_back(i);
+            data->L_values.push_back(m_work[i] / d);
+            clearRow(i);
+        }
+        data->L_colptr[j + 1] = static_cast<sofa::Index>(data->L_rowind.size());
+        linkColumn(data, j);
+    }
+
+    for (sofa::Index j = 0; j < n; ++j)
+    {
+        data->invD[j] = 1 / data->invD[j];
+    }
+    return true;
+}
+
+// solve L D L^T x = b
+template<class TMatrix, class TVector, class TThreadManager>
+void IncompleteCholeskyPreconditioner<TMatrix,TVector,TThreadManager>::solve(Matrix& M, Vector& x, Vector& b)
+{
+    auto* data = static_cast<IncompleteCholeskyInvertData*>(this->getMatrixInvertData(&M));
+
+    const sofa::Index n = static_cast<sofa::Index>(data->invD.size());
+    const sofa::Index* colptr = data->L_colptr.data();
+    const sofa::Index* rowind = data->L_rowind.data();
+    const Real* values = data->L_values.data();
+    const Real* invD = data->invD.data();
+
+    for (sofa::Index j = 0; j < n; ++j)
+    {
+        x[j] = b[j];
+    }
+
+    // solve L y = b
+    for (sofa::Index j = 0; j < n; ++j)
+    {
+        const Real xj = x[j];
+        if (xj != 0)
+        {
+            for (sofa::Index p = colptr[j]; p < colptr[j + 1]; ++p)
+            {
+                x[rowind[p]] -= values[p] * xj;
+            }
+        }
+    }
+
+    // solve D L^T x = y
+    for (sofa::Index j = n; j-- > 0;)
+    {
+        Real xj = x[j] * invD[j];
+        for (sofa::Index p = colptr[j]; p < colptr[j + 1]; ++p)
+        {
+            xj -= values[p] * x[rowind[p]];
+        }
+        x[j] = xj;
+    }
+}
+
+} // namespace sofa::component::linearsolver::preconditioner
@@ -0,0 +1,251 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/linearsolver/preconditioner/config.h>
+
+#include <sofa/type/vector.h>
+#include <algorithm>
+#include <limits>
+
+namespace sofa::component::linearsolver::preconditioner
+{
+
+/// Scalar matrix in compressed row storage, used by the preconditioners computing a factorization or a hierarchy of
+/// the system matrix.
+/// The blocks of the system matrix are expanded with all their entries, so that the pattern only depends on the block
+/// pattern, and the products of matrices are split in a symbolic phase, computed while the pattern does not change,
+/// and a numeric phase.
+template<class Real>
+class ScalarCRSMatrix
+{
+public:
+    sofa::Index nbRows { 0 };
+    sofa::Index nbCols { 0 };
+    type::vector<sofa::Index> rowBegin; ///< first entry of each row, and the number of entries at the end
+    type::vector<sofa::Index> colsIndex; ///< column of each entry, sorted in each row
+    type::vector<Real> values;
+
+    std::size_t getMemoryFootprint() const
+    {
+        return (rowBegin.capacity() + colsIndex.capacity() + sourceRowIndex.capacity() + sourceRowBegin.capacity()
+            + sourceColsIndex.capacity()) * sizeof(sofa::Index) + values.capacity() * sizeof(Real);
+    }
+
+    /// Copy a compressed row sparse matrix, with scalar or block entries.
+    /// Returns true if its pattern differs from the previous copy: the pattern is then rebuilt, otherwise only the
+    /// values are written.
+    template<class TMatrix>
+    bool copyFrom(const TMatrix& M)
+    {
+        using traits = typename TMatrix::traits;
+        constexpr sofa::Index NL = traits::NL;
+        constexpr sofa::Index NC = traits::NC;
+
+        const auto& rowIndex = M.getRowIndex();
+        const auto& blockRowBegin = M.getRowBegin();
+        const auto& blockColsIndex = M.getColsIndex();
+        const auto& blocks = M.getColsValue();
+
+        const bool patternChanged = nbRows != static_cast<sofa::Index>(M.rowSize()) || nbCols != static_cast<sofa::Index>(M.colSize())
+            || !std::equal(sourceRowIndex.begin(), sourceRowIndex.end(), rowIndex.begin(), rowIndex.end())
+            || !std::equal(sourceRowBegin.begin(), sourceRowBegin.end(), blockRowBegin.begin(), blockRowBegin.end())
+            || !std::equal(sourceColsIndex.begin(), sourceColsIndex.end(), blockColsIndex.begin(), blockColsIndex.end());
+
+        if (patternChanged)
+        {
+            nbRows = M.rowSize();
+            nbCols = M.colSize();
+            sourceRowIndex.assign(rowIndex.begin(), rowIndex.end());
+            sourceRowBegin.assign(blockRowBegin.begin(), blockRowBegin.end());
+            sourceColsIndex.assign(blockColsIndex.begin(), blockColsIndex.end());
+
+            rowBegin.assign(nbRows + 1, 0);
+            for (std::size_t rowId = 0; rowId < rowIndex.size(); ++rowId)
+            {
+                for (sofa::Index a = 0; a < NL; ++a)
+                {
+                    rowBegin[rowIndex[rowId] * NL + a + 1] = (blockRowBegin[rowId + 1] - blockRowBegin[rowId]) * NC;
+                }
+            }
+            for (sofa::Index i = 0; i < nbRows; ++i)
+            {
+                rowBegin[i + 1] += rowBegin[i];
+            }
+            colsIndex.resize(rowBegin[nbRows]);
+            values.resize(rowBegin[nbRows]);
+        }
+
+        for (std::size_t rowId = 0; rowId < rowIndex.size(); ++rowId)
+        {
+            for (sofa::Index a = 0; a < NL; ++a)
+            {
+                sofa::Index p = rowBegin[rowIndex[rowId] * NL + a];
+                for (sofa::Index xj = blockRowBegin[rowId]; xj < blockRowBegin[rowId + 1]; ++xj)
+                {
+                    for (sofa::Index b = 0; b < NC; ++b, ++p)
+                    {
+                        if (patternChanged)
+                        {
+                            colsIndex[p] = blockColsIndex[xj] * NC + b;
+                        }
+                        values[p] = static_cast<Real>(traits::v(blocks[xj], a, b));
+                    }
+                }
+            }
+        }
+
+        return patternChanged;
+    }
+
+    /// y = this * x
+    template<class InVector, class OutVector>
+    void multiply(const InVector& x, OutVector& y) const
+    {
+        for (sofa::Index i = 0; i < nbRows; ++i)
+        {
+            Real r = 0;
+            for (sofa::Index p = rowBegin[i]; p < rowBegin[i + 1]; ++p)
+            {
+                r += values[p] * x[colsIndex[p]];
+            }
+            y[i] = r;
+        }
+    }
+
+    /// Diagonal entry of the row i (0 if it is not stored)
+    Real diagonal(sofa::Index i) const
+    {
+        const auto first = colsIndex.begin() + rowBegin[i];
+        const auto last = colsIndex.begin() + rowBegin[i + 1];
+        const auto it = std::lower_bound(first, last, i);
+        return (it != last && *it == i) ? values[it - colsIndex.begin()] : Real(0);
+    }
+
+protected:
+    /// Block pattern of the copied matrix
+    type::vector<sofa::Index> sourceRowIndex, sourceRowBegin, sourceColsIndex;
+};
+
+/// Symbolic phase of the product C = A * B: computes the pattern of C, with sorted columns.
+/// marker is a workspace.
+template<class Real>
+void multiplySymbolic(const ScalarCRSMatrix<Real>& A, const ScalarCRSMatrix<Real>& B, ScalarCRSMatrix<Real>& C,
+                      type::vector<sofa::Index>& marker)
+{
+    constexpr sofa::Index none = std::numeric_limits<sofa::Index>::max();
+    marker.assign(B.nbCols, none);
+
+    C.nbRows = A.nbRows;
+    C.nbCols = B.nbCols;
+    C.rowBegin.resize(A.nbRows + 1);
+    C.colsIndex.clear();
+    C.rowBegin[0] = 0;
+    for (sofa::Index i = 0; i < A.nbRows; ++i)
+    {
+        for (sofa::Index p = A.rowBegin[i]; p < A.rowBegin[i + 1]; ++p)
+        {
+            const sofa::Index k = A.colsIndex[p];
+            for (sofa::Index q = B.rowBegin[k]; q < B.rowBegin[k + 1]; ++q)
+            {
+                const sofa::Index j = B.colsIndex[q];
+                if (marker[j] != i)
+                {
+                    marker[j] = i;
+                    C.colsIndex.push_back(j);
+                }
+            }
+        }
+        C.rowBegin[i + 1] = static_cast<sofa::Index>(C.colsIndex.size());
+        std::sort(C.colsIndex.begin() + C.rowBegin[i], C.colsIndex.end());
+    }
+    C.values.resize(C.colsIndex.size());
+}
+
+/// Numeric phase of the product C = A * B, C having the pattern computed by multiplySymbolic.
+/// position is a workspace.
+template<class Real>
+void multiplyNumeric(const ScalarCRSMatrix<Real>& A, const ScalarCRSMatrix<Real>& B, ScalarCRSMatrix<Real>& C,
+                     type::vector<sofa::Index>& position)
+{
+    position.resize(C.nbCols);
+    for (sofa::Index i = 0; i < C.nbRows; ++i)
+    {
+        for (sofa::Index p = C.rowBegin[i]; p < C.rowBegin[i + 1]; ++p)
+        {
+            position[C.colsIndex[p]] = p;
+            C.values[p] = 0;
+        }
+        for (sofa::Index p = A.rowBegin[i]; p < A.rowBegin[i + 1]; ++p)
+        {
+            const sofa::Index k = A.colsIndex[p];
+            const Real a = A.values[p];
+            for (sofa::Index q = B.rowBegin[k]; q < B.rowBegin[k + 1]; ++q)
+            {
+                C.values[position[B.colsIndex[q]]] += a * B.values[q];
+            }
+        }
+    }
+}
+
+/// Symbolic phase of the transposition At = A^T: computes the pattern of At, and the position in the values of A of
+/// each value of At.
+template<class Real>
+void transposeSymbolic(const ScalarCRSMatrix<Real>& A, ScalarCRSMatrix<Real>& At, type::vector<sofa::Index>& map)
+{
+    At.nbRows = A.nbCols;
+    At.nbCols = A.nbRows;
+    At.rowBegin.assign(A.nbCols + 1, 0);
+    for (const sofa::Index j : A.colsIndex)
+    {
+        ++At.rowBegin[j + 1];
+    }
+    for (sofa::Index j = 0; j < A.nbCols; ++j)
+    {
+        At.rowBegin[j + 1] += At.rowBegin[j];
+    }
+
+    At.colsIndex.resize(A.colsIndex.size());
+    At.values.resize(A.colsIndex.size());
+    map.resize(A.colsIndex.size());
+    type::vector<sofa::Index> next(At.rowBegin.begin(), At.rowBegin.end() - 1);
+    for (sofa::Index i = 0; i < A.nbRows; ++i)
+    {
+        for (sofa::Index p = A.rowBegin[i]; p < A.rowBegin[i + 1]; ++p)
+        {
+            const sofa::Index q = next[A.colsIndex[p]]++;
+            At.colsIndex[q] = i;
+            map[q] = p;
+        }
+    }
+}
+
+/// Numeric phase of the transposition At = A^T, from the map computed by transposeSymbolic
+template<class Real>
+void transposeNumeric(const ScalarCRSMatrix<Real>& A, ScalarCRSMatrix<Real>& At, const type::vector<sofa::Index>& map)
+{
+    for (std::size_t q = 0; q < map.size(); ++q)
+    {
+        At.values[q] = A.values[map[q]];
+    }
+}
+
+} // namespace sofa::component::linearsolver::preconditioner
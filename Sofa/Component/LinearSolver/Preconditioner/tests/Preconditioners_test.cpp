@@ -0,0 +1,497 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/testing/BaseTest.h>
+#include <sofa/component/linearsolver/preconditioner/AMGPreconditioner.h>
+#include <sofa/component/linearsolver/preconditioner/IncompleteCholeskyPreconditioner.h>
+#include <sofa/linearalgebra/CompressedRowSparseMatrix.h>
+#include <sofa/linearalgebra/FullVector.h>
+#include <sofa/simulation/Node.h>
+#include <sofa/simulation/graph/DAGSimulation.h>
+#include <sofa/simulation/graph/SimpleApi.h>
+#include <algorithm>
+#include <functional>
+#include <sstream>
+
+namespace
+{
+
+using Vector = sofa::linearalgebra::FullVector<SReal>;
+using BlockMatrix = sofa::linearalgebra::CompressedRowSparseMatrix<sofa::type::Mat<3, 3, SReal> >;
+using ScalarMatrix = sofa::linearalgebra::CompressedRowSparseMatrix<SReal>;
+
+/// Stiffness matrix of a grid of n^3 nodes linked by springs, with a small mass term. The springs of the half x > n/2
+/// are stiffer by a factor contrast.
+template<class TMatrix>
+void assembleGrid(TMatrix& matrix, sofa::Index n, SReal contrast, SReal scale = 1)
+{
+    const sofa::Index nbNodes = n * n * n;
+    matrix.resize(3 * nbNodes, 3 * nbNodes);
+
+    const auto addBlock = [&matrix, scale](sofa::Index i, sofa::Index j, sofa::Index axis, SReal k)
+    {
+        for (sofa::Index c = 0; c < 3; ++c)
+        {
+            matrix.add(3 * i + c, 3 * j + c, scale * ((c == axis) ? 2 * k : k));
+        }
+    };
+
+    for (sofa::Index z = 0; z < n; ++z)
+    {
+        for (sofa::Index y = 0; y < n; ++y)
+        {
+            for (sofa::Index x = 0; x < n; ++x)
+            {
+                const sofa::Index i = x + n * (y + n * z);
+                const sofa::Index position[3] { x, y, z };
+                const sofa::Index stride[3] { 1, n, n * n };
+                const SReal k = (x > n / 2) ? contrast : 1;
+                for (sofa::Index axis = 0; axis < 3; ++axis)
+                {
+                    if (position[axis] + 1 < n)
+                    {
+                        const sofa::Index j = i + stride[axis];
+                        addBlock(i, i, axis, k);
+                        addBlock(j, j, axis, k);
+                        addBlock(i, j, axis, -k);
+                        addBlock(j, i, axis, -k);
+                    }
+                }
+                for (sofa::Index c = 0; c < 3; ++c)
+                {
+                    matrix.add(3 * i + c, 3 * i + c, scale * 1e-2);
+                }
+            }
+        }
+    }
+    matrix.compress();
+}
+
+/// Stiffness matrix of a grid of n^3 nodes of unit spacing, linked by axial springs along the edges and the diagonals
+/// of the faces of the cells, with a small mass term: its near null space is made of the rigid body modes.
+/// The rest positions of the nodes are written in positions.
+void assembleElasticGrid(BlockMatrix& matrix, sofa::Index n, std::string& positions)
+{
+    const sofa::Index nbNodes = n * n * n;
+    matrix.resize(3 * nbNodes, 3 * nbNodes);
+
+    const auto nodeIndex = [n](sofa::Index x, sofa::Index y, sofa::Index z) { return x + n * (y + n * z); };
+    const int directions[9][3] { {1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {1, 1, 0}, {1, -1, 0}, {1, 0, 1}, {1, 0, -1},
+                                 {0, 1, 1}, {0, 1, -1} };
+
+    std::stringstream positionStream;
+    for (sofa::Index z = 0; z < n; ++z)
+    {
+        for (sofa::Index y = 0; y < n; ++y)
+        {
+            for (sofa::Index x = 0; x < n; ++x)
+            {
+                positionStream << x << " " << y << " " << z << " ";
+                const sofa::Index i = nodeIndex(x, y, z);
+                for (const auto& d : directions)
+                {
+                    const int neighbor[3] { int(x) + d[0], int(y) + d[1], int(z) + d[2] };
+                    if (std::any_of(neighbor, neighbor + 3, [n](int c) { return c < 0 || c >= int(n); }))
+                    {
+                        continue;
+                    }
+                    const sofa::Index j = nodeIndex(neighbor[0], neighbor[1], neighbor[2]);
+                    const SReal invLength2 = 1 / static_cast<SReal>(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+                    for (sofa::Index a = 0; a < 3; ++a)
+                    {
+                        for (sofa::Index b = 0; b < 3; ++b)
+                        {
+                            const SReal k = d[a] * d[b] * invLength2;
+                            matrix.add(3 * i + a, 3 * i + b, k);
+                            matrix.add(3 * j + a, 3 * j + b, k);
+                            matrix.add(3 * i + a, 3 * j + b, -k);
+                            matrix.add(3 * j + a, 3 * i + b, -k);
+                        }
+                    }
+                }
+                for (sofa::Index c = 0; c < 3; ++c)
+                {
+                    matrix.add(3 * i + c, 3 * i + c, 1e-4);
+                }
+            }
+        }
+    }
+    matrix.compress();
+    positions = positionStream.str();
+}
+
+void fillVector(Vector& v, sofa::Index n, unsigned int seed)
+{
+    v.resize(n);
+    for (sofa::Index i = 0; i < n; ++i)
+    {
+        v[i] = static_cast<SReal>((i * 7919 + seed * 104729) % 1013) / 1013 - 0.5;
+    }
+}
+
+SReal dot(const Vector& a, const Vector& b)
+{
+    SReal r = 0;
+    for (Vector::Index i = 0; i < a.size(); ++i)
+    {
+        r += a[i] * b[i];
+    }
+    return r;
+}
+
+/// Preconditioned conjugate gradient. Returns the number of iterations to reduce the residual by the tolerance.
+template<class TMatrix>
+unsigned int pcg(const TMatrix& A, const std::function<void(Vector&, Vector&)>& precondition, const Vector& b,
+                 SReal tolerance, unsigned int maxIterations)
+{
+    const sofa::Index n = b.size();
+    Vector x(n), r(n), z(n), p(n), q(n);
+    for (sofa::Index i = 0; i < n; ++i)
+    {
+        x[i] = 0;
+        r[i] = b[i];
+    }
+    const SReal normB = std::sqrt(dot(b, b));
+
+    precondition(z, r);
+    for (sofa::Index i = 0; i < n; ++i)
+    {
+        p[i] = z[i];
+    }
+    SReal rz = dot(r, z);
+
+    for (unsigned int it = 1; it <= maxIterations; ++it)
+    {
+        A.mul(q, p);
+        const SReal alpha = rz / dot(p, q);
+        for (sofa::Index i = 0; i < n; ++i)
+        {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * q[i];
+        }
+        if (std::sqrt(dot(r, r)) <= tolerance * normB)
+        {
+            return it;
+        }
+
+        precondition(z, r);
+        const SReal rzNew = dot(r, z);
+        for (sofa::Index i = 0; i < n; ++i)
+        {
+            p[i] = z[i] + rzNew / rz * p[i];
+        }
+        rz = rzNew;
+    }
+    return maxIterations + 1;
+}
+
+template<class TPreconditioner, class TMatrix>
+unsigned int pcg(TPreconditioner* preconditioner, TMatrix& A, const Vector& b, SReal tolerance, unsigned int maxIterations)
+{
+    return pcg(A, [preconditioner, &A](Vector& z, Vector& r) { preconditioner->solve(A, z, r); }, b, tolerance, maxIterations);
+}
+
+template<class TMatrix>
+unsigned int cg(const TMatrix& A, const Vector& b, SReal tolerance, unsigned int maxIterations)
+{
+    return pcg(A, [](Vector& z, Vector& r)
+    {
+        for (Vector::Index i = 0; i < r.size(); ++i)
+        {
+            z[i] = r[i];
+        }
+    }, b, tolerance, maxIterations);
+}
+
+/// The preconditioner must be symmetric to be used with a conjugate gradient
+template<class TPreconditioner, class TMatrix>
+void checkSymmetry(TPreconditioner* preconditioner, TMatrix& A)
+{
+    Vector u, v, Mu(A.rowSize()), Mv(A.rowSize());
+    fillVector(u, A.rowSize(), 1);
+    fillVector(v, A.rowSize(), 2);
+    preconditioner->solve(A, Mu, u);
+    preconditioner->solve(A, Mv, v);
+    EXPECT_NEAR(dot(v, Mu), dot(u, Mv), 1e-10 * std::abs(dot(u, Mv)));
+    EXPECT_GT(dot(u, Mu), 0);
+}
+
+template<class TPreconditioner>
+typename TPreconditioner::SPtr createPreconditioner()
+{
+    typename TPreconditioner::SPtr preconditioner = sofa::core::objectmodel::New<TPreconditioner>();
+    preconditioner->init();
+    return preconditioner;
+}
+
+}
+
+TEST(IncompleteCholeskyPreconditioner, ExactWithoutFillIn)
+{
+    using Preconditioner = sofa::component::linearsolver::preconditioner::IncompleteCholeskyPreconditioner<ScalarMatrix, Vector>;
+
+    // tridiagonal matrix: its Cholesky factorization has no fill-in
+    constexpr sofa::Index n = 100;
+    ScalarMatrix matrix;
+    matrix.resize(n, n);
+    for (sofa::Index i = 0; i < n; ++i)
+    {
+        matrix.add(i, i, 2.5);
+        if (i + 1 < n)
+        {
+            matrix.add(i, i + 1, -1);
+            matrix.add(i + 1, i, -1);
+        }
+    }
+    matrix.compress();
+
+    const auto preconditioner = createPreconditioner<Preconditioner>();
+    preconditioner->invert(matrix);
+
+    Vector b, x(n), Ax(n);
+    fillVector(b, n, 0);
+    preconditioner->solve(matrix, x, b);
+    matrix.mul(Ax, x);
+    for (sofa::Index i = 0; i < n; ++i)
+    {
+        EXPECT_NEAR(Ax[i], b[i], 1e-12);
+    }
+}
+
+TEST(IncompleteCholeskyPreconditioner, ReducesIterations)
+{
+    using Preconditioner = sofa::component::linearsolver::preconditioner::IncompleteCholeskyPreconditioner<BlockMatrix, Vector>;
+
+    BlockMatrix matrix;
+    assembleGrid(matrix, 6, 1e4);
+    Vector b;
+    fillVector(b, matrix.rowSize(), 0);
+
+    const unsigned int nbIterationsCG = cg(matrix, b, 1e-8, 5000);
+
+    const auto ic0 = createPreconditioner<Preconditioner>();
+    ic0->invert(matrix);
+    checkSymmetry(ic0.get(), matrix);
+    const unsigned int nbIterationsIC0 = pcg(ic0.get(), matrix, b, 1e-8, 5000);
+    EXPECT_LT(nbIterationsIC0, nbIterationsCG / 2);
+
+    const auto ict = createPreconditioner<Preconditioner>();
+    sofa::helper::getWriteAccessor(ict->d_method)->setSelectedItem(1);
+    ict->invert(matrix);
+    checkSymmetry(ict.get(), matrix);
+    const unsigned int nbIterationsICT = pcg(ict.get(), matrix, b, 1e-8, 5000);
+    EXPECT_LE(nbIterationsICT, nbIterationsIC0);
+
+    // without dropping, the factorization is exact
+    const auto complete = createPreconditioner<Preconditioner>();
+    sofa::helper::getWriteAccessor(complete->d_method)->setSelectedItem(1);
+    complete->d_dropTolerance.setValue(0);
+    complete->d_fillFactor.setValue(1e6);
+    complete->invert(matrix);
+    EXPECT_LE(pcg(complete.get(), matrix, b, 1e-8, 5000), 2u);
+}
+
+TEST(IncompleteCholeskyPreconditioner, ReuseFactorizationPattern)
+{
+    using Preconditioner = sofa::component::linearsolver::preconditioner::IncompleteCholeskyPreconditioner<BlockMatrix, Vector>;
+
+    BlockMatrix matrix;
+    assembleGrid(matrix, 4, 10);
+
+    for (const int method : {0, 1})
+    {
+        const auto preconditioner = createPreconditioner<Preconditioner>();
+        sofa::helper::getWriteAccessor(preconditioner->d_method)->setSelectedItem(method);
+        preconditioner->invert(matrix);
+
+        auto* data = static_cast<Preconditioner::IncompleteCholeskyInvertData*>(preconditioner->getMatrixInvertData(&matrix));
+        const auto rowind = data->L_rowind;
+        EXPECT_EQ(data->patternMethod, method);
+
+        // same pattern, other values: the pattern of the factor is kept
+        assembleGrid(matrix, 4, 1e3);
+        preconditioner->invert(matrix);
+        EXPECT_EQ(data->patternMethod, method);
+        EXPECT_EQ(data->L_rowind, rowind);
+
+        // IC0: the factorization on the kept pattern gives the factorization from scratch
+        if (method == 0)
+        {
+            const auto fromScratch = createPreconditioner<Preconditioner>();
+            fromScratch->invert(matrix);
+            Vector b, x(matrix.rowSize()), expected(matrix.rowSize());
+            fillVector(b, matrix.rowSize(), 0);
+            preconditioner->solve(matrix, x, b);
+            fromScratch->solve(matrix, expected, b);
+            for (BlockMatrix::Index i = 0; i < matrix.rowSize(); ++i)
+            {
+                EXPECT_DOUBLE_EQ(x[i], expected[i]);
+            }
+        }
+
+        assembleGrid(matrix, 4, 10);
+    }
+}
+
+TEST(AMGPreconditioner, ReducesIterations)
+{
+    using Preconditioner = sofa::component::linearsolver::preconditioner::AMGPreconditioner<BlockMatrix, Vector>;
+
+    BlockMatrix matrix;
+    assembleGrid(matrix, 8, 1e4);
+    Vector b;
+    fillVector(b, matrix.rowSize(), 0);
+
+    const auto amg = createPreconditioner<Preconditioner>();
+    amg->d_maxCoarsestSize.setValue(50);
+    amg->invert(matrix);
+
+    auto* data = static_cast<Preconditioner::AMGInvertData*>(amg->getMatrixInvertData(&matrix));
+    ASSERT_GT(data->levels.size(), 2u);
+    for (std::size_t l = 1; l < data->levels.size(); ++l)
+    {
+        EXPECT_LT(data->levels[l].A.nbRows, data->levels[l - 1].A.nbRows);
+    }
+    EXPECT_LE(data->levels.back().A.nbRows, 50u);
+
+    checkSymmetry(amg.get(), matrix);
+
+    const unsigned int nbIterationsCG = cg(matrix, b, 1e-8, 5000);
+    const unsigned int nbIterationsAMG = pcg(amg.get(), matrix, b, 1e-8, 5000);
+    EXPECT_LT(nbIterationsAMG, nbIterationsCG / 5);
+}
+
+TEST(AMGPreconditioner, ScalarMatrix)
+{
+    using Preconditioner = sofa::component::linearsolver::preconditioner::AMGPreconditioner<ScalarMatrix, Vector>;
+
+    ScalarMatrix matrix;
+    assembleGrid(matrix, 6, 1);
+    Vector b;
+    fillVector(b, matrix.rowSize(), 0);
+
+    const auto amg = createPreconditioner<Preconditioner>();
+    amg->d_maxCoarsestSize.setValue(50);
+    amg->invert(matrix);
+    checkSymmetry(amg.get(), matrix);
+    EXPECT_LT(pcg(amg.get(), matrix, b, 1e-8, 5000), cg(matrix, b, 1e-8, 5000));
+}
+
+TEST(AMGPreconditioner, ReuseHierarchy)
+{
+    using Preconditioner = sofa::component::linearsolver::preconditioner::AMGPreconditioner<BlockMatrix, Vector>;
+
+    BlockMatrix matrix;
+    assembleGrid(matrix, 6, 100);
+    Vector b;
+    fillVector(b, matrix.rowSize(), 0);
+
+    const auto amg = createPreconditioner<Preconditioner>();
+    amg->d_maxCoarsestSize.setValue(50);
+    amg->invert(matrix);
+    Vector x(matrix.rowSize());
+    amg->solve(matrix, x, b);
+
+    auto* data = static_cast<Preconditioner::AMGInvertData*>(amg->getMatrixInvertData(&matrix));
+    const auto P_cols = data->levels.front().P.colsIndex;
+
+    // scaling the matrix keeps the aggregates: the reused hierarchy is the hierarchy computed from scratch
+    assembleGrid(matrix, 6, 100, 2);
+    amg->invert(matrix);
+    EXPECT_EQ(data->levels.front().P.colsIndex, P_cols);
+
+    Vector scaledX(matrix.rowSize());
+    amg->solve(matrix, scaledX, b);
+
+    const auto fromScratch = createPreconditioner<Preconditioner>();
+    fromScratch->d_maxCoarsestSize.setValue(50);
+    fromScratch->invert(matrix);
+    Vector expected(matrix.rowSize());
+    fromScratch->solve(matrix, expected, b);
+
+    for (BlockMatrix::Index i = 0; i < matrix.rowSize(); ++i)
+    {
+        EXPECT_NEAR(scaledX[i], expected[i], 1e-12 * std::abs(x[i]) + 1e-14);
+        EXPECT_NEAR(scaledX[i], x[i] / 2, 1e-10 * std::abs(x[i]) + 1e-14);
+    }
+}
+
+TEST(AMGPreconditioner, RigidBodyModes)
+{
+    using Preconditioner = sofa::component::linearsolver::preconditioner::AMGPreconditioner<BlockMatrix, Vector>;
+
+    BlockMatrix matrix;
+    std::string positions;
+    assembleElasticGrid(matrix, 8, positions);
+    Vector b;
+    fillVector(b, matrix.rowSize(), 0);
+
+    sofa::simulation::setSimulation(new sofa::simulation::graph::DAGSimulation());
+    const sofa::simulation::Node::SPtr root = sofa::simulation::getSimulation()->createNewGraph("root");
+    sofa::simpleapi::importPlugin("Sofa.Component.StateContainer");
+    sofa::simpleapi::createObject(root, "MechanicalObject", {{"template", "Vec3"}, {"position", positions}});
+
+    // the rigid body modes are computed from the rest positions of the mechanical state of the context
+    const auto rigid = sofa::core::objectmodel::New<Preconditioner>();
+    rigid->d_maxCoarsestSize.setValue(50);
+    root->addObject(rigid);
+    sofa::simulation::getSimulation()->init(root.get());
+    rigid->invert(matrix);
+
+    // without mechanical state, only the translations are interpolated
+    const auto translations = createPreconditioner<Preconditioner>();
+    translations->d_maxCoarsestSize.setValue(50);
+    translations->invert(matrix);
+
+    // same aggregates, with 6 modes instead of 3
+    auto* data = static_cast<Preconditioner::AMGInvertData*>(rigid->getMatrixInvertData(&matrix));
+    auto* translationData = static_cast<Preconditioner::AMGInvertData*>(translations->getMatrixInvertData(&matrix));
+    ASSERT_GT(data->levels.size(), 1u);
+    ASSERT_GT(translationData->levels.size(), 1u);
+    const auto& T = data->levels.front().T;
+    EXPECT_EQ(T.nbCols / 6, translationData->levels.front().T.nbCols / 3);
+
+    // the columns of the tentative prolongator are orthonormal
+    std::vector<SReal> TtT(static_cast<std::size_t>(T.nbCols) * T.nbCols, 0);
+    for (sofa::Index i = 0; i < T.nbRows; ++i)
+    {
+        for (sofa::Index p = T.rowBegin[i]; p < T.rowBegin[i + 1]; ++p)
+        {
+            for (sofa::Index q = T.rowBegin[i]; q < T.rowBegin[i + 1]; ++q)
+            {
+                TtT[T.colsIndex[p] * T.nbCols + T.colsIndex[q]] += T.values[p] * T.values[q];
+            }
+        }
+    }
+    for (sofa::Index j = 0; j < T.nbCols; ++j)
+    {
+        for (sofa::Index k = 0; k < T.nbCols; ++k)
+        {
+            const SReal expected = (j == k && TtT[j * T.nbCols + j] != 0) ? 1 : 0;
+            EXPECT_NEAR(TtT[j * T.nbCols + k], expected, 1e-10);
+        }
+    }
+
+    checkSymmetry(rigid.get(), matrix);
+    EXPECT_LT(pcg(rigid.get(), matrix, b, 1e-8, 5000), pcg(translations.get(), matrix, b, 1e-8, 5000));
+
+    sofa::simulation::getSimulation()->unload(root);
+}
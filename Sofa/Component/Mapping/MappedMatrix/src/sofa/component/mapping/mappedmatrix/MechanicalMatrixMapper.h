@@ -35,6 +35,7 @@
 #include <sofa/linearalgebra/SparseMatrixProduct[EigenSparseMatrix].h>
 
 #include <sofa/simulation/fwd.h>
+#include <sofa/simulation/TaskScheduler.h>
 
 namespace sofa::component::mapping::mappedmatrix
 {
@@ -147,19 +148,20 @@ protected:
     Eigen::SparseMatrix<double> m_J1tKJ2eigen;
     Eigen::SparseMatrix<double> m_J2tKJ1eigen;
 
-    /// Compute J1^T * K * J2 using the accelerated sparse matrix products
+    /// Compute J1^T * K * J2 using the accelerated sparse matrix products.
+    /// The accelerated products are computed in parallel if a task scheduler is provided.
     static void computeMatrixProduct(
         bool fastProduct,
         JtKMatrixProduct& product_1,
         linearalgebra::SparseMatrixProduct<Eigen::SparseMatrix<double> >& product_2,
         const Eigen::SparseMatrix<double>* J1, const Eigen::SparseMatrix<double>* J2,
         const Eigen::SparseMatrix<double>* K,
-        Eigen::SparseMatrix<double>*& output);
+        Eigen::SparseMatrix<double>*& output,
+        simulation::TaskScheduler* taskScheduler = nullptr);
 
     unsigned int m_fullMatrixSize;
     size_t m_nbInteractionForceFields;
 
-    int m_topologyRevision { -1 };
 
     MechanicalMatrixMapper() ;
 
@@ -42,6 +42,7 @@ using sofa::simulation::mechanicalvisitor::MechanicalResetConstraintVisitor;
 
 #include <sofa/simulation/CpuTask.h>
 #include <sofa/simulation/TaskScheduler.h>
+#include <sofa/simulation/ParallelSparseMatrixProduct.h>
 
 // verify timing
 #include <sofa/helper/system/thread/CTime.h>
@@ -61,8 +62,21 @@ void MechanicalMatrixMapper<TDataTypes1, TDataTypes2>::computeMatrixProduct(
     linearalgebra::SparseMatrixProduct<Eigen::SparseMatrix<double> >& product_2,
     const Eigen::SparseMatrix<double>* J1, const Eigen::SparseMatrix<double>* J2,
     const Eigen::SparseMatrix<double>* K,
-    Eigen::SparseMatrix<double>*& output)
+    Eigen::SparseMatrix<double>*& output,
+    simulation::TaskScheduler* taskScheduler)
 {
+    const auto computeProduct = [taskScheduler](auto& product)
+    {
+        if (taskScheduler)
+        {
+            simulation::parallelComputeProduct(*taskScheduler, product);
+        }
+        else
+        {
+            product.computeProduct();
+        }
+    };
+
     if (fastProduct)
     {
         // product_1 is involved in multiple products. It can be reused if already computed
@@ -71,13 +85,13 @@ void MechanicalMatrixMapper<TDataTypes1, TDataTypes2>::computeMatrixProduct(
             const Eigen::SparseMatrix<double> Jt = J1->transpose();
             product_1.product.matrixA = &Jt;
             product_1.product.matrixB = K;
-            product_1.product.computeProduct();
+            computeProduct(product_1.product);
             product_1.isComputed = true;
         }
 
         product_2.matrixA = &product_1.product.getProductResult();
         product_2.matrixB = J2;
-        product_2.computeProduct();
+        computeProduct(product_2);
 
         output = const_cast<Eigen::SparseMatrix<double>*>(&product_2.getProductResult());
     }
@@ -480,23 +494,10 @@ void MechanicalMatrixMapper<DataTypes1, DataTypes2>::addKToMatrix(const Mechanic
     KAccessor->setGlobalMatrix(K);
     KAccessor->setupMatrices();
 
+    // The intersections of the fast matrix products are recomputed automatically when the sparsity
+    // pattern of the matrices changes, e.g. after a topological change
     const sofa::simulation::Node *node = l_nodeToParse.get();
 
-    if (node->meshTopology)
-    {
-        if (const auto currentRevision = node->meshTopology->getRevision(); currentRevision != m_topologyRevision)
-        {
-            //the topology has been modified: intersection is no longer valid
-            m_product_J1tK.product.invalidateIntersection();
-            m_product_J2tK.product.invalidateIntersection();
-            m_product_J1tKJ1.invalidateIntersection();
-            m_product_J2tKJ2.invalidateIntersection();
-            m_product_J1tKJ2.invalidateIntersection();
-            m_product_J2tKJ1.invalidateIntersection();
-            m_topologyRevision = currentRevision;
-        }
-    }
-
     size_t currentNbInteractionFFs = node->interactionForceField.size();
     msg_info() << "nb m_nbInteractionForceFields :" << m_nbInteractionForceFields << msgendl << "nb currentNbInteractionFFs :" << currentNbInteractionFFs;
     if (m_nbInteractionForceFields != currentNbInteractionFFs)
@@ -552,6 +553,7 @@ void MechanicalMatrixMapper<DataTypes1, DataTypes2>::addKToMatrix(const Mechanic
     /* -------------------------------------------------------------------------- */
     sofa::helper::AdvancedTimer::stepBegin("Multiplication" );
     const auto fastProduct = d_fastMatrixProduct.getValue();
+    auto* productTaskScheduler = d_parallelTasks.getValue() ? taskScheduler : nullptr;
     m_product_J1tK.isComputed = false;
     m_product_J2tK.isComputed = false;
 
@@ -565,7 +567,7 @@ void MechanicalMatrixMapper<DataTypes1, DataTypes2>::addKToMatrix(const Mechanic
     if (!d_skipJ1tKJ1.getValue())
     {
         sofa::helper::ScopedAdvancedTimer J1tKJ1Timer("J1tKJ1" );
-        computeMatrixProduct(fastProduct, m_product_J1tK, m_product_J1tKJ1, &m_J1eig, &m_J1eig, &Keig, J1tKJ1eigen);
+        computeMatrixProduct(fastProduct, m_product_J1tK, m_product_J1tKJ1, &m_J1eig, &m_J1eig, &Keig, J1tKJ1eigen, productTaskScheduler);
     }
 
     Eigen::SparseMatrix<double>* J2tKJ2eigen{ &m_J2tKJ2eigen };
@@ -577,15 +579,15 @@ void MechanicalMatrixMapper<DataTypes1, DataTypes2>::addKToMatrix(const Mechanic
         if (!d_skipJ2tKJ2.getValue())
         {
             sofa::helper::ScopedAdvancedTimer J2tKJ2Timer("J2tKJ2" );
-            computeMatrixProduct(fastProduct, m_product_J2tK, m_product_J2tKJ2, &m_J2eig, &m_J2eig, &Keig, J2tKJ2eigen);
+            computeMatrixProduct(fastProduct, m_product_J2tK, m_product_J2tKJ2, &m_J2eig, &m_J2eig, &Keig, J2tKJ2eigen, productTaskScheduler);
         }
         {
             sofa::helper::ScopedAdvancedTimer J1tKJ2Timer("J1tKJ2" );
-            computeMatrixProduct(fastProduct, m_product_J1tK, m_product_J1tKJ2, &m_J1eig, &m_J2eig, &Keig, J1tKJ2eigen);
+            computeMatrixProduct(fastProduct, m_product_J1tK, m_product_J1tKJ2, &m_J1eig, &m_J2eig, &Keig, J1tKJ2eigen, productTaskScheduler);
         }
         {
             sofa::helper::ScopedAdvancedTimer J2tKJ1Timer("J2tKJ1" );
-            computeMatrixProduct(fastProduct, m_product_J2tK, m_product_J2tKJ1, &m_J2eig, &m_J1eig, &Keig, J2tKJ1eigen);
+            computeMatrixProduct(fastProduct, m_product_J2tK, m_product_J2tKJ1, &m_J2eig, &m_J1eig, &Keig, J2tKJ1eigen, productTaskScheduler);
         }
 
     }
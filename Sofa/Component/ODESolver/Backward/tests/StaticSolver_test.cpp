@@ -62,7 +62,10 @@ public:
         createObject(root, "RequiredPlugin", {{"pluginName", "Sofa.Component"}});
         createObject(root, "RegularGridTopology", {{"name", "grid"}, {"min", "-7.5 -7.5 0"}, {"max", "7.5 7.5 80"}, {"n", "3 3 9"}});
         auto s = createObject(root, "StaticSolver", {{"newton_iterations", "10"}});
-        createObject(root, "SparseLDLSolver");
+        if (linearSolverTemplate.empty())
+            createObject(root, "SparseLDLSolver");
+        else
+            createObject(root, "SparseLDLSolver", {{"template", linearSolverTemplate}});
         createObject(root, "MechanicalObject", {{"name", "mo"}, {"src", "@grid"}});
         createObject(root, "TetrahedronSetTopologyContainer", {{"name", "mechanical_topology"}});
         createObject(root, "TetrahedronSetTopologyModifier");
@@ -100,6 +103,22 @@ public:
 
     NodeSPtr root;
     StaticSolver::SPtr solver;
+
+    /// Template of the linear solver. If empty, the default one is used.
+    std::string linearSolverTemplate;
+};
+
+/**
+ * Same simulation, where the linear solver stores the matrix and its factorization in single
+ * precision, and refines the solution in double precision.
+ */
+class StaticSolverMixedPrecisionTest : public StaticSolverTest
+{
+public:
+    StaticSolverMixedPrecisionTest()
+    {
+        linearSolverTemplate = "CompressedRowSparseMatrixMat3x3f";
+    }
 };
 
 TEST_F(StaticSolverTest, Residuals) {
@@ -253,3 +272,35 @@ TEST_F(StaticSolverTest, AbsoluteIncrements) {
     EXPECT_EQ(actual_increment_norms.size(), 7)
     << "The static ODE solver is supposed to converge after 7 Newton steps when using a relative correction threshold of 1e-5.";
 }
+
+#ifndef SOFA_FLOAT
+TEST_F(StaticSolverMixedPrecisionTest, Residuals) {
+    using namespace sofa::core::objectmodel;
+    // Thanks to the iterative refinement, the Newton iterations converge as with a linear solver in
+    // double precision
+    std::vector<double> expected_force_residual_norms = {
+        1.237102e+03,
+        6.931312e+00,
+        2.634097e-01,
+        2.829366e-02,
+        2.928456e-03,
+        3.017181e-04
+    };
+
+    dynamic_cast< Data<unsigned> * > ( this->solver->findData("newton_iterations") )->setValue(6);
+    dynamic_cast< Data<SReal> *   > ( this->solver->findData("absolute_correction_tolerance_threshold") )->setValue(-1);
+    dynamic_cast< Data<SReal> *   > ( this->solver->findData("relative_correction_tolerance_threshold") )->setValue(-1);
+    dynamic_cast< Data<SReal> *   > ( this->solver->findData("absolute_residual_tolerance_threshold")   )->setValue(-1);
+    dynamic_cast< Data<SReal> *   > ( this->solver->findData("relative_residual_tolerance_threshold")   )->setValue(-1);
+    dynamic_cast< Data<bool> *     > ( this->solver->findData("should_diverge_when_residual_is_growing") )->setValue(false);
+
+    std::vector<SReal> actual_force_residual_norms = this->execute().first;
+
+    ASSERT_EQ(actual_force_residual_norms.size(), expected_force_residual_norms.size());
+
+    for (std::size_t newton_it = 0; newton_it < actual_force_residual_norms.size(); ++newton_it) {
+        EXPECT_NEAR(actual_force_residual_norms[newton_it], expected_force_residual_norms[newton_it], 1e-3)
+        << "The actual force residual norm doesn't match the expected one.";
+    }
+}
+#endif
@@ -29,6 +29,7 @@
 #include <sofa/type/Vec.h>
 #include <sofa/type/Mat.h>
 #include <sofa/type/trait/Rebind.h>
+#include <sofa/simulation/ParallelElementAssembly.h>
 
 
 namespace sofa::component::solidmechanics::fem::elastic
@@ -133,6 +134,7 @@ public:
     Data<sofa::type::RGBAColor> drawColor2; ///<  draw color for faces 2
     Data<sofa::type::RGBAColor> drawColor3; ///<  draw color for faces 3
     Data<sofa::type::RGBAColor> drawColor4; ///<  draw color for faces 4
+    Data<bool> d_multithreading; ///< Accumulate the forces of the tetrahedra and of the edges in parallel
 
     /// Link to be set to the topology container in the component graph.
     SingleLink<FastTetrahedralCorotationalForceField<DataTypes>, sofa::core::topology::BaseMeshTopology, BaseLink::FLAG_STOREPATH | BaseLink::FLAG_STRONGLINK> l_topology;
@@ -199,6 +201,9 @@ protected :
 
     typedef FastTetrahedralCorotationalForceFieldData<DataTypes> ExtraData;
     ExtraData m_data;
+
+    /// Task scheduler used to compute the forces of the element colors in parallel (nullptr if d_multithreading is false)
+    simulation::TaskScheduler* m_taskScheduler { nullptr };
 };
 
 #if  !defined(SOFA_COMPONENT_INTERACTIONFORCEFIELD_FASTTETRAHEDRALCOROTATIONALFORCEFIELD_CPP)
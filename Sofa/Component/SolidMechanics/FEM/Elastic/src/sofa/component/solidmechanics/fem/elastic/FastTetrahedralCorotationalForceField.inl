@@ -27,6 +27,7 @@
 #include <sofa/core/behavior/MultiMatrixAccessor.h>
 #include <sofa/core/topology/Topology.h>
 #include <sofa/core/topology/TopologyData.inl>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
 
 namespace sofa::component::solidmechanics::fem::elastic
 {
@@ -148,6 +149,7 @@ FastTetrahedralCorotationalForceField<DataTypes>::FastTetrahedralCorotationalFor
     , drawColor2(initData(&drawColor2, sofa::type::RGBAColor(0.0f, 0.5f, 1.0f, 1.0f), "drawColor2", " draw color for faces 2"))
     , drawColor3(initData(&drawColor3, sofa::type::RGBAColor(0.0f, 1.0f, 1.0f, 1.0f), "drawColor3", " draw color for faces 3"))
     , drawColor4(initData(&drawColor4, sofa::type::RGBAColor(0.5f, 1.0f, 1.0f, 1.0f), "drawColor4", " draw color for faces 4"))
+    , d_multithreading(initData(&d_multithreading, false, "multithreading", "Compute the forces of the tetrahedra and of the edges in parallel, color by color (elements sharing no vertex), using the main task scheduler"))
     , l_topology(initLink("topology", "link to the topology container"))
     , m_topology(nullptr)
     , updateMatrix(true)
@@ -170,6 +172,19 @@ void FastTetrahedralCorotationalForceField<DataTypes>::init()
     msg_warning_when(!f_poissonRatio.isSet()) << "The default value of the Data " << f_poissonRatio.getName() << " changed in v23.06 from 0.3 to 0.45.";
     msg_warning_when(!f_youngModulus.isSet()) << "The default value of the Data " << f_youngModulus.getName() << " changed in v23.06 from 1000 to 5000";
 
+    if (d_multithreading.getValue())
+    {
+        m_taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+        if (m_taskScheduler->getThreadCount() == 0)
+        {
+            m_taskScheduler->init();
+        }
+    }
+    else
+    {
+        m_taskScheduler = nullptr;
+    }
+
     if (l_topology.empty())
     {
         msg_info() << "link to Topology container should be set to ensure right behavior. First Topology found in current context will be used.";
@@ -310,96 +325,111 @@ void FastTetrahedralCorotationalForceField<DataTypes>::addForce(const sofa::core
     const VecCoord& x  =   dataX.getValue()  ;
 
 
-    unsigned int j,k,l;
-    int nbTetrahedra=m_topology->getNbTetrahedra();
-    int i;
-
     helper::WriteOnlyAccessor< Data< VecTetrahedronRestInformation > > tetrahedronInf = tetrahedronInfo;
 
-
-    Coord displ[6],sv;
-    Mat3x3NoInit deformationGradient,S,R;
     const auto& tetrahedra = m_topology->getTetrahedra();
 
-    Coord tetraVertex[4];
-    for(i=0; i<nbTetrahedra; i++ )
-    {
-        TetrahedronRestInformation& tetraInfo = tetrahedronInf[i];
-        const core::topology::BaseMeshTopology::Tetrahedron &tetra = tetrahedra[i];
-        
-        for (int j = 0; j < 4; ++j)
-            tetraVertex[j] = x[tetra[j]];
-
-        // compute current tetrahedron displacement
-        for (j=0; j<6; ++j)
+    const auto addTetrahedronForce = [&](const std::size_t i, VecDeriv& fOut)
         {
-            displ[j] = tetraVertex[edgesInTetrahedronArray[j][1]] - tetraVertex[edgesInTetrahedronArray[j][0]];
-        }
+            unsigned int j,k,l;
+            Coord displ[6],sv;
+            Mat3x3NoInit deformationGradient,S,R;
+            Coord tetraVertex[4];
 
-        if (m_decompositionMethod == POLAR_DECOMPOSITION)
-        {
-            // compute the deformation gradient
-            // deformation gradient = sum of tensor product between vertex position and shape vector
-            // optimize by using displacement with first vertex
-            sv= tetraInfo.shapeVector[1];
-            for (k=0; k<3; ++k)
+            TetrahedronRestInformation& tetraInfo = tetrahedronInf[i];
+            const core::topology::BaseMeshTopology::Tetrahedron &tetra = tetrahedra[i];
+        
+            for (int j = 0; j < 4; ++j)
+                tetraVertex[j] = x[tetra[j]];
+
+            // compute current tetrahedron displacement
+            for (j=0; j<6; ++j)
             {
-                for (l=0; l<3; ++l)
-                {
-                    deformationGradient[k][l]= displ[0][k]*sv[l];
-                }
+                displ[j] = tetraVertex[edgesInTetrahedronArray[j][1]] - tetraVertex[edgesInTetrahedronArray[j][0]];
             }
-            for (j=1; j<3; ++j)
+
+            if (m_decompositionMethod == POLAR_DECOMPOSITION)
             {
-                sv= tetraInfo.shapeVector[j+1];
+                // compute the deformation gradient
+                // deformation gradient = sum of tensor product between vertex position and shape vector
+                // optimize by using displacement with first vertex
+                sv= tetraInfo.shapeVector[1];
                 for (k=0; k<3; ++k)
                 {
                     for (l=0; l<3; ++l)
                     {
-                        deformationGradient[k][l]+= displ[j][k]*sv[l];
+                        deformationGradient[k][l]= displ[0][k]*sv[l];
                     }
                 }
+                for (j=1; j<3; ++j)
+                {
+                    sv= tetraInfo.shapeVector[j+1];
+                    for (k=0; k<3; ++k)
+                    {
+                        for (l=0; l<3; ++l)
+                        {
+                            deformationGradient[k][l]+= displ[j][k]*sv[l];
+                        }
+                    }
+                }
+                // polar decomposition of the transformation
+                helper::Decompose<Real>::polarDecomposition(deformationGradient,R);
             }
-            // polar decomposition of the transformation
-            helper::Decompose<Real>::polarDecomposition(deformationGradient,R);
-        }
-        else if (m_decompositionMethod == QR_DECOMPOSITION)
-        {
-            /// perform QR decomposition
-            computeQRRotation(S, displ);
-            R=S.multTranspose(tetraInfo.restRotation);
-        } 
-        else if (m_decompositionMethod == POLAR_DECOMPOSITION_MODIFIED) 
-        {
-            S[0]= displ[0];
-            S[1]= displ[1];
-            S[2]= displ[2];
-            helper::Decompose<Real>::polarDecomposition( S, R );
-            R=R.transposed()*tetraInfo.restRotation;
-        }  
-        else if (m_decompositionMethod == LINEAR_ELASTIC) 
-        {
-            R.identity();
-        }
-        // store transpose of rotation
-        tetraInfo.rotation=R.transposed();
-        Coord force[4];
+            else if (m_decompositionMethod == QR_DECOMPOSITION)
+            {
+                /// perform QR decomposition
+                computeQRRotation(S, displ);
+                R=S.multTranspose(tetraInfo.restRotation);
+            } 
+            else if (m_decompositionMethod == POLAR_DECOMPOSITION_MODIFIED) 
+            {
+                S[0]= displ[0];
+                S[1]= displ[1];
+                S[2]= displ[2];
+                helper::Decompose<Real>::polarDecomposition( S, R );
+                R=R.transposed()*tetraInfo.restRotation;
+            }  
+            else if (m_decompositionMethod == LINEAR_ELASTIC) 
+            {
+                R.identity();
+            }
+            // store transpose of rotation
+            tetraInfo.rotation=R.transposed();
+            Coord force[4];
 
 
-        for (j=0; j<6; ++j)
-        {
-            // displacement in the rest configuration
-            displ[j]=tetraInfo.rotation* displ[j]-tetraInfo.restEdgeVector[j];
+            for (j=0; j<6; ++j)
+            {
+                // displacement in the rest configuration
+                displ[j]=tetraInfo.rotation* displ[j]-tetraInfo.restEdgeVector[j];
 
-            // force on first vertex in the rest configuration
-            force[edgesInTetrahedronArray[j][1]]+=tetraInfo.linearDfDx[j]* displ[j];
+                // force on first vertex in the rest configuration
+                force[edgesInTetrahedronArray[j][1]]+=tetraInfo.linearDfDx[j]* displ[j];
 
-            // force on second vertex in the rest configuration
-            force[edgesInTetrahedronArray[j][0]]-=tetraInfo.linearDfDx[j].multTranspose(displ[j]);
-        }
-        for (j=0; j<4; ++j)
+                // force on second vertex in the rest configuration
+                force[edgesInTetrahedronArray[j][0]]-=tetraInfo.linearDfDx[j].multTranspose(displ[j]);
+            }
+            for (j=0; j<4; ++j)
+            {
+                fOut[tetra[j]]+=R*force[j];
+            }
+        };
+
+    if (m_taskScheduler)
+    {
+        // the tetrahedra of a same color do not share any vertex: their forces are written directly into f
+        const auto& coloring = m_topology->getElementColoring(sofa::geometry::ElementType::TETRAHEDRON);
+        simulation::forEachColoredElement(m_taskScheduler, coloring.getColors(),
+            [&addTetrahedronForce, &f](const sofa::Index i)
+            {
+                addTetrahedronForce(i, f);
+            });
+    }
+    else
+    {
+        for (std::size_t i = 0; i < tetrahedra.size(); ++i)
         {
-            f[tetra[j]]+=R*force[j];
+            addTetrahedronForce(i, f);
         }
     }
 
@@ -464,17 +494,30 @@ void FastTetrahedralCorotationalForceField<DataTypes>::addDForce(const sofa::cor
     }
 
     const VecMat3x3& edgeDfDx = edgeInfo.getValue();
-    Coord deltax;
 
     const auto& edges = m_topology->getEdges();
     // use the already stored matrix
-    for (i = 0; i < nbEdges; i++)
-    {
-        const core::topology::BaseMeshTopology::Edge& edge = edges[i];
+    const auto addEdgeDForce = [&edges, &edgeDfDx, &dx, &df, kFactor](const std::size_t i)
+        {
+            const core::topology::BaseMeshTopology::Edge& edge = edges[i];
 
-        deltax = (dx[edge[1]] - dx[edge[0]]) * kFactor;
-        df[edge[1]] += edgeDfDx[i] * deltax;
-        df[edge[0]] -= edgeDfDx[i].multTranspose(deltax);
+            const Coord deltax = (dx[edge[1]] - dx[edge[0]]) * kFactor;
+            df[edge[1]] += edgeDfDx[i] * deltax;
+            df[edge[0]] -= edgeDfDx[i].multTranspose(deltax);
+        };
+
+    if (m_taskScheduler)
+    {
+        // the edges of a same color do not share any vertex: their contributions are written directly into df
+        const auto& coloring = m_topology->getElementColoring(sofa::geometry::ElementType::EDGE);
+        simulation::forEachColoredElement(m_taskScheduler, coloring.getColors(), addEdgeDForce);
+    }
+    else
+    {
+        for (i = 0; i < nbEdges; ++i)
+        {
+            addEdgeDForce(i);
+        }
     }
 
     datadF.endEdit();
@@ -1144,29 +1144,35 @@ void HexahedronFEMForceField<DataTypes>::addKToMatrix(const core::MechanicalPara
     const auto& stiffnesses = _elementStiffnesses.getValue();
     const auto* indexedElements = this->getIndexedElements();
 
+    // element stiffness matrix in the global frame
+    ElementStiffness K;
+
     for (const auto& element : *indexedElements)
     {
         const ElementStiffness &Ke = stiffnesses[e];
         const Transformation Rot = getElementRotation(e);
         e++;
 
-        // find index of node 1
         for (Element::size_type n1 = 0; n1 < Element::size(); n1++)
         {
-            const auto node1 = element[n1];
-            // find index of node 2
             for (Element::size_type n2 = 0; n2 < Element::size(); n2++)
             {
-                const auto node2 = element[n2];
-
                 const Mat33 tmp = Rot.multTranspose( Mat33(
                         Coord(Ke[3*n1+0][3*n2+0],Ke[3*n1+0][3*n2+1],Ke[3*n1+0][3*n2+2]),
                         Coord(Ke[3*n1+1][3*n2+0],Ke[3*n1+1][3*n2+1],Ke[3*n1+1][3*n2+2]),
                         Coord(Ke[3*n1+2][3*n2+0],Ke[3*n1+2][3*n2+1],Ke[3*n1+2][3*n2+2])) ) * Rot;
 
-                r.matrix->add( r.offset + 3 * node1, r.offset + 3 * node2, tmp * (-kFactor));
+                for (sofa::Index i = 0; i < 3; ++i)
+                {
+                    for (sofa::Index j = 0; j < 3; ++j)
+                    {
+                        K[3*n1+i][3*n2+j] = tmp[i][j];
+                    }
+                }
             }
         }
+
+        r.matrix->addElementMatrix(r.offset, element, K, -kFactor);
     }
 }
 
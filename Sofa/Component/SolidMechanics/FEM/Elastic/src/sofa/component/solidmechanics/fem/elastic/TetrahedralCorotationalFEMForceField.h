@@ -28,6 +28,7 @@
 #include <sofa/type/Vec.h>
 #include <sofa/type/Mat.h>
 #include <sofa/helper/map.h>
+#include <sofa/simulation/ParallelElementAssembly.h>
 
 // corotational tetrahedron from
 // @InProceedings{NPF05,
@@ -146,6 +147,7 @@ public:
     Data<VecReal> _localStiffnessFactor; ///< Allow specification of different stiffness per element. If there are N element and M values are specified, the youngModulus factor for element i would be localStiffnessFactor[i*M/N]
     Data<bool> _updateStiffnessMatrix;
     Data<bool> _assembling;
+    Data<bool> d_multithreading; ///< Accumulate the forces of the tetrahedra in parallel
     Data<bool> f_drawing; ///<  draw the forcefield if true
     Data<bool> _displayWholeVolume;
     Data<sofa::type::RGBAColor> drawColor1; ///<  draw color for faces 1
@@ -231,16 +233,23 @@ protected:
     ////////////// large displacements method
     void initLarge(int i, Index&a, Index&b, Index&c, Index&d);
     void computeRotationLarge( Transformation &r, const Vector &p, const Index &a, const Index &b, const Index &c);
-    void accumulateForceLarge( Vector& f, const Vector & p, Index elementIndex );
+    void accumulateForceLarge( Vector& f, const Vector & p, Index elementIndex, type::vector<TetrahedronInformation>& tetrahedronInf );
     void applyStiffnessLarge( Vector& f, const Vector& x, int i=0, Index a=0,Index b=1,Index c=2,Index d=3, SReal fact=1.0 );
 
     ////////////// polar decomposition method
     void initPolar(int i, Index&a, Index&b, Index&c, Index&d);
-    void accumulateForcePolar( Vector& f, const Vector & p,Index elementIndex );
+    void accumulateForcePolar( Vector& f, const Vector & p,Index elementIndex, type::vector<TetrahedronInformation>& tetrahedronInf );
     void applyStiffnessPolar( Vector& f, const Vector& x, int i=0, Index a=0,Index b=1,Index c=2,Index d=3, SReal fact=1.0 );
 
     void printStiffnessMatrix(int idTetra);
 
+    /// Task scheduler used to accumulate the forces in parallel, or nullptr to accumulate them
+    /// sequentially (d_multithreading is false, or the global matrix is assembled)
+    simulation::TaskScheduler* getElementTaskScheduler() const;
+
+    simulation::TaskScheduler* m_taskScheduler { nullptr };
+    simulation::ParallelElementAccumulator<VecDeriv> m_elementAccumulator;
+
 };
 
 #if  !defined(SOFA_COMPONENT_FORCEFIELD_TETRAHEDRALCOROTATIONALFEMFORCEFIELD_CPP)
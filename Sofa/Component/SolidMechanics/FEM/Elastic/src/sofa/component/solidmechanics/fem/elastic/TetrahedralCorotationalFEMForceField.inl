@@ -25,6 +25,7 @@
 #include <sofa/core/visual/VisualParams.h>
 #include <sofa/helper/decompose.h>
 #include <sofa/core/topology/TopologyData.inl>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
 
 
 namespace sofa::component::solidmechanics::fem::elastic
@@ -74,6 +75,7 @@ TetrahedralCorotationalFEMForceField<DataTypes>::TetrahedralCorotationalFEMForce
     , _localStiffnessFactor(core::objectmodel::BaseObject::initData(&_localStiffnessFactor,"localStiffnessFactor","Allow specification of different stiffness per element. If there are N element and M values are specified, the youngModulus factor for element i would be localStiffnessFactor[i*M/N]"))
     , _updateStiffnessMatrix(core::objectmodel::BaseObject::initData(&_updateStiffnessMatrix,false,"updateStiffnessMatrix",""))
     , _assembling(core::objectmodel::BaseObject::initData(&_assembling,false,"computeGlobalMatrix",""))
+    , d_multithreading(initData(&d_multithreading, false, "multithreading", "Accumulate the forces of the tetrahedra in parallel, using the main task scheduler. Ignored if computeGlobalMatrix is set"))
     , f_drawing(initData(&f_drawing,true,"drawing"," draw the forcefield if true"))
     , drawColor1(initData(&drawColor1,sofa::type::RGBAColor(0.0f,0.0f,1.0f,1.0f),"drawColor1"," draw color for faces 1"))
     , drawColor2(initData(&drawColor2,sofa::type::RGBAColor(0.0f,0.5f,1.0f,1.0f),"drawColor2"," draw color for faces 2"))
@@ -93,6 +95,19 @@ void TetrahedralCorotationalFEMForceField<DataTypes>::init()
 {
     this->core::behavior::ForceField<DataTypes>::init();
 
+    if (d_multithreading.getValue())
+    {
+        m_taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+        if (m_taskScheduler->getThreadCount() == 0)
+        {
+            m_taskScheduler->init();
+        }
+    }
+    else
+    {
+        m_taskScheduler = nullptr;
+    }
+
     if (l_topology.empty())
     {
         msg_info() << "link to Topology container should be set to ensure right behavior. First Topology found in current context will be used.";
@@ -159,36 +174,53 @@ void TetrahedralCorotationalFEMForceField<DataTypes>::reinit()
 }
 
 
+template<class DataTypes>
+simulation::TaskScheduler* TetrahedralCorotationalFEMForceField<DataTypes>::getElementTaskScheduler() const
+{
+    // the assembled stiffness matrix is shared by all the elements
+    return _assembling.getValue() ? nullptr : m_taskScheduler;
+}
+
 template<class DataTypes>
 void TetrahedralCorotationalFEMForceField<DataTypes>::addForce(const core::MechanicalParams* /* mparams */, DataVecDeriv& d_f, const DataVecCoord& d_x, const DataVecDeriv& /* d_v */)
 {
     VecDeriv& f = *d_f.beginEdit();
     const VecCoord& p = d_x.getValue();
 
+    simulation::TaskScheduler* taskScheduler = getElementTaskScheduler();
+    const std::size_t nbTetrahedra = m_topology->getNbTetrahedra();
+
     switch(method)
     {
     case SMALL :
     {
-        for(Size i = 0 ; i<m_topology->getNbTetrahedra(); ++i)
-        {
-            accumulateForceSmall( f, p, i );
-        }
+        m_elementAccumulator.accumulate(taskScheduler, nbTetrahedra, f,
+            [this, &p](const Index i, VecDeriv& out)
+            {
+                accumulateForceSmall( out, p, i );
+            });
         break;
     }
     case LARGE :
     {
-        for(Size i = 0 ; i<m_topology->getNbTetrahedra(); ++i)
-        {
-            accumulateForceLarge( f, p, i );
-        }
+        type::vector<TetrahedronInformation>& tetrahedronInf = *(tetrahedronInfo.beginEdit());
+        m_elementAccumulator.accumulate(taskScheduler, nbTetrahedra, f,
+            [this, &p, &tetrahedronInf](const Index i, VecDeriv& out)
+            {
+                accumulateForceLarge( out, p, i, tetrahedronInf );
+            });
+        tetrahedronInfo.endEdit();
         break;
     }
     case POLAR :
     {
-        for(Size i = 0 ; i<m_topology->getNbTetrahedra(); ++i)
-        {
-            accumulateForcePolar( f, p, i );
-        }
+        type::vector<TetrahedronInformation>& tetrahedronInf = *(tetrahedronInfo.beginEdit());
+        m_elementAccumulator.accumulate(taskScheduler, nbTetrahedra, f,
+            [this, &p, &tetrahedronInf](const Index i, VecDeriv& out)
+            {
+                accumulateForcePolar( out, p, i, tetrahedronInf );
+            });
+        tetrahedronInfo.endEdit();
         break;
     }
     }
@@ -203,51 +235,30 @@ void TetrahedralCorotationalFEMForceField<DataTypes>::addDForce(const core::Mech
 
     Real kFactor = (Real)sofa::core::mechanicalparams::kFactorIncludingRayleighDamping(mparams, this->rayleighStiffness.getValue());
 
-    switch(method)
-    {
-    case SMALL :
-    {
-        for(Size i = 0 ; i<m_topology->getNbTetrahedra(); ++i)
-        {
-            const core::topology::BaseMeshTopology::Tetrahedron t=m_topology->getTetrahedron(i);
-            Index a = t[0];
-            Index b = t[1];
-            Index c = t[2];
-            Index d = t[3];
+    const auto& tetrahedra = m_topology->getTetrahedra();
 
-            applyStiffnessSmall( df, dx, i, a,b,c,d, kFactor );
-        }
-        break;
-    }
-    case LARGE :
-    {
-        for(Size i = 0 ; i<m_topology->getNbTetrahedra(); ++i)
-        {
-            const core::topology::BaseMeshTopology::Tetrahedron t=m_topology->getTetrahedron(i);
-            Index a = t[0];
-            Index b = t[1];
-            Index c = t[2];
-            Index d = t[3];
-
-            applyStiffnessLarge( df, dx, i, a,b,c,d, kFactor );
-        }
-        break;
-    }
-    case POLAR :
-    {
-        for(Size i = 0 ; i<m_topology->getNbTetrahedra(); ++i)
+    m_elementAccumulator.accumulate(getElementTaskScheduler(), tetrahedra.size(), df,
+        [this, &tetrahedra, &dx, kFactor](const Index i, VecDeriv& out)
         {
-            const core::topology::BaseMeshTopology::Tetrahedron t=m_topology->getTetrahedron(i);
+            const core::topology::BaseMeshTopology::Tetrahedron& t = tetrahedra[i];
             Index a = t[0];
             Index b = t[1];
             Index c = t[2];
             Index d = t[3];
 
-            applyStiffnessPolar( df, dx, i, a,b,c,d, kFactor );
-        }
-        break;
-    }
-    }
+            switch(method)
+            {
+            case SMALL :
+                applyStiffnessSmall( out, dx, i, a,b,c,d, kFactor );
+                break;
+            case LARGE :
+                applyStiffnessLarge( out, dx, i, a,b,c,d, kFactor );
+                break;
+            case POLAR :
+                applyStiffnessPolar( out, dx, i, a,b,c,d, kFactor );
+                break;
+            }
+        });
 
     d_df.endEdit();
 }
@@ -935,12 +946,10 @@ void TetrahedralCorotationalFEMForceField<DataTypes>::initLarge(int i, Index&a,
 }
 
 template<class DataTypes>
-void TetrahedralCorotationalFEMForceField<DataTypes>::accumulateForceLarge( Vector& f, const Vector & p, Index elementIndex )
+void TetrahedralCorotationalFEMForceField<DataTypes>::accumulateForceLarge( Vector& f, const Vector & p, Index elementIndex, type::vector<TetrahedronInformation>& tetrahedronInf )
 {
     const core::topology::BaseMeshTopology::Tetrahedron t=m_topology->getTetrahedron(elementIndex);
 
-    type::vector<typename TetrahedralCorotationalFEMForceField<DataTypes>::TetrahedronInformation>& tetrahedronInf = *(tetrahedronInfo.beginEdit());
-
     // Rotation matrix (deformed and displaced Tetrahedron/world)
     Transformation R_0_2;
     computeRotationLarge( R_0_2, p, t[0],t[1],t[2]);
@@ -1048,8 +1057,6 @@ void TetrahedralCorotationalFEMForceField<DataTypes>::accumulateForceLarge( Vect
         for(int i=0; i<12; i+=3)
             f[t[i/3]] += Deriv( F[i], F[i+1],  F[i+2] );
     }
-
-    tetrahedronInfo.endEdit();
 }
 
 template<class DataTypes>
@@ -1124,7 +1131,7 @@ void TetrahedralCorotationalFEMForceField<DataTypes>::initPolar(int i, Index& a,
 }
 
 template<class DataTypes>
-void TetrahedralCorotationalFEMForceField<DataTypes>::accumulateForcePolar( Vector& f, const Vector & p, Index elementIndex )
+void TetrahedralCorotationalFEMForceField<DataTypes>::accumulateForcePolar( Vector& f, const Vector & p, Index elementIndex, type::vector<TetrahedronInformation>& tetrahedronInf )
 {
     const core::topology::BaseMeshTopology::Tetrahedron t=m_topology->getTetrahedron(elementIndex);
 
@@ -1136,8 +1143,6 @@ void TetrahedralCorotationalFEMForceField<DataTypes>::accumulateForcePolar( Vect
     Transformation R_0_2;
     helper::Decompose<Real>::polarDecomposition(A, R_0_2);
 
-    type::vector<typename TetrahedralCorotationalFEMForceField<DataTypes>::TetrahedronInformation>& tetrahedronInf = *(tetrahedronInfo.beginEdit());
-
     tetrahedronInf[elementIndex].rotation.transpose( R_0_2 );
 
     // positions of the deformed and displaced Tetrahedre in its frame
@@ -1177,14 +1182,12 @@ void TetrahedralCorotationalFEMForceField<DataTypes>::accumulateForcePolar( Vect
     {
         msg_error() << "TODO(TetrahedralCorotationalFEMForceField): support for assembling system matrix when using polar method.";
     }
-
-    tetrahedronInfo.endEdit();
 }
 
 template<class DataTypes>
 void TetrahedralCorotationalFEMForceField<DataTypes>::applyStiffnessPolar( Vector& f, const Vector& x, int i, Index a, Index b, Index c, Index d, SReal fact )
 {
-    type::vector<typename TetrahedralCorotationalFEMForceField<DataTypes>::TetrahedronInformation>& tetrahedronInf = *(tetrahedronInfo.beginEdit());
+    const type::vector<typename TetrahedralCorotationalFEMForceField<DataTypes>::TetrahedronInformation>& tetrahedronInf = tetrahedronInfo.getValue();
 
     Transformation R_0_2;
     R_0_2.transpose( tetrahedronInf[i].rotation );
@@ -1220,8 +1223,6 @@ void TetrahedralCorotationalFEMForceField<DataTypes>::applyStiffnessPolar( Vecto
     f[b] -= tetrahedronInf[i].rotation * Deriv( F[3], F[4],  F[5] );
     f[c] -= tetrahedronInf[i].rotation * Deriv( F[6], F[7],  F[8] );
     f[d] -= tetrahedronInf[i].rotation * Deriv( F[9], F[10], F[11] );
-
-    tetrahedronInfo.endEdit();
 }
 
 //////////////////////////////////////////////////////////////////////
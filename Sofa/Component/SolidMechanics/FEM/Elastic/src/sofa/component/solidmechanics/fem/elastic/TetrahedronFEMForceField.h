@@ -28,6 +28,7 @@
 #include <sofa/defaulttype/VecTypes.h>
 #include <sofa/type/Mat.h>
 #include <sofa/core/behavior/RotationFinder.h>
+#include <sofa/core/behavior/LinearizedOperator.h>
 #include <sofa/helper/OptionsGroup.h>
 
 #include <sofa/helper/ColorMap.h>
@@ -73,7 +74,8 @@ public:
 *   Corotational methods are based on a rotation from world-space to material-space.
 */
 template<class DataTypes>
-class TetrahedronFEMForceField : public core::behavior::ForceField<DataTypes>, public sofa::core::behavior::RotationFinder<DataTypes>
+class TetrahedronFEMForceField : public core::behavior::ForceField<DataTypes>, public sofa::core::behavior::RotationFinder<DataTypes>,
+                                 public core::behavior::LinearizedOperatorProvider
 {
 public:
     SOFA_CLASS2(SOFA_TEMPLATE(TetrahedronFEMForceField, DataTypes), SOFA_TEMPLATE(core::behavior::ForceField, DataTypes), SOFA_TEMPLATE(core::behavior::RotationFinder, DataTypes));
@@ -232,6 +234,7 @@ public:
     Data<bool> _showVonMisesStressPerElement; ///< draw triangles showing vonMises stress interpolated in elements
 
     Data<bool>  _updateStiffness; ///< udpate structures (precomputed in init) using stiffness parameters in each iteration (set listening=1)
+    Data<bool> d_cacheElementStiffness; ///< Compute the rotated stiffness matrix of each element once after each addForce, and reuse it in addDForce and addKToMatrix
 
     /// Link to be set to the topology container in the component graph. 
     SingleLink<TetrahedronFEMForceField<DataTypes>, sofa::core::topology::BaseMeshTopology, BaseLink::FLAG_STOREPATH|BaseLink::FLAG_STRONGLINK> l_topology;
@@ -280,6 +283,9 @@ public:
     void addKToMatrix(sofa::linearalgebra::BaseMatrix *m, SReal kFactor, unsigned int &offset) override;
     void addKToMatrix(const core::MechanicalParams* /*mparams*/, const sofa::core::behavior::MultiMatrixAccessor* /*matrix*/ ) override;
 
+    /// Snapshot of the rotated stiffness matrices of the elements, scaled by the stiffness factor of mparams
+    std::shared_ptr<core::behavior::LinearizedOperator> createLinearizedOperator(const core::MechanicalParams* mparams) override;
+
     void draw(const core::visual::VisualParams* vparams) override;
 
     void computeBBox(const core::ExecParams* params, bool onlyVisible) override;
@@ -329,6 +335,27 @@ protected:
 
     void handleTopologyChange() override { needUpdateTopology = true; }
 
+    /// Compute the rotated stiffness matrix R*J*K*Jt*Rt of each element, if it is outdated
+    void updateElementStiffness();
+
+    /// Rotated stiffness matrices of the elements, used if d_cacheElementStiffness is true.
+    /// They are outdated by addForce, which updates the rotations.
+    type::vector<StiffnessMatrix> m_elementStiffness;
+    bool m_isElementStiffnessUpToDate { false };
+
+    /// df += K dx, K being the assembly of the element matrices, stored with the indices of their nodes
+    class ElementStiffnessOperator : public core::behavior::LinearizedOperator
+    {
+    public:
+        explicit ElementStiffnessOperator(core::behavior::MechanicalState<DataTypes>* state) : m_state(state) {}
+
+        void addMultiply(core::MultiVecDerivId dfId, core::ConstMultiVecDerivId dxId) override;
+
+        core::behavior::MechanicalState<DataTypes>* m_state;
+        type::vector<Tetrahedron> m_elements;
+        type::vector<StiffnessMatrix> m_stiffness;
+    };
+
     void computeVonMisesStress();
     bool isComputeVonMisesStressMethodSet();
     void computeMinMaxFromYoungsModulus();
@@ -63,6 +63,8 @@ TetrahedronFEMForceField<DataTypes>::TetrahedronFEMForceField()
     , _showVonMisesStressPerNode(initData(&_showVonMisesStressPerNode,false,"showVonMisesStressPerNode","draw points showing vonMises stress interpolated in nodes"))
     , _showVonMisesStressPerElement(initData(&_showVonMisesStressPerElement, false, "showVonMisesStressPerElement", "draw triangles showing vonMises stress interpolated in elements"))
     , _updateStiffness(initData(&_updateStiffness,false,"updateStiffness","udpate structures (precomputed in init) using stiffness parameters in each iteration (set listening=1)"))
+    , d_cacheElementStiffness(initData(&d_cacheElementStiffness, false, "cacheElementStiffness", "Compute the rotated stiffness matrix of each element once after each addForce, and reuse it in addDForce and addKToMatrix. "
+                                                                                              "It speeds up the solvers calling addDForce many times per time step (e.g. CGLinearSolver), at the cost of storing 144 values per element."))
     , l_topology(initLink("topology", "link to the tetrahedron topology container"))
 {
     _poissonRatio.setRequired(true);
@@ -1488,6 +1490,8 @@ void TetrahedronFEMForceField<DataTypes>::reset()
 template <class DataTypes>
 inline void TetrahedronFEMForceField<DataTypes>::reinit()
 {
+    m_isElementStiffnessUpToDate = false;
+
     if(this->d_componentState.getValue() == ComponentState::Invalid)
         return ;
 
@@ -1661,6 +1665,9 @@ inline void TetrahedronFEMForceField<DataTypes>::addForce (const core::Mechanica
         needUpdateTopology = false;
     }
 
+    // the rotations are updated
+    m_isElementStiffnessUpToDate = false;
+
     unsigned int i;
     typename VecElement::const_iterator it;
     switch(method)
@@ -1718,7 +1725,36 @@ inline void TetrahedronFEMForceField<DataTypes>::addDForce(const core::Mechanica
     unsigned int i;
     typename VecElement::const_iterator it;
 
-    if( method == SMALL )
+    if (d_cacheElementStiffness.getValue())
+    {
+        updateElementStiffness();
+
+        for(it = _indexedElements->begin(), i = 0 ; it != _indexedElements->end() ; ++it, ++i)
+        {
+            const Tetrahedron& t = *it;
+
+            Displacement X;
+            for (unsigned int n = 0; n < 4; ++n)
+            {
+                for (unsigned int c = 0; c < 3; ++c)
+                {
+                    X[3 * n + c] = dx[t[n]][c];
+                }
+            }
+
+            const type::Vec<12, Real> F = m_elementStiffness[i] * X;
+
+            for (unsigned int n = 0; n < 4; ++n)
+            {
+                Deriv& dfn = df[t[n]];
+                for (unsigned int c = 0; c < 3; ++c)
+                {
+                    dfn[c] -= kFactor * F[3 * n + c];
+                }
+            }
+        }
+    }
+    else if( method == SMALL )
     {
         for(it = _indexedElements->begin(), i = 0 ; it != _indexedElements->end() ; ++it, ++i)
         {
@@ -2022,18 +2058,119 @@ void TetrahedronFEMForceField<DataTypes>::addKToMatrix(const core::MechanicalPar
 }
 
 
+template<class DataTypes>
+std::shared_ptr<core::behavior::LinearizedOperator> TetrahedronFEMForceField<DataTypes>::createLinearizedOperator(const core::MechanicalParams* mparams)
+{
+    auto snapshot = std::make_shared<ElementStiffnessOperator>(this->mstate.get());
+
+    const Real kFactor = (Real)sofa::core::mechanicalparams::kFactorIncludingRayleighDamping(mparams, this->rayleighStiffness.getValue());
+    if (kFactor == 0 || _indexedElements == nullptr)
+    {
+        return snapshot;
+    }
+
+    // the element matrices are scaled once here, rather than at each product
+    snapshot->m_elements.assign(_indexedElements->begin(), _indexedElements->end());
+    snapshot->m_stiffness.resize(_indexedElements->size());
+    if (d_cacheElementStiffness.getValue())
+    {
+        updateElementStiffness();
+        for (std::size_t i = 0; i < m_elementStiffness.size(); ++i)
+        {
+            snapshot->m_stiffness[i] = m_elementStiffness[i] * (-kFactor);
+        }
+    }
+    else
+    {
+        StiffnessMatrix JKJt;
+        Transformation Rot;
+        Rot.identity();
+        for (std::size_t i = 0; i < _indexedElements->size(); ++i)
+        {
+            computeStiffnessMatrix(JKJt, snapshot->m_stiffness[i], materialsStiffnesses[i], strainDisplacements[i],
+                                   method == SMALL ? Rot : rotations[i]);
+            snapshot->m_stiffness[i] *= -kFactor;
+        }
+    }
+
+    return snapshot;
+}
+
+template<class DataTypes>
+void TetrahedronFEMForceField<DataTypes>::ElementStiffnessOperator::addMultiply(core::MultiVecDerivId dfId, core::ConstMultiVecDerivId dxId)
+{
+    helper::WriteAccessor<DataVecDeriv> df = *dfId[m_state].write();
+    helper::ReadAccessor<DataVecDeriv> dx = *dxId[m_state].read();
+
+    Displacement X;
+    for (std::size_t i = 0; i < m_elements.size(); ++i)
+    {
+        const Tetrahedron& t = m_elements[i];
+        for (unsigned int n = 0; n < 4; ++n)
+        {
+            for (unsigned int c = 0; c < 3; ++c)
+            {
+                X[3 * n + c] = dx[t[n]][c];
+            }
+        }
+
+        const type::Vec<12, Real> F = m_stiffness[i] * X;
+
+        for (unsigned int n = 0; n < 4; ++n)
+        {
+            Deriv& dfn = df[t[n]];
+            for (unsigned int c = 0; c < 3; ++c)
+            {
+                dfn[c] += F[3 * n + c];
+            }
+        }
+    }
+}
+
+template<class DataTypes>
+void TetrahedronFEMForceField<DataTypes>::updateElementStiffness()
+{
+    if (m_isElementStiffnessUpToDate && m_elementStiffness.size() == _indexedElements->size())
+    {
+        return;
+    }
+
+    m_elementStiffness.resize(_indexedElements->size());
+
+    StiffnessMatrix JKJt;
+    Transformation Rot;
+    Rot.identity();
+
+    for (std::size_t i = 0; i < _indexedElements->size(); ++i)
+    {
+        computeStiffnessMatrix(JKJt, m_elementStiffness[i], materialsStiffnesses[i], strainDisplacements[i],
+                               method == SMALL ? Rot : rotations[i]);
+    }
+
+    m_isElementStiffnessUpToDate = true;
+}
+
 template<class DataTypes>
 void TetrahedronFEMForceField<DataTypes>::addKToMatrix(sofa::linearalgebra::BaseMatrix *mat, SReal k, unsigned int &offset)
 {
+    if (d_cacheElementStiffness.getValue())
+    {
+        updateElementStiffness();
+
+        int IT = 0;
+        for(auto it = _indexedElements->begin() ; it != _indexedElements->end() ; ++it,++IT)
+        {
+            mat->addElementMatrix(offset, *it, m_elementStiffness[IT], -k);
+        }
+        return;
+    }
+
     int IT = 0;
     StiffnessMatrix JKJt,tmp;
 
     Transformation Rot;
     Rot.identity(); //set the transformation to identity
 
-    constexpr auto S = DataTypes::deriv_total_size; // size of node blocks
-    constexpr auto N = Element::size();
-
     for(auto it = _indexedElements->begin() ; it != _indexedElements->end() ; ++it,++IT)
     {
         if (method == SMALL)
@@ -2041,28 +2178,7 @@ void TetrahedronFEMForceField<DataTypes>::addKToMatrix(sofa::linearalgebra::Base
         else
             computeStiffnessMatrix(JKJt,tmp,materialsStiffnesses[IT], strainDisplacements[IT],rotations[IT]);
 
-        type::Mat<S, S, double> tmpBlock[4][4];
-        for (sofa::Index n1=0; n1 < N; n1++)
-        {
-            for(sofa::Index i=0; i < S; i++)
-            {
-                for (sofa::Index n2=0; n2 < N; n2++)
-                {
-                    for (sofa::Index j=0; j < S; j++)
-                    {
-                        tmpBlock[n1][n2][i][j] = - tmp[n1*S+i][n2*S+j]*k;
-                    }
-                }
-            }
-        }
-
-        for (sofa::Index n1=0; n1 < N; n1++)
-        {
-            for (sofa::Index n2=0; n2 < N; n2++)
-            {
-                mat->add(offset + (*it)[n1] * S, offset + (*it)[n2] * S, tmpBlock[n1][n2]);
-            }
-        }
+        mat->addElementMatrix(offset, *it, tmp, -k);
     }
 }
 
@@ -2081,6 +2197,7 @@ void TetrahedronFEMForceField<DataTypes>::handleEvent(core::objectmodel::Event *
                 Index d = (*it)[3];
                 this->computeMaterialStiffness(i,a,b,c,d);
             }
+            m_isElementStiffnessUpToDate = false;
         }
     }
     if (sofa::simulation::AnimateEndEvent::checkEventType(event)) {
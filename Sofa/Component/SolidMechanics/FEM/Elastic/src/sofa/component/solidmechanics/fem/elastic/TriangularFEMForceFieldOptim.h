@@ -26,6 +26,7 @@
 #include <sofa/defaulttype/VecTypes.h>
 #include <sofa/type/Mat.h>
 #include <sofa/core/topology/TopologyData.h>
+#include <sofa/simulation/ParallelElementAssembly.h>
 
 #include <sofa/type/trait/Rebind.h>
 
@@ -232,6 +233,7 @@ public:
     Data<Real> d_young; ///< Young modulus in Hooke's law
     Data<Real> d_damping; ///< Ratio damping/stiffness
     Data<Real> d_restScale; ///< Scale factor applied to rest positions (to simulate pre-stretched materials)
+    Data<bool> d_multithreading; ///< Accumulate the forces of the triangles in parallel
 
     /// Display parameters
     Data<bool> d_showStressValue;
@@ -246,6 +248,10 @@ protected:
 
     /// Pointer to the topology container. Will be set by link @sa l_topology
     sofa::core::topology::BaseMeshTopology* m_topology;
+
+    /// Task scheduler used to accumulate the forces in parallel (nullptr if d_multithreading is false)
+    simulation::TaskScheduler* m_taskScheduler { nullptr };
+    simulation::ParallelElementAccumulator<VecDeriv> m_elementAccumulator;
 };
 
 
@@ -24,6 +24,7 @@
 #include <sofa/core/behavior/BlocMatrixWriter.h>
 #include <sofa/core/visual/VisualParams.h>
 #include <sofa/core/topology/TopologyData.inl>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
 #include <limits>
 
 
@@ -41,6 +42,7 @@ TriangularFEMForceFieldOptim<DataTypes>::TriangularFEMForceFieldOptim()
     , d_young(initData(&d_young,(Real)(1000.0),"youngModulus","Young modulus in Hooke's law"))
     , d_damping(initData(&d_damping,(Real)0.,"damping","Ratio damping/stiffness"))
     , d_restScale(initData(&d_restScale,(Real)1.,"restScale","Scale factor applied to rest positions (to simulate pre-stretched materials)"))
+    , d_multithreading(initData(&d_multithreading, false, "multithreading", "Accumulate the forces of the triangles in parallel, using the main task scheduler"))
     , d_showStressVector(initData(&d_showStressVector,false,"showStressVector","Flag activating rendering of stress directions within each triangle"))
     , d_showStressMaxValue(initData(&d_showStressMaxValue,(Real)0.0,"showStressMaxValue","Max value for rendering of stress values"))
     , l_topology(initLink("topology", "link to the topology container"))
@@ -67,6 +69,19 @@ void TriangularFEMForceFieldOptim<DataTypes>::init()
 {
     this->Inherited::init();
 
+    if (d_multithreading.getValue())
+    {
+        m_taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+        if (m_taskScheduler->getThreadCount() == 0)
+        {
+            m_taskScheduler->init();
+        }
+    }
+    else
+    {
+        m_taskScheduler = nullptr;
+    }
+
     if (l_topology.empty())
     {
         msg_info() << "link to Topology container should be set to ensure right behavior. First Topology found in current context will be used.";
@@ -265,74 +280,75 @@ void TriangularFEMForceFieldOptim<DataTypes>::addForce(const core::MechanicalPar
 
     f.resize(x.size());
 
-    for ( Index i=0; i<nbTriangles; i+=1)
-    {
-        Triangle t = triangles[i];
-        const TriangleInfo& ti = triInfo[i];
-        TriangleState& ts = triState[i];
-        Coord a = x[t[0]];
-        Coord ab = x[t[1]] -a;
-        Coord ac = x[t[2]] -a;
-
-        computeTriangleRotation(ts.frame, ab, ac);
-
-        // Displacement in local space (rest pos - current pos), dby == 0
-        Real dbx = ti.bx - ts.frame[0] * ab;
-        Real dcx = ti.cx - ts.frame[0] * ac;
-        Real dcy = ti.cy - ts.frame[1] * ac;
-
-        /// Full StrainDisplacement matrix.
-        // | beta1  0       beta2  0        beta3  0      |
-        // | 0      gamma1  0      gamma2   0      gamma3 | / (2 * A)
-        // | gamma1 beta1   gamma2 beta2    gamma3 beta3 |
-
-        // As no displacement for Pa nor in Pb[y], Beta1, gamma1 and beta3 are not considered. Therefor we obtain:
-        // | beta2  0        beta3  0      |
-        // | 0      gamma2   0      gamma3 | / (2 * A)
-        // | gamma2 beta2    gamma3 beta3 |
-
-        // |   cy     0     0      0   |
-        // |   0     -cx    0      bx  |
-        // |  -cx     cy    bx     0   |
-
-        // Directly apply division by determinant(Area = det * 0.5 in local space; det = bx * cy)
-        // |   1/bx        0        0        0   |
-        // |   0       -cx/(bx*cy)  0       1/cy |
-        // | -cx/(bx*cy)  1/bx     1/cy      0   |
-
-        // StrainDisplacement:
-        // beta2 = ti.cy;
-        // gamma2 = -ti.cx;
-        // gamma3 = ti.bx;
-
-        // Strain = StrainDisplacement * Displacement
-        type::Vec<3,Real> strain (
-            ti.cy * dbx,                   // ( cy,   0,  0,  0) * (dbx, dby(0), dcx, dcy)
-            ti.bx * dcy,                   // (  0, -cx,  0, bx) * (dbx, dby(0), dcx, dcy)
-            ti.bx * dcx - ti.cx * dbx);    // ( -cx, cy, bx,  0) * (dbx, dby(0), dcx, dcy)
-
-        // Stress = K * Strain
-        Real gammaXY = gamma * (strain[0] + strain[1]);
-        type::Vec<3,Real> stress (
-            mu*strain[0] + gammaXY,      // (gamma+mu, gamma   ,    0) * strain
-            mu*strain[1] + gammaXY,      // (gamma   , gamma+mu,    0) * strain
-            (Real)(0.5)*mu*strain[2]);   // (       0,        0, mu/2) * strain
-
-        stress *= ti.ss_factor;
-
-        Deriv fb = ts.frame[0] * (ti.cy * stress[0] - ti.cx * stress[2])  // (cy,   0, -cx) * stress
-                + ts.frame[1] * (ti.cy * stress[2] - ti.cx * stress[1]);  // ( 0, -cx,  cy) * stress
-        Deriv fc = ts.frame[0] * (ti.bx * stress[2])                      // ( 0,   0,  bx) * stress
-                + ts.frame[1] * (ti.bx * stress[1]);                      // ( 0,  bx,   0) * stress
-        Deriv fa = -fb-fc;
-
-        f[t[0]] += fa;
-        f[t[1]] += fb;
-        f[t[2]] += fc;
-
-        // store data for re-use
-        ts.stress = stress;
-    }
+    m_elementAccumulator.accumulate(m_taskScheduler, nbTriangles, f.wref(),
+        [&](const Index i, VecDeriv& fOut)
+        {
+            Triangle t = triangles[i];
+            const TriangleInfo& ti = triInfo[i];
+            TriangleState& ts = triState[i];
+            Coord a = x[t[0]];
+            Coord ab = x[t[1]] -a;
+            Coord ac = x[t[2]] -a;
+
+            computeTriangleRotation(ts.frame, ab, ac);
+
+            // Displacement in local space (rest pos - current pos), dby == 0
+            Real dbx = ti.bx - ts.frame[0] * ab;
+            Real dcx = ti.cx - ts.frame[0] * ac;
+            Real dcy = ti.cy - ts.frame[1] * ac;
+
+            /// Full StrainDisplacement matrix.
+            // | beta1  0       beta2  0        beta3  0      |
+            // | 0      gamma1  0      gamma2   0      gamma3 | / (2 * A)
+            // | gamma1 beta1   gamma2 beta2    gamma3 beta3 |
+
+            // As no displacement for Pa nor in Pb[y], Beta1, gamma1 and beta3 are not considered. Therefor we obtain:
+            // | beta2  0        beta3  0      |
+            // | 0      gamma2   0      gamma3 | / (2 * A)
+            // | gamma2 beta2    gamma3 beta3 |
+
+            // |   cy     0     0      0   |
+            // |   0     -cx    0      bx  |
+            // |  -cx     cy    bx     0   |
+
+            // Directly apply division by determinant(Area = det * 0.5 in local space; det = bx * cy)
+            // |   1/bx        0        0        0   |
+            // |   0       -cx/(bx*cy)  0       1/cy |
+            // | -cx/(bx*cy)  1/bx     1/cy      0   |
+
+            // StrainDisplacement:
+            // beta2 = ti.cy;
+            // gamma2 = -ti.cx;
+            // gamma3 = ti.bx;
+
+            // Strain = StrainDisplacement * Displacement
+            type::Vec<3,Real> strain (
+                ti.cy * dbx,                   // ( cy,   0,  0,  0) * (dbx, dby(0), dcx, dcy)
+                ti.bx * dcy,                   // (  0, -cx,  0, bx) * (dbx, dby(0), dcx, dcy)
+                ti.bx * dcx - ti.cx * dbx);    // ( -cx, cy, bx,  0) * (dbx, dby(0), dcx, dcy)
+
+            // Stress = K * Strain
+            Real gammaXY = gamma * (strain[0] + strain[1]);
+            type::Vec<3,Real> stress (
+                mu*strain[0] + gammaXY,      // (gamma+mu, gamma   ,    0) * strain
+                mu*strain[1] + gammaXY,      // (gamma   , gamma+mu,    0) * strain
+                (Real)(0.5)*mu*strain[2]);   // (       0,        0, mu/2) * strain
+
+            stress *= ti.ss_factor;
+
+            Deriv fb = ts.frame[0] * (ti.cy * stress[0] - ti.cx * stress[2])  // (cy,   0, -cx) * stress
+                    + ts.frame[1] * (ti.cy * stress[2] - ti.cx * stress[1]);  // ( 0, -cx,  cy) * stress
+            Deriv fc = ts.frame[0] * (ti.bx * stress[2])                      // ( 0,   0,  bx) * stress
+                    + ts.frame[1] * (ti.bx * stress[1]);                      // ( 0,  bx,   0) * stress
+            Deriv fa = -fb-fc;
+
+            fOut[t[0]] += fa;
+            fOut[t[1]] += fb;
+            fOut[t[2]] += fc;
+
+            // store data for re-use
+            ts.stress = stress;
+        });
 }
 
 // --------------------------------------------------------------------------------------
@@ -354,45 +370,46 @@ void TriangularFEMForceFieldOptim<DataTypes>::addDForce(const core::MechanicalPa
 
     df.resize(dx.size());
 
-    for ( Index i=0; i<nbTriangles; i+=1)
-    {
-        Triangle t = triangles[i];
-        const TriangleInfo& ti = triInfo[i];
-        const TriangleState& ts = triState[i];
-        Deriv da  = dx[t[0]];
-        Deriv dab = dx[t[1]]-da;
-        Deriv dac = dx[t[2]]-da;
-
-        Real dbx = ts.frame[0]*dab;
-        Real dby = ts.frame[1]*dab;
-        Real dcx = ts.frame[0]*dac;
-        Real dcy = ts.frame[1]*dac;
-
-        // Strain = StrainDisplacement * Displacement
-        type::Vec<3, Real> dstrain(
-            ti.cy * dbx,                                // ( cy,   0,  0,  0) * (dbx, dby, dcx, dcy)
-            ti.bx * dcy - ti.cx * dby,                  // (  0, -cx,  0, bx) * (dbx, dby, dcx, dcy)
-            ti.bx * dcx - ti.cx * dbx + ti.cy * dby);   // ( -cx, cy, bx,  0) * (dbx, dby, dcx, dcy)
-
-
-        // Stress = K * Strain
-        Real gammaXY = gamma*(dstrain[0]+dstrain[1]);
-        type::Vec<3,Real> dstress (
-            mu*dstrain[0] + gammaXY,        // (gamma+mu, gamma   ,    0) * dstrain
-            mu*dstrain[1] + gammaXY,        // (gamma   , gamma+mu,    0) * dstrain
-            (Real)(0.5)*mu*dstrain[2]);     // (       0,        0, mu/2) * dstrain
-
-        dstress *= ti.ss_factor * kFactor;
-        Deriv dfb = ts.frame[0] * (ti.cy * dstress[0] - ti.cx * dstress[2])  // (cy,   0, -cx) * stress
-            + ts.frame[1] * (ti.cy * dstress[2] - ti.cx * dstress[1]);       // ( 0, -cx,  cy) * stress
-        Deriv dfc = ts.frame[0] * (ti.bx * dstress[2])                       // ( 0,   0,  bx) * stress
-            + ts.frame[1] * (ti.bx * dstress[1]);                            // ( 0,  bx,   0) * stress
-        Deriv dfa = -dfb - dfc;
-
-        df[t[0]] -= dfa;
-        df[t[1]] -= dfb;
-        df[t[2]] -= dfc;
-    }
+    m_elementAccumulator.accumulate(m_taskScheduler, nbTriangles, df.wref(),
+        [&](const Index i, VecDeriv& dfOut)
+        {
+            Triangle t = triangles[i];
+            const TriangleInfo& ti = triInfo[i];
+            const TriangleState& ts = triState[i];
+            Deriv da  = dx[t[0]];
+            Deriv dab = dx[t[1]]-da;
+            Deriv dac = dx[t[2]]-da;
+
+            Real dbx = ts.frame[0]*dab;
+            Real dby = ts.frame[1]*dab;
+            Real dcx = ts.frame[0]*dac;
+            Real dcy = ts.frame[1]*dac;
+
+            // Strain = StrainDisplacement * Displacement
+            type::Vec<3, Real> dstrain(
+                ti.cy * dbx,                                // ( cy,   0,  0,  0) * (dbx, dby, dcx, dcy)
+                ti.bx * dcy - ti.cx * dby,                  // (  0, -cx,  0, bx) * (dbx, dby, dcx, dcy)
+                ti.bx * dcx - ti.cx * dbx + ti.cy * dby);   // ( -cx, cy, bx,  0) * (dbx, dby, dcx, dcy)
+
+
+            // Stress = K * Strain
+            Real gammaXY = gamma*(dstrain[0]+dstrain[1]);
+            type::Vec<3,Real> dstress (
+                mu*dstrain[0] + gammaXY,        // (gamma+mu, gamma   ,    0) * dstrain
+                mu*dstrain[1] + gammaXY,        // (gamma   , gamma+mu,    0) * dstrain
+                (Real)(0.5)*mu*dstrain[2]);     // (       0,        0, mu/2) * dstrain
+
+            dstress *= ti.ss_factor * kFactor;
+            Deriv dfb = ts.frame[0] * (ti.cy * dstress[0] - ti.cx * dstress[2])  // (cy,   0, -cx) * stress
+                + ts.frame[1] * (ti.cy * dstress[2] - ti.cx * dstress[1]);       // ( 0, -cx,  cy) * stress
+            Deriv dfc = ts.frame[0] * (ti.bx * dstress[2])                       // ( 0,   0,  bx) * stress
+                + ts.frame[1] * (ti.bx * dstress[1]);                            // ( 0,  bx,   0) * stress
+            Deriv dfa = -dfb - dfc;
+
+            dfOut[t[0]] -= dfa;
+            dfOut[t[1]] -= dfb;
+            dfOut[t[2]] -= dfc;
+        });
 }
 
 
@@ -43,6 +43,9 @@ using sofa::simulation::SceneLoaderXML ;
 #include <sofa/component/statecontainer/MechanicalObject.h>
 #include <sofa/component/solidmechanics/fem/elastic/TetrahedralCorotationalFEMForceField.h>
 #include <sofa/component/solidmechanics/fem/elastic/FastTetrahedralCorotationalForceField.h>
+#include <sofa/core/MechanicalParams.h>
+#include <sofa/core/behavior/LinearSolver.h>
+#include <sofa/linearalgebra/FullMatrix.h>
 
 using sofa::core::execparams::defaultInstance; 
 
@@ -869,6 +872,144 @@ public:
     }
 
 
+    /// Compare the simulation of a beam solved with a CGLinearSolver computing its products with visitors, and with
+    /// the snapshot of the linearized operators of the components
+    void checkLinearizedOperatorSnapshot(bool cacheElementStiffness)
+    {
+        const auto simulate = [this, cacheElementStiffness](bool snapshotOperators)
+        {
+            createGridFEMScene(0, type::Vec3(3, 8, 3));
+
+            auto* linearSolver = m_root->getTreeObject<core::behavior::LinearSolver>();
+            auto* tetraFEM = m_root->getTreeObject<TetrahedronFEM>();
+            EXPECT_NE(linearSolver, nullptr);
+            EXPECT_NE(tetraFEM, nullptr);
+            linearSolver->findData("snapshotOperators")->read(snapshotOperators ? "true" : "false");
+            tetraFEM->d_cacheElementStiffness.setValue(cacheElementStiffness);
+
+            {
+                // an error is emitted if the operators cannot be snapshotted
+                EXPECT_MSG_NOEMIT(Error);
+                for (int i = 0; i < 10; i++)
+                {
+                    m_simulation->animate(m_root.get(), 0.01);
+                }
+            }
+
+            const VecCoord positions = m_root->getTreeObject<MState>()->x.getValue();
+            m_simulation->unload(m_root);
+            m_root = nullptr;
+            return positions;
+        };
+
+        const VecCoord expected = simulate(false);
+        const VecCoord positions = simulate(true);
+
+        ASSERT_EQ(positions.size(), expected.size());
+        for (std::size_t i = 0; i < positions.size(); ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                EXPECT_NEAR(positions[i][j], expected[i][j], 1e-8);
+            }
+        }
+
+        // the beam falls under gravity
+        EXPECT_GT(positions.back()[1], 40.0);
+    }
+
+    /// The snapshot of the operators does not support the mechanical mappings: the linear solver is invalid
+    void checkLinearizedOperatorSnapshotWithMapping()
+    {
+        createGridFEMScene(0, type::Vec3(3, 8, 3));
+        sofa::simpleapi::importPlugin("Sofa.Component.Mapping.Linear");
+
+        Node::SPtr mappedNode = sofa::simpleapi::createChild(m_root->getChild("Beam"), "Mapped");
+        createObject(mappedNode, "MechanicalObject", { {"template", dataTypeName} });
+        createObject(mappedNode, "IdentityMapping");
+        mappedNode->init(core::execparams::defaultInstance());
+
+        auto* linearSolver = m_root->getTreeObject<core::behavior::LinearSolver>();
+        ASSERT_NE(linearSolver, nullptr);
+        EXPECT_TRUE(linearSolver->isComponentStateValid());
+
+        linearSolver->findData("snapshotOperators")->read("true");
+        {
+            EXPECT_MSG_EMIT(Error);
+            linearSolver->init();
+        }
+        EXPECT_FALSE(linearSolver->isComponentStateValid());
+    }
+
+
+    /// Compare addDForce and addKToMatrix with and without the cached element stiffness matrices,
+    /// in two successive deformed configurations
+    void checkCachedElementStiffness(const std::string& method)
+    {
+        using Deriv = typename DataTypes::Deriv;
+        using VecDeriv = typename DataTypes::VecDeriv;
+
+        createSingleTetrahedronFEMScene(0, static_cast<Real>(1000), static_cast<Real>(0.3), method);
+
+        typename TetrahedronFEM::SPtr tetraFEM = m_root->getTreeObject<TetrahedronFEM>();
+        ASSERT_TRUE(tetraFEM.get() != nullptr);
+
+        core::MechanicalParams mparams;
+        mparams.setKFactor(0.5);
+
+        const VecDeriv dx { Deriv(0.1, -0.2, 0.3), Deriv(-0.4, 0.1, 0), Deriv(0.2, 0.2, -0.1), Deriv(0, -0.3, 0.5) };
+
+        const auto computeDForce = [&](const VecCoord& x, bool cache, linearalgebra::FullMatrix<SReal>& K)
+        {
+            tetraFEM->d_cacheElementStiffness.setValue(cache);
+
+            core::objectmodel::Data<VecCoord> xData;
+            xData.setValue(x);
+            core::objectmodel::Data<VecDeriv> f, v, df, dxData;
+            v.setValue(VecDeriv(x.size()));
+            dxData.setValue(dx);
+
+            tetraFEM->addForce(&mparams, f, xData, v);
+            tetraFEM->addDForce(&mparams, df, dxData);
+
+            K.resize(12, 12);
+            unsigned int offset = 0;
+            tetraFEM->addKToMatrix(&K, 0.5, offset);
+
+            return df.getValue();
+        };
+
+        const std::vector<VecCoord> configurations {
+            VecCoord { Coord(0, 0, 0), Coord(1.1, 0.1, 0), Coord(-0.1, 0.9, 0.2), Coord(0.1, 0, 1.2) },
+            VecCoord { Coord(0, 0, 0.1), Coord(0.8, 0.5, 0), Coord(-0.5, 0.8, 0), Coord(0, -0.2, 0.9) }
+        };
+
+        for (const auto& x : configurations)
+        {
+            linearalgebra::FullMatrix<SReal> K, cachedK;
+            const VecDeriv df = computeDForce(x, false, K);
+            const VecDeriv cachedDf = computeDForce(x, true, cachedK);
+
+            ASSERT_EQ(df.size(), cachedDf.size());
+            for (std::size_t i = 0; i < df.size(); ++i)
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    EXPECT_NEAR(df[i][j], cachedDf[i][j], 1e-10);
+                }
+            }
+
+            for (int i = 0; i < 12; ++i)
+            {
+                for (int j = 0; j < 12; ++j)
+                {
+                    EXPECT_NEAR(K.element(i, j), cachedK.element(i, j), 1e-10);
+                }
+            }
+        }
+    }
+
+
 };
 
 
@@ -944,6 +1085,36 @@ TEST_F(TetrahedronFEMForceField3_test, checkFEMValues)
     this->checkFEMValues(0);
 }
 
+TEST_F(TetrahedronFEMForceField3_test, checkCachedElementStiffnessSmall)
+{
+    this->checkCachedElementStiffness("small");
+}
+
+TEST_F(TetrahedronFEMForceField3_test, checkCachedElementStiffnessLarge)
+{
+    this->checkCachedElementStiffness("large");
+}
+
+TEST_F(TetrahedronFEMForceField3_test, checkCachedElementStiffnessPolar)
+{
+    this->checkCachedElementStiffness("polar");
+}
+
+TEST_F(TetrahedronFEMForceField3_test, checkLinearizedOperatorSnapshot)
+{
+    this->checkLinearizedOperatorSnapshot(false);
+}
+
+TEST_F(TetrahedronFEMForceField3_test, checkLinearizedOperatorSnapshotWithCachedStiffness)
+{
+    this->checkLinearizedOperatorSnapshot(true);
+}
+
+TEST_F(TetrahedronFEMForceField3_test, checkLinearizedOperatorSnapshotWithMapping)
+{
+    this->checkLinearizedOperatorSnapshotWithMapping();
+}
+
 
 
 typedef TetrahedronFEMForceField_test<Vec3Types> TetrahedralCorotationalFEMForceField3_test;
@@ -547,21 +547,25 @@ void  StandardTetrahedralFEMForceField<DataTypes>::addKToMatrix(sofa::linearalge
 
     const edgeInformationVector& edgeInf = edgeInfo.getValue();
 
+    // stiffness matrix of an edge
+    type::Mat<6, 6, Real> K;
+
     for (unsigned int l = 0; l < nbEdges; ++l)
     {
-        const auto& einfo = edgeInf[l];
-        const Index node0 = edgeArray[l][0];
-        const Index node1 = edgeArray[l][1];
-        const unsigned int N0 = offset + 3 * node0;
-        const unsigned int N1 = offset + 3 * node1;
-
-        const Matrix3 stiff = einfo.DfDx * (Real)kFact;
-        const Matrix3 stiffTransposed = stiff.transposed();
-
-        mat->add(N0,N0,  stiffTransposed);
-        mat->add(N1,N1,  stiff);
-        mat->add(N0,N1, -stiffTransposed);
-        mat->add(N1,N0, -stiff);
+        const Matrix3& stiff = edgeInf[l].DfDx;
+
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            for (unsigned int j = 0; j < 3; ++j)
+            {
+                K[i    ][j    ] =  stiff[j][i];
+                K[i    ][j + 3] = -stiff[j][i];
+                K[i + 3][j    ] = -stiff[i][j];
+                K[i + 3][j + 3] =  stiff[i][j];
+            }
+        }
+
+        mat->addElementMatrix(offset, edgeArray[l], K, kFact);
     }
 }
 
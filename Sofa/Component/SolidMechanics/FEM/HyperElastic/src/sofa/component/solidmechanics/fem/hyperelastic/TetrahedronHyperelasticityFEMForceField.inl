@@ -502,24 +502,25 @@ void TetrahedronHyperelasticityFEMForceField<DataTypes>::addKToMatrix(sofa::line
     const type::vector< Edge> &edgeArray=m_topology->getEdges() ;
     auto edgeInf = sofa::helper::getWriteAccessor(m_edgeInfo);
 
+    // stiffness matrix of an edge
+    type::Mat<6, 6, Real> K;
+
     for (unsigned int l = 0; l < nbEdges; l++)
     {
         EdgeInformation* einfo = &edgeInf[l];
-        const Index noeud0 = edgeArray[l][0];
-        const Index noeud1 = edgeArray[l][1];
-        const unsigned int N0 = offset + 3 * noeud0;
-        const unsigned int N1 = offset + 3 * noeud1;
 
         for (unsigned int i = 0; i < 3; i++)
         {
             for (unsigned int j = 0; j < 3; j++)
             {
-                mat->add(N0 + i, N0 + j, + einfo->DfDx[j][i] * k);
-                mat->add(N0 + i, N1 + j, - einfo->DfDx[j][i] * k);
-                mat->add(N1 + i, N0 + j, - einfo->DfDx[i][j] * k);
-                mat->add(N1 + i, N1 + j, + einfo->DfDx[i][j] * k);
+                K[i    ][j    ] = + einfo->DfDx[j][i];
+                K[i    ][j + 3] = - einfo->DfDx[j][i];
+                K[i + 3][j    ] = - einfo->DfDx[i][j];
+                K[i + 3][j + 3] = + einfo->DfDx[i][j];
             }
         }
+
+        mat->addElementMatrix(offset, edgeArray[l], K, k);
     }
 }
 
@@ -23,6 +23,7 @@
 #include <sofa/component/solidmechanics/spring/config.h>
 
 #include <sofa/component/solidmechanics/spring/StiffSpringForceField.h>
+#include <sofa/simulation/ParallelElementAssembly.h>
 #include <set>
 
 namespace sofa::component::solidmechanics::spring
@@ -65,6 +66,9 @@ protected:
     /// optional range of local DOF indices. Any computation involving only indices outside of this range are discarded (useful for parallelization using mesh partitionning)
     Data< type::Vec<2, sofa::Index> > d_localRange;
 
+    /// Accumulate the forces of the springs in parallel
+    Data< bool >  d_multithreading;
+
     /// Link to be set to the topology container in the component graph.
     SingleLink<MeshSpringForceField<DataTypes>, sofa::core::topology::BaseMeshTopology, BaseLink::FLAG_STOREPATH | BaseLink::FLAG_STRONGLINK> l_topology;
 
@@ -72,6 +76,13 @@ protected:
 
     MeshSpringForceField() ;
     virtual ~MeshSpringForceField();
+
+    /// Task scheduler used to accumulate the forces in parallel (nullptr if d_multithreading is false)
+    simulation::TaskScheduler* m_taskScheduler { nullptr };
+    simulation::ParallelElementAccumulator<VecDeriv> m_springAccumulator;
+
+    /// Potential energy of each spring, summed in the order of the springs after a parallel addForce
+    sofa::type::vector<Real> m_springEnergies;
 public:
     Real getStiffness() const { return d_linesStiffness.getValue(); }
     Real getLinesStiffness() const { return d_linesStiffness.getValue(); }
@@ -145,6 +156,11 @@ public:
 
     void init() override;
 
+    /// Accumulate f corresponding to x,v, in parallel if d_multithreading is set
+    void addForce(const sofa::core::MechanicalParams* mparams, DataVecDeriv& data_f1, DataVecDeriv& data_f2, const DataVecCoord& data_x1, const DataVecCoord& data_x2, const DataVecDeriv& data_v1, const DataVecDeriv& data_v2 ) override;
+    /// Accumulate df corresponding to dx, in parallel if d_multithreading is set
+    void addDForce(const core::MechanicalParams* mparams, DataVecDeriv& data_df1, DataVecDeriv& data_df2, const DataVecDeriv& data_dx1, const DataVecDeriv& data_dx2) override;
+
     void draw(const core::visual::VisualParams* vparams) override;
 };
 
@@ -25,6 +25,7 @@
 #include <sofa/core/visual/VisualParams.h>
 #include <sofa/core/topology/BaseMeshTopology.h>
 #include <sofa/type/RGBAColor.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
 #include <iostream>
 
 namespace sofa::component::solidmechanics::spring
@@ -47,6 +48,7 @@ MeshSpringForceField<DataTypes>::MeshSpringForceField()
     , d_drawMaxElongationRange(initData(&d_drawMaxElongationRange, Real(15.), "drawMaxElongationRange","Max range of elongation (red eongation - blue neutral - green compression)"))
     , d_drawSpringSize(initData(&d_drawSpringSize, Real(8.), "drawSpringSize","Size of drawed lines"))
     , d_localRange( initData(&d_localRange, type::Vec<2, sofa::Index>(sofa::InvalidID, sofa::InvalidID), "localRange", "optional range of local DOF indices. Any computation involving only indices outside of this range are discarded (useful for parallelization using mesh partitionning)" ) )
+    , d_multithreading(initData(&d_multithreading, false, "multithreading", "Accumulate the forces of the springs in parallel, using the main task scheduler"))
     , l_topology(initLink("topology", "link to the topology container"))
 {
 	this->ks.setDisplayed(false);
@@ -207,6 +209,77 @@ void MeshSpringForceField<DataTypes>::init()
     }
 
     StiffSpringForceField<DataTypes>::init();
+
+    // the springs are accumulated in parallel only if both ends of the springs are in the same state
+    if (d_multithreading.getValue() && mstate1 == mstate2)
+    {
+        m_taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+        if (m_taskScheduler->getThreadCount() == 0)
+        {
+            m_taskScheduler->init();
+        }
+    }
+    else
+    {
+        m_taskScheduler = nullptr;
+    }
+}
+
+template<class DataTypes>
+void MeshSpringForceField<DataTypes>::addForce(const sofa::core::MechanicalParams* mparams, DataVecDeriv& data_f1, DataVecDeriv& data_f2, const DataVecCoord& data_x1, const DataVecCoord& data_x2, const DataVecDeriv& data_v1, const DataVecDeriv& data_v2 )
+{
+    if (m_taskScheduler == nullptr || &data_f1 != &data_f2)
+    {
+        Inherit1::addForce(mparams, data_f1, data_f2, data_x1, data_x2, data_v1, data_v2);
+        return;
+    }
+
+    const VecCoord& x = data_x1.getValue();
+    const VecDeriv& v = data_v1.getValue();
+    sofa::helper::WriteOnlyAccessor<sofa::Data<VecDeriv> > f = sofa::helper::getWriteOnlyAccessor(data_f1);
+
+    const type::vector<typename Inherit1::Spring>& springs = this->springs.getValue();
+    f.resize(x.size());
+    this->dfdx.resize(springs.size());
+    m_springEnergies.resize(springs.size());
+
+    m_springAccumulator.accumulate(m_taskScheduler, springs.size(), f.wref(),
+        [this, &x, &v, &springs](const sofa::Index i, VecDeriv& fOut)
+        {
+            Real energy = 0;
+            this->addSpringForce(energy, fOut, x, v, fOut, x, v, i, springs[i]);
+            m_springEnergies[i] = energy;
+        });
+
+    this->m_potentialEnergy = 0;
+    for (const Real energy : m_springEnergies)
+    {
+        this->m_potentialEnergy += energy;
+    }
+}
+
+template<class DataTypes>
+void MeshSpringForceField<DataTypes>::addDForce(const core::MechanicalParams* mparams, DataVecDeriv& data_df1, DataVecDeriv& data_df2, const DataVecDeriv& data_dx1, const DataVecDeriv& data_dx2)
+{
+    if (m_taskScheduler == nullptr || &data_df1 != &data_df2)
+    {
+        Inherit1::addDForce(mparams, data_df1, data_df2, data_dx1, data_dx2);
+        return;
+    }
+
+    sofa::helper::WriteOnlyAccessor<sofa::Data<VecDeriv> > df = sofa::helper::getWriteOnlyAccessor(data_df1);
+    const VecDeriv& dx = data_dx1.getValue();
+    const Real kFactor = (Real)sofa::core::mechanicalparams::kFactorIncludingRayleighDamping(mparams, this->rayleighStiffness.getValue());
+    const Real bFactor = (Real)sofa::core::mechanicalparams::bFactor(mparams);
+
+    const type::vector<typename Inherit1::Spring>& springs = this->springs.getValue();
+    df.resize(dx.size());
+
+    m_springAccumulator.accumulate(m_taskScheduler, springs.size(), df.wref(),
+        [this, &dx, &springs, kFactor, bFactor](const sofa::Index i, VecDeriv& dfOut)
+        {
+            this->addSpringDForce(dfOut, dx, dfOut, dx, i, springs[i], kFactor, bFactor);
+        });
 }
 
 
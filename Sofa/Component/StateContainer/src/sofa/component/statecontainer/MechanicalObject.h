@@ -35,6 +35,11 @@
 
 #include <fstream>
 
+namespace sofa::simulation
+{
+class TaskScheduler;
+}
+
 namespace sofa::component::statecontainer
 {
 
@@ -114,6 +119,7 @@ public:
     Data< float > showVectorsScale; ///< Scale for vectors display. (default=0.0001)
     Data< int > drawMode; ///< The way vectors will be drawn: - 0: Line - 1:Cylinder - 2: Arrow.  The DOFS will be drawn: - 0: point - >1: sphere. (default=0)
     Data< type::RGBAColor > d_color;  ///< drawing color
+    Data< bool > d_parallelVectorOperations; ///< Compute the vector operations (vOp, vDot) and the bounding box in parallel
 
     void init() override;
     void reinit() override;
@@ -208,6 +214,9 @@ public:
     /// Bounding Box computation method.
     void computeBBox(const core::ExecParams* params, bool onlyVisible=false) override;
 
+    /// Add the memory allocated by the state vectors (static and dynamic) to the footprint of the other Data
+    std::size_t getMemoryFootprint() const override;
+
     /// @name Base Matrices and Vectors Interface
     /// @{
 
@@ -375,6 +384,11 @@ protected :
     sofa::type::vector< Data< VecDeriv >    * > vectorsDeriv; ///< Derivates DOFs vectors table (static and dynamic allocated)
     sofa::type::vector< Data< MatrixDeriv > * > vectorsMatrixDeriv; ///< Constraint vectors table
 
+    /// Buffers of the freed temporary vectors, handed over to the next allocated ones.
+    /// Temporary vectors being allocated and freed at each time step, whatever their VecId, this avoids reallocations.
+    sofa::type::vector< VecCoord > m_releasedCoordBuffers;
+    sofa::type::vector< VecDeriv > m_releasedDerivBuffers;
+
     /**
      * @brief Inserts VecCoord DOF coordinates vector at index in the vectorsCoord container.
      */
@@ -411,6 +425,14 @@ protected :
     template<core::VecType vtype>
     void vFreeImpl(core::TVecId<vtype, core::V_WRITE> v);
 
+    /// Buffers of the freed temporary vectors of the provided VecType
+    template<core::VecType vtype>
+    sofa::type::vector< core::StateVecType_t<DataTypes, vtype> >& getReleasedBuffers();
+
+    /// Resize an empty vector, reusing the buffer of a freed temporary vector if its own capacity is not sufficient
+    template<core::VecType vtype>
+    void resizeFromReleasedBuffers(core::StateVecType_t<DataTypes, vtype>& vec, sofa::Size size);
+
     /// Generic implementation of the method vInit
     template<core::VecType vtype>
     void vInitImpl(const core::ExecParams* params,
@@ -432,6 +454,18 @@ protected :
     helper::ReadAccessor<core::objectmodel::Data<core::StateVecType_t<DataTypes, vtype> > >
         getReadAccessor(core::ConstVecId v);
 
+    /// Applies f to the indices [0, n), in parallel if d_parallelVectorOperations is set
+    template<class Function>
+    void forEachIndex(std::size_t n, Function f);
+
+    /// Reduces the indices [0, n) (see simulation::reduce), in parallel if d_parallelVectorOperations is set.
+    /// The result is identical from a run to the next.
+    template<class T, class MapFunction, class CombineFunction>
+    T reduceIndices(std::size_t n, T identity, MapFunction map, CombineFunction combine);
+
+    /// Task scheduler used for the vector operations, nullptr if they are sequential
+    simulation::TaskScheduler* m_taskScheduler { nullptr };
+
     /**
     * @brief Internal function : Draw indices in 3d coordinates.
     */
@@ -33,6 +33,8 @@
 #include <sofa/helper/accessor.h>
 #include <sofa/simulation/Node.h>
 #include <sofa/defaulttype/DataTypeOperations.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/ParallelReduce.h>
 
 #ifdef SOFA_DUMP_VISITOR_INFO
 #include <sofa/simulation/Visitor.h>
@@ -154,6 +156,7 @@ MechanicalObject<DataTypes>::MechanicalObject()
     , showVectorsScale(initData(&showVectorsScale, 0.0001f, "showVectorsScale", "Scale for vectors display. (default=0.0001)"))
     , drawMode(initData(&drawMode,0,"drawMode","The way vectors will be drawn:\n- 0: Line\n- 1:Cylinder\n- 2: Arrow.\n\nThe DOFS will be drawn:\n- 0: point\n- >1: sphere. (default=0)"))
     , d_color(initData(&d_color, type::RGBAColor::white(), "showColor", "Color for object display. (default=[1 1 1 1])"))
+    , d_parallelVectorOperations(initData(&d_parallelVectorOperations, false, "parallelVectorOperations", "Compute the vector operations (vOp, vDot) and the bounding box in parallel, using the main task scheduler. Worth it for large vectors only. (default=false)"))
     , translation(initData(&translation, type::Vec3(), "translation", "Translation of the DOFs"))
     , rotation(initData(&rotation, type::Vec3(), "rotation", "Rotation of the DOFs"))
     , scale(initData(&scale, type::Vec3(1_sreal, 1_sreal, 1_sreal), "scale3d", "Scale of the DOFs in 3 dimensions"))
@@ -924,6 +927,19 @@ void MechanicalObject<DataTypes>::addFromBaseVectorDifferentSize(sofa::core::Vec
 template <class DataTypes>
 void MechanicalObject<DataTypes>::init()
 {
+    if (d_parallelVectorOperations.getValue())
+    {
+        m_taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+        if (m_taskScheduler->getThreadCount() == 0)
+        {
+            m_taskScheduler->init();
+        }
+    }
+    else
+    {
+        m_taskScheduler = nullptr;
+    }
+
     if (!l_topology && d_useTopology.getValue())
     {
         l_topology.set( this->getContext()->getMeshTopology(sofa::simulation::Node::Local) );
@@ -1315,7 +1331,7 @@ Data<typename MechanicalObject<DataTypes>::VecCoord>* MechanicalObject<DataTypes
         }
         if (vectorsCoord[v.index]->getValue().size() != getSize())
         {
-            vectorsCoord[v.index]->beginWriteOnly()->resize( getSize() );
+            resizeFromReleasedBuffers<core::V_COORD>(*vectorsCoord[v.index]->beginWriteOnly(), getSize());
             vectorsCoord[v.index]->endEdit();
         }
     }
@@ -1389,7 +1405,7 @@ Data<typename MechanicalObject<DataTypes>::VecDeriv>* MechanicalObject<DataTypes
         }
         if (vectorsDeriv[v.index]->getValue().size() != getSize())
         {
-            vectorsDeriv[v.index]->beginWriteOnly()->resize( getSize() );
+            resizeFromReleasedBuffers<core::V_DERIV>(*vectorsDeriv[v.index]->beginWriteOnly(), getSize());
             vectorsDeriv[v.index]->endEdit();
         }
     }
@@ -1566,7 +1582,7 @@ void MechanicalObject<DataTypes>::vAllocImpl(
     if (v.index >= core::TVecId<vtype, core::V_WRITE>::V_FIRST_DYNAMIC_INDEX)
     {
         auto* vec_d = this->write(v);
-        vec_d->beginEdit()->resize(d_size.getValue());
+        resizeFromReleasedBuffers<vtype>(*vec_d->beginEdit(), d_size.getValue());
         vec_d->endEdit();
 
         setVecIdProperties(v, properties, vec_d);
@@ -1599,7 +1615,7 @@ void MechanicalObject<DataTypes>::vReallocImpl(
 
     if ( !vec_d->isSet() /*&& v.index >= core::TVecId<vtype, core::V_WRITE>::V_FIRST_DYNAMIC_INDEX*/ )
     {
-        vec_d->beginEdit()->resize(d_size.getValue());
+        resizeFromReleasedBuffers<vtype>(*vec_d->beginEdit(), d_size.getValue());
         vec_d->endEdit();
     }
 
@@ -1653,12 +1669,62 @@ void MechanicalObject<DataTypes>::vFreeImpl(core::TVecId<vtype, core::V_WRITE> v
 
         auto* vec = vec_d->beginEdit();
         vec->resize(0);
+        if (vec->capacity() > 0)
+        {
+            // the buffer is kept for the next allocated vector, whatever its VecId
+            auto& releasedBuffers = getReleasedBuffers<vtype>();
+            releasedBuffers.emplace_back();
+            releasedBuffers.back().swap(*vec);
+        }
         vec_d->endEdit();
 
         vec_d->unset();
     }
 }
 
+template <class DataTypes>
+template <core::VecType vtype>
+sofa::type::vector< core::StateVecType_t<DataTypes, vtype> >& MechanicalObject<DataTypes>::getReleasedBuffers()
+{
+    static_assert(vtype == core::V_COORD || vtype == core::V_DERIV);
+    if constexpr (vtype == core::V_COORD)
+    {
+        return m_releasedCoordBuffers;
+    }
+    else
+    {
+        return m_releasedDerivBuffers;
+    }
+}
+
+template <class DataTypes>
+template <core::VecType vtype>
+void MechanicalObject<DataTypes>::resizeFromReleasedBuffers(core::StateVecType_t<DataTypes, vtype>& vec, sofa::Size size)
+{
+    auto& releasedBuffers = getReleasedBuffers<vtype>();
+    if (vec.empty() && vec.capacity() < size && !releasedBuffers.empty())
+    {
+        // take the smallest sufficient buffer, or the largest one if none is sufficient
+        std::size_t best = 0;
+        for (std::size_t i = 1; i < releasedBuffers.size(); ++i)
+        {
+            const auto capacity = releasedBuffers[i].capacity();
+            const auto bestCapacity = releasedBuffers[best].capacity();
+            if (bestCapacity < size ? capacity > bestCapacity : (capacity >= size && capacity < bestCapacity))
+            {
+                best = i;
+            }
+        }
+
+        vec.swap(releasedBuffers[best]);
+        if (releasedBuffers[best].capacity() == 0)
+        {
+            releasedBuffers.erase(releasedBuffers.begin() + best);
+        }
+    }
+    vec.resize(size);
+}
+
 template <class DataTypes>
 void MechanicalObject<DataTypes>::vFree(const core::ExecParams* params, core::VecCoordId vId)
 {
@@ -1772,8 +1838,10 @@ void MechanicalObject<DataTypes>::vOp(const core::ExecParams* params, core::VecI
                 applyPredicateIfCoordOrDeriv(v.type, [this, &v, f](auto vtype_v)
                 {
                     auto vv = this->getWriteAccessor<vtype_v>(v);
-                    for (unsigned int i = 0; i < vv.size(); ++i)
+                    forEachIndex(vv.size(), [&vv, f](const std::size_t i)
+                    {
                         vv[i] *= static_cast<Real>(f);
+                    });
                 });
             }
             else
@@ -1784,8 +1852,10 @@ void MechanicalObject<DataTypes>::vOp(const core::ExecParams* params, core::VecI
                     auto vv = this->getWriteAccessor<vtype_v>(v);
                     auto vb = this->getReadAccessor<vtype_v>(b);
                     vv.resize(vb.size());
-                    for (unsigned int i = 0; i < vv.size(); ++i)
+                    forEachIndex(vv.size(), [&vv, &vb, f](const std::size_t i)
+                    {
                         vv[i] = vb[i] * static_cast<Real>(f);
+                    });
                 });
             }
         }
@@ -1824,8 +1894,10 @@ void MechanicalObject<DataTypes>::vOp(const core::ExecParams* params, core::VecI
                         if (vb.size() > vv.size())
                             vv.resize(vb.size());
 
-                        for (unsigned int i = 0; i < vb.size(); ++i)
+                        forEachIndex(vb.size(), [&vv, &vb](const std::size_t i)
+                        {
                             vv[i] += vb[i];
+                        });
                     });
                     msg_error_when(!isApplied) << "Invalid vOp operation 4 ("<<v<<','<<a<<','<<b<<','<<f<<")";
                 }
@@ -1841,8 +1913,10 @@ void MechanicalObject<DataTypes>::vOp(const core::ExecParams* params, core::VecI
                         if (vb.size() > vv.size())
                             vv.resize(vb.size());
 
-                        for (unsigned int i = 0; i < vb.size(); ++i)
+                        forEachIndex(vb.size(), [&vv, &vb, f](const std::size_t i)
+                        {
                             vv[i] += vb[i] * static_cast<Real>(f);
+                        });
                     });
                     msg_error_when(!isApplied) << "Invalid vOp operation 5 ("<<v<<','<<a<<','<<b<<','<<f<<")";
                 }
@@ -1861,8 +1935,10 @@ void MechanicalObject<DataTypes>::vOp(const core::ExecParams* params, core::VecI
                         if (va.size() > vv.size())
                             vv.resize(va.size());
 
-                        for (unsigned int i = 0; i < va.size(); ++i)
+                        forEachIndex(va.size(), [&vv, &va](const std::size_t i)
+                        {
                             vv[i] += va[i];
+                        });
                     });
                     msg_error_when(!isApplied) << "Invalid vOp operation 6 ("<<v<<','<<a<<','<<b<<','<<f<<")";
                 }
@@ -1875,11 +1951,11 @@ void MechanicalObject<DataTypes>::vOp(const core::ExecParams* params, core::VecI
                         auto va = this->getReadAccessor<vtype_v>(a);
 
                         vv.resize(va.size());
-                        for (unsigned int i = 0; i < vv.size(); ++i)
+                        forEachIndex(vv.size(), [&vv, &va, f](const std::size_t i)
                         {
                             vv[i] *= static_cast<Real>(f);
                             vv[i] += va[i];
-                        }
+                        });
                     });
                 }
             }
@@ -1897,11 +1973,11 @@ void MechanicalObject<DataTypes>::vOp(const core::ExecParams* params, core::VecI
 
                         vv.resize(va.size());
 
-                        for (unsigned int i = 0; i < vb.size(); ++i)
+                        forEachIndex(vb.size(), [&vv, &va, &vb](const std::size_t i)
                         {
                             vv[i] = va[i];
                             vv[i] += vb[i];
-                        }
+                        });
                     });
                     msg_error_when(!isApplied) << "Invalid vOp operation 7 ("<<v<<','<<a<<','<<b<<','<<f<<")";
                 }
@@ -1917,11 +1993,11 @@ void MechanicalObject<DataTypes>::vOp(const core::ExecParams* params, core::VecI
 
                         vv.resize(va.size());
 
-                        for (unsigned int i = 0; i < vb.size(); ++i)
+                        forEachIndex(vb.size(), [&vv, &va, &vb, f](const std::size_t i)
                         {
                             vv[i] = va[i];
                             vv[i] += vb[i] * static_cast<Real>(f);
-                        }
+                        });
                     });
                     msg_error_when(!isApplied) << "Invalid vOp operation 8 ("<<v<<','<<a<<','<<b<<','<<f<<")";
                 }
@@ -2072,10 +2148,9 @@ SReal MechanicalObject<DataTypes>::vDot(const core::ExecParams*, core::ConstVecI
         {
             auto va = this->getReadAccessor<vtype>(a);
             auto vb = this->getReadAccessor<vtype>(b);
-            for (unsigned int i = 0; i < va.size(); ++i)
-            {
-                r += va[i] * vb[i];
-            }
+            r = reduceIndices(va.size(), r,
+                [&va, &vb](const std::size_t i) -> Real { return va[i] * vb[i]; },
+                [](const Real x, const Real y) { return x + y; });
         });
     }
 
@@ -2586,7 +2661,93 @@ void MechanicalObject<DataTypes>::computeBBox(const core::ExecParams* params, bo
 {
     // participating to bbox only if it is drawn
     if( onlyVisible && !showObject.getValue() ) return;
-    Inherited::computeBBox( params );
+
+    if (!m_taskScheduler)
+    {
+        Inherited::computeBBox( params );
+        return;
+    }
+
+    const VecCoord& x = this->read(core::ConstVecCoordId::position())->getValue();
+    this->f_bbox.setValue(reduceIndices(x.size(), type::BoundingBox(),
+        [&x](const std::size_t i)
+        {
+            Real p[3];
+            DataTypes::get(p[0], p[1], p[2], x[i]);
+            return type::BoundingBox(type::Vec3(p[0], p[1], p[2]), type::Vec3(p[0], p[1], p[2]));
+        },
+        [](type::BoundingBox a, const type::BoundingBox& b)
+        {
+            a.include(b);
+            return a;
+        }));
+}
+
+template <class DataTypes>
+std::size_t MechanicalObject<DataTypes>::getMemoryFootprint() const
+{
+    std::size_t footprint = Inherited::getMemoryFootprint();
+    for (const auto* v : vectorsCoord)
+    {
+        if (v)
+            footprint += v->getValue().capacity() * sizeof(Coord);
+    }
+    for (const auto* v : vectorsDeriv)
+    {
+        if (v)
+            footprint += v->getValue().capacity() * sizeof(Deriv);
+    }
+    for (const auto& buffer : m_releasedCoordBuffers)
+    {
+        footprint += buffer.capacity() * sizeof(Coord);
+    }
+    for (const auto& buffer : m_releasedDerivBuffers)
+    {
+        footprint += buffer.capacity() * sizeof(Deriv);
+    }
+    for (const auto* v : vectorsMatrixDeriv)
+    {
+        if (!v)
+            continue;
+        // only the stored entries are counted, not the overhead of the sparse containers
+        const MatrixDeriv& m = v->getValue();
+        for (auto row = m.begin(), rowEnd = m.end(); row != rowEnd; ++row)
+        {
+            for (auto col = row.begin(), colEnd = row.end(); col != colEnd; ++col)
+                footprint += sizeof(Deriv) + sizeof(sofa::Index);
+        }
+    }
+    return footprint;
+}
+
+template <class DataTypes>
+template <class Function>
+void MechanicalObject<DataTypes>::forEachIndex(const std::size_t n, Function f)
+{
+    if (m_taskScheduler)
+    {
+        simulation::parallelForEach(*m_taskScheduler, static_cast<std::size_t>(0), n, f,
+            simulation::Partitioner{simulation::Partitioner::Type::STATIC, 1024});
+    }
+    else
+    {
+        simulation::forEach(static_cast<std::size_t>(0), n, f);
+    }
+}
+
+template <class DataTypes>
+template <class T, class MapFunction, class CombineFunction>
+T MechanicalObject<DataTypes>::reduceIndices(const std::size_t n, T identity, MapFunction map, CombineFunction combine)
+{
+    if (m_taskScheduler)
+    {
+        return simulation::parallelReduce(*m_taskScheduler, static_cast<std::size_t>(0), n, identity, map, combine, 1024);
+    }
+    if (simulation::TaskScheduler::isDeterministic())
+    {
+        return simulation::deterministicReduce(static_cast<std::size_t>(0), n, identity, map, combine, 1024);
+    }
+    return simulation::reduce(static_cast<std::size_t>(0), n, identity, map, combine);
 }
 
 template <class DataTypes>
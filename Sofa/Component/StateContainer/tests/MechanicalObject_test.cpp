@@ -110,6 +110,32 @@ TYPED_TEST(MechanicalObject_test, checkThatPositionDefaultValueIsAVectorOfValueI
     TestHelpers::CheckPosition(this->mechanicalObject);
 }
 
+TYPED_TEST(MechanicalObject_test, checkThatFreedTemporaryBuffersAreReused)
+{
+    auto& mechanicalObject = this->mechanicalObject;
+    mechanicalObject.resize(100);
+
+    const core::VecDerivId first(core::VecDerivId::V_FIRST_DYNAMIC_INDEX);
+    const core::VecDerivId second(core::VecDerivId::V_FIRST_DYNAMIC_INDEX + 1);
+
+    mechanicalObject.vAlloc(nullptr, first);
+    const auto* buffer = mechanicalObject.read(core::ConstVecDerivId(first))->getValue().data();
+    ASSERT_NE(buffer, nullptr);
+    mechanicalObject.vFree(nullptr, first);
+
+    // the buffer of the freed vector is handed over to the next allocated one, even with a different VecId
+    mechanicalObject.vAlloc(nullptr, second);
+    const auto& vec = mechanicalObject.read(core::ConstVecDerivId(second))->getValue();
+    ASSERT_EQ(vec.size(), 100u);
+    EXPECT_EQ(vec.data(), buffer);
+    for (const auto& d : vec)
+    {
+        EXPECT_EQ(d, typename TypeParam::Deriv());
+    }
+    EXPECT_TRUE(mechanicalObject.read(core::ConstVecDerivId(first))->getValue().empty());
+    mechanicalObject.vFree(nullptr, second);
+}
+
 } // namespace
 
 } // namespace sofa
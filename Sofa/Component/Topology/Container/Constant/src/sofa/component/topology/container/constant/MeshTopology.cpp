@@ -2033,6 +2033,22 @@ core::topology::Topology::HexahedronID MeshTopology::getHexahedronIndex(PointID
     return InvalidID;
 }
 
+int MeshTopology::getElementsRevision(const sofa::geometry::ElementType elementType) const
+{
+    const core::objectmodel::BaseData* elements = nullptr;
+    switch (elementType)
+    {
+    case sofa::geometry::ElementType::EDGE: elements = &seqEdges; break;
+    case sofa::geometry::ElementType::TRIANGLE: elements = &seqTriangles; break;
+    case sofa::geometry::ElementType::QUAD: elements = &seqQuads; break;
+    case sofa::geometry::ElementType::TETRAHEDRON: elements = &seqTetrahedra; break;
+    case sofa::geometry::ElementType::HEXAHEDRON: elements = &seqHexahedra; break;
+    default: return Inherit1::getElementsRevision(elementType);
+    }
+    elements->updateIfDirty();
+    return elements->getCounter();
+}
+
 int MeshTopology::getVertexIndexInTriangle(const Triangle &t, PointID vertexIndex) const
 {
     if (t[0]==vertexIndex)
@@ -605,6 +605,9 @@ public:
   
     int revision;
 
+    /// Revision of the elements of the given type (counter of the corresponding Data)
+    int getElementsRevision(sofa::geometry::ElementType elementType) const override;
+
     // To draw the mesh, the topology position must be linked with the mechanical object position 
     Data< bool > _drawEdges; ///< if true, draw the topology Edges
     Data< bool > _drawTriangles; ///< if true, draw the topology Triangles
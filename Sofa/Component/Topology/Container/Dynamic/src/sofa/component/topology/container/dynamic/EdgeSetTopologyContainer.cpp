@@ -556,6 +556,16 @@ void EdgeSetTopologyContainer::setEdgeTopologyToDirty()
 
 }
 
+int EdgeSetTopologyContainer::getElementsRevision(const sofa::geometry::ElementType elementType) const
+{
+    if (elementType == sofa::geometry::ElementType::EDGE)
+    {
+        d_edge.updateIfDirty();
+        return d_edge.getCounter();
+    }
+    return Inherit1::getElementsRevision(elementType);
+}
+
 void EdgeSetTopologyContainer::cleanEdgeTopologyFromDirty()
 {
     m_edgeTopologyDirty = false;
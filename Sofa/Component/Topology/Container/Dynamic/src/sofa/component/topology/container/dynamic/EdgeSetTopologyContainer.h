@@ -206,6 +206,9 @@ protected:
     void cleanEdgeTopologyFromDirty();
     const bool& isEdgeTopologyDirty() {return m_edgeTopologyDirty;}
 
+    /// Revision of the edges (d_edge counter), used to detect that the cached element coloring is outdated
+    int getElementsRevision(sofa::geometry::ElementType elementType) const override;
+
 protected:
 
     /** \brief Returns a non-const list of Edge indices around the ith DOF for subsequent modification.
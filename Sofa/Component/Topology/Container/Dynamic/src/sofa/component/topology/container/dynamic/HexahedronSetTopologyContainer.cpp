@@ -1203,6 +1203,16 @@ void HexahedronSetTopologyContainer::setHexahedronTopologyToDirty()
     }
 }
 
+int HexahedronSetTopologyContainer::getElementsRevision(const sofa::geometry::ElementType elementType) const
+{
+    if (elementType == sofa::geometry::ElementType::HEXAHEDRON)
+    {
+        d_hexahedron.updateIfDirty();
+        return d_hexahedron.getCounter();
+    }
+    return Inherit1::getElementsRevision(elementType);
+}
+
 void HexahedronSetTopologyContainer::cleanHexahedronTopologyFromDirty()
 {
     m_hexahedronTopologyDirty = false;
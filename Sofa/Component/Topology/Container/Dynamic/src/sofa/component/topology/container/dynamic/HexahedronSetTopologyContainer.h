@@ -423,6 +423,9 @@ protected:
     void cleanHexahedronTopologyFromDirty();
     const bool& isHexahedronTopologyDirty() {return m_hexahedronTopologyDirty;}
 
+    /// Revision of the hexahedra (d_hexahedron counter), used to detect that the cached element coloring is outdated
+    int getElementsRevision(sofa::geometry::ElementType elementType) const override;
+
 public:
 	/// force the creation of quads
 	Data<bool>  d_createQuadArray;
@@ -754,6 +754,16 @@ void QuadSetTopologyContainer::setQuadTopologyToDirty()
 
 }
 
+int QuadSetTopologyContainer::getElementsRevision(const sofa::geometry::ElementType elementType) const
+{
+    if (elementType == sofa::geometry::ElementType::QUAD)
+    {
+        d_quad.updateIfDirty();
+        return d_quad.getCounter();
+    }
+    return Inherit1::getElementsRevision(elementType);
+}
+
 void QuadSetTopologyContainer::cleanQuadTopologyFromDirty()
 {
     m_quadTopologyDirty = false;
@@ -296,6 +296,9 @@ protected:
     void cleanQuadTopologyFromDirty();
     const bool& isQuadTopologyDirty() {return m_quadTopologyDirty;}
 
+    /// Revision of the quads (d_quad counter), used to detect that the cached element coloring is outdated
+    int getElementsRevision(sofa::geometry::ElementType elementType) const override;
+
 public:
     /// provides the set of quads.
     Data< sofa::type::vector<Quad> > d_quad;
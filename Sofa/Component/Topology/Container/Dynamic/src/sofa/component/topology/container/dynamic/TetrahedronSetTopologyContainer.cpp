@@ -1185,6 +1185,16 @@ void TetrahedronSetTopologyContainer::setTetrahedronTopologyToDirty()
     }
 }
 
+int TetrahedronSetTopologyContainer::getElementsRevision(const sofa::geometry::ElementType elementType) const
+{
+    if (elementType == sofa::geometry::ElementType::TETRAHEDRON)
+    {
+        d_tetrahedron.updateIfDirty();
+        return d_tetrahedron.getCounter();
+    }
+    return Inherit1::getElementsRevision(elementType);
+}
+
 void TetrahedronSetTopologyContainer::cleanTetrahedronTopologyFromDirty()
 {
     m_tetrahedronTopologyDirty = false;
@@ -402,6 +402,9 @@ protected:
     void cleanTetrahedronTopologyFromDirty();
     const bool& isTetrahedronTopologyDirty() {return m_tetrahedronTopologyDirty;}
 
+    /// Revision of the tetrahedra (d_tetrahedron counter), used to detect that the cached element coloring is outdated
+    int getElementsRevision(sofa::geometry::ElementType elementType) const override;
+
 public:
     /// force the creation of triangles
     Data<bool>  d_createTriangleArray;
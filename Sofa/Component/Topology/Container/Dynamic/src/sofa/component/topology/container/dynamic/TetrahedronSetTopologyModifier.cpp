@@ -117,6 +117,11 @@ void TetrahedronSetTopologyModifier::addTetrahedronProcess(Tetrahedron t)
 		// check if there already exists a tetrahedron with the same indices
         assert(m_container->getTetrahedronIndex(t[0], t[1], t[2], t[3]) == sofa::InvalidID);
 	}
+
+    // the coloring of the tetrahedra is updated incrementally if it is up to date
+    core::topology::ElementColoring* coloring = m_container->hasTetrahedraAroundVertex() ?
+        m_container->getUpToDateElementColoring(sofa::geometry::ElementType::TETRAHEDRON) : nullptr;
+
     helper::WriteAccessor< Data< sofa::type::vector<Tetrahedron> > > m_tetrahedron = m_container->d_tetrahedron;
     const TetrahedronID tetrahedronIndex = (TetrahedronID)m_tetrahedron.size();
 
@@ -237,6 +242,15 @@ void TetrahedronSetTopologyModifier::addTetrahedronProcess(Tetrahedron t)
     }
 
     m_tetrahedron.push_back(t);
+
+    if (coloring)
+    {
+        coloring->addElement(tetrahedronIndex, t, [this](const PointID v) -> const TetrahedraAroundVertex&
+        {
+            return m_container->m_tetrahedraAroundVertex[v];
+        });
+        m_container->validateElementColoring(sofa::geometry::ElementType::TETRAHEDRON);
+    }
 }
 
 
@@ -316,6 +330,8 @@ void TetrahedronSetTopologyModifier::removeTetrahedraProcess( const sofa::type::
     sofa::type::vector<EdgeID> edgeToBeRemoved;
     sofa::type::vector<PointID> vertexToBeRemoved;
 
+    core::topology::ElementColoring* coloring = m_container->getUpToDateElementColoring(sofa::geometry::ElementType::TETRAHEDRON);
+
     helper::WriteAccessor< Data< sofa::type::vector<Tetrahedron> > > m_tetrahedron = m_container->d_tetrahedron;
 
     TetrahedronID lastTetrahedron = (TetrahedronID)m_container->getNumberOfTetrahedra() - 1;
@@ -407,6 +423,16 @@ void TetrahedronSetTopologyModifier::removeTetrahedraProcess( const sofa::type::
         // removes the tetrahedron from the tetrahedronArray
         m_tetrahedron[ indices[i] ] = m_tetrahedron[ lastTetrahedron ]; // overwriting with last valid value.
         m_tetrahedron.resize( lastTetrahedron ); // resizing to erase multiple occurence of the tetrahedron.
+
+        if (coloring)
+        {
+            coloring->removeElement(indices[i]);
+        }
+    }
+
+    if (coloring)
+    {
+        m_container->validateElementColoring(sofa::geometry::ElementType::TETRAHEDRON);
     }
 
     if ( (!triangleToBeRemoved.empty()) || (!edgeToBeRemoved.empty()))
@@ -476,6 +502,9 @@ void TetrahedronSetTopologyModifier::addTrianglesProcess(const sofa::type::vecto
 void TetrahedronSetTopologyModifier::removePointsProcess(const sofa::type::vector<PointID> &indices,
         const bool removeDOF)
 {
+    // renumbering the vertices does not change the coloring of the tetrahedra
+    const bool isColoringUpToDate = m_container->getUpToDateElementColoring(sofa::geometry::ElementType::TETRAHEDRON) != nullptr;
+
     if(m_container->hasTetrahedra())
     {
         if(!m_container->hasTetrahedraAroundVertex())
@@ -506,6 +535,11 @@ void TetrahedronSetTopologyModifier::removePointsProcess(const sofa::type::vecto
     // Important : the points are actually deleted from the mechanical object's state vectors iff (removeDOF == true)
     // call the parent's method.
     TriangleSetTopologyModifier::removePointsProcess(  indices, removeDOF );
+
+    if (isColoringUpToDate)
+    {
+        m_container->validateElementColoring(sofa::geometry::ElementType::TETRAHEDRON);
+    }
 }
 
 void TetrahedronSetTopologyModifier::removeEdgesProcess( const sofa::type::vector<EdgeID> &indices,
@@ -576,6 +610,8 @@ void TetrahedronSetTopologyModifier::renumberPointsProcess( const sofa::type::ve
         const sofa::type::vector<PointID> &inv_index,
         const bool renumberDOF)
 {
+    const bool isColoringUpToDate = m_container->getUpToDateElementColoring(sofa::geometry::ElementType::TETRAHEDRON) != nullptr;
+
     if(m_container->hasTetrahedra())
     {
         helper::WriteAccessor< Data< sofa::type::vector<Tetrahedron> > > m_tetrahedron = m_container->d_tetrahedron;
@@ -599,6 +635,11 @@ void TetrahedronSetTopologyModifier::renumberPointsProcess( const sofa::type::ve
 
     // call the parent's method.
     TriangleSetTopologyModifier::renumberPointsProcess( index, inv_index, renumberDOF );
+
+    if (isColoringUpToDate)
+    {
+        m_container->validateElementColoring(sofa::geometry::ElementType::TETRAHEDRON);
+    }
 }
 
 void TetrahedronSetTopologyModifier::removeTetrahedra(const sofa::type::vector<TetrahedronID> &tetrahedraIds, const bool removeIsolatedItems)
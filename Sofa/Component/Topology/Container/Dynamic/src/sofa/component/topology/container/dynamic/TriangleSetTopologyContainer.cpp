@@ -1029,6 +1029,16 @@ void TriangleSetTopologyContainer::setTriangleTopologyToDirty()
     }
 }
 
+int TriangleSetTopologyContainer::getElementsRevision(const sofa::geometry::ElementType elementType) const
+{
+    if (elementType == sofa::geometry::ElementType::TRIANGLE)
+    {
+        d_triangle.updateIfDirty();
+        return d_triangle.getCounter();
+    }
+    return Inherit1::getElementsRevision(elementType);
+}
+
 void TriangleSetTopologyContainer::cleanTriangleTopologyFromDirty()
 {
     m_triangleTopologyDirty = false;
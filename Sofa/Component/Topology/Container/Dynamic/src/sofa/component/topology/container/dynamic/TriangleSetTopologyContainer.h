@@ -335,6 +335,9 @@ protected:
     void cleanTriangleTopologyFromDirty();
     const bool& isTriangleTopologyDirty() {return m_triangleTopologyDirty;}
 
+    /// Revision of the triangles (d_triangle counter), used to detect that the cached element coloring is outdated
+    int getElementsRevision(sofa::geometry::ElementType elementType) const override;
+
 public:
     /// provides the set of triangles.
     Data< sofa::type::vector<Triangle> > d_triangle;
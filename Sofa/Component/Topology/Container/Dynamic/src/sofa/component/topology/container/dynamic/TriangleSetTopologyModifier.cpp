@@ -189,6 +189,11 @@ void TriangleSetTopologyModifier::addTriangleProcess(Triangle t)
 	}
 
     const TriangleID triangleIndex = (TriangleID)m_container->getNumberOfTriangles();
+
+    // the coloring of the triangles is updated incrementally if it is up to date
+    core::topology::ElementColoring* coloring = m_container->hasTrianglesAroundVertex() ?
+        m_container->getUpToDateElementColoring(sofa::geometry::ElementType::TRIANGLE) : nullptr;
+
     helper::WriteAccessor< Data< sofa::type::vector<Triangle> > > m_triangle = m_container->d_triangle;
 
     // update nbr point if needed
@@ -253,6 +258,15 @@ void TriangleSetTopologyModifier::addTriangleProcess(Triangle t)
     }
 
     m_triangle.push_back(t);
+
+    if (coloring)
+    {
+        coloring->addElement(triangleIndex, t, [this](const PointID v) -> const TrianglesAroundVertex&
+        {
+            return m_container->m_trianglesAroundVertex[v];
+        });
+        m_container->validateElementColoring(sofa::geometry::ElementType::TRIANGLE);
+    }
 }
 
 
@@ -393,6 +407,9 @@ void TriangleSetTopologyModifier::removeTrianglesProcess(const sofa::type::vecto
 
     sofa::type::vector<EdgeID> edgeToBeRemoved;
     sofa::type::vector<PointID> vertexToBeRemoved;
+
+    core::topology::ElementColoring* coloring = m_container->getUpToDateElementColoring(sofa::geometry::ElementType::TRIANGLE);
+
     helper::WriteAccessor< Data< sofa::type::vector<Triangle> > > m_triangle = m_container->d_triangle;
 
     size_t lastTriangle = m_container->getNumberOfTriangles() - 1;
@@ -458,6 +475,16 @@ void TriangleSetTopologyModifier::removeTrianglesProcess(const sofa::type::vecto
         // removes the triangle from the triangleArray
         m_triangle[ indices[i] ] = m_triangle[ lastTriangle ]; // overwriting with last valid value.
         m_triangle.resize( lastTriangle ); // resizing to erase multiple occurence of the triangle.
+
+        if (coloring)
+        {
+            coloring->removeElement(indices[i]);
+        }
+    }
+
+    if (coloring)
+    {
+        m_container->validateElementColoring(sofa::geometry::ElementType::TRIANGLE);
     }
 
     removeTrianglesPostProcessing(edgeToBeRemoved, vertexToBeRemoved); // Arrange the current topology.
@@ -521,6 +548,8 @@ void TriangleSetTopologyModifier::removeEdgesProcess( const sofa::type::vector<E
 void TriangleSetTopologyModifier::removePointsProcess(const sofa::type::vector<PointID> &indices,
         const bool removeDOF)
 {
+    // renumbering the vertices does not change the coloring of the triangles
+    const bool isColoringUpToDate = m_container->getUpToDateElementColoring(sofa::geometry::ElementType::TRIANGLE) != nullptr;
 
     if(m_container->hasTriangles())
     {
@@ -562,6 +591,11 @@ void TriangleSetTopologyModifier::removePointsProcess(const sofa::type::vector<P
     // Important : the points are actually deleted from the mechanical object's state vectors iff (removeDOF == true)
     // call the parent's method.
     EdgeSetTopologyModifier::removePointsProcess( indices, removeDOF );
+
+    if (isColoringUpToDate)
+    {
+        m_container->validateElementColoring(sofa::geometry::ElementType::TRIANGLE);
+    }
 }
 
 
@@ -569,6 +603,7 @@ void TriangleSetTopologyModifier::renumberPointsProcess( const sofa::type::vecto
         const sofa::type::vector<PointID> &inv_index,
         const bool renumberDOF)
 {
+    const bool isColoringUpToDate = m_container->getUpToDateElementColoring(sofa::geometry::ElementType::TRIANGLE) != nullptr;
 
     if(m_container->hasTriangles())
     {
@@ -592,6 +627,11 @@ void TriangleSetTopologyModifier::renumberPointsProcess( const sofa::type::vecto
 
     // call the parent's method
     EdgeSetTopologyModifier::renumberPointsProcess( index, inv_index, renumberDOF );
+
+    if (isColoringUpToDate)
+    {
+        m_container->validateElementColoring(sofa::geometry::ElementType::TRIANGLE);
+    }
 }
 
 
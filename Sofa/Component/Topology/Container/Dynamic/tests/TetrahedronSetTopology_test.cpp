@@ -23,6 +23,7 @@
 #include <sofa/component/topology/testing/fake_TopologyScene.h>
 #include <sofa/testing/BaseTest.h>
 #include <sofa/component/topology/container/dynamic/TetrahedronSetTopologyContainer.h>
+#include <sofa/component/topology/container/dynamic/TetrahedronSetTopologyModifier.h>
 #include <sofa/component/topology/container/dynamic/TetrahedronSetGeometryAlgorithms.h>
 #include <sofa/helper/system/FileRepository.h>
 
@@ -40,6 +41,7 @@ public:
     bool testVertexBuffers();
     bool checkTopology();
     bool testTetrahedronGeometry();
+    bool testElementColoring();
 
     // ground truth from obj file;
     int nbrTetrahedron = 44;
@@ -439,6 +441,63 @@ bool TetrahedronSetTopology_test::testTetrahedronGeometry()
 }
 
 
+bool TetrahedronSetTopology_test::testElementColoring()
+{
+    using sofa::geometry::ElementType;
+
+    fake_TopologyScene* scene = new fake_TopologyScene("mesh/cube_low_res.msh", sofa::core::topology::TopologyElementType::TETRAHEDRON);
+    TetrahedronSetTopologyContainer* topoCon = dynamic_cast<TetrahedronSetTopologyContainer*>(scene->getNode().get()->getMeshTopology());
+    TetrahedronSetTopologyModifier* topoMod = scene->getNode()->get<TetrahedronSetTopologyModifier>();
+
+    if (topoCon == nullptr || topoMod == nullptr)
+    {
+        if (scene != nullptr)
+            delete scene;
+        return false;
+    }
+
+    const auto& tetraColoring = topoCon->getElementColoring(ElementType::TETRAHEDRON);
+    EXPECT_EQ(tetraColoring.getNbElements(), nbrTetrahedron);
+    EXPECT_TRUE(tetraColoring.isValid(topoCon->getTetrahedra()));
+    EXPECT_GT(tetraColoring.getNbColors(), 1);
+
+    const auto& triangleColoring = topoCon->getElementColoring(ElementType::TRIANGLE);
+    EXPECT_EQ(triangleColoring.getNbElements(), nbrTriangle);
+    EXPECT_TRUE(triangleColoring.isValid(topoCon->getTriangles()));
+
+    // remove some tetrahedra, with their isolated triangles, edges and vertices
+    const auto tetra0 = topoCon->getTetrahedron(0);
+    const auto tetra10 = topoCon->getTetrahedron(10);
+    sofa::type::vector<TetrahedronSetTopologyContainer::TetrahedronID> tetraIds = { 0, 10, 43 };
+    topoMod->removeTetrahedra(tetraIds, true);
+
+    EXPECT_EQ(topoCon->getNbTetrahedra(), nbrTetrahedron - 3);
+    EXPECT_EQ(&topoCon->getElementColoring(ElementType::TETRAHEDRON), &tetraColoring);
+    EXPECT_EQ(tetraColoring.getNbElements(), topoCon->getNbTetrahedra());
+    EXPECT_TRUE(tetraColoring.isValid(topoCon->getTetrahedra()));
+    EXPECT_TRUE(topoCon->getElementColoring(ElementType::TRIANGLE).isValid(topoCon->getTriangles()));
+
+    // add tetrahedra back, if their vertices still exist
+    sofa::type::vector<TetrahedronSetTopologyContainer::Tetrahedron> tetrahedra;
+    for (const auto& tetra : { tetra0, tetra10 })
+    {
+        if (std::all_of(tetra.begin(), tetra.end(), [topoCon](const auto v) { return v < topoCon->getNbPoints(); }))
+        {
+            tetrahedra.push_back(tetra);
+        }
+    }
+    topoMod->addTetrahedra(tetrahedra);
+
+    EXPECT_EQ(tetraColoring.getNbElements(), topoCon->getNbTetrahedra());
+    EXPECT_TRUE(topoCon->getElementColoring(ElementType::TETRAHEDRON).isValid(topoCon->getTetrahedra()));
+    EXPECT_TRUE(topoCon->getElementColoring(ElementType::TRIANGLE).isValid(topoCon->getTriangles()));
+
+    if (scene != nullptr)
+        delete scene;
+
+    return true;
+}
+
 
 TEST_F(TetrahedronSetTopology_test, testEmptyContainer)
 {
@@ -475,6 +534,11 @@ TEST_F(TetrahedronSetTopology_test, testTetrahedronGeometry)
     ASSERT_TRUE(testTetrahedronGeometry());
 }
 
+TEST_F(TetrahedronSetTopology_test, testElementColoring)
+{
+    ASSERT_TRUE(testElementColoring());
+}
+
 
 
 // TODO epernod 2018-07-05: test element on Border
@@ -56,6 +56,9 @@ Vec3State::Vec3State()
     , m_restPositions(initData(&m_restPositions, "restPosition", "Vertices rest coordinates"))
     , m_vnormals (initData (&m_vnormals, "normal", "Normals of the model"))
     , modified(false)
+    , m_bufferedPositions("Positions written by the simulation when the state is double buffered", false, true)
+    , m_isDoubleBuffered(false)
+    , m_bufferedModified(false)
 {
     m_positions.setGroup("Vector");
     m_restPositions.setGroup("Vector");
@@ -64,6 +67,16 @@ Vec3State::Vec3State()
 
 void Vec3State::resize(Size vsize)
 {
+    if (m_isDoubleBuffered)
+    {
+        // the other vectors are resized when the positions are swapped
+        helper::WriteOnlyAccessor< Data<VecCoord > > bufferedPositions = m_bufferedPositions;
+        if (bufferedPositions.size() == vsize) return;
+        bufferedPositions.resize(vsize);
+        m_bufferedModified = true;
+        return;
+    }
+
     helper::WriteOnlyAccessor< Data<VecCoord > > positions = m_positions;
     if( positions.size() == vsize ) return;
     helper::WriteOnlyAccessor< Data<VecCoord > > restPositions = m_restPositions;
@@ -76,10 +89,54 @@ void Vec3State::resize(Size vsize)
     modified = true;
 }
 
-Size Vec3State::getSize() const { return Size(m_positions.getValue().size()); }
+Size Vec3State::getSize() const
+{
+    return Size(m_isDoubleBuffered ? m_bufferedPositions.getValue().size() : m_positions.getValue().size());
+}
+
+void Vec3State::enablePositionsBuffering(const bool enabled)
+{
+    if (enabled == m_isDoubleBuffered) return;
+
+    if (enabled)
+    {
+        m_bufferedPositions.setValue(m_positions.getValue());
+        m_bufferedModified = false;
+    }
+    else
+    {
+        swapPositions();
+    }
+    m_isDoubleBuffered = enabled;
+}
+
+bool Vec3State::swapPositions()
+{
+    if (!m_isDoubleBuffered || !m_bufferedModified) return false;
+
+    const VecCoord& bufferedPositions = m_bufferedPositions.getValue();
+    if (bufferedPositions.size() != m_positions.getValue().size())
+    {
+        helper::WriteOnlyAccessor< Data<VecCoord > > restPositions = m_restPositions;
+        helper::WriteOnlyAccessor< Data<VecDeriv > > normals = m_vnormals;
+        restPositions.resize(bufferedPositions.size());
+        normals.resize(bufferedPositions.size());
+    }
+    m_positions.setValue(bufferedPositions);
+
+    m_bufferedModified = false;
+    modified = true;
+    return true;
+}
 
 Data<Vec3State::VecCoord>* Vec3State::write(     core::VecCoordId  v )
 {
+    if( m_isDoubleBuffered && v == core::VecCoordId::position() )
+    {
+        m_bufferedModified = true;
+        return &m_bufferedPositions;
+    }
+
     modified = true;
 
     if( v == core::VecCoordId::position() )
@@ -92,6 +149,8 @@ Data<Vec3State::VecCoord>* Vec3State::write(     core::VecCoordId  v )
 
 const Data<Vec3State::VecCoord>* Vec3State::read(core::ConstVecCoordId  v )  const
 {
+    if( m_isDoubleBuffered && v == core::VecCoordId::position() )
+        return &m_bufferedPositions;
     if( v == core::VecCoordId::position() )
         return &m_positions;
     if( v == core::VecCoordId::restPosition() )
@@ -1361,6 +1420,16 @@ void VisualModelImpl::setColor(std::string color)
 }
 
 
+void VisualModelImpl::setDoubleBuffered(const bool enabled)
+{
+    enablePositionsBuffering(enabled);
+}
+
+void VisualModelImpl::swapVisualState()
+{
+    swapPositions();
+}
+
 void VisualModelImpl::updateVisual()
 {
     if (modified && !getVertices().empty())
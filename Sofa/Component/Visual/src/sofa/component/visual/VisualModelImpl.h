@@ -46,6 +46,11 @@ public:
     core::topology::PointData< VecDeriv > m_vnormals; ///< Normals of the model
     bool modified; ///< True if input vertices modified since last rendering
 
+    /// Positions written by the simulation when the state is double buffered, published in m_positions by swapPositions()
+    Data< VecCoord > m_bufferedPositions;
+    bool m_isDoubleBuffered; ///< True if the simulation writes the positions in m_bufferedPositions
+    bool m_bufferedModified; ///< True if m_bufferedPositions was modified since the last swap
+
     Vec3State() ;
 
     virtual void resize(Size vsize) ;
@@ -59,6 +64,13 @@ public:
 
     virtual       Data<MatrixDeriv>*	write(core::MatrixDerivId /* v */) { return nullptr; }
     virtual const Data<MatrixDeriv>*	read(core::ConstMatrixDerivId /* v */) const {  return nullptr; }
+
+protected:
+    /// Route the positions written by the simulation to m_bufferedPositions
+    void enablePositionsBuffering(bool enabled);
+
+    /// Copy the positions written by the simulation in m_positions. Returns false if they were not modified.
+    bool swapPositions();
 };
 
 /**
@@ -384,6 +396,9 @@ public:
 
     void updateVisual() override;
 
+    void setDoubleBuffered(bool enabled) override;
+    void swapVisualState() override;
+
     void init() override;
     void initFromTopology();
     void initPositionFromVertices();
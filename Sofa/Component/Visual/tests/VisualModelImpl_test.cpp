@@ -120,4 +120,36 @@ TEST( VisualModelImpl_test , checkThatMembersAreCorrectlyConstructed )
     ASSERT_EQ(1u, visualModel.xforms.size());
 }
 
+TEST( VisualModelImpl_test , doubleBufferedPositions )
+{
+    using VecCoord = component::visual::VisualModelImpl::VecCoord;
+    StubVisualModelImpl visualModel;
+    visualModel.m_positions.setValue(VecCoord{ {0, 0, 0}, {1, 0, 0} });
+
+    visualModel.setDoubleBuffered(true);
+
+    // the simulation writes the next positions, while the current ones are rendered
+    {
+        auto x = helper::getWriteOnlyAccessor(*visualModel.write(core::VecCoordId::position()));
+        x.resize(3);
+        x[2] = { 2, 0, 0 };
+    }
+    EXPECT_EQ(3u, visualModel.getSize());
+    EXPECT_EQ(3u, visualModel.read(core::ConstVecCoordId::position())->getValue().size());
+    EXPECT_EQ(2u, visualModel.getVertices().size());
+
+    visualModel.swapVisualState();
+    ASSERT_EQ(3u, visualModel.getVertices().size());
+    EXPECT_EQ(component::visual::VisualModelImpl::Coord(2, 0, 0), visualModel.getVertices()[2]);
+    EXPECT_EQ(3u, visualModel.m_vnormals.getValue().size());
+
+    // nothing new to publish
+    visualModel.m_positions.setValue(VecCoord{ {0, 0, 0} });
+    visualModel.swapVisualState();
+    EXPECT_EQ(1u, visualModel.getVertices().size());
+
+    visualModel.setDoubleBuffered(false);
+    EXPECT_EQ(&visualModel.m_positions, visualModel.write(core::VecCoordId::position()));
+}
+
 } //sofa
@@ -24,6 +24,7 @@
 #include <sofa/gui/component/performer/ComponentMouseInteraction.h>
 #include <sofa/component/collision/response/contact/RayContact.h>
 
+#include <sofa/simulation/DefaultAnimationLoop.h>
 #include <sofa/simulation/DeleteVisitor.h>
 #include <sofa/simulation/Node.h>
 #include <sofa/core/collision/Pipeline.h>
@@ -197,6 +198,9 @@ void PickHandler::activateRay(int width, int height, core::objectmodel::BaseNode
 {
     if (!interactorInUse)
     {
+        // the mouse node is added to the graph, which must not be traversed by a pipelined time step
+        simulation::DefaultAnimationLoop::waitForPendingStep(down_cast<simulation::Node>(root));
+
         if (mouseNode)
         {
             root->addChild(mouseNode);
@@ -215,6 +219,8 @@ void PickHandler::deactivateRay()
 {
     if (interactorInUse )
     {
+        simulation::DefaultAnimationLoop::waitForPendingStep(mouseNode.get());
+
         if (mouseNode)
             mouseNode->detachFromGraph();
 
@@ -283,6 +289,9 @@ void PickHandler::updateRay(const sofa::type::Vec3 &position,const sofa::type::V
 {
     if (!interactorInUse || !mouseCollision) return;
 
+    // the picking reads and the mouse interactors write the mechanical states: a pipelined time step must be finished
+    simulation::DefaultAnimationLoop::waitForPendingStep(mouseNode.get());
+
     mouseCollision->getRay(0).setOrigin( position+orientation*interaction->mouseInteractor->getDistanceFromMouse() );
     mouseCollision->getRay(0).setDirection( orientation );
     MechanicalPropagateOnlyPositionVisitor(sofa::core::mechanicalparams::defaultInstance(), 0, sofa::core::VecCoordId::position()).execute(mouseCollision->getContext());
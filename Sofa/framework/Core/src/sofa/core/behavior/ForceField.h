@@ -160,25 +160,7 @@ public:
     template<class IndexArray, class ElementMat>
     void addToMatrix(sofa::linearalgebra::BaseMatrix* bm, unsigned offset, const IndexArray& nodeIndex, const ElementMat& em, SReal scale )
     {
-        constexpr auto S = DataTypes::deriv_total_size; // size of node blocks
-        for (unsigned n1=0; n1<nodeIndex.size(); n1++)
-        {
-            for(unsigned i=0; i<S; i++)
-            {
-                const unsigned ROW = offset + S*nodeIndex[n1] + i;  // i-th row associated with node n1 in BaseMatrix
-                const unsigned row = S*n1+i;                        // i-th row associated with node n1 in the element matrix
-
-                for (unsigned n2=0; n2<nodeIndex.size(); n2++)
-                {
-                    for (unsigned j=0; j<S; j++)
-                    {
-                        const unsigned COLUMN = offset + S*nodeIndex[n2] +j; // j-th column associated with node n2 in BaseMatrix
-                        const unsigned column = S*n2+j;                      // j-th column associated with node n2 in the element matrix
-                        bm->add( ROW,COLUMN, em[row][column]* scale );
-                    }
-                }
-            }
-        }
+        bm->addElementMatrix(offset, nodeIndex, em, scale);
     }
 
     virtual void addBToMatrix(sofa::linearalgebra::BaseMatrix * matrix, SReal bFact, unsigned int &offset);
@@ -0,0 +1,61 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/core/config.h>
+#include <sofa/core/MultiVecId.h>
+#include <sofa/core/fwd.h>
+#include <memory>
+
+namespace sofa::core::behavior
+{
+
+/**
+ * Linear operator df += A dx of a component contributing to the system matrix, A being frozen at the linearization
+ * point where the operator was created (e.g. A = k K for the stiffness K of a force field).
+ *
+ * It is created once per linear system, and applied by the matrix-free solvers at each iteration directly on the
+ * vectors of the mechanical states of the component, without traversing the scene graph.
+ */
+class LinearizedOperator
+{
+public:
+    virtual ~LinearizedOperator() = default;
+
+    /// df += A dx, dx and df being vectors of the mechanical states of the component
+    virtual void addMultiply(MultiVecDerivId df, ConstMultiVecDerivId dx) = 0;
+};
+
+/**
+ * Interface of the force fields able to snapshot their linearized operator (m M + b B + k K), with the factors of
+ * mparams, in a flat form which does not depend on the component anymore.
+ */
+class LinearizedOperatorProvider
+{
+public:
+    virtual ~LinearizedOperatorProvider() = default;
+
+    /// Snapshot of the linearized operator at the current linearization point, i.e. after the last addForce
+    virtual std::shared_ptr<LinearizedOperator> createLinearizedOperator(const MechanicalParams* mparams) = 0;
+};
+
+} // namespace sofa::core::behavior
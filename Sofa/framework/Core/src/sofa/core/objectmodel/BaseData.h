@@ -122,6 +122,9 @@ public:
     /// \see sofa::defaulttype::AbstractTypeInfo
     virtual const sofa::defaulttype::AbstractTypeInfo* getValueTypeInfo() const = 0;
 
+    /// Get the number of bytes allocated to store the value held in this %Data, or 0 if unknown.
+    virtual std::size_t getMemoryFootprint() const { return 0; }
+
     /// Get a constant void pointer to the value held in this %Data, to be used with AbstractTypeInfo.
     ///
     /// This pointer should be used via the instance of AbstractTypeInfo
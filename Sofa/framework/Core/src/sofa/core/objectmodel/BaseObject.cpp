@@ -350,6 +350,16 @@ void BaseObject::handleTopologyChange(core::topology::Topology* t)
     }
 }
 
+std::size_t BaseObject::getMemoryFootprint() const
+{
+    std::size_t footprint = 0;
+    for (const auto* data : this->getDataFields())
+    {
+        footprint += data->getMemoryFootprint();
+    }
+    return footprint;
+}
+
 SReal BaseObject::getTime() const
 {
     return getContext()->getTime();
@@ -161,6 +161,10 @@ public:
     /// Default to empty method.
     virtual void computeBBox(const core::ExecParams* /* params */, bool /*onlyVisible*/=false) {}
 
+    /// Number of bytes allocated by this object.
+    /// Default to the sum of the memory footprints reported by its Data.
+    virtual std::size_t getMemoryFootprint() const;
+
     /// Sets a source Object and parses it to collect dependent Data
     void setSrc(const std::string &v, std::vector< std::string > *attributeList=nullptr);
 
@@ -481,6 +481,65 @@ BaseMeshTopology::Quad BaseMeshTopology::getLocalQuadsInHexahedron (const PointI
     return InvalidQuad;
 }
 
+const ElementColoring& BaseMeshTopology::getElementColoring(const sofa::geometry::ElementType elementType)
+{
+    auto& cache = m_elementColorings[static_cast<std::size_t>(elementType)];
+    if (cache.computed && cache.revision == getElementsRevision(elementType))
+    {
+        return cache.coloring;
+    }
+
+    switch (elementType)
+    {
+    case sofa::geometry::ElementType::EDGE:
+        cache.coloring.compute(getEdges(), getNbPoints());
+        break;
+    case sofa::geometry::ElementType::TRIANGLE:
+        cache.coloring.compute(getTriangles(), getNbPoints());
+        break;
+    case sofa::geometry::ElementType::QUAD:
+        cache.coloring.compute(getQuads(), getNbPoints());
+        break;
+    case sofa::geometry::ElementType::TETRAHEDRON:
+        cache.coloring.compute(getTetrahedra(), getNbPoints());
+        break;
+    case sofa::geometry::ElementType::HEXAHEDRON:
+        cache.coloring.compute(getHexahedra(), getNbPoints());
+        break;
+    default:
+        msg_error() << "getElementColoring() not supported for this type of element.";
+        cache.coloring.clear();
+        break;
+    }
+
+    // read after the elements, which may be created on demand
+    cache.revision = getElementsRevision(elementType);
+    cache.computed = true;
+    return cache.coloring;
+}
+
+int BaseMeshTopology::getElementsRevision(sofa::geometry::ElementType) const
+{
+    return getRevision();
+}
+
+ElementColoring* BaseMeshTopology::getUpToDateElementColoring(const sofa::geometry::ElementType elementType)
+{
+    auto& cache = m_elementColorings[static_cast<std::size_t>(elementType)];
+    if (cache.computed && cache.revision == getElementsRevision(elementType))
+    {
+        return &cache.coloring;
+    }
+    return nullptr;
+}
+
+void BaseMeshTopology::validateElementColoring(const sofa::geometry::ElementType elementType)
+{
+    auto& cache = m_elementColorings[static_cast<std::size_t>(elementType)];
+    cache.revision = getElementsRevision(elementType);
+    cache.computed = true;
+}
+
 bool BaseMeshTopology::insertInNode( objectmodel::BaseNode* node )
 {
     node->addMeshTopology(this);
@@ -23,6 +23,7 @@
 
 #include <sofa/core/fwd.h>
 #include <sofa/core/topology/Topology.h>
+#include <sofa/core/topology/ElementColoring.h>
 #include <sofa/core/objectmodel/DataFileName.h>
 
 namespace sofa::core::topology
@@ -275,6 +276,15 @@ public:
     /// This can be used to detect changes, however topological changes event should be used whenever possible.
     virtual int getRevision() const { return 0; }
 
+    /** \brief Returns a coloring of the elements of the given type, such that two elements of the
+    * same color do not share any vertex.
+    *
+    * The coloring is computed on the first call and cached. It is recomputed when the elements
+    * change, unless the topology modifier updated it incrementally.
+    * This method is not thread-safe: call it before starting a parallel loop.
+    */
+    const ElementColoring& getElementColoring(sofa::geometry::ElementType elementType);
+
     /// Will change order of vertices in triangle: t[1] <=> t[2]
     virtual void reOrientateTriangle(TriangleID id);
 
@@ -310,6 +320,27 @@ protected:
 
     sofa::core::objectmodel::DataFileName fileTopology;
 
+    /// Revision of the elements of the given type, used to detect that a cached coloring is outdated.
+    /// By default, the revision of the whole mesh.
+    virtual int getElementsRevision(sofa::geometry::ElementType elementType) const;
+
+    /// Returns the cached coloring of the given element type if it is up to date, nullptr otherwise.
+    /// Used by topology modifiers to update the coloring incrementally.
+    ElementColoring* getUpToDateElementColoring(sofa::geometry::ElementType elementType);
+
+    /// Marks the cached coloring of the given element type as up to date with the current elements
+    void validateElementColoring(sofa::geometry::ElementType elementType);
+
+private:
+
+    struct ElementColoringCache
+    {
+        ElementColoring coloring;
+        int revision { 0 };
+        bool computed { false };
+    };
+    std::array<ElementColoringCache, sofa::geometry::NumberOfElementType> m_elementColorings;
+
 public:
 
     bool insertInNode( objectmodel::BaseNode* node ) override;
@@ -0,0 +1,87 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/core/topology/ElementColoring.h>
+
+namespace sofa::core::topology
+{
+
+void ElementColoring::removeElement(const sofa::Index elementId)
+{
+    const sofa::Index lastElement = sofa::Index(m_elementColor.size() - 1);
+
+    // remove the element from its color
+    auto& color = m_colors[m_elementColor[elementId]];
+    const sofa::Index position = m_positionInColor[elementId];
+    const sofa::Index moved = color.back();
+    color[position] = moved;
+    m_positionInColor[moved] = position;
+    color.pop_back();
+
+    // the last element takes the index of the removed one
+    if (elementId != lastElement)
+    {
+        const Color lastColor = m_elementColor[lastElement];
+        m_colors[lastColor][m_positionInColor[lastElement]] = elementId;
+        m_elementColor[elementId] = lastColor;
+        m_positionInColor[elementId] = m_positionInColor[lastElement];
+    }
+    m_elementColor.pop_back();
+    m_positionInColor.pop_back();
+
+    while (!m_colors.empty() && m_colors.back().empty())
+    {
+        m_colors.pop_back();
+    }
+}
+
+void ElementColoring::clear()
+{
+    m_colors.clear();
+    m_elementColor.clear();
+    m_positionInColor.clear();
+}
+
+ElementColoring::Color ElementColoring::selectColor()
+{
+    m_usedColors.assign(m_colors.size() + 1, false);
+    for (const Color c : m_neighborColors)
+    {
+        m_usedColors[c] = true;
+    }
+
+    const auto firstFree = std::find(m_usedColors.begin(), m_usedColors.end(), false);
+    return Color(std::distance(m_usedColors.begin(), firstFree));
+}
+
+void ElementColoring::insert(const sofa::Index elementId, const Color c)
+{
+    if (c >= m_colors.size())
+    {
+        m_colors.resize(c + 1);
+    }
+
+    m_positionInColor.push_back(sofa::Index(m_colors[c].size()));
+    m_elementColor.push_back(c);
+    m_colors[c].push_back(elementId);
+}
+
+} // namespace sofa::core::topology
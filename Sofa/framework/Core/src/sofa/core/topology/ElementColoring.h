@@ -0,0 +1,174 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/core/config.h>
+#include <sofa/type/vector.h>
+
+#include <algorithm>
+
+namespace sofa::core::topology
+{
+
+/**
+ * Partition of a set of topological elements (edges, triangles, tetrahedra, ...) into colors, such
+ * that two elements of the same color do not share any vertex.
+ *
+ * The elements of a color can be processed in parallel while accumulating per-vertex values
+ * (forces, matrix blocks, ...) without synchronization: the colors are processed one after the
+ * other, and the elements of each color in parallel.
+ *
+ * The coloring is greedy: an element gets the smallest color which is not used by the elements
+ * sharing one of its vertices. It can be updated when elements are added or removed, following the
+ * convention of the dynamic topology containers: a removed element is replaced by the last one.
+ */
+class SOFA_CORE_API ElementColoring
+{
+public:
+    using Color = sofa::Index;
+
+    /// Color all the elements, in the order of their indices
+    template<class Element>
+    void compute(const sofa::type::vector<Element>& elements, sofa::Size nbPoints)
+    {
+        clear();
+
+        for (const auto& element : elements)
+        {
+            for (const auto v : element)
+            {
+                nbPoints = std::max<sofa::Size>(nbPoints, v + 1);
+            }
+        }
+
+        // colors of the elements already colored around each vertex
+        sofa::type::vector<sofa::type::vector<Color> > colorsAroundVertex(nbPoints);
+
+        m_elementColor.reserve(elements.size());
+        m_positionInColor.reserve(elements.size());
+
+        for (std::size_t e = 0; e < elements.size(); ++e)
+        {
+            m_neighborColors.clear();
+            for (const auto v : elements[e])
+            {
+                m_neighborColors.insert(m_neighborColors.end(), colorsAroundVertex[v].begin(), colorsAroundVertex[v].end());
+            }
+
+            const Color color = selectColor();
+            insert(static_cast<sofa::Index>(e), color);
+
+            for (const auto v : elements[e])
+            {
+                colorsAroundVertex[v].push_back(color);
+            }
+        }
+    }
+
+    /**
+     * Color the element elementId, which must be equal to the current number of elements.
+     * elementsAroundVertex(v) returns the indices of the elements around the vertex v. It can
+     * contain elementId itself, and elements which are not colored yet: they are ignored.
+     */
+    template<class Element, class ElementsAroundVertex>
+    void addElement(const sofa::Index elementId, const Element& element, ElementsAroundVertex elementsAroundVertex)
+    {
+        m_neighborColors.clear();
+        for (const auto v : element)
+        {
+            for (const auto neighbor : elementsAroundVertex(v))
+            {
+                if (neighbor != elementId && neighbor < m_elementColor.size())
+                {
+                    m_neighborColors.push_back(m_elementColor[neighbor]);
+                }
+            }
+        }
+
+        insert(elementId, selectColor());
+    }
+
+    /// Remove the element elementId. The last element takes its index.
+    void removeElement(sofa::Index elementId);
+
+    /// Remove all the elements and all the colors
+    void clear();
+
+    /// Number of colors (some colors can be empty after removals)
+    sofa::Size getNbColors() const { return sofa::Size(m_colors.size()); }
+
+    /// Number of colored elements
+    sofa::Size getNbElements() const { return sofa::Size(m_elementColor.size()); }
+
+    /// Indices of the elements of the color c
+    const sofa::type::vector<sofa::Index>& getColor(const Color c) const { return m_colors[c]; }
+
+    /// Indices of the elements of each color
+    const sofa::type::vector<sofa::type::vector<sofa::Index> >& getColors() const { return m_colors; }
+
+    /// Color of the element elementId
+    Color getElementColor(const sofa::Index elementId) const { return m_elementColor[elementId]; }
+
+    /// Check that the coloring covers all the elements and that two elements of the same color do
+    /// not share any vertex
+    template<class Element>
+    bool isValid(const sofa::type::vector<Element>& elements) const
+    {
+        if (elements.size() != m_elementColor.size())
+        {
+            return false;
+        }
+
+        for (const auto& color : m_colors)
+        {
+            sofa::type::vector<sofa::Index> vertices;
+            for (const auto e : color)
+            {
+                vertices.insert(vertices.end(), elements[e].begin(), elements[e].end());
+            }
+            std::sort(vertices.begin(), vertices.end());
+            if (std::adjacent_find(vertices.begin(), vertices.end()) != vertices.end())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+
+    /// Smallest color which is not in m_neighborColors
+    Color selectColor();
+
+    /// Add elementId (equal to the current number of elements) in the color c
+    void insert(sofa::Index elementId, Color c);
+
+    sofa::type::vector<sofa::type::vector<sofa::Index> > m_colors;
+    sofa::type::vector<Color> m_elementColor;
+    sofa::type::vector<sofa::Index> m_positionInColor;
+
+    /// Temporary buffers, kept to avoid reallocations
+    sofa::type::vector<Color> m_neighborColors;
+    sofa::type::vector<bool> m_usedColors;
+};
+
+} // namespace sofa::core::topology
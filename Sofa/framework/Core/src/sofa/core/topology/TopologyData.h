@@ -68,6 +68,12 @@ public:
     /// Default Destructor
     ~TopologyData();
 
+    /// Number of bytes allocated for the elements of the container (the value is not updated beforehand)
+    std::size_t getMemoryFootprint() const override
+    {
+        return this->m_value.getValue().capacity() * sizeof(value_type);
+    }
+
 
     /// Function to create topology handler to manage this Data. @param Pointer to dynamic topology is needed.
     virtual void createTopologyHandler(sofa::core::topology::BaseMeshTopology* _topology);
@@ -111,6 +111,23 @@ public:
     */
     virtual void parallelUpdateVisual() { }
 
+    /**
+     *  \brief Enable or disable the double buffering of the state written by the simulation.
+     *
+     *  When enabled, the simulation writes the next state of the model (for instance through a
+     *  mapping) in a back buffer, while the current state is updated and rendered. The back
+     *  buffer is published by swapVisualState(). Used by pipelined animation loops.
+     */
+    virtual void setDoubleBuffered(bool /*enabled*/) { }
+
+    /**
+     *  \brief Publish the state written by the simulation since the last call, so that it is used
+     *  by the next updateVisual() and draw calls. Only meaningful if the model is double buffered.
+     *
+     *  Must not be called while the simulation is computing a step.
+     */
+    virtual void swapVisualState() { }
+
 
     /**
      *  \brief used to add the bounding-box of this visual model to the
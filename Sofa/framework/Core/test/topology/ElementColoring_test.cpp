@@ -0,0 +1,181 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/core/topology/ElementColoring.h>
+#include <sofa/core/topology/Topology.h>
+#include <gtest/gtest.h>
+
+namespace sofa::core::topology
+{
+
+using Triangle = Topology::Triangle;
+using Tetrahedron = Topology::Tetrahedron;
+
+namespace
+{
+/// Triangulated grid of nx*ny squares
+sofa::type::vector<Triangle> makeTriangleGrid(const sofa::Index nx, const sofa::Index ny)
+{
+    sofa::type::vector<Triangle> triangles;
+    for (sofa::Index j = 0; j < ny; ++j)
+    {
+        for (sofa::Index i = 0; i < nx; ++i)
+        {
+            const sofa::Index p = j * (nx + 1) + i;
+            triangles.emplace_back(p, p + 1, p + nx + 2);
+            triangles.emplace_back(p, p + nx + 2, p + nx + 1);
+        }
+    }
+    return triangles;
+}
+
+/// Elements around each vertex, as stored by the topology containers
+sofa::type::vector<sofa::type::vector<sofa::Index> > computeElementsAroundVertex(const sofa::type::vector<Triangle>& triangles, const sofa::Size nbPoints)
+{
+    sofa::type::vector<sofa::type::vector<sofa::Index> > elementsAroundVertex(nbPoints);
+    for (sofa::Index t = 0; t < triangles.size(); ++t)
+    {
+        for (const auto v : triangles[t])
+        {
+            elementsAroundVertex[v].push_back(t);
+        }
+    }
+    return elementsAroundVertex;
+}
+}
+
+TEST(ElementColoring, empty)
+{
+    ElementColoring coloring;
+    coloring.compute(sofa::type::vector<Triangle>(), 0);
+
+    EXPECT_EQ(coloring.getNbColors(), 0u);
+    EXPECT_EQ(coloring.getNbElements(), 0u);
+}
+
+TEST(ElementColoring, compute)
+{
+    const auto triangles = makeTriangleGrid(10, 8);
+
+    ElementColoring coloring;
+    coloring.compute(triangles, 0);
+
+    EXPECT_EQ(coloring.getNbElements(), triangles.size());
+    EXPECT_TRUE(coloring.isValid(triangles));
+
+    // at most one color per neighbor (a vertex of the grid has at most 6 triangles around it)
+    EXPECT_LE(coloring.getNbColors(), 3 * 5 + 1);
+
+    sofa::Size nbElements = 0;
+    for (sofa::Index c = 0; c < coloring.getNbColors(); ++c)
+    {
+        for (const auto t : coloring.getColor(c))
+        {
+            EXPECT_EQ(coloring.getElementColor(t), c);
+        }
+        nbElements += coloring.getColor(c).size();
+    }
+    EXPECT_EQ(nbElements, triangles.size());
+}
+
+TEST(ElementColoring, disjointElements)
+{
+    const sofa::type::vector<Tetrahedron> tetrahedra { {0, 1, 2, 3}, {4, 5, 6, 7}, {8, 9, 10, 11} };
+
+    ElementColoring coloring;
+    coloring.compute(tetrahedra, 12);
+
+    EXPECT_EQ(coloring.getNbColors(), 1u);
+    EXPECT_TRUE(coloring.isValid(tetrahedra));
+}
+
+TEST(ElementColoring, invalid)
+{
+    const sofa::type::vector<Triangle> triangles { {0, 1, 2}, {3, 4, 5} };
+
+    ElementColoring coloring;
+    coloring.compute(triangles, 6);
+
+    // the two triangles now share the vertex 2
+    const sofa::type::vector<Triangle> modified { {0, 1, 2}, {2, 4, 5} };
+    EXPECT_FALSE(coloring.isValid(modified));
+    EXPECT_FALSE(coloring.isValid(makeTriangleGrid(1, 1)));
+}
+
+TEST(ElementColoring, addElements)
+{
+    const auto grid = makeTriangleGrid(6, 6);
+    const auto elementsAroundVertex = computeElementsAroundVertex(grid, 7 * 7);
+
+    ElementColoring coloring;
+    sofa::type::vector<Triangle> triangles;
+    for (sofa::Index t = 0; t < grid.size(); ++t)
+    {
+        triangles.push_back(grid[t]);
+        coloring.addElement(t, grid[t], [&](const sofa::Index v) -> const auto& { return elementsAroundVertex[v]; });
+        ASSERT_TRUE(coloring.isValid(triangles));
+    }
+
+    // same greedy order as compute
+    ElementColoring reference;
+    reference.compute(grid, 7 * 7);
+    EXPECT_EQ(coloring.getColors(), reference.getColors());
+}
+
+TEST(ElementColoring, removeElements)
+{
+    auto triangles = makeTriangleGrid(6, 6);
+
+    ElementColoring coloring;
+    coloring.compute(triangles, 7 * 7);
+
+    // remove elements as the topology modifiers do: the last element takes the index of the removed one
+    const sofa::type::vector<sofa::Index> removed { 5, 70, 0, 30, 30, 12 };
+    for (const auto t : removed)
+    {
+        coloring.removeElement(t);
+        triangles[t] = triangles.back();
+        triangles.pop_back();
+
+        ASSERT_TRUE(coloring.isValid(triangles));
+        ASSERT_EQ(coloring.getNbElements(), triangles.size());
+        for (sofa::Index c = 0; c < coloring.getNbColors(); ++c)
+        {
+            for (const auto e : coloring.getColor(c))
+            {
+                ASSERT_LT(e, triangles.size());
+                ASSERT_EQ(coloring.getElementColor(e), c);
+            }
+        }
+    }
+
+    // remove all the remaining elements
+    while (!triangles.empty())
+    {
+        coloring.removeElement(0);
+        triangles[0] = triangles.back();
+        triangles.pop_back();
+    }
+    EXPECT_EQ(coloring.getNbElements(), 0u);
+    EXPECT_EQ(coloring.getNbColors(), 0u);
+}
+
+}
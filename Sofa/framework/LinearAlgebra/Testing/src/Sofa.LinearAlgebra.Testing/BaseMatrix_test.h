@@ -134,6 +134,49 @@ public:
         }
     }
 
+    /// A dense element matrix, made of 2x2 blocks of size 3x3, is added twice into the matrix
+    /// This assumes the matrix is big enough to contain 6 rows and columns after the offset
+    /// @param offset index of the first row and column associated with the nodes of the element
+    void checkAddElementMatrix(sofa::linearalgebra::BaseMatrix::Index offset)
+    {
+        m_testedMatrix->clear();
+        m_modelMatrix.clear();
+
+        const sofa::type::fixed_array<sofa::Index, 2> nodes(1, 0);
+        sofa::type::Mat<6, 6, Real> elementMatrix;
+        Real value = (Real)0;
+        for (sofa::Index i = 0 ; i < 6; ++i)
+        {
+            for (sofa::Index j = 0 ; j < 6; ++j)
+            {
+                elementMatrix(i, j) = ++value;
+            }
+        }
+
+        constexpr SReal scale = -2;
+        m_testedMatrix->addElementMatrix(offset, nodes, elementMatrix, scale);
+        m_testedMatrix->addElementMatrix(offset, nodes, elementMatrix, scale);
+        m_testedMatrix->compress();
+
+        for (sofa::Index n1 = 0; n1 < 2; ++n1)
+        {
+            for (sofa::Index n2 = 0; n2 < 2; ++n2)
+            {
+                for (sofa::Index i = 0 ; i < 3; ++i)
+                {
+                    for (sofa::Index j = 0 ; j < 3; ++j)
+                    {
+                        m_modelMatrix(offset + 3 * nodes[n1] + i, offset + 3 * nodes[n2] + j) += 2 * scale * elementMatrix(3 * n1 + i, 3 * n2 + j);
+                    }
+                }
+            }
+        }
+
+        EXPECT_LT(Inherit::matrixMaxDiff(m_modelMatrix, *m_testedMatrix), 100 * Inherit::epsilon())
+            << "offset = " << offset << "\n"
+            << "M = " << *m_testedMatrix;
+    }
+
 protected:
 
     sofa::type::Mat<NbRows, NbCols, Real> m_modelMatrix;
@@ -160,8 +203,15 @@ TYPED_TEST_P(TestBaseMatrix, addBloc)
     this->checkAddBloc(0, 2);
 }
 
+TYPED_TEST_P(TestBaseMatrix, addElementMatrix)
+{
+    this->checkAddElementMatrix(0);
+    this->checkAddElementMatrix(3);
+    this->checkAddElementMatrix(1);
+}
+
 REGISTER_TYPED_TEST_SUITE_P(TestBaseMatrix,
-                            resize, addScalar, addBloc
+                            resize, addScalar, addBloc, addElementMatrix
 );
 
 } //namespace sofa::linearalgebra::testing
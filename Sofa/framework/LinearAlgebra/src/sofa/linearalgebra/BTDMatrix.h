@@ -159,6 +159,8 @@ public:
 
     Index colSize(void) const override;
 
+    std::size_t getMemoryFootprint() const override { return allocsize > 0 ? allocsize * sizeof(Block) : 0; }
+
     SReal element(Index i, Index j) const override;
 
     const Block& asub(Index bi, Index bj, Index, Index) const;
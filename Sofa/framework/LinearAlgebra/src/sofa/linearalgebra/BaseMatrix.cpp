@@ -134,6 +134,58 @@ void BaseMatrix::add(Index row, Index col, const type::Mat2x2f & _M) {
             add(row + i, col + j, _M[i][j]);
 }
 
+/// Add the blocks of a dense element matrix, using the 2x2 and 3x3 block insertions of the matrix if possible
+template<class real>
+void addElementMatrixByBlocks(BaseMatrix* self, BaseMatrix::Index offset, BaseMatrix::Index blockSize,
+                              const sofa::Index* nodes, sofa::Size nbNodes, const real* values, SReal scale)
+{
+    using Index = BaseMatrix::Index;
+    const Index nbCols = static_cast<Index>(nbNodes) * blockSize;
+
+    for (sofa::Size n1 = 0; n1 < nbNodes; ++n1)
+    {
+        const Index row = offset + static_cast<Index>(nodes[n1]) * blockSize;
+        for (sofa::Size n2 = 0; n2 < nbNodes; ++n2)
+        {
+            const Index col = offset + static_cast<Index>(nodes[n2]) * blockSize;
+            const real* block = values + static_cast<Index>(n1) * blockSize * nbCols + static_cast<Index>(n2) * blockSize;
+
+            if (blockSize == 3)
+            {
+                type::Mat<3, 3, real> M(type::NOINIT);
+                for (Index i = 0; i < 3; ++i)
+                    for (Index j = 0; j < 3; ++j)
+                        M[i][j] = static_cast<real>(block[i * nbCols + j] * scale);
+                self->add(row, col, M);
+            }
+            else if (blockSize == 2)
+            {
+                type::Mat<2, 2, real> M(type::NOINIT);
+                for (Index i = 0; i < 2; ++i)
+                    for (Index j = 0; j < 2; ++j)
+                        M[i][j] = static_cast<real>(block[i * nbCols + j] * scale);
+                self->add(row, col, M);
+            }
+            else
+            {
+                for (Index i = 0; i < blockSize; ++i)
+                    for (Index j = 0; j < blockSize; ++j)
+                        self->add(row + i, col + j, block[i * nbCols + j] * scale);
+            }
+        }
+    }
+}
+
+void BaseMatrix::addElementMatrix(Index offset, Index blockSize, const sofa::Index* nodes, sofa::Size nbNodes, const double* values, SReal scale)
+{
+    addElementMatrixByBlocks(this, offset, blockSize, nodes, nbNodes, values, scale);
+}
+
+void BaseMatrix::addElementMatrix(Index offset, Index blockSize, const sofa::Index* nodes, sofa::Size nbNodes, const float* values, SReal scale)
+{
+    addElementMatrixByBlocks(this, offset, blockSize, nodes, nbNodes, values, scale);
+}
+
 
 // specialication for 1x1 blocks
 template <class Real, bool add, bool transpose, class M, class V1, class V2>
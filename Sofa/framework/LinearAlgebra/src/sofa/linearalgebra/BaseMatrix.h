@@ -78,6 +78,26 @@ public:
     ///Adding values from a 2x2f matrix. This function may be overload to obtain better performances
     virtual void add(Index row, Index col, const type::Mat2x2f & _M);
 
+    /** Adding the dense matrix of an element, made of nbNodes x nbNodes blocks of size blockSize x blockSize.
+     * The block (n1, n2) of the element matrix, multiplied by scale, is added at
+     * (offset + nodes[n1] * blockSize, offset + nodes[n2] * blockSize).
+     * values is the element matrix stored row by row, i.e. (nbNodes * blockSize)^2 values.
+     * This function may be overload to obtain better performances: the default implementation
+     * adds the element matrix block by block.
+     */
+    virtual void addElementMatrix(Index offset, Index blockSize, const sofa::Index* nodes, sofa::Size nbNodes, const double* values, SReal scale);
+
+    ///Adding the dense matrix of an element stored in floats. This function may be overload to obtain better performances
+    virtual void addElementMatrix(Index offset, Index blockSize, const sofa::Index* nodes, sofa::Size nbNodes, const float* values, SReal scale);
+
+    ///Adding the dense matrix of an element, given with the list of its nodes
+    template<class IndexArray, sofa::Size L, class real>
+    void addElementMatrix(Index offset, const IndexArray& nodes, const type::Mat<L, L, real>& elementMatrix, SReal scale = 1)
+    {
+        const auto nbNodes = static_cast<sofa::Size>(nodes.size());
+        addElementMatrix(offset, static_cast<Index>(L / nbNodes), nodes.data(), nbNodes, elementMatrix.ptr(), scale);
+    }
+
     /*    /// Write the value of the element at row i, column j (using 0-based indices)
         virtual void set(Index i, Index j, float v) { set(i,j,(double)v); }
         /// Add v to the existing value of the element at row i, column j (using 0-based indices)
@@ -144,6 +164,9 @@ public:
     /// @return the width of the band on each side of the diagonal (only for band matrices)
     virtual Index getBandWidth() const { return -1; }
 
+    /// @return the number of bytes allocated to store this matrix, or 0 if unknown
+    virtual std::size_t getMemoryFootprint() const { return 0; }
+
     /// @return true if this matrix is diagonal
     bool isDiagonal() const
     {
@@ -76,6 +76,9 @@ public:
     /// This is the exact opposite to isFull().
     bool isSparse() const { return !isFull(); }
 
+    /// @return the number of bytes allocated to store this vector, or 0 if unknown
+    virtual std::size_t getMemoryFootprint() const { return 0; }
+
     /// @}
 
 protected:
@@ -0,0 +1,119 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/linearalgebra/BlockKernels.h>
+
+namespace sofa::linearalgebra::kernels
+{
+
+static_assert(sizeof(type::Mat<3,3,double>) == 9 * sizeof(double), "the kernels expect the 9 values of a block to be contiguous");
+static_assert(sizeof(type::Mat<3,3,float>) == 9 * sizeof(float), "the kernels expect the 9 values of a block to be contiguous");
+
+namespace
+{
+
+template<class Real>
+void rowProduct(const type::Mat<3,3,Real>* blocks, const sofa::Index* cols, sofa::Size nbBlocks, const Real* vec, Real* r)
+{
+    Real r0 = 0, r1 = 0, r2 = 0;
+    for (sofa::Size k = 0; k < nbBlocks; ++k)
+    {
+        const Real* b = blocks[k].ptr();
+        const Real* x = vec + 3 * cols[k];
+        for (sofa::Size j = 0; j < 3; ++j)
+        {
+            r0 += b[j] * x[j];
+            r1 += b[3 + j] * x[j];
+            r2 += b[6 + j] * x[j];
+        }
+    }
+    r[0] = r0;
+    r[1] = r1;
+    r[2] = r2;
+}
+
+template<class Real>
+void rowTransposedProduct(const type::Mat<3,3,Real>* blocks, const sofa::Index* cols, sofa::Size nbBlocks, const Real* v, Real* res)
+{
+    const Real v0 = v[0], v1 = v[1], v2 = v[2];
+    for (sofa::Size k = 0; k < nbBlocks; ++k)
+    {
+        const Real* b = blocks[k].ptr();
+        Real* out = res + 3 * cols[k];
+        out[0] += b[0] * v0 + b[3] * v1 + b[6] * v2;
+        out[1] += b[1] * v0 + b[4] * v1 + b[7] * v2;
+        out[2] += b[2] * v0 + b[5] * v1 + b[8] * v2;
+    }
+}
+
+template<class Real>
+void columnTransposedProduct(const type::Mat<3,3,Real>* values, const sofa::Index* slots, const sofa::Index* rows, sofa::Size nbBlocks, const Real* vec, Real* r)
+{
+    Real r0 = 0, r1 = 0, r2 = 0;
+    for (sofa::Size k = 0; k < nbBlocks; ++k)
+    {
+        const Real* b = values[slots[k]].ptr();
+        const Real* x = vec + 3 * rows[k];
+        for (sofa::Size i = 0; i < 3; ++i)
+        {
+            r0 += b[3 * i] * x[i];
+            r1 += b[3 * i + 1] * x[i];
+            r2 += b[3 * i + 2] * x[i];
+        }
+    }
+    r[0] = r0;
+    r[1] = r1;
+    r[2] = r2;
+}
+
+} // namespace
+
+void mat3x3RowProduct(const type::Mat<3,3,double>* blocks, const sofa::Index* cols, sofa::Size nbBlocks, const double* vec, double* r)
+{
+    rowProduct(blocks, cols, nbBlocks, vec, r);
+}
+
+void mat3x3RowProduct(const type::Mat<3,3,float>* blocks, const sofa::Index* cols, sofa::Size nbBlocks, const float* vec, float* r)
+{
+    rowProduct(blocks, cols, nbBlocks, vec, r);
+}
+
+void mat3x3RowTransposedProduct(const type::Mat<3,3,double>* blocks, const sofa::Index* cols, sofa::Size nbBlocks, const double* v, double* res)
+{
+    rowTransposedProduct(blocks, cols, nbBlocks, v, res);
+}
+
+void mat3x3RowTransposedProduct(const type::Mat<3,3,float>* blocks, const sofa::Index* cols, sofa::Size nbBlocks, const float* v, float* res)
+{
+    rowTransposedProduct(blocks, cols, nbBlocks, v, res);
+}
+
+void mat3x3ColumnTransposedProduct(const type::Mat<3,3,double>* values, const sofa::Index* slots, const sofa::Index* rows, sofa::Size nbBlocks, const double* vec, double* r)
+{
+    columnTransposedProduct(values, slots, rows, nbBlocks, vec, r);
+}
+
+void mat3x3ColumnTransposedProduct(const type::Mat<3,3,float>* values, const sofa::Index* slots, const sofa::Index* rows, sofa::Size nbBlocks, const float* vec, float* r)
+{
+    columnTransposedProduct(values, slots, rows, nbBlocks, vec, r);
+}
+
+} // namespace sofa::linearalgebra::kernels
@@ -0,0 +1,60 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/linearalgebra/config.h>
+
+#include <sofa/linearalgebra/FullVector.h>
+#include <sofa/type/Mat.h>
+#include <type_traits>
+
+/**
+ * Kernels of the products of a sparse matrix of 3x3 blocks with a vector.
+ *
+ * The blocks are read in place (type::Mat<3,3,Real> stores 9 contiguous values), and the three
+ * components of the result are accumulated in local variables, instead of the temporary block-sized
+ * vectors of the generic products of CompressedRowSparseMatrix.
+ */
+namespace sofa::linearalgebra::kernels
+{
+
+/// r = sum_k blocks[k] * vec[3*cols[k] .. 3*cols[k]+2]
+SOFA_LINEARALGEBRA_API void mat3x3RowProduct(const type::Mat<3,3,double>* blocks, const sofa::Index* cols, sofa::Size nbBlocks, const double* vec, double* r);
+SOFA_LINEARALGEBRA_API void mat3x3RowProduct(const type::Mat<3,3,float>* blocks, const sofa::Index* cols, sofa::Size nbBlocks, const float* vec, float* r);
+
+/// res[3*cols[k] .. 3*cols[k]+2] += blocks[k]^T * v, for each block k
+SOFA_LINEARALGEBRA_API void mat3x3RowTransposedProduct(const type::Mat<3,3,double>* blocks, const sofa::Index* cols, sofa::Size nbBlocks, const double* v, double* res);
+SOFA_LINEARALGEBRA_API void mat3x3RowTransposedProduct(const type::Mat<3,3,float>* blocks, const sofa::Index* cols, sofa::Size nbBlocks, const float* v, float* res);
+
+/// r = sum_k values[slots[k]]^T * vec[3*rows[k] .. 3*rows[k]+2]
+SOFA_LINEARALGEBRA_API void mat3x3ColumnTransposedProduct(const type::Mat<3,3,double>* values, const sofa::Index* slots, const sofa::Index* rows, sofa::Size nbBlocks, const double* vec, double* r);
+SOFA_LINEARALGEBRA_API void mat3x3ColumnTransposedProduct(const type::Mat<3,3,float>* values, const sofa::Index* slots, const sofa::Index* rows, sofa::Size nbBlocks, const float* vec, float* r);
+
+/// True if the products of a matrix of blocks of type Block with vectors of types V1 and V2,
+/// computed with the precision Real2, can use the kernels
+template<class Block, class Real2, class V1, class V2>
+inline constexpr bool hasMat3x3Kernels = false;
+
+template<class Real>
+inline constexpr bool hasMat3x3Kernels<type::Mat<3,3,Real>, Real, FullVector<Real>, FullVector<Real> > =
+    std::is_same_v<Real, double> || std::is_same_v<Real, float>;
+
+} // namespace sofa::linearalgebra::kernels
@@ -82,6 +82,7 @@ void filterValuesFromBlocs(TMatrix& self, CompressedRowSparseMatrix<type::Mat<L,
     self.colsValue.clear();
     self.compressed = true;
     self.btemp.clear();
+    self.invalidatePatternCache();
     self.rowIndex.reserve(M.rowIndex.size()*3);
     self.rowBegin.reserve(M.rowBegin.size()*3);
     self.colsIndex.reserve(M.colsIndex.size()*9);
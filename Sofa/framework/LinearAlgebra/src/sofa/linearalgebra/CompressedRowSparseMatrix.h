@@ -23,16 +23,28 @@
 #include <sofa/linearalgebra/config.h>
 
 #include <sofa/linearalgebra/BaseMatrix.h>
+#include <sofa/linearalgebra/BlockKernels.h>
 #include <sofa/linearalgebra/MatrixExpr.h>
 #include <sofa/linearalgebra/matrix_bloc_traits.h>
 #include <sofa/linearalgebra/FullMatrix.h>
 #include <sofa/linearalgebra/FullVector.h>
 #include <sofa/type/vector.h>
 #include <sofa/helper/rmath.h>
+#include <type_traits>
 
 namespace sofa::linearalgebra
 {
 
+namespace details
+{
+/// Scalar type used to accumulate the product of a matrix of scalar type Real with a vector of type V
+template<class Real, class V, class = void>
+struct ProductReal { using type = Real; };
+
+template<class Real, class V>
+struct ProductReal<Real, V, std::void_t<typename V::Real> > { using type = std::common_type_t<Real, typename V::Real>; };
+}
+
 template<typename TBlock, typename TVecBlock = type::vector<TBlock>, typename TVecIndex = type::vector<sofa::Index> >
 class CompressedRowSparseMatrix : public linearalgebra::BaseMatrix
 {
@@ -52,6 +64,13 @@ public:
 
     typedef TVecBlock VecBlock;
     typedef TVecIndex VecIndex;
+
+    /// Scalar type used to accumulate the products with a vector of type V: the most precise of the
+    /// scalar types of the matrix and of the vector. A matrix stored in single precision can then be
+    /// multiplied by double precision vectors without losing the precision of the vectors.
+    template<class V>
+    using ProductReal = typename details::ProductReal<Real, V>::type;
+
     struct IndexedBlock
     {
         Index l,c;
@@ -194,10 +213,7 @@ public:
         if (nBlockRow == nbBRow && nBlockRow == nbBCol)
         {
             // just clear the matrix
-            for (Index i=0; i < (Index)colsValue.size(); ++i)
-                traits::clear(colsValue[i]);
-            compressed = colsValue.empty();
-            btemp.clear();
+            clearValues();
         }
         else
         {
@@ -214,6 +230,7 @@ public:
             colsValue.clear();
             compressed = true;
             btemp.clear();
+            invalidatePatternCache();
         }
     }
 
@@ -352,8 +369,54 @@ public:
         rowBegin.push_back(outValId);
         btemp.clear();
         compressed = true;
+
+        if (m_patternReuse)
+        {
+            // the slots changed: the next assembly records them again
+            m_cachedSlots.clear();
+            m_patternState = PatternState::RECORDING;
+            m_isInsertionSequenceBroken = m_nbInsertions > 0;
+        }
+    }
+
+    /// @name Reuse of the sparsity pattern
+    /// When the sparsity pattern does not change from an assembly to the next one (e.g. constant
+    /// topology), it can be frozen instead of being rebuilt at each assembly:
+    /// - the assembly following a compress() records, for each block insertion, the slot of the
+    ///   block in colsValue,
+    /// - the next assemblies add each inserted block directly at the slot recorded for the same
+    ///   insertion, and clear() only resets the values: compress() has nothing to sort nor merge.
+    /// The empty blocks are kept in a frozen pattern.
+    /// If an assembly does not insert the same sequence of blocks (e.g. after a topological change),
+    /// its result is still correct, and the pattern is rebuilt from scratch by the next assembly.
+    /// @{
+
+    /// Enable or disable the reuse of the sparsity pattern
+    void setPatternReuse(bool reuse)
+    {
+        if (reuse != m_patternReuse)
+        {
+            m_patternReuse = reuse;
+            invalidatePatternCache();
+        }
+    }
+
+    bool isPatternReused() const { return m_patternReuse; }
+
+    /// true if the blocks are inserted at the slots recorded in a previous assembly
+    bool isPatternFrozen() const { return m_patternState == PatternState::FROZEN; }
+
+    /// Forget the recorded slots. Must be called if the compressed structure is modified directly.
+    void invalidatePatternCache()
+    {
+        m_cachedSlots.clear();
+        m_nbInsertions = 0;
+        m_isInsertionSequenceBroken = false;
+        m_patternState = PatternState::NONE;
     }
 
+    /// @}
+
     void swap(Matrix& m)
     {
         Index t;
@@ -370,6 +433,8 @@ public:
         colsIndex.swap(m.colsIndex);
         colsValue.swap(m.colsValue);
         btemp.swap(m.btemp);
+        invalidatePatternCache();
+        m.invalidatePatternCache();
     }
 
     /// Make sure all rows have an entry even if they are empty
@@ -377,6 +442,7 @@ public:
     {
         compress();
         if ((decltype(nRow))rowIndex.size() >= nRow) return;
+        invalidatePatternCache();
         oldRowIndex.swap(rowIndex);
         oldRowBegin.swap(rowBegin);
         rowIndex.resize(nRow);
@@ -421,6 +487,7 @@ public:
         }
         if (ndiag == nRow) return;
 
+        invalidatePatternCache();
         oldRowIndex.swap(rowIndex);
         oldRowBegin.swap(rowBegin);
         oldColsIndex.swap(colsIndex);
@@ -481,6 +548,7 @@ public:
     /// to call again with -1 as base to undo it.
     void shiftIndices(Index base)
     {
+        invalidatePatternCache();
         for (Index i=0; i<(decltype(i))rowIndex.size(); ++i)
             rowIndex[i] += base;
         for (Index i=0; i<(decltype(i))rowBegin.size(); ++i)
@@ -538,6 +606,7 @@ public:
         colsValue.clear();
         compressed = true;
         btemp.clear();
+        invalidatePatternCache();
         rowIndex.reserve(M.rowIndex.size());
         rowBegin.reserve(M.rowBegin.size());
         colsIndex.reserve(M.colsIndex.size());
@@ -632,6 +701,14 @@ public:
 
     Block* wbloc(Index i, Index j, bool create = false)
     {
+        if (create && m_patternState != PatternState::NONE)
+        {
+            if (Block* b = wblocFromPatternCache(i, j))
+            {
+                return b;
+            }
+        }
+
         Index rowId = i * (Index)rowIndex.size() / nBlockRow;
         if (sortedFind(rowIndex, i, rowId))
         {
@@ -744,6 +821,18 @@ public:
         BaseMatrix::add(row, col, _M);
     }
 
+    using BaseMatrix::addElementMatrix;
+
+    void addElementMatrix(Index offset, Index blockSize, const sofa::Index* nodes, sofa::Size nbNodes, const double* values, SReal scale) override
+    {
+        addElementMatrixImpl(offset, blockSize, nodes, nbNodes, values, scale);
+    }
+
+    void addElementMatrix(Index offset, Index blockSize, const sofa::Index* nodes, sofa::Size nbNodes, const float* values, SReal scale) override
+    {
+        addElementMatrixImpl(offset, blockSize, nodes, nbNodes, values, scale);
+    }
+
     void clear(Index i, Index j) override
     {
         dmsg_info_when(COMPRESSEDROWSPARSEMATRIX_VERBOSE)
@@ -855,13 +944,157 @@ public:
     }
 
     void clear() override
+    {
+        clearValues();
+    }
+
+protected:
+
+    /// Add a dense element matrix block by block, each block of the matrix being accessed once
+    /// per element, without going through the per-entry virtual insertion
+    template<class real>
+    void addElementMatrixImpl(Index offset, Index blockSize, const sofa::Index* nodes, sofa::Size nbNodes, const real* values, SReal scale)
+    {
+        if (offset % NL != 0 || offset % NC != 0 || blockSize % NL != 0 || blockSize % NC != 0)
+        {
+            // the blocks of the element are not aligned on the blocks of the matrix
+            BaseMatrix::addElementMatrix(offset, blockSize, nodes, nbNodes, values, scale);
+            return;
+        }
+
+        const Index nbCols = static_cast<Index>(nbNodes) * blockSize;
+        for (sofa::Size n1 = 0; n1 < nbNodes; ++n1)
+        {
+            const Index row = offset + static_cast<Index>(nodes[n1]) * blockSize;
+            const real* rowValues = values + static_cast<Index>(n1) * blockSize * nbCols;
+            for (sofa::Size n2 = 0; n2 < nbNodes; ++n2)
+            {
+                const Index col = offset + static_cast<Index>(nodes[n2]) * blockSize;
+                const real* nodeValues = rowValues + static_cast<Index>(n2) * blockSize;
+                for (Index bi = 0; bi < blockSize; bi += NL)
+                {
+                    for (Index bj = 0; bj < blockSize; bj += NC)
+                    {
+                        Block& block = *wbloc((row + bi) / NL, (col + bj) / NC, true);
+                        const real* blockValues = nodeValues + bi * nbCols + bj;
+                        for (Index i = 0; i < NL; ++i)
+                        {
+                            for (Index j = 0; j < NC; ++j)
+                            {
+                                traits::v(block, i, j) += static_cast<Real>(blockValues[i * nbCols + j] * scale);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /// Set all the values to zero, keeping the pattern if it is reused (see setPatternReuse)
+    void clearValues()
     {
         for (Index i=0; i < (Index)colsValue.size(); ++i)
             traits::clear(colsValue[i]);
-        compressed = colsValue.empty();
         btemp.clear();
+
+        if (m_patternState == PatternState::NONE)
+        {
+            // the empty blocks will be removed by the next compression
+            compressed = colsValue.empty();
+            return;
+        }
+
+        if (m_nbInsertions > 0)
+        {
+            if (m_patternState == PatternState::FROZEN)
+            {
+                if (m_isInsertionSequenceBroken || m_nbInsertions != m_cachedSlots.size())
+                {
+                    // the pattern changed: it is fully rebuilt by the next assembly
+                    rowIndex.clear();
+                    rowBegin.clear();
+                    colsIndex.clear();
+                    colsValue.clear();
+                    m_cachedSlots.clear();
+                    m_patternState = PatternState::NONE;
+                }
+            }
+            else if (m_isInsertionSequenceBroken)
+            {
+                m_cachedSlots.clear();
+            }
+            else
+            {
+                m_patternState = PatternState::FROZEN;
+            }
+        }
+        m_nbInsertions = 0;
+        m_isInsertionSequenceBroken = false;
+    }
+
+    /// Block inserted by the current insertion, from the slots recorded for the pattern reuse.
+    /// Returns nullptr if the block is not in the compressed structure, or if the sequence of
+    /// insertions differs from the recorded one.
+    Block* wblocFromPatternCache(Index i, Index j)
+    {
+        const std::size_t insertionId = m_nbInsertions++;
+        if (m_isInsertionSequenceBroken)
+        {
+            return nullptr;
+        }
+
+        if (m_patternState == PatternState::FROZEN)
+        {
+            if (insertionId < m_cachedSlots.size())
+            {
+                const CachedSlot& cached = m_cachedSlots[insertionId];
+                if (cached.row == i && cached.col == j)
+                {
+                    return &colsValue[cached.slot];
+                }
+            }
+        }
+        else if (!rowIndex.empty())
+        {
+            Index rowId = i * (Index)rowIndex.size() / nBlockRow;
+            if (sortedFind(rowIndex, i, rowId))
+            {
+                Range rowRange(rowBegin[rowId], rowBegin[rowId+1]);
+                Index colId = rowRange.begin() + j * rowRange.size() / nBlockCol;
+                if (sortedFind(colsIndex, rowRange, j, colId))
+                {
+                    m_cachedSlots.push_back({i, j, colId});
+                    return &colsValue[colId];
+                }
+            }
+        }
+
+        m_isInsertionSequenceBroken = true;
+        return nullptr;
     }
 
+    enum class PatternState : char
+    {
+        NONE,      ///< the pattern is not reused
+        RECORDING, ///< the slots of the inserted blocks are recorded
+        FROZEN     ///< the blocks are inserted at the recorded slots
+    };
+
+    struct CachedSlot
+    {
+        Index row;
+        Index col;
+        Index slot; ///< index of the block in colsValue
+    };
+
+    bool m_patternReuse { false };
+    PatternState m_patternState { PatternState::NONE };
+    type::vector<CachedSlot> m_cachedSlots; ///< slot of each block insertion, in order of insertion
+    std::size_t m_nbInsertions { 0 }; ///< number of block insertions since the last clear
+    bool m_isInsertionSequenceBroken { false }; ///< true if an insertion did not match the recorded slots
+
+public:
+
     /// @name Get information about the content and structure of this matrix (diagonal, band, sparse, full, block size, ...)
     /// @{
 
@@ -889,6 +1122,16 @@ public:
     /// @return the width of the band on each side of the diagonal (only for band matrices)
     Index getBandWidth() const override { return NC-1; }
 
+    /// @return the number of bytes allocated by the compressed storage, the insertion buffers and the cached insertion slots
+    std::size_t getMemoryFootprint() const override
+    {
+        return (rowIndex.capacity() + rowBegin.capacity() + colsIndex.capacity()
+                + oldRowIndex.capacity() + oldRowBegin.capacity() + oldColsIndex.capacity()) * sizeof(typename VecIndex::value_type)
+            + (colsValue.capacity() + oldColsValue.capacity()) * sizeof(typename VecBlock::value_type)
+            + btemp.capacity() * sizeof(IndexedBlock)
+            + m_cachedSlots.capacity() * sizeof(CachedSlot);
+    }
+
     /// @}
 
     /// @name Virtual iterator classes and methods
@@ -1026,6 +1269,14 @@ public:
     /// Get write access to a block, possibly creating it
     BlockAccessor blocCreate(Index i, Index j) override
     {
+        if (m_patternState != PatternState::NONE)
+        {
+            if (const Block* b = wblocFromPatternCache(i, j))
+            {
+                return createBlockAccessor(i, j, static_cast<Index>(b - colsValue.data()));
+            }
+        }
+
         Index rowId = i * (Index)rowIndex.size() / nBlockRow;
         if (sortedFind(rowIndex, i, rowId))
         {
@@ -1216,25 +1467,27 @@ protected:
     /// @name setter/getter & product methods on template vector types
     /// @{
 
-    template<class Vec> static Real vget(const Vec& vec, Index i, Index j, Index k) { return vget( vec, i*j+k ); }
-    template<class Vec> static Real vget(const type::vector<Vec>&vec, Index i, Index /*j*/, Index k) { return vec[i][k]; }
+    // The values are read and written in the precision of the vectors, which can differ from the
+    // precision of the matrix (see ProductReal)
+    template<class Vec> static auto vget(const Vec& vec, Index i, Index j, Index k) { return vget( vec, i*j+k ); }
+    template<class Vec> static auto vget(const type::vector<Vec>&vec, Index i, Index /*j*/, Index k) { return vec[i][k]; }
 
                           static auto  vget(const linearalgebra::BaseVector& vec, Index i) { return vec.element(i); }
     template<class Real2> static Real2 vget(const FullVector<Real2>& vec, Index i) { return vec[i]; }
 
 
-    template<class Vec> static void vset(Vec& vec, Index i, Index j, Index k, Real v) { vset( vec, i*j+k, v ); }
-    template<class Vec> static void vset(type::vector<Vec>&vec, Index i, Index /*j*/, Index k, Real v) { vec[i][k] = v; }
+    template<class Vec, class Real2> static void vset(Vec& vec, Index i, Index j, Index k, Real2 v) { vset( vec, i*j+k, v ); }
+    template<class Vec, class Real2> static void vset(type::vector<Vec>&vec, Index i, Index /*j*/, Index k, Real2 v) { vec[i][k] = v; }
 
-                          static void vset(linearalgebra::BaseVector& vec, Index i, Real v) { vec.set(i, v); }
-    template<class Real2> static void vset(FullVector<Real2>& vec, Index i, Real2 v) { vec[i] = v; }
+                                        static void vset(linearalgebra::BaseVector& vec, Index i, Real v) { vec.set(i, v); }
+    template<class Real2, class Real3> static void vset(FullVector<Real2>& vec, Index i, Real3 v) { vec[i] = v; }
 
 
-    template<class Vec> static void vadd(Vec& vec, Index i, Index j, Index k, Real v) { vadd( vec, i*j+k, v ); }
-    template<class Vec> static void vadd(type::vector<Vec>&vec, Index i, Index /*j*/, Index k, Real v) { vec[i][k] += v; }
+    template<class Vec, class Real2> static void vadd(Vec& vec, Index i, Index j, Index k, Real2 v) { vadd( vec, i*j+k, v ); }
+    template<class Vec, class Real2> static void vadd(type::vector<Vec>&vec, Index i, Index /*j*/, Index k, Real2 v) { vec[i][k] += v; }
 
-                          static void vadd(linearalgebra::BaseVector& vec, Index i, Real v) { vec.add(i, v); }
-    template<class Real2> static void vadd(FullVector<Real2>& vec, Index i, Real2 v) { vec[i] += v; }
+                                        static void vadd(linearalgebra::BaseVector& vec, Index i, Real v) { vec.add(i, v); }
+    template<class Real2, class Real3> static void vadd(FullVector<Real2>& vec, Index i, Real3 v) { vec[i] += v; }
 
     template<class Vec> static void vresize(Vec& vec, Index /*blockSize*/, Index totalSize) { vec.resize( totalSize ); }
     template<class Vec> static void vresize(type::vector<Vec>&vec, Index blockSize, Index /*totalSize*/) { vec.resize( blockSize ); }
@@ -1249,32 +1502,7 @@ protected:
 
           ((Matrix*)this)->compress();
           vresize( res, rowBSize(), rowSize() );
-          for (Index xi = 0; xi < (Index)rowIndex.size(); ++xi)  // for each non-empty block row
-          {
-              type::Vec<NL,Real2> r;  // local block-sized vector to accumulate the product of the block row  with the large vector
-
-              // multiply the non-null blocks with the corresponding chunks of the large vector
-              Range rowRange(rowBegin[xi], rowBegin[xi+1]);
-              for (Index xj = rowRange.begin(); xj < rowRange.end(); ++xj)
-              {
-                  // transfer a chunk of large vector to a local block-sized vector
-                  type::Vec<NC,Real2> v;
-                  //Index jN = colsIndex[xj] * NC;    // scalar column index
-                  for (Index bj = 0; bj < NC; ++bj)
-                      v[bj] = vget(vec,colsIndex[xj],NC,bj);
-
-                  // multiply the block with the local vector
-                  const Block& b = colsValue[xj];    // non-null block has block-indices (rowIndex[xi],colsIndex[xj]) and value colsValue[xj]
-                  for (Index bi = 0; bi < NL; ++bi)
-                      for (Index bj = 0; bj < NC; ++bj)
-                          r[bi] += traits::v(b, bi, bj) * v[bj];
-              }
-
-              // transfer the local result  to the large result vector
-              //Index iN = rowIndex[xi] * NL;                      // scalar row index
-              for (Index bi = 0; bi < NL; ++bi)
-                  vset(res, rowIndex[xi], NL, bi, r[bi]);
-          }
+          tmulRows<Real2>(res, vec, 0, (Index)rowIndex.size());
       }
 
 
@@ -1286,6 +1514,20 @@ protected:
 
           ((Matrix*)this)->compress();
           vresize( res, rowBSize(), rowSize() );
+
+          if constexpr (kernels::hasMat3x3Kernels<Block, Real2, V1, V2>)
+          {
+              for (Index xi = 0; xi < (Index)rowIndex.size(); ++xi)
+              {
+                  const Index begin = rowBegin[xi];
+                  type::Vec<NL,Real2> r;
+                  kernels::mat3x3RowProduct(colsValue.data() + begin, colsIndex.data() + begin, rowBegin[xi+1] - begin, vec.ptr(), r.ptr());
+                  for (Index bi = 0; bi < NL; ++bi)
+                      vadd(res, rowIndex[xi], NL, bi, r[bi]);
+              }
+              return;
+          }
+
           for (Index xi = 0; xi < (Index)rowIndex.size(); ++xi)  // for each non-empty block row
           {
               type::Vec<NL,Real2> r;  // local block-sized vector to accumulate the product of the block row  with the large vector
@@ -1353,6 +1595,18 @@ protected:
 
           ((Matrix*)this)->compress();
           vresize( res, colBSize(), colSize() );
+
+          if constexpr (kernels::hasMat3x3Kernels<Block, Real2, V1, V2>)
+          {
+              for (Index xi = 0; xi < (Index)rowIndex.size(); ++xi)
+              {
+                  const Index begin = rowBegin[xi];
+                  kernels::mat3x3RowTransposedProduct(colsValue.data() + begin, colsIndex.data() + begin, rowBegin[xi+1] - begin,
+                                                      vec.ptr() + NL * rowIndex[xi], res.ptr());
+              }
+              return;
+          }
+
           for (Index xi = 0; xi < rowIndex.size(); ++xi) // for each non-empty block row (i.e. column of the transpose)
           {
               // copy the corresponding chunk of the input to a local vector
@@ -1384,6 +1638,144 @@ protected:
           }
       }
 
+public:
+
+      /// @name Products restricted to a part of the matrix
+      /// They allow to split a product into independent parts, e.g. to compute them in parallel.
+      /// The matrix must be compressed, and the result vector must be resized beforehand.
+      /// @{
+
+      /// Resize a vector to store the result of this * vec
+      template<class V>
+      void resizeMulResult(V& res) const { vresize( res, rowBSize(), rowSize() ); }
+
+      /// Resize a vector to store the result of this^T * vec
+      template<class V>
+      void resizeMulTransposeResult(V& res) const { vresize( res, colBSize(), colSize() ); }
+
+      /** Product of the matrix with a templated vector res = this * vec, restricted to the non-empty
+       * block rows rowIndex[firstRowId] to rowIndex[lastRowId-1]. The other rows of res are not modified.
+       */
+      template<class Real2, class V1, class V2>
+      void tmulRows(V1& res, const V2& vec, Index firstRowId, Index lastRowId) const
+      {
+          if constexpr (kernels::hasMat3x3Kernels<Block, Real2, V1, V2>)
+          {
+              for (Index xi = firstRowId; xi < lastRowId; ++xi)
+              {
+                  const Index begin = rowBegin[xi];
+                  kernels::mat3x3RowProduct(colsValue.data() + begin, colsIndex.data() + begin, rowBegin[xi+1] - begin,
+                                            vec.ptr(), res.ptr() + NL * rowIndex[xi]);
+              }
+              return;
+          }
+
+          for (Index xi = firstRowId; xi < lastRowId; ++xi)  // for each non-empty block row
+          {
+              type::Vec<NL,Real2> r;  // local block-sized vector to accumulate the product of the block row  with the large vector
+
+              // multiply the non-null blocks with the corresponding chunks of the large vector
+              Range rowRange(rowBegin[xi], rowBegin[xi+1]);
+              for (Index xj = rowRange.begin(); xj < rowRange.end(); ++xj)
+              {
+                  // transfer a chunk of large vector to a local block-sized vector
+                  type::Vec<NC,Real2> v;
+                  //Index jN = colsIndex[xj] * NC;    // scalar column index
+                  for (Index bj = 0; bj < NC; ++bj)
+                      v[bj] = vget(vec,colsIndex[xj],NC,bj);
+
+                  // multiply the block with the local vector
+                  const Block& b = colsValue[xj];    // non-null block has block-indices (rowIndex[xi],colsIndex[xj]) and value colsValue[xj]
+                  for (Index bi = 0; bi < NL; ++bi)
+                      for (Index bj = 0; bj < NC; ++bj)
+                          r[bi] += traits::v(b, bi, bj) * v[bj];
+              }
+
+              // transfer the local result  to the large result vector
+              //Index iN = rowIndex[xi] * NL;                      // scalar row index
+              for (Index bi = 0; bi < NL; ++bi)
+                  vset(res, rowIndex[xi], NL, bi, r[bi]);
+          }
+      }
+
+      /// Non-empty blocks of the matrix sorted by block column, i.e. the pattern of the transposed matrix.
+      /// It must be rebuilt each time the pattern of the matrix changes.
+      struct TransposedPattern
+      {
+          VecIndex colBegin; ///< the blocks of the j-th block column are the entries [colBegin[j], colBegin[j+1]) of the following vectors
+          VecIndex rows;     ///< block row of each block
+          VecIndex slots;    ///< index of each block in colsValue
+      };
+
+      /// Build the pattern of the transposed matrix. The matrix must be compressed.
+      void buildTransposedPattern(TransposedPattern& pattern) const
+      {
+          pattern.colBegin.clear();
+          pattern.colBegin.resize(nBlockCol + 1, 0);
+          for (Index xj = 0; xj < (Index)colsIndex.size(); ++xj)
+              ++pattern.colBegin[colsIndex[xj] + 1];
+          for (Index j = 0; j < nBlockCol; ++j)
+              pattern.colBegin[j + 1] += pattern.colBegin[j];
+
+          pattern.rows.resize(colsIndex.size());
+          pattern.slots.resize(colsIndex.size());
+          VecIndex next(pattern.colBegin.begin(), pattern.colBegin.end() - 1);
+          for (Index xi = 0; xi < (Index)rowIndex.size(); ++xi)
+          {
+              Range rowRange(rowBegin[xi], rowBegin[xi+1]);
+              for (Index xj = rowRange.begin(); xj < rowRange.end(); ++xj)
+              {
+                  const Index k = next[colsIndex[xj]]++;
+                  pattern.rows[k] = rowIndex[xi];
+                  pattern.slots[k] = xj;
+              }
+          }
+      }
+
+      /** Product of the transpose with a templated vector and add it to res   res += this^T * vec,
+       * restricted to the block columns [firstCol, lastCol). The other entries of res are not modified,
+       * so that the block columns can be processed independently.
+       */
+      template<class Real2, class V1, class V2>
+      void taddMulTransposeColumns(V1& res, const V2& vec, const TransposedPattern& pattern, Index firstCol, Index lastCol) const
+      {
+          for (Index j = firstCol; j < lastCol; ++j)
+          {
+              const Index begin = pattern.colBegin[j];
+              const Index end = pattern.colBegin[j+1];
+              if (begin == end) continue;
+
+              type::Vec<NC,Real2> r;  // local vector to accumulate the product of the column with the large vector
+              if constexpr (kernels::hasMat3x3Kernels<Block, Real2, V1, V2>)
+              {
+                  kernels::mat3x3ColumnTransposedProduct(colsValue.data(), pattern.slots.data() + begin, pattern.rows.data() + begin,
+                                                         end - begin, vec.ptr(), r.ptr());
+                  for (Index bj = 0; bj < NC; ++bj)
+                      vadd(res, j, NC, bj, r[bj]);
+                  continue;
+              }
+
+              for (Index k = begin; k < end; ++k)
+              {
+                  const Index i = pattern.rows[k];
+                  const Block& b = colsValue[pattern.slots[k]];
+                  for (Index bi = 0; bi < NL; ++bi)
+                  {
+                      const Real2 v = vget(vec, i, NL, bi);
+                      for (Index bj = 0; bj < NC; ++bj)
+                          r[bj] += traits::v(b, bi, bj) * v;
+                  }
+              }
+
+              for (Index bj = 0; bj < NC; ++bj)
+                  vadd(res, j, NC, bj, r[bj]);
+          }
+      }
+
+      /// @}
+
+protected:
+
 
 /// @}
 
@@ -1531,7 +1923,7 @@ public:
     template< typename V1, typename V2 >
     void mul( V2& result, const V1& v ) const
     {
-        tmul< Real, V2, V1 >(result, v);
+        tmul< ProductReal<V2>, V2, V1 >(result, v);
     }
 
 
@@ -1540,7 +1932,7 @@ public:
     template< typename V1, typename V2 >
     void addMultTranspose( V1& result, const V2& v ) const
     {
-        taddMulTranspose< Real, V1, V2 >(result, v);
+        taddMulTranspose< ProductReal<V1>, V1, V2 >(result, v);
     }
 
     /// @returns this * v
@@ -1572,7 +1964,7 @@ public:
     template< typename V1, typename V2 >
     void addMul( V1& res, const V2& v ) const
     {
-        taddMul< Real,V1,V2 >( res, v );
+        taddMul< ProductReal<V1>,V1,V2 >( res, v );
     }
 
 
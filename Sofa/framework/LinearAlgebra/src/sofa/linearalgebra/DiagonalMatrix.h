@@ -90,6 +90,11 @@ public:
         return data.size();
     }
 
+    std::size_t getMemoryFootprint() const override
+    {
+        return data.getMemoryFootprint();
+    }
+
     SReal element(Index i, Index j) const override
     {
         if (i!=j) return (Real)0;
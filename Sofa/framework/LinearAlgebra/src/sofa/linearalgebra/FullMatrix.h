@@ -93,6 +93,9 @@ public:
     Index rowSize(void) const override { return nRow; }
     Index colSize(void) const override { return nCol; }
 
+    /// Only the memory owned by this matrix is reported, not the one of an external buffer
+    std::size_t getMemoryFootprint() const override { return allocsize > 0 ? allocsize * sizeof(Real) : 0; }
+
     SReal element(Index i, Index j) const override;
     void set(Index i, Index j, double v) override;
     using BaseMatrix::add;
@@ -24,6 +24,8 @@
 
 #include <sofa/helper/logging/Messaging.h>
 #include <sofa/linearalgebra/BaseVector.h>
+#include <sofa/type/aligned_allocator.h>
+#include <memory>
 
 namespace sofa::linearalgebra
 {
@@ -55,6 +57,22 @@ protected:
 
     void checkIndex(Index n) const;
 
+    /// The owned buffers are aligned for SIMD loads and stores
+    using Allocator = sofa::type::aligned_allocator<T>;
+
+    static T* allocateData(Index n)
+    {
+        T* p = Allocator().allocate(n);
+        std::uninitialized_default_construct_n(p, n);
+        return p;
+    }
+
+    static void deallocateData(T* p, Index n)
+    {
+        std::destroy_n(p, n);
+        Allocator().deallocate(p, n);
+    }
+
 public:
 
     FullVector()
@@ -72,7 +90,7 @@ public:
 
     explicit FullVector(Index n)
         : linearalgebra::BaseVector()
-        , data(new T[n]), cursize(n), allocsize(n)
+        , data(allocateData(n)), cursize(n), allocsize(n)
     {
     }
 
@@ -91,7 +109,7 @@ public:
     ~FullVector() override
     {
         if (allocsize>0)
-            delete[] data;
+            deallocateData(data, allocsize);
     }
 
     T* ptr() { return data; }
@@ -101,6 +119,9 @@ public:
 
     Index capacity() const { if (allocsize < 0) return -allocsize; else return allocsize; }
 
+    /// Only the memory owned by this vector is reported, not the one of an external buffer
+    std::size_t getMemoryFootprint() const override { return allocsize > 0 ? allocsize * sizeof(T) : 0; }
+
     Iterator begin() { return data; }
     Iterator end()   { return data+cursize; }
 
@@ -69,9 +69,9 @@ void FullVector<Real>::fastResize(Index dim)
         if (dim > allocsize)
         {
             if (allocsize > 0)
-                delete[] data;
+                deallocateData(data, allocsize);
             allocsize = dim;
-            data = new Real[dim];
+            data = allocateData(dim);
         }
     }
     else
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <sofa/linearalgebra/config.h>
+#include <cstddef>
 #include <utility>
 
 #include <sofa/type/vector_T.h>
@@ -39,6 +40,14 @@ namespace sofa::linearalgebra
  *
  * To compute the product, the method computeProduct must be called.
  *
+ * The intersection is recomputed automatically if the sparsity pattern of one of the input matrices changed since
+ * the previous computation, for the types where it is supported: a hash of the patterns rejects most of the changes
+ * quickly, and the patterns are then compared exactly with a copy of them. It can also be recomputed explicitly
+ * (invalidateIntersection, or the parameter of computeProduct).
+ *
+ * Once the intersection is known, the values of the product are independent from each other: the numeric phase can
+ * be split into ranges of values, and computed in parallel (see sofa::simulation::parallelComputeProduct).
+ *
  * Based on:
  * Saupin, G., Duriez, C. and Grisoni, L., 2007, November. Embedded multigrid approach for real-time volumetric deformation. In International Symposium on Visual Computing (pp. 149-159). Springer, Berlin, Heidelberg.
  * and
@@ -54,8 +63,22 @@ public:
     const TMatrix* matrixB { nullptr };
 
     void computeProduct(bool forceComputeIntersection = false);
+
+    /**
+     * Same as computeProduct, but the numeric phase is split into independent ranges of values of the product.
+     * parallelFor(nbValues, computeRange) must call computeRange(first, last) on ranges covering [0, nbValues),
+     * possibly in parallel.
+     */
+    template<class ParallelFor>
+    void computeProduct(bool forceComputeIntersection, ParallelFor&& parallelFor);
+
     void computeRegularProduct();
 
+    /// Compute the intersection if it is not valid anymore: if it has been invalidated, or if the sparsity pattern of
+    /// one of the input matrices changed since it was computed.
+    /// Return true if the intersection has been computed.
+    bool updateIntersection(bool forceComputeIntersection = false);
+
     const TMatrix& getProductResult() const { return matrixC; }
 
     void invalidateIntersection();
@@ -76,6 +99,15 @@ public:
         ValuesIntersection intersection;
     };
 
+    /// Sparsity pattern of a matrix: its size, and the inner indices of each outer vector
+    struct SparsityPattern
+    {
+        typename TMatrix::Index rows { 0 };
+        typename TMatrix::Index cols { 0 };
+        type::vector<typename TMatrix::Index> outerSizes;
+        type::vector<typename TMatrix::Index> innerIndices;
+    };
+
 protected:
     TMatrix matrixC; /// Result of A*B
 
@@ -83,24 +115,79 @@ protected:
     void computeIntersection();
     void computeProductFromIntersection();
 
+    /// Compute the values [firstValue, lastValue) of the product from the intersection
+    void computeProductFromIntersection(std::size_t firstValue, std::size_t lastValue);
+
+    /// Hash of the sparsity pattern of a matrix, used to detect changes of pattern.
+    /// 0 if it is not supported for the type of matrix.
+    static std::size_t computeSparsityPatternHash(const TMatrix& matrix);
+
+    /// Copy the sparsity pattern of a matrix. Nothing is copied if it is not supported for the type of matrix.
+    static void copySparsityPattern(const TMatrix& matrix, SparsityPattern& pattern);
+
+    /// Compare exactly the sparsity pattern of a matrix with a copy of a pattern.
+    /// Always true if it is not supported for the type of matrix.
+    static bool hasSparsityPattern(const TMatrix& matrix, const SparsityPattern& pattern);
+
     Intersection m_intersectionAB;
 
+    /// Hashes of the sparsity patterns of the input matrices when the intersection was computed
+    std::size_t m_patternHashA { 0 };
+    std::size_t m_patternHashB { 0 };
+
+    /// Sparsity patterns of the input matrices when the intersection was computed: two different patterns can have
+    /// the same hash
+    SparsityPattern m_patternA;
+    SparsityPattern m_patternB;
+
 };
 
 template <class TMatrix>
 void SparseMatrixProduct<TMatrix>::computeProduct(bool forceComputeIntersection)
 {
-    if (forceComputeIntersection)
+    updateIntersection(forceComputeIntersection);
+    computeProductFromIntersection();
+}
+
+template <class TMatrix>
+template <class ParallelFor>
+void SparseMatrixProduct<TMatrix>::computeProduct(bool forceComputeIntersection, ParallelFor&& parallelFor)
+{
+    updateIntersection(forceComputeIntersection);
+
+    const std::size_t nbValues = m_intersectionAB.intersection.size();
+    if (nbValues == 0)
     {
-        m_hasComputedIntersection = false;
+        // the product is not computed from an intersection
+        computeProductFromIntersection();
+        return;
     }
 
-    if (m_hasComputedIntersection == false)
+    parallelFor(nbValues, [this](std::size_t firstValue, std::size_t lastValue)
+    {
+        computeProductFromIntersection(firstValue, lastValue);
+    });
+}
+
+template <class TMatrix>
+bool SparseMatrixProduct<TMatrix>::updateIntersection(bool forceComputeIntersection)
+{
+    const std::size_t hashA = computeSparsityPatternHash(*matrixA);
+    const std::size_t hashB = computeSparsityPatternHash(*matrixB);
+
+    if (forceComputeIntersection || !m_hasComputedIntersection
+        || hashA != m_patternHashA || hashB != m_patternHashB
+        || !hasSparsityPattern(*matrixA, m_patternA) || !hasSparsityPattern(*matrixB, m_patternB))
     {
         computeIntersection();
         m_hasComputedIntersection = true;
+        m_patternHashA = hashA;
+        m_patternHashB = hashB;
+        copySparsityPattern(*matrixA, m_patternA);
+        copySparsityPattern(*matrixB, m_patternB);
+        return true;
     }
-    computeProductFromIntersection();
+    return false;
 }
 
 template <class TMatrix>
@@ -115,6 +202,28 @@ void SparseMatrixProduct<TMatrix>::computeProductFromIntersection()
     matrixC = (*matrixA) * (*matrixB);
 }
 
+template <class TMatrix>
+void SparseMatrixProduct<TMatrix>::computeProductFromIntersection(std::size_t /*firstValue*/, std::size_t /*lastValue*/)
+{
+}
+
+template <class TMatrix>
+std::size_t SparseMatrixProduct<TMatrix>::computeSparsityPatternHash(const TMatrix& /*matrix*/)
+{
+    return 0;
+}
+
+template <class TMatrix>
+void SparseMatrixProduct<TMatrix>::copySparsityPattern(const TMatrix& /*matrix*/, SparsityPattern& /*pattern*/)
+{
+}
+
+template <class TMatrix>
+bool SparseMatrixProduct<TMatrix>::hasSparsityPattern(const TMatrix& /*matrix*/, const SparsityPattern& /*pattern*/)
+{
+    return true;
+}
+
 template <class TMatrix>
 void SparseMatrixProduct<TMatrix>::invalidateIntersection()
 {
@@ -25,6 +25,8 @@
 #include <sofa/linearalgebra/SparseMatrixStorageOrder[EigenSparseMatrix].h>
 
 #include <sofa/helper/logging/Messaging.h>
+#include <sofa/helper/hash.h>
+#include <algorithm>
 
 namespace sofa::linearalgebra
 {
@@ -190,25 +192,105 @@ void SparseMatrixProduct<Eigen::SparseMatrix<double, Eigen::RowMajor> >::compute
 }
 
 template<class TMatrix>
-void __computeProductFromIntersection(const TMatrix* A, const TMatrix* B, TMatrix* C, const typename SparseMatrixProduct<TMatrix>::Intersection& intersection)
+void __computeProductFromIntersection(const TMatrix* A, const TMatrix* B, TMatrix* C, const typename SparseMatrixProduct<TMatrix>::Intersection& intersection,
+                                      std::size_t firstValue, std::size_t lastValue)
 {
     assert(intersection.intersection.size() == C->nonZeros());
+    assert(lastValue <= intersection.intersection.size());
 
     auto* a_ptr = A->valuePtr();
     auto* b_ptr = B->valuePtr();
     auto* c_ptr = C->valuePtr();
 
-    for (const auto& pairs : intersection.intersection)
+    for (std::size_t i = firstValue; i < lastValue; ++i)
     {
-        auto& value = *c_ptr++;
+        auto& value = c_ptr[i];
         value = 0;
-        for (const auto& p : pairs)
+        for (const auto& p : intersection.intersection[i])
         {
             value += a_ptr[p.first] * b_ptr[p.second];
         }
     }
 }
 
+template<class TMatrix>
+void __computeProductFromIntersection(const TMatrix* A, const TMatrix* B, TMatrix* C, const typename SparseMatrixProduct<TMatrix>::Intersection& intersection)
+{
+    __computeProductFromIntersection(A, B, C, intersection, 0, intersection.intersection.size());
+}
+
+template<class TMatrix>
+std::size_t __computeSparsityPatternHash(const TMatrix& matrix)
+{
+    std::size_t seed = 0;
+    hash_combine(seed, matrix.rows());
+    hash_combine(seed, matrix.cols());
+    hash_combine(seed, matrix.nonZeros());
+
+    const auto* outer = matrix.outerIndexPtr();
+    const auto* innerNonZeros = matrix.innerNonZeroPtr(); // nullptr in compressed mode
+    const auto* inner = matrix.innerIndexPtr();
+    for (Eigen::Index i = 0; i < matrix.outerSize(); ++i)
+    {
+        const auto begin = outer[i];
+        const auto end = innerNonZeros ? begin + innerNonZeros[i] : outer[i + 1];
+        hash_combine(seed, end - begin);
+        for (auto k = begin; k < end; ++k)
+        {
+            hash_combine(seed, inner[k]);
+        }
+    }
+    return seed;
+}
+
+template<class TMatrix>
+void __copySparsityPattern(const TMatrix& matrix, typename SparseMatrixProduct<TMatrix>::SparsityPattern& pattern)
+{
+    pattern.rows = matrix.rows();
+    pattern.cols = matrix.cols();
+    pattern.outerSizes.resize(matrix.outerSize());
+    pattern.innerIndices.clear();
+    pattern.innerIndices.reserve(matrix.nonZeros());
+
+    const auto* outer = matrix.outerIndexPtr();
+    const auto* innerNonZeros = matrix.innerNonZeroPtr(); // nullptr in compressed mode
+    const auto* inner = matrix.innerIndexPtr();
+    for (Eigen::Index i = 0; i < matrix.outerSize(); ++i)
+    {
+        const auto begin = outer[i];
+        const auto end = innerNonZeros ? begin + innerNonZeros[i] : outer[i + 1];
+        pattern.outerSizes[i] = end - begin;
+        pattern.innerIndices.insert(pattern.innerIndices.end(), inner + begin, inner + end);
+    }
+}
+
+template<class TMatrix>
+bool __hasSparsityPattern(const TMatrix& matrix, const typename SparseMatrixProduct<TMatrix>::SparsityPattern& pattern)
+{
+    if (matrix.rows() != pattern.rows || matrix.cols() != pattern.cols
+        || matrix.outerSize() != static_cast<Eigen::Index>(pattern.outerSizes.size())
+        || matrix.nonZeros() != static_cast<Eigen::Index>(pattern.innerIndices.size()))
+    {
+        return false;
+    }
+
+    const auto* outer = matrix.outerIndexPtr();
+    const auto* innerNonZeros = matrix.innerNonZeroPtr(); // nullptr in compressed mode
+    const auto* inner = matrix.innerIndexPtr();
+    auto patternInner = pattern.innerIndices.begin();
+    for (Eigen::Index i = 0; i < matrix.outerSize(); ++i)
+    {
+        const auto begin = outer[i];
+        const auto end = innerNonZeros ? begin + innerNonZeros[i] : outer[i + 1];
+        if (end - begin != pattern.outerSizes[i] || !std::equal(inner + begin, inner + end, patternInner))
+        {
+            return false;
+        }
+        patternInner += end - begin;
+    }
+    return true;
+}
+
 template <>
 void SparseMatrixProduct<Eigen::SparseMatrix<float> >::computeProductFromIntersection()
 {
@@ -253,6 +335,102 @@ void SparseMatrixProduct<Eigen::SparseMatrix<double, Eigen::RowMajor> >::compute
     __computeProductFromIntersection(matrixA, matrixB, &matrixC, m_intersectionAB);
 }
 
+template <>
+void SparseMatrixProduct<Eigen::SparseMatrix<float> >::computeProductFromIntersection(std::size_t firstValue, std::size_t lastValue)
+{
+    __computeProductFromIntersection(matrixA, matrixB, &matrixC, m_intersectionAB, firstValue, lastValue);
+}
+
+template <>
+void SparseMatrixProduct<Eigen::SparseMatrix<double> >::computeProductFromIntersection(std::size_t firstValue, std::size_t lastValue)
+{
+    __computeProductFromIntersection(matrixA, matrixB, &matrixC, m_intersectionAB, firstValue, lastValue);
+}
+
+template <>
+void SparseMatrixProduct<Eigen::SparseMatrix<float, Eigen::RowMajor> >::computeProductFromIntersection(std::size_t firstValue, std::size_t lastValue)
+{
+    __computeProductFromIntersection(matrixA, matrixB, &matrixC, m_intersectionAB, firstValue, lastValue);
+}
+
+template <>
+void SparseMatrixProduct<Eigen::SparseMatrix<double, Eigen::RowMajor> >::computeProductFromIntersection(std::size_t firstValue, std::size_t lastValue)
+{
+    __computeProductFromIntersection(matrixA, matrixB, &matrixC, m_intersectionAB, firstValue, lastValue);
+}
+
+template <>
+std::size_t SparseMatrixProduct<Eigen::SparseMatrix<float> >::computeSparsityPatternHash(const Eigen::SparseMatrix<float>& matrix)
+{
+    return __computeSparsityPatternHash(matrix);
+}
+
+template <>
+std::size_t SparseMatrixProduct<Eigen::SparseMatrix<double> >::computeSparsityPatternHash(const Eigen::SparseMatrix<double>& matrix)
+{
+    return __computeSparsityPatternHash(matrix);
+}
+
+template <>
+std::size_t SparseMatrixProduct<Eigen::SparseMatrix<float, Eigen::RowMajor> >::computeSparsityPatternHash(const Eigen::SparseMatrix<float, Eigen::RowMajor>& matrix)
+{
+    return __computeSparsityPatternHash(matrix);
+}
+
+template <>
+std::size_t SparseMatrixProduct<Eigen::SparseMatrix<double, Eigen::RowMajor> >::computeSparsityPatternHash(const Eigen::SparseMatrix<double, Eigen::RowMajor>& matrix)
+{
+    return __computeSparsityPatternHash(matrix);
+}
+
+template <>
+void SparseMatrixProduct<Eigen::SparseMatrix<float> >::copySparsityPattern(const Eigen::SparseMatrix<float>& matrix, SparsityPattern& pattern)
+{
+    __copySparsityPattern(matrix, pattern);
+}
+
+template <>
+void SparseMatrixProduct<Eigen::SparseMatrix<double> >::copySparsityPattern(const Eigen::SparseMatrix<double>& matrix, SparsityPattern& pattern)
+{
+    __copySparsityPattern(matrix, pattern);
+}
+
+template <>
+void SparseMatrixProduct<Eigen::SparseMatrix<float, Eigen::RowMajor> >::copySparsityPattern(const Eigen::SparseMatrix<float, Eigen::RowMajor>& matrix, SparsityPattern& pattern)
+{
+    __copySparsityPattern(matrix, pattern);
+}
+
+template <>
+void SparseMatrixProduct<Eigen::SparseMatrix<double, Eigen::RowMajor> >::copySparsityPattern(const Eigen::SparseMatrix<double, Eigen::RowMajor>& matrix, SparsityPattern& pattern)
+{
+    __copySparsityPattern(matrix, pattern);
+}
+
+template <>
+bool SparseMatrixProduct<Eigen::SparseMatrix<float> >::hasSparsityPattern(const Eigen::SparseMatrix<float>& matrix, const SparsityPattern& pattern)
+{
+    return __hasSparsityPattern(matrix, pattern);
+}
+
+template <>
+bool SparseMatrixProduct<Eigen::SparseMatrix<double> >::hasSparsityPattern(const Eigen::SparseMatrix<double>& matrix, const SparsityPattern& pattern)
+{
+    return __hasSparsityPattern(matrix, pattern);
+}
+
+template <>
+bool SparseMatrixProduct<Eigen::SparseMatrix<float, Eigen::RowMajor> >::hasSparsityPattern(const Eigen::SparseMatrix<float, Eigen::RowMajor>& matrix, const SparsityPattern& pattern)
+{
+    return __hasSparsityPattern(matrix, pattern);
+}
+
+template <>
+bool SparseMatrixProduct<Eigen::SparseMatrix<double, Eigen::RowMajor> >::hasSparsityPattern(const Eigen::SparseMatrix<double, Eigen::RowMajor>& matrix, const SparsityPattern& pattern)
+{
+    return __hasSparsityPattern(matrix, pattern);
+}
+
 template class SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<float> >;
 template class SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<double> >;
 
@@ -32,6 +32,26 @@ template<> void SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<d
 template<> void SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<float, Eigen::RowMajor> >::computeRegularProduct();
 template<> void SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<double, Eigen::RowMajor> >::computeRegularProduct();
 
+template<> void SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<float> >::computeProductFromIntersection(std::size_t firstValue, std::size_t lastValue);
+template<> void SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<double> >::computeProductFromIntersection(std::size_t firstValue, std::size_t lastValue);
+template<> void SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<float, Eigen::RowMajor> >::computeProductFromIntersection(std::size_t firstValue, std::size_t lastValue);
+template<> void SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<double, Eigen::RowMajor> >::computeProductFromIntersection(std::size_t firstValue, std::size_t lastValue);
+
+template<> std::size_t SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<float> >::computeSparsityPatternHash(const Eigen::SparseMatrix<float>& matrix);
+template<> std::size_t SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<double> >::computeSparsityPatternHash(const Eigen::SparseMatrix<double>& matrix);
+template<> std::size_t SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<float, Eigen::RowMajor> >::computeSparsityPatternHash(const Eigen::SparseMatrix<float, Eigen::RowMajor>& matrix);
+template<> std::size_t SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<double, Eigen::RowMajor> >::computeSparsityPatternHash(const Eigen::SparseMatrix<double, Eigen::RowMajor>& matrix);
+
+template<> void SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<float> >::copySparsityPattern(const Eigen::SparseMatrix<float>& matrix, SparsityPattern& pattern);
+template<> void SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<double> >::copySparsityPattern(const Eigen::SparseMatrix<double>& matrix, SparsityPattern& pattern);
+template<> void SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<float, Eigen::RowMajor> >::copySparsityPattern(const Eigen::SparseMatrix<float, Eigen::RowMajor>& matrix, SparsityPattern& pattern);
+template<> void SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<double, Eigen::RowMajor> >::copySparsityPattern(const Eigen::SparseMatrix<double, Eigen::RowMajor>& matrix, SparsityPattern& pattern);
+
+template<> bool SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<float> >::hasSparsityPattern(const Eigen::SparseMatrix<float>& matrix, const SparsityPattern& pattern);
+template<> bool SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<double> >::hasSparsityPattern(const Eigen::SparseMatrix<double>& matrix, const SparsityPattern& pattern);
+template<> bool SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<float, Eigen::RowMajor> >::hasSparsityPattern(const Eigen::SparseMatrix<float, Eigen::RowMajor>& matrix, const SparsityPattern& pattern);
+template<> bool SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<double, Eigen::RowMajor> >::hasSparsityPattern(const Eigen::SparseMatrix<double, Eigen::RowMajor>& matrix, const SparsityPattern& pattern);
+
 #if !defined(SOFA_LINEARAGEBRA_SPARSEMATRIXPRODUCT_EIGENSPARSEMATRIX_CPP)
     extern template class SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<float> >;
     extern template class SOFA_LINEARALGEBRA_API SparseMatrixProduct<Eigen::SparseMatrix<double> >;
@@ -0,0 +1,175 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/linearalgebra/BlockKernels.h>
+#include <sofa/linearalgebra/CompressedRowSparseMatrix.h>
+#include <sofa/helper/RandomGenerator.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+
+/// Fill a matrix of 3x3 blocks and a matrix of scalars with the same random values
+template<class Real>
+void generateMatrices(sofa::linearalgebra::CompressedRowSparseMatrix<sofa::type::Mat<3,3,Real> >& blockMatrix,
+                      sofa::linearalgebra::CompressedRowSparseMatrix<Real>& scalarMatrix,
+                      sofa::Index nbBlockRows, sofa::Index nbBlockCols, sofa::Index nbBlocks)
+{
+    sofa::helper::RandomGenerator randomGenerator;
+    randomGenerator.initSeed(123);
+
+    blockMatrix.resize(3 * nbBlockRows, 3 * nbBlockCols);
+    scalarMatrix.resize(3 * nbBlockRows, 3 * nbBlockCols);
+    for (sofa::Index k = 0; k < nbBlocks; ++k)
+    {
+        const auto i = randomGenerator.random<sofa::Index>(0, nbBlockRows);
+        const auto j = randomGenerator.random<sofa::Index>(0, nbBlockCols);
+        for (sofa::Index n = 0; n < 9; ++n)
+        {
+            const auto value = randomGenerator.random<Real>(-1, 1);
+            blockMatrix.add(3 * i + n / 3, 3 * j + n % 3, value);
+            scalarMatrix.add(3 * i + n / 3, 3 * j + n % 3, value);
+        }
+    }
+    blockMatrix.compress();
+    scalarMatrix.compress();
+}
+
+template<class Real>
+sofa::linearalgebra::FullVector<Real> generateVector(sofa::Index size)
+{
+    sofa::helper::RandomGenerator randomGenerator;
+    randomGenerator.initSeed(456);
+
+    sofa::linearalgebra::FullVector<Real> v(size);
+    for (sofa::Index i = 0; i < size; ++i)
+    {
+        v[i] = randomGenerator.random<Real>(-1, 1);
+    }
+    return v;
+}
+
+template<class Real>
+void expectNear(const sofa::linearalgebra::FullVector<Real>& a, const sofa::linearalgebra::FullVector<Real>& b)
+{
+    const Real tolerance = std::is_same_v<Real, float> ? 1e-4 : 1e-12;
+    ASSERT_EQ(a.size(), b.size());
+    for (sofa::Index i = 0; i < sofa::Index(a.size()); ++i)
+    {
+        ASSERT_NEAR(a[i], b[i], tolerance) << "entry " << i;
+    }
+}
+
+template<class Real>
+class BlockKernels : public ::testing::Test {};
+
+using RealTypes = ::testing::Types<double, float>;
+TYPED_TEST_SUITE(BlockKernels, RealTypes);
+
+/// The products of a matrix of 3x3 blocks, computed with the kernels, are compared to the products
+/// of a matrix of scalars with the same values, that do not use the kernels
+TYPED_TEST(BlockKernels, productsMatchScalarMatrix)
+{
+    using Real = TypeParam;
+    using Vector = sofa::linearalgebra::FullVector<Real>;
+    using BlockMatrix = sofa::linearalgebra::CompressedRowSparseMatrix<sofa::type::Mat<3,3,Real> >;
+
+    BlockMatrix blockMatrix;
+    sofa::linearalgebra::CompressedRowSparseMatrix<Real> scalarMatrix;
+    generateMatrices(blockMatrix, scalarMatrix, 200, 150, 2000);
+
+    const Vector x = generateVector<Real>(blockMatrix.colSize());
+    const Vector y = generateVector<Real>(blockMatrix.rowSize());
+
+    Vector reference, referenceAddMul(blockMatrix.rowSize()), referenceTranspose(blockMatrix.colSize());
+    scalarMatrix.mul(reference, x);
+    scalarMatrix.addMul(referenceAddMul, x);
+    scalarMatrix.addMultTranspose(referenceTranspose, y);
+
+    typename BlockMatrix::TransposedPattern transposedPattern;
+    blockMatrix.buildTransposedPattern(transposedPattern);
+
+    Vector res;
+    blockMatrix.mul(res, x);
+    {
+        SCOPED_TRACE("res");
+        expectNear(res, reference);
+    }
+
+    Vector resAddMul(blockMatrix.rowSize());
+    blockMatrix.addMul(resAddMul, x);
+    {
+        SCOPED_TRACE("resAddMul");
+        expectNear(resAddMul, referenceAddMul);
+    }
+
+    Vector resTranspose(blockMatrix.colSize());
+    blockMatrix.addMultTranspose(resTranspose, y);
+    {
+        SCOPED_TRACE("resTranspose");
+        expectNear(resTranspose, referenceTranspose);
+    }
+
+    Vector resTransposeColumns;
+    blockMatrix.resizeMulTransposeResult(resTransposeColumns);
+    blockMatrix.template taddMulTransposeColumns<Real>(resTransposeColumns, y, transposedPattern, 0, blockMatrix.colBSize());
+    {
+        SCOPED_TRACE("resTransposeColumns");
+        expectNear(resTransposeColumns, referenceTranspose);
+    }
+}
+
+/// A row of a block must not read the values of the next row, nor the next entries of the vectors
+TYPED_TEST(BlockKernels, noReadOutsideOfRows)
+{
+    using Real = TypeParam;
+    using Vector = sofa::linearalgebra::FullVector<Real>;
+    constexpr Real inf = std::numeric_limits<Real>::infinity();
+
+    sofa::linearalgebra::CompressedRowSparseMatrix<sofa::type::Mat<3,3,Real> > matrix(6, 6);
+    sofa::type::Mat<3,3,Real> block;
+    block.identity();
+    block[1][0] = inf;
+    *matrix.wbloc(0, 0, true) = block;
+    matrix.compress();
+
+    Vector x(6);
+    x[0] = x[1] = x[2] = 1;
+    x[3] = x[4] = x[5] = inf;
+
+    Vector res;
+    matrix.mul(res, x);
+    EXPECT_EQ(res[0], 1);
+    EXPECT_TRUE(std::isinf(res[1]));
+    EXPECT_EQ(res[2], 1);
+
+    Vector resTranspose(6);
+    matrix.addMultTranspose(resTranspose, x);
+    EXPECT_TRUE(std::isinf(resTranspose[0]));
+    EXPECT_EQ(resTranspose[1], 1);
+    EXPECT_EQ(resTranspose[2], 1);
+    EXPECT_EQ(resTranspose[3], 0);
+}
+
+}
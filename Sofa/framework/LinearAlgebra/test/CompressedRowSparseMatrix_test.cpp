@@ -218,3 +218,214 @@ TEST(CompressedRowSparseMatrix, fullRowsWithEntries)
     EXPECT_NO_THROW(A.fullRows());
     EXPECT_EQ(A.getRowIndex().size(), 1321);
 }
+
+namespace
+{
+using Mat3x3CRS = sofa::linearalgebra::CompressedRowSparseMatrix<sofa::type::Mat<3, 3, SReal> >;
+
+/// Assembly of a 1D chain of nbNodes nodes, as a force field would do it: the diagonal blocks, then
+/// the coupling blocks between consecutive nodes. If isClosed is true, the last node is coupled to
+/// the first one.
+void assembleChain(Mat3x3CRS& matrix, sofa::Index nbNodes, SReal factor, bool isClosed = false)
+{
+    matrix.resize(3 * nbNodes, 3 * nbNodes);
+    matrix.clear();
+    const sofa::Index nbSprings = isClosed ? nbNodes : nbNodes - 1;
+    for (sofa::Index s = 0; s < nbSprings; ++s)
+    {
+        const sofa::Index i = s;
+        const sofa::Index j = (s + 1) % nbNodes;
+        const auto k = static_cast<SReal>(s + 1) * factor;
+        const sofa::type::Mat<3, 3, SReal> block = sofa::type::Mat<3, 3, SReal>::Identity() * k;
+        matrix.add(3 * i, 3 * i, block);
+        matrix.add(3 * j, 3 * j, block);
+        matrix.add(3 * i, 3 * j, -block);
+        matrix.add(3 * j, 3 * i, -block);
+    }
+    matrix.compress();
+}
+
+void expectSameMatrices(const Mat3x3CRS& a, const Mat3x3CRS& b)
+{
+    ASSERT_EQ(a.rowSize(), b.rowSize());
+    ASSERT_EQ(a.colSize(), b.colSize());
+    for (sofa::Index i = 0; i < a.rowSize(); ++i)
+    {
+        for (sofa::Index j = 0; j < a.colSize(); ++j)
+        {
+            EXPECT_EQ(a.element(i, j), b.element(i, j)) << "(" << i << ", " << j << ")";
+        }
+    }
+}
+}
+
+TEST(CompressedRowSparseMatrix, patternReuse)
+{
+    Mat3x3CRS reference, A;
+    A.setPatternReuse(true);
+
+    for (unsigned int step = 0; step < 4; ++step)
+    {
+        const SReal factor = 1 + step;
+        assembleChain(reference, 10, factor);
+        assembleChain(A, 10, factor);
+
+        expectSameMatrices(reference, A);
+        EXPECT_EQ(A.getColsValue().size(), reference.getColsValue().size());
+    }
+
+    // the first assembly builds the pattern, the second one records the slots
+    EXPECT_TRUE(A.isPatternFrozen());
+
+    A.setPatternReuse(false);
+    EXPECT_FALSE(A.isPatternFrozen());
+    assembleChain(reference, 10, 7);
+    assembleChain(A, 10, 7);
+    expectSameMatrices(reference, A);
+}
+
+TEST(CompressedRowSparseMatrix, patternReuseWithNewBlocks)
+{
+    Mat3x3CRS reference, A;
+    A.setPatternReuse(true);
+
+    for (unsigned int step = 0; step < 3; ++step)
+    {
+        assembleChain(A, 10, 1);
+    }
+    ASSERT_TRUE(A.isPatternFrozen());
+
+    // the closed chain inserts blocks outside of the frozen pattern
+    assembleChain(reference, 10, 2, true);
+    assembleChain(A, 10, 2, true);
+    expectSameMatrices(reference, A);
+
+    // the pattern is rebuilt, then frozen again
+    for (unsigned int step = 0; step < 3; ++step)
+    {
+        assembleChain(reference, 10, 3 + step, true);
+        assembleChain(A, 10, 3 + step, true);
+        expectSameMatrices(reference, A);
+    }
+    EXPECT_TRUE(A.isPatternFrozen());
+    EXPECT_EQ(A.getColsValue().size(), reference.getColsValue().size());
+}
+
+TEST(CompressedRowSparseMatrix, patternReuseWithRemovedBlocks)
+{
+    Mat3x3CRS reference, A;
+    A.setPatternReuse(true);
+
+    for (unsigned int step = 0; step < 3; ++step)
+    {
+        assembleChain(A, 10, 1, true);
+    }
+    ASSERT_TRUE(A.isPatternFrozen());
+
+    // fewer insertions than in the frozen pattern: the values are still correct
+    assembleChain(reference, 10, 2);
+    assembleChain(A, 10, 2);
+    expectSameMatrices(reference, A);
+
+    // the unused blocks are removed when the pattern is rebuilt
+    for (unsigned int step = 0; step < 3; ++step)
+    {
+        assembleChain(reference, 10, 3 + step);
+        assembleChain(A, 10, 3 + step);
+        expectSameMatrices(reference, A);
+    }
+    EXPECT_TRUE(A.isPatternFrozen());
+    EXPECT_EQ(A.getColsValue().size(), reference.getColsValue().size());
+}
+
+TEST(CompressedRowSparseMatrix, patternReuseWithResize)
+{
+    Mat3x3CRS reference, A;
+    A.setPatternReuse(true);
+
+    for (unsigned int step = 0; step < 3; ++step)
+    {
+        assembleChain(A, 10, 1);
+    }
+    ASSERT_TRUE(A.isPatternFrozen());
+
+    assembleChain(reference, 12, 2);
+    assembleChain(A, 12, 2);
+    EXPECT_FALSE(A.isPatternFrozen());
+    expectSameMatrices(reference, A);
+}
+
+template<class FloatBlock, class DoubleBlock>
+void checkMixedPrecisionProducts()
+{
+    sofa::linearalgebra::CompressedRowSparseMatrix<FloatBlock> A;
+    generateMatrix(A, 48, 36, 0.1f, 12);
+
+    // same values, stored in double precision
+    sofa::linearalgebra::CompressedRowSparseMatrix<DoubleBlock> B;
+    B.resize(A.rowSize(), A.colSize());
+    for (sofa::Index i = 0; i < A.rowSize(); ++i)
+    {
+        for (sofa::Index j = 0; j < A.colSize(); ++j)
+        {
+            if (const auto value = A.element(i, j); value != 0)
+            {
+                B.add(i, j, static_cast<double>(value));
+            }
+        }
+    }
+    B.compress();
+
+    sofa::linearalgebra::FullVector<double> x(A.colSize()), y(A.rowSize());
+    for (sofa::Index i = 0; i < x.size(); ++i)
+    {
+        x[i] = 1. / (3. + i);
+    }
+    for (sofa::Index i = 0; i < y.size(); ++i)
+    {
+        y[i] = 1. / (7. + i);
+    }
+
+    // the products with double precision vectors are accumulated in double precision
+    sofa::linearalgebra::FullVector<double> resA, resB;
+    A.mul(resA, x);
+    B.mul(resB, x);
+    ASSERT_EQ(resA.size(), resB.size());
+    for (sofa::Index i = 0; i < resA.size(); ++i)
+    {
+        EXPECT_NEAR(resA[i], resB[i], 1e-13) << i;
+    }
+
+    A.addMultTranspose(resA, y);
+    B.addMultTranspose(resB, y);
+    ASSERT_EQ(resA.size(), resB.size());
+    for (sofa::Index i = 0; i < resA.size(); ++i)
+    {
+        EXPECT_NEAR(resA[i], resB[i], 1e-13) << i;
+    }
+}
+
+TEST(CompressedRowSparseMatrix, mixedPrecisionProducts)
+{
+    checkMixedPrecisionProducts<float, double>();
+    checkMixedPrecisionProducts<sofa::type::Mat<3, 3, float>, sofa::type::Mat<3, 3, double> >();
+}
+
+TEST(CompressedRowSparseMatrix, memoryFootprint)
+{
+    Mat3x3CRS A;
+    EXPECT_EQ(A.getMemoryFootprint(), 0u);
+
+    assembleChain(A, 10, 1);
+    const std::size_t compressedStorage =
+        (A.getRowIndex().size() + A.getRowBegin().size() + A.getColsIndex().size()) * sizeof(sofa::Index)
+        + A.getColsValue().size() * sizeof(Mat3x3CRS::Block);
+    EXPECT_GE(A.getMemoryFootprint(), compressedStorage);
+
+    sofa::linearalgebra::FullVector<SReal> v(30);
+    EXPECT_EQ(v.getMemoryFootprint(), 30 * sizeof(SReal));
+
+    SReal buffer[30];
+    const sofa::linearalgebra::FullVector<SReal> external(buffer, 30);
+    EXPECT_EQ(external.getMemoryFootprint(), 0u);
+}
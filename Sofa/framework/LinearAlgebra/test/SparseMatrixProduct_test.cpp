@@ -96,6 +96,29 @@ struct TestSparseMatrixProduct : public sofa::testing::SparseMatrixTest<typename
         product.computeProduct(); //intersection is already computed: uses the faster algorithm
         EXPECT_TRUE(compareSparseMatrix(eigen_c, product.getProductResult()));
 
+        // the values computed from the intersection are split into independent ranges
+        std::size_t nbComputedValues = 0;
+        product.computeProduct(false, [&nbComputedValues](std::size_t nbValues, const auto& computeRange)
+        {
+            for (std::size_t first = 0; first < nbValues; first += 7)
+            {
+                const std::size_t last = std::min(nbValues, first + 7);
+                computeRange(first, last);
+                nbComputedValues += last - first;
+            }
+        });
+        EXPECT_EQ(nbComputedValues, static_cast<std::size_t>(eigen_c.nonZeros()));
+        EXPECT_TRUE(compareSparseMatrix(eigen_c, product.getProductResult()));
+
+        //modify the pattern of A: the intersection is recomputed without being invalidated explicitly
+        generateRandomSparseMatrix(eigen_a, nbRowsA, nbColsA, sparsity);
+        eigen_c = eigen_a * eigen_b;
+        copyFromEigen(A, eigen_a);
+
+        product.matrixA = &A;
+        product.computeProduct();
+        EXPECT_TRUE(compareSparseMatrix(eigen_c, product.getProductResult()));
+
         return true;
     }
 };
@@ -134,4 +157,43 @@ TYPED_TEST(TestSparseMatrixProduct, rectangularMatrix )
     ASSERT_TRUE( this->checkMatrix( 1000, 3000, 2000, 20. / 1000. ) );
 
     ASSERT_TRUE( this->checkMatrix( 20, 30, 10, 1. ) );
-}
\ No newline at end of file
+}
+/// Gives access to the comparison of the sparsity patterns
+struct SparsityPatternComparison : sofa::linearalgebra::SparseMatrixProduct<Eigen::SparseMatrix<double> >
+{
+    using SparseMatrixProduct::copySparsityPattern;
+    using SparseMatrixProduct::hasSparsityPattern;
+};
+
+TEST(SparseMatrixProduct, exactSparsityPatternComparison)
+{
+    Eigen::SparseMatrix<double> a(3, 3);
+    a.insert(0, 0) = 1.;
+    a.insert(1, 2) = 2.;
+    a.insert(2, 1) = 3.;
+    a.makeCompressed();
+
+    SparsityPatternComparison::SparsityPattern pattern;
+    SparsityPatternComparison::copySparsityPattern(a, pattern);
+    EXPECT_TRUE(SparsityPatternComparison::hasSparsityPattern(a, pattern));
+
+    // same number of non-zeros per column, but not at the same rows
+    Eigen::SparseMatrix<double> b(3, 3);
+    b.insert(0, 0) = 1.;
+    b.insert(1, 1) = 3.;
+    b.insert(2, 2) = 2.;
+    b.makeCompressed();
+    EXPECT_FALSE(SparsityPatternComparison::hasSparsityPattern(b, pattern));
+
+    // same pattern, with other values and in uncompressed mode
+    Eigen::SparseMatrix<double> c(3, 3);
+    c.reserve(Eigen::VectorXi::Constant(3, 2));
+    c.insert(2, 1) = 4.;
+    c.insert(0, 0) = 5.;
+    c.insert(1, 2) = 6.;
+    EXPECT_FALSE(c.isCompressed());
+    EXPECT_TRUE(SparsityPatternComparison::hasSparsityPattern(c, pattern));
+
+    Eigen::SparseMatrix<double> d(3, 4);
+    EXPECT_FALSE(SparsityPatternComparison::hasSparsityPattern(d, pattern));
+}
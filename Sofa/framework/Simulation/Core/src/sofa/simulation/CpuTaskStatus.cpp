@@ -28,7 +28,8 @@ CpuTaskStatus::CpuTaskStatus(): m_busy(0)
 
 bool CpuTaskStatus::isBusy() const
 {
-    return (m_busy.load(std::memory_order_relaxed) > 0);
+    // acquire: the results of the finished tasks are visible to the thread which waited for them
+    return (m_busy.load(std::memory_order_acquire) > 0);
 }
 
 int CpuTaskStatus::setBusy(bool busy)
@@ -39,7 +40,7 @@ int CpuTaskStatus::setBusy(bool busy)
     }
     else
     {
-        return m_busy.fetch_sub(1, std::memory_order_relaxed);
+        return m_busy.fetch_sub(1, std::memory_order_release);
     }
 }
 }
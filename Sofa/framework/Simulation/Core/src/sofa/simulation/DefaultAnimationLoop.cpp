@@ -33,6 +33,9 @@
 #include <sofa/simulation/AnimateEndEvent.h>
 #include <sofa/simulation/UpdateMappingEndEvent.h>
 #include <sofa/simulation/UpdateBoundingBoxVisitor.h>
+#include <sofa/simulation/VisualVisitor.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/TaskScheduler.h>
 
 #include <sofa/helper/ScopedAdvancedTimer.h>
 #include <sofa/helper/AdvancedTimer.h>
@@ -52,10 +55,20 @@ This loop do the following steps:
 - build and solve all linear systems in the scene : collision and time integration to compute the new values of the dofs
 - update the context (dt++)
 - update the mappings
-- update the bounding box (volume covering all objects of the scene))");
+- update the bounding box (volume covering all objects of the scene)
+In pipelined mode, the time step is computed by the task scheduler while the visual models are
+updated with the state of the previous time step. The rendering, the bounding box, the events and the
+picking wait for the end of the time step.)");
 
 DefaultAnimationLoop::DefaultAnimationLoop(simulation::Node* _gnode)
     : Inherit()
+    , d_pipelined(initData(&d_pipelined, false, "pipelined", "If true, the next time step is computed asynchronously while the visual models are updated with the state of the previous one. "
+                                                             "The rendering, the bounding box, the events and the picking wait for the end of the time step. "
+                                                             "The visual models are one time step late. "
+                                                             "Requires a task scheduler with at least two threads. "
+                                                             "Topological changes of the visual models are not supported."))
+    , d_parallelComputeBoundingBox(initData(&d_parallelComputeBoundingBox, false, "parallelComputeBoundingBox", "If true, the bounding boxes of the objects of a node are computed in parallel, using the main task scheduler. "
+                                                                                                               "The computeBBox method of all the objects of the scene must then be thread-safe."))
     , gnode(_gnode)
 {
     //assert(gnode);
@@ -63,7 +76,7 @@ DefaultAnimationLoop::DefaultAnimationLoop(simulation::Node* _gnode)
 
 DefaultAnimationLoop::~DefaultAnimationLoop()
 {
-
+    waitForPendingStep();
 }
 
 void DefaultAnimationLoop::init()
@@ -77,11 +90,102 @@ void DefaultAnimationLoop::setNode( simulation::Node* n )
     gnode=n;
 }
 
+void DefaultAnimationLoop::reset()
+{
+    waitForPendingStep();
+}
+
+void DefaultAnimationLoop::cleanup()
+{
+    stopPipeline(core::execparams::defaultInstance());
+}
+
+void DefaultAnimationLoop::waitForPendingStep()
+{
+    if (m_taskScheduler && m_pendingStep.isBusy()
+        && !m_isWaitingForPendingStep && std::this_thread::get_id() == m_stepCallerThread)
+    {
+        m_isWaitingForPendingStep = true;
+        m_taskScheduler->workUntilDone(&m_pendingStep);
+        m_isWaitingForPendingStep = false;
+    }
+}
+
+void DefaultAnimationLoop::waitForPendingStep(simulation::Node* node)
+{
+    auto* root = node ? dynamic_cast<simulation::Node*>(node->getRoot()) : nullptr;
+    if (!root)
+    {
+        return;
+    }
+    if (auto* loop = dynamic_cast<DefaultAnimationLoop*>(root->getAnimationLoop()))
+    {
+        loop->waitForPendingStep();
+    }
+}
+
+void DefaultAnimationLoop::stopPipeline(const core::ExecParams* params)
+{
+    waitForPendingStep();
+
+    if (m_isPipelineStarted)
+    {
+        VisualSwapStateVisitor swapState(params);
+        gnode->execute(swapState);
+
+        VisualSetDoubleBufferedVisitor doubleBuffered(params, false);
+        gnode->execute(doubleBuffered);
+
+        m_isPipelineStarted = false;
+    }
+}
+
 void DefaultAnimationLoop::step(const core::ExecParams* params, SReal dt)
 {
     if (dt == 0)
         dt = this->gnode->getDt();
 
+    if (d_pipelined.getValue() && !m_taskScheduler)
+    {
+        m_taskScheduler = MainTaskSchedulerFactory::createInRegistry();
+        if (m_taskScheduler->getThreadCount() == 0)
+        {
+            m_taskScheduler->init();
+        }
+        msg_warning_when(m_taskScheduler->getThreadCount() < 2) << "The pipelined mode requires a task scheduler with at least two threads: the time steps are computed sequentially.";
+    }
+
+    if (!d_pipelined.getValue() || m_taskScheduler->getThreadCount() < 2)
+    {
+        stopPipeline(params);
+        computeStep(params, dt);
+        return;
+    }
+
+    if (!m_isPipelineStarted)
+    {
+        VisualSetDoubleBufferedVisitor doubleBuffered(params, true);
+        gnode->execute(doubleBuffered);
+        m_isPipelineStarted = true;
+    }
+
+    // publish the state computed during the previous call: the visual models are updated with it
+    // while the next time step is computed
+    m_stepCallerThread = std::this_thread::get_id();
+    waitForPendingStep();
+    {
+        VisualSwapStateVisitor swapState(params);
+        gnode->execute(swapState);
+    }
+
+    m_taskScheduler->addTask(m_pendingStep, [this, params, dt]()
+    {
+        computeStep(params, dt);
+    });
+}
+
+void DefaultAnimationLoop::computeStep(const core::ExecParams* params, SReal dt)
+{
 
 #ifdef SOFA_DUMP_VISITOR_INFO
     simulation::Visitor::printNode("Step");
@@ -138,7 +242,9 @@ void DefaultAnimationLoop::step(const core::ExecParams* params, SReal dt)
     if (d_computeBoundingBox.getValue())
     {
         sofa::helper::ScopedAdvancedTimer timer("UpdateBBox");
-        gnode->execute< UpdateBoundingBoxVisitor >(params);
+        UpdateBoundingBoxVisitor updateBBox(params, d_parallelComputeBoundingBox.getValue() ?
+            ForEachExecutionPolicy::PARALLEL : ForEachExecutionPolicy::SEQUENTIAL);
+        gnode->execute(updateBBox);
     }
 
 #ifdef SOFA_DUMP_VISITOR_INFO
@@ -26,6 +26,9 @@
 #include <sofa/core/behavior/BaseAnimationLoop.h>
 
 #include <sofa/simulation/fwd.h>
+#include <sofa/simulation/CpuTaskStatus.h>
+
+#include <thread>
 
 namespace sofa {
 namespace core {
@@ -40,6 +43,8 @@ namespace sofa
 namespace simulation
 {
 
+class TaskScheduler;
+
 /**
  *  \brief Default Animation Loop to be created when no AnimationLoop found on simulation::node.
  *
@@ -67,6 +72,21 @@ public:
     /// perform one animation step
     void step(const sofa::core::ExecParams* params, SReal dt) override;
 
+    /// Wait for the end of the time step computed asynchronously, if any (pipelined mode only).
+    /// It does nothing if called from the time step itself, i.e. from another thread than the one calling step.
+    void waitForPendingStep();
+
+    /// Wait for the pending time step of the animation loop of the root of node, if it is a DefaultAnimationLoop.
+    /// Only the visual models are double buffered: the other consumers of the simulation state (drawing, bounding
+    /// box, events, picking) must call it before reading the state.
+    static void waitForPendingStep(simulation::Node* node);
+
+    void reset() override;
+    void cleanup() override;
+
+    Data<bool> d_pipelined; ///< If true, compute the next time step while the visual models are updated with the previous one
+    Data<bool> d_parallelComputeBoundingBox; ///< If true, compute the bounding boxes of the objects of a node in parallel
+
 
     /// Construction method called by ObjectFactory.
     template<class T>
@@ -83,6 +103,27 @@ protected :
 
     simulation::Node* gnode;  ///< the node controlled by the loop
 
+    /// Compute one time step, in the calling thread
+    void computeStep(const sofa::core::ExecParams* params, SReal dt);
+
+    /// Wait for the pending time step, publish its state to the visual models and disable their double buffering
+    void stopPipeline(const sofa::core::ExecParams* params);
+
+    /// Task scheduler running the time steps in pipelined mode
+    simulation::TaskScheduler* m_taskScheduler { nullptr };
+
+    /// Status of the time step computed asynchronously
+    CpuTaskStatus m_pendingStep;
+
+    /// True if the visual models are double buffered
+    bool m_isPipelineStarted { false };
+
+    /// Thread calling step, the only one waiting for the pending time step
+    std::thread::id m_stepCallerThread;
+
+    /// True while waiting for the pending time step: the tasks run meanwhile by the waiting thread do not wait again
+    bool m_isWaitingForPendingStep { false };
+
 };
 
 } // namespace simulation
@@ -63,6 +63,7 @@ DefaultTaskScheduler::DefaultTaskScheduler()
     // init global static thread local var
     {
         _threads[std::this_thread::get_id()] = new WorkerThread(this, 0, "Main  ");// new WorkerThread(this, 0, "Main  ");
+        m_threadsByIndex.push_back(_threads[std::this_thread::get_id()]);
     }
 }
         
@@ -83,6 +84,16 @@ WorkerThread* DefaultTaskScheduler::getWorkerThread(const std::thread::id id)
     }
     return thread->second;
 }
+
+WorkerThread* DefaultTaskScheduler::getScheduledWorkerThread(const Task* task) const
+{
+    const int scheduledThread = task->getScheduledThread();
+    if (scheduledThread < 0 || m_threadsByIndex.empty())
+    {
+        return nullptr;
+    }
+    return m_threadsByIndex[static_cast<std::size_t>(scheduledThread) % m_threadsByIndex.size()];
+}
         
 Task::Allocator* DefaultTaskScheduler::getTaskAllocator()
 {
@@ -123,9 +134,10 @@ void DefaultTaskScheduler::start(const unsigned int NbThread )
     /* start worker threads */
     for( unsigned int i=1; i<m_threadCount; ++i)
     {
-        WorkerThread* thread = new WorkerThread(this, int(i));
+        WorkerThread* thread = new WorkerThread(this, int(i), m_workerThreadSettings.namePrefix);
         thread->create_and_attach(this);
         _threads[thread->getId()] = thread;
+        m_threadsByIndex.push_back(thread);
         thread->start(this);
     }
             
@@ -135,6 +147,24 @@ void DefaultTaskScheduler::start(const unsigned int NbThread )
         
         
         
+void DefaultTaskScheduler::setWorkerThreadSettings(const WorkerThreadSettings& settings)
+{
+    // the running workers read the settings: they are stopped before the settings are changed
+    const bool isInitialized = m_isInitialized;
+    const unsigned int threadCount = m_threadCount;
+    if (isInitialized)
+    {
+        stop();
+    }
+
+    m_workerThreadSettings = settings;
+
+    if (isInitialized)
+    {
+        start(threadCount);
+    }
+}
+
 void DefaultTaskScheduler::stop()
 {
     m_isClosing = true;
@@ -174,6 +204,7 @@ void DefaultTaskScheduler::stop()
         WorkerThread* mainThread = mainThreadIt->second;
         _threads.clear();
         _threads[std::this_thread::get_id()] = mainThread;
+        m_threadsByIndex.assign(1, mainThread);
     }
             
     return;
@@ -30,6 +30,7 @@
 #include <condition_variable>
 #include <memory>
 #include <map>
+#include <vector>
 #include <string> 
 #include <mutex>
 
@@ -40,6 +41,34 @@ namespace sofa::simulation
 
 class WorkerThread;
 
+/// Settings of the worker threads of a DefaultTaskScheduler. They do not apply to the main thread.
+struct SOFA_SIMULATION_CORE_API WorkerThreadSettings
+{
+    /// CPUs on which the worker threads are allowed to run. Empty means no restriction.
+    /// The indices greater than or equal to getMaxNbCpus() are ignored.
+    std::vector<unsigned int> cpuAffinity;
+
+    /// If true, the worker i is pinned to the single CPU cpuAffinity[(i-1) % cpuAffinity.size()],
+    /// otherwise each worker can run on any CPU of cpuAffinity
+    bool pinEachThread { false };
+
+    /// Priority of the worker threads relatively to the process, from -2 (lowest) to 2 (highest).
+    /// On Linux, it is applied as a nice value (5 per level), and raising the priority requires privileges.
+    int priority { 0 };
+
+    /// Number of times an idle worker checks for new work (yielding in between) before it goes to sleep.
+    /// Spinning reduces the latency to start the tasks, at the cost of CPU time.
+    unsigned int idleSpinCount { 0 };
+
+    /// Prefix of the names of the worker threads, as shown by the system tools (e.g. perf, htop).
+    /// The names are truncated to 15 characters on Linux.
+    std::string namePrefix { "Worker" };
+
+    /// Number of CPUs that the affinity of a thread can refer to on this platform
+    /// (the size of the affinity mask: 64 on Windows, CPU_SETSIZE on Linux)
+    static unsigned int getMaxNbCpus();
+};
+
 class SOFA_SIMULATION_CORE_API DefaultTaskScheduler : public TaskScheduler
 {
     enum
@@ -70,9 +99,17 @@ public:
 
     // queue task if there is space, and run it otherwise
     bool addTask(Task* task) override final;
+    using TaskScheduler::addTask;
     void workUntilDone(Task::Status* status) override final;
     Task::Allocator* getTaskAllocator() override final;
 
+    /**
+     * Settings applied to the worker threads when they are created.
+     * If the scheduler is already initialized, the worker threads are restarted.
+     */
+    void setWorkerThreadSettings(const WorkerThreadSettings& settings);
+    const WorkerThreadSettings& getWorkerThreadSettings() const { return m_workerThreadSettings; }
+
     // factory methods: name, creator function
     static const char* name() { return "_default"; }
             
@@ -92,10 +129,16 @@ private:
             
     WorkerThread* getWorkerThread(const std::thread::id id);
 
+    /// Thread on which the task has been scheduled (see Task::getScheduledThread), nullptr if any thread can run it
+    WorkerThread* getScheduledWorkerThread(const Task* task) const;
+
             
     static const std::string _name;
 
     std::map< std::thread::id, WorkerThread*> _threads;
+
+    /// The same threads as in _threads, ordered by index (0 is the main thread)
+    std::vector<WorkerThread*> m_threadsByIndex;
             
     const Task::Status*	m_mainTaskStatus;
             
@@ -127,6 +170,8 @@ private:
     bool m_isClosing;
             
     unsigned m_threadCount;
+
+    WorkerThreadSettings m_workerThreadSettings;
             
     friend class WorkerThread;
 };
@@ -0,0 +1,84 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/simulation/MemoryFootprintVisitor.h>
+#include <sofa/simulation/Node.h>
+#include <sofa/helper/AdvancedTimer.h>
+
+namespace sofa::simulation
+{
+
+Visitor::Result MemoryFootprintVisitor::processNodeTopDown(simulation::Node* node)
+{
+    std::size_t footprint = 0;
+    for (const auto& object : node->object)
+    {
+        footprint += object->getMemoryFootprint();
+    }
+    m_ownFootprints[node] = footprint;
+    m_nodeFootprints[node] = footprint;
+    m_totalFootprint += footprint;
+    return RESULT_CONTINUE;
+}
+
+void MemoryFootprintVisitor::processNodeBottomUp(simulation::Node* node)
+{
+    // the children have already been processed: gather the nodes of their sub-graphs, so that a node
+    // shared by several children is counted once
+    auto& subGraphNodes = m_subGraphNodes[node];
+    subGraphNodes.insert(node);
+    for (const auto& child : node->child)
+    {
+        const auto it = m_subGraphNodes.find(child.get());
+        if (it != m_subGraphNodes.end())
+        {
+            subGraphNodes.insert(it->second.begin(), it->second.end());
+        }
+    }
+
+    std::size_t footprint = 0;
+    for (const auto* subGraphNode : subGraphNodes)
+    {
+        const auto it = m_ownFootprints.find(subGraphNode);
+        if (it != m_ownFootprints.end())
+        {
+            footprint += it->second;
+        }
+    }
+    m_nodeFootprints[node] = footprint;
+}
+
+std::size_t MemoryFootprintVisitor::getNodeFootprint(const simulation::Node* node) const
+{
+    const auto it = m_nodeFootprints.find(node);
+    return it != m_nodeFootprints.end() ? it->second : 0;
+}
+
+void MemoryFootprintVisitor::recordInAdvancedTimer() const
+{
+    for (const auto& [node, footprint] : m_nodeFootprints)
+    {
+        const std::string id = "Memory footprint " + node->getPathName();
+        sofa::helper::AdvancedTimer::valSet(id.c_str(), static_cast<double>(footprint));
+    }
+}
+
+} // namespace sofa::simulation
@@ -0,0 +1,69 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/simulation/Visitor.h>
+#include <map>
+#include <set>
+
+namespace sofa::simulation
+{
+
+/**
+ * Collect the number of bytes allocated by the objects of the graph (matrices, vectors, factorizations,
+ * topological data, ...), as reported by BaseObject::getMemoryFootprint, and aggregate them per node.
+ */
+class SOFA_SIMULATION_CORE_API MemoryFootprintVisitor : public Visitor
+{
+public:
+    MemoryFootprintVisitor(const core::ExecParams* params) : Visitor(params) {}
+
+    Result processNodeTopDown(simulation::Node* node) override;
+    void processNodeBottomUp(simulation::Node* node) override;
+
+    const char* getClassName() const override { return "MemoryFootprintVisitor"; }
+
+    /// Number of bytes allocated by the objects of the node and of its descendants.
+    /// A descendant reachable from several children (multi-parent node) is counted once.
+    std::size_t getNodeFootprint(const simulation::Node* node) const;
+
+    /// Number of bytes allocated by all the visited objects
+    std::size_t getTotalFootprint() const { return m_totalFootprint; }
+
+    const std::map<const simulation::Node*, std::size_t>& getNodeFootprints() const { return m_nodeFootprints; }
+
+    /// Record the footprint of each visited node as an AdvancedTimer value, in bytes
+    void recordInAdvancedTimer() const;
+
+protected:
+    std::map<const simulation::Node*, std::size_t> m_nodeFootprints;
+
+    /// Footprint of the objects of each node only
+    std::map<const simulation::Node*, std::size_t> m_ownFootprints;
+
+    /// The node itself and its descendants, to count once the nodes shared by several children
+    std::map<const simulation::Node*, std::set<const simulation::Node*> > m_subGraphNodes;
+
+    std::size_t m_totalFootprint { 0 };
+};
+
+} // namespace sofa::simulation
@@ -51,6 +51,7 @@
 #include <sofa/simulation/Node.inl>
 #include <sofa/simulation/VisitorScheduler.h>
 #include <sofa/simulation/PropagateEventVisitor.h>
+#include <sofa/simulation/DefaultAnimationLoop.h>
 #include <sofa/simulation/UpdateMappingEndEvent.h>
 #include <sofa/simulation/AnimateVisitor.h>
 #include <sofa/simulation/DeactivatedNodeVisitor.h>
@@ -608,6 +609,11 @@ bool Node::doAddObject(BaseObject::SPtr sobj, sofa::core::objectmodel::TypeOfIns
     {
         unsorted.add(obj);
     }
+
+    if (auto* visitorScheduler = dynamic_cast<VisitorScheduler*>(obj))
+    {
+        m_visitorScheduler = visitorScheduler;
+    }
     return true;
 }
 
@@ -622,6 +628,11 @@ bool Node::doRemoveObject(BaseObject::SPtr sobj)
 
     if(obj != nullptr && !obj->removeInNode( this ) )
         unsorted.remove(obj);
+
+    if (obj != nullptr && obj == dynamic_cast<BaseObject*>(m_visitorScheduler))
+    {
+        m_visitorScheduler = nullptr;
+    }
     return true;
 }
 
@@ -902,7 +913,14 @@ void Node::executeVisitor(Visitor* action, bool precomputedOrder)
         ++level;
     }
 
-    doExecuteVisitor(action, precomputedOrder);
+    if (m_visitorScheduler)
+    {
+        m_visitorScheduler->executeVisitor(this, action);
+    }
+    else
+    {
+        doExecuteVisitor(action, precomputedOrder);
+    }
 
     if(DEBUG_VISITOR)
     {
@@ -918,6 +936,8 @@ void Node::executeVisitor(Visitor* action, bool precomputedOrder)
 /// Propagate an event
 void Node::propagateEvent(const core::ExecParams* params, core::objectmodel::Event* event)
 {
+    // the events (e.g. from the GUI) are handled by components reading or writing the simulation state
+    DefaultAnimationLoop::waitForPendingStep(this);
     simulation::PropagateEventVisitor act(params, event);
     this->executeVisitor(&act);
 }
@@ -560,6 +560,9 @@ protected:
 
     type::vector<MutationListener*> listener;
 
+    /// Scheduler executing the visitors started from this node, if one was added to this node
+    VisitorScheduler* m_visitorScheduler { nullptr };
+
 
 public:
     virtual void addListener(MutationListener* obj);
@@ -0,0 +1,185 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/simulation/ParallelForEach.h>
+#include <sofa/simulation/TaskScheduler.h>
+#include <sofa/type/vector.h>
+#include <algorithm>
+
+namespace sofa::simulation
+{
+
+/**
+ * Accumulates in parallel the contributions of a set of elements (triangles, tetrahedra, springs,
+ * ...) into a vector of derivatives, typically in addForce and addDForce.
+ *
+ * Several elements share the same nodes, so they cannot write directly into the output vector from
+ * different threads. Instead, the elements are split into ranges, and each range accumulates its
+ * contributions into its own buffer. The buffers are then summed into the output vector, also in
+ * parallel (each thread sums a chunk of nodes). The buffers are summed in the order of the ranges,
+ * so that the result only depends on the number of ranges.
+ *
+ * Without task scheduler, or with a single thread, the element function is applied directly on the
+ * output vector: the result is the same as a sequential loop over the elements.
+ *
+ * In deterministic mode (see TaskScheduler::isDeterministic), the number of ranges is
+ * DeterministicNbRanges (shared with parallelForEach and parallelReduce) whatever the number of
+ * threads, and the buffers are also used without task scheduler (processed sequentially), so that
+ * the result is bitwise identical in all cases.
+ *
+ * The buffers are kept from a call to the next one to avoid reallocations. An accumulator must not
+ * be used concurrently by several threads.
+ */
+template<class VecDeriv>
+class ParallelElementAccumulator
+{
+public:
+
+    /// Minimal number of elements processed by a task
+    std::size_t elementGrainSize { 64 };
+
+    /// Minimal number of nodes merged by a task
+    std::size_t mergeGrainSize { 1024 };
+
+    /**
+     * Calls f(elementId, out) for every element in [0, nbElements), where out is a vector of the
+     * same size as output, in which f must accumulate the contribution of the element.
+     */
+    template<class ElementFunction>
+    void accumulate(TaskScheduler* taskScheduler, const std::size_t nbElements, VecDeriv& output,
+                    ElementFunction f)
+    {
+        const bool isParallel = taskScheduler != nullptr && taskScheduler->getThreadCount() >= 2;
+        const bool isDeterministic = TaskScheduler::isDeterministic();
+
+        if ((!isParallel && !isDeterministic) || nbElements < 2 * elementGrainSize)
+        {
+            for (std::size_t i = 0; i < nbElements; ++i)
+            {
+                f(i, output);
+            }
+            return;
+        }
+
+        const auto ranges = makeRangesForLoop<std::size_t>(0, nbElements,
+            isDeterministic ? DeterministicNbRanges : taskScheduler->getThreadCount(), elementGrainSize);
+
+        const std::size_t nbNodes = output.size();
+        if (m_buffers.size() < ranges.size())
+        {
+            m_buffers.resize(ranges.size());
+        }
+
+        const auto accumulateRange = [this, nbNodes, &ranges, &f](const std::size_t r)
+        {
+            VecDeriv& buffer = m_buffers[r];
+            buffer.resize(nbNodes);
+            std::fill(buffer.begin(), buffer.end(), typename VecDeriv::value_type());
+
+            for (std::size_t i = ranges[r].start; i < ranges[r].end; ++i)
+            {
+                f(i, buffer);
+            }
+        };
+
+        const std::size_t nbBuffers = ranges.size();
+        const auto mergeBuffers = [this, nbBuffers, &output](const Range<std::size_t>& range)
+        {
+            for (std::size_t b = 0; b < nbBuffers; ++b)
+            {
+                const VecDeriv& buffer = m_buffers[b];
+                for (std::size_t i = range.start; i < range.end; ++i)
+                {
+                    output[i] += buffer[i];
+                }
+            }
+        };
+
+        if (!isParallel)
+        {
+            for (std::size_t r = 0; r < ranges.size(); ++r)
+            {
+                accumulateRange(r);
+            }
+            mergeBuffers(Range<std::size_t>{0, nbNodes});
+            return;
+        }
+
+        CpuTaskStatus status;
+        for (std::size_t r = 0; r < ranges.size(); ++r)
+        {
+            taskScheduler->addTask(status, [&accumulateRange, r]()
+            {
+                accumulateRange(r);
+            });
+        }
+        taskScheduler->workUntilDone(&status);
+
+        parallelForEachRange(*taskScheduler, std::size_t{0}, nbNodes, mergeBuffers,
+            Partitioner{Partitioner::Type::STATIC, mergeGrainSize});
+    }
+
+    /// Release the memory of the thread-local buffers
+    void clear()
+    {
+        m_buffers.clear();
+    }
+
+private:
+
+    sofa::type::vector<VecDeriv> m_buffers;
+};
+
+/**
+ * Calls f(elementId) for every element of a colored set of elements: the elements of a same color
+ * do not share any node, so they are processed in parallel and can write directly into a shared
+ * vector. The colors are processed one after the other.
+ *
+ * Without task scheduler, the elements are processed sequentially, color after color.
+ */
+template<class ElementId, class ElementFunction>
+void forEachColoredElement(TaskScheduler* taskScheduler,
+                           const sofa::type::vector<sofa::type::vector<ElementId> >& colors,
+                           ElementFunction f, const std::size_t grainSize = 64)
+{
+    for (const auto& color : colors)
+    {
+        if (taskScheduler == nullptr || taskScheduler->getThreadCount() < 2)
+        {
+            for (const auto& elementId : color)
+            {
+                f(elementId);
+            }
+        }
+        else
+        {
+            parallelForEach(*taskScheduler, color.begin(), color.end(),
+                [&f](const ElementId& elementId)
+                {
+                    f(elementId);
+                }, Partitioner{Partitioner::Type::STATIC, grainSize});
+        }
+    }
+}
+
+} // namespace sofa::simulation
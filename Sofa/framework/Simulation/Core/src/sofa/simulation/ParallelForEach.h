@@ -26,6 +26,9 @@
 #include <sofa/simulation/CpuTaskStatus.h>
 #include <sofa/type/vector_T.h>
 
+#include <algorithm>
+#include <thread>
+
 namespace sofa::simulation
 {
 
@@ -54,17 +57,31 @@ void advance(InputIt& it, Distance n)
     }
 }
 
+template<class InputIt>
+std::size_t nbElementsInRange(const InputIt first, const InputIt last)
+{
+    if constexpr (std::is_integral_v<InputIt>)
+    {
+        return static_cast<std::size_t>(last - first);
+    }
+    else
+    {
+        return static_cast<std::size_t>(std::distance(first, last));
+    }
+}
+
 /**
  * Function returning a list of ranges from an iterable container.
  * The number of ranges depends on:
  *  1) the desired number of ranges provided in a parameter
  *  2) the number of elements in the container
+ *  3) the minimal number of elements in a range (grain size)
  * The number of elements in each range is homogenous, except for the last range which may contain
  * more elements.
  */
 template<class InputIt>
 sofa::type::vector<Range<InputIt> >
-makeRangesForLoop(const InputIt first, const InputIt last, const unsigned int nbRangesHint)
+makeRangesForLoop(const InputIt first, const InputIt last, const unsigned int nbRangesHint, const std::size_t grainSize = 1)
 {
     sofa::type::vector<Range<InputIt> > ranges;
 
@@ -73,17 +90,10 @@ makeRangesForLoop(const InputIt first, const InputIt last, const unsigned int nb
         return ranges;
     }
 
-    unsigned int nbElements = 0;
-    if constexpr (std::is_integral_v<InputIt>)
-    {
-        nbElements = static_cast<unsigned int>(last - first);
-    }
-    else
-    {
-        nbElements = static_cast<unsigned int>(std::distance(first, last));
-    }
+    const auto nbElements = static_cast<unsigned int>(nbElementsInRange(first, last));
+    const auto maxNbRanges = static_cast<unsigned int>(std::max<std::size_t>(1, nbElements / std::max<std::size_t>(1, grainSize)));
 
-    const unsigned int nbRanges = std::min(nbRangesHint, nbElements);
+    const unsigned int nbRanges = std::min({nbRangesHint, nbElements, maxNbRanges});
     ranges.reserve(nbRanges);
 
     const auto nbElementsPerRange = nbElements / nbRanges;
@@ -104,6 +114,24 @@ makeRangesForLoop(const InputIt first, const InputIt last, const unsigned int nb
     return ranges;
 }
 
+/// Number of ranges generated by makeRangesForReduction in deterministic mode
+static constexpr unsigned int DeterministicNbRanges = 64;
+
+/**
+ * Ranges used by the parallel algorithms which combine the partial results of the ranges.
+ * By default, there is one range per thread of the task scheduler. In deterministic mode (see
+ * TaskScheduler::isDeterministic), the number of ranges is DeterministicNbRanges, so that the
+ * ranges, and thus the partial results, do not depend on the number of threads.
+ */
+template<class InputIt>
+sofa::type::vector<Range<InputIt> >
+makeRangesForReduction(const TaskScheduler& taskScheduler, const InputIt first, const InputIt last, const std::size_t grainSize = 1)
+{
+    const unsigned int nbRanges = TaskScheduler::isDeterministic() ?
+        DeterministicNbRanges : std::max(1u, taskScheduler.getThreadCount());
+    return makeRangesForLoop(first, last, nbRanges, grainSize);
+}
+
 /**
  * Applies the given function object f to the result of dereferencing every iterator in the
  * range [first, last), in order.
@@ -141,6 +169,76 @@ UnaryFunction forEachRange(InputIt first, InputIt last, UnaryFunction f)
     return f;
 }
 
+/**
+ * Describes how the iterations of a parallel loop are split into ranges, and how the ranges are
+ * distributed among the threads of the task scheduler.
+ */
+struct Partitioner
+{
+    enum class Type
+    {
+        /// One range per thread. The ranges are distributed among the threads by work stealing.
+        STATIC,
+        /// The loop is split recursively into ranges. A range is split further when it is stolen by
+        /// another thread, so that the load is balanced even if the cost per element varies.
+        AUTO,
+        /// One range per thread. The i-th range is always executed by the i-th thread, so that the
+        /// same elements are processed by the same thread from a call to the next one.
+        AFFINITY
+    };
+
+    Type type { Type::STATIC };
+
+    /// Minimal number of elements in a range
+    std::size_t grainSize { 1 };
+};
+
+namespace details
+{
+
+/// Number of additional splits allowed to a range when it is stolen (AUTO partitioner)
+static constexpr unsigned int NbSplitsOnSteal = 2;
+
+/**
+ * Split recursively the range r into tasks until the split budget (depth) is exhausted or the
+ * range is too small, then apply f to what remains.
+ * The split budget is increased when the range has been stolen, i.e. when it is executed by
+ * another thread than the one which created it.
+ */
+template<class InputIt, class UnaryFunction>
+void autoPartitionedRange(TaskScheduler& taskScheduler, CpuTaskStatus& status, Range<InputIt> r,
+                          UnaryFunction& f, const std::size_t grainSize, unsigned int depth,
+                          const std::thread::id parentThread)
+{
+    if (std::this_thread::get_id() != parentThread)
+    {
+        depth += NbSplitsOnSteal;
+    }
+
+    std::size_t nbElements = nbElementsInRange(r.start, r.end);
+    while (depth > 0 && nbElements >= 2 * grainSize)
+    {
+        const std::size_t half = nbElements / 2;
+        InputIt middle = r.start;
+        sofa::simulation::advance(middle, half);
+
+        --depth;
+        const Range<InputIt> right { middle, r.end };
+        taskScheduler.addTask(status,
+            [&taskScheduler, &status, right, &f, grainSize, depth, thread = std::this_thread::get_id()]()
+            {
+                autoPartitionedRange(taskScheduler, status, right, f, grainSize, depth, thread);
+            });
+
+        r.end = middle;
+        nbElements = half;
+    }
+
+    f(r);
+}
+
+}
+
 /**
  * Applies in parallel the given function object f to a list of ranges generated from [first, last)
  *
@@ -149,10 +247,12 @@ UnaryFunction forEachRange(InputIt first, InputIt last, UnaryFunction f)
  * The signature does not need to have const &.
  *
  * A task scheduler must be provided and correctly initiallized. The number of generated ranges
- * depends on the threads available in the task scheduler.
+ * depends on the threads available in the task scheduler, on the type of partitioner and on its
+ * grain size.
  */
 template<class InputIt, class UnaryFunction>
-UnaryFunction parallelForEachRange(TaskScheduler& taskScheduler, InputIt first, InputIt last, UnaryFunction f)
+UnaryFunction parallelForEachRange(TaskScheduler& taskScheduler, InputIt first, InputIt last, UnaryFunction f,
+                                   const Partitioner& partitioner = {})
 {
     if (first != last)
     {
@@ -163,16 +263,50 @@ UnaryFunction parallelForEachRange(TaskScheduler& taskScheduler, InputIt first,
             return forEachRange(first, last, f);
         }
 
-        CpuTaskStatus status;
+        const std::size_t grainSize = std::max<std::size_t>(1, partitioner.grainSize);
 
-        const auto ranges = makeRangesForLoop<InputIt>(first, last, taskSchedulerThreadCount);
+        CpuTaskStatus status;
 
-        for (const Range<InputIt>& r : ranges)
+        if (partitioner.type == Partitioner::Type::AUTO)
         {
-            taskScheduler.addTask(status, [&r, &f]()
+            // initial split budget: about 4 ranges per thread
+            unsigned int depth = 2;
+            for (unsigned int n = 1; n < taskSchedulerThreadCount; n *= 2)
+            {
+                ++depth;
+            }
+
+            const auto thread = std::this_thread::get_id();
+            taskScheduler.addTask(status, [&taskScheduler, &status, first, last, &f, grainSize, depth, thread]()
             {
-                f(r);
+                details::autoPartitionedRange(taskScheduler, status, Range<InputIt>{first, last}, f, grainSize, depth, thread);
             });
+            taskScheduler.workUntilDone(&status);
+            return f;
+        }
+
+        const auto ranges = makeRangesForLoop<InputIt>(first, last, taskSchedulerThreadCount, grainSize);
+
+        if (partitioner.type == Partitioner::Type::AFFINITY)
+        {
+            for (std::size_t i = 0; i < ranges.size(); ++i)
+            {
+                const Range<InputIt>& r = ranges[i];
+                taskScheduler.addTask(status, [&r, &f]()
+                {
+                    f(r);
+                }, static_cast<int>(i));
+            }
+        }
+        else
+        {
+            for (const Range<InputIt>& r : ranges)
+            {
+                taskScheduler.addTask(status, [&r, &f]()
+                {
+                    f(r);
+                });
+            }
         }
 
         taskScheduler.workUntilDone(&status);
@@ -185,13 +319,14 @@ UnaryFunction parallelForEachRange(TaskScheduler& taskScheduler, InputIt first,
  * range [first, last), in parallel.
  */
 template<class InputIt, class UnaryFunction>
-UnaryFunction parallelForEach(TaskScheduler& taskScheduler, InputIt first, InputIt last, UnaryFunction f)
+UnaryFunction parallelForEach(TaskScheduler& taskScheduler, InputIt first, InputIt last, UnaryFunction f,
+                              const Partitioner& partitioner = {})
 {
     parallelForEachRange(taskScheduler, first, last,
         [&f](const Range<InputIt>& r)
         {
             forEach(r.start, r.end, f);
-        });
+        }, partitioner);
     return f;
 }
 
@@ -205,11 +340,11 @@ enum class ForEachExecutionPolicy : bool
 template<class InputIt, class UnaryFunction>
 UnaryFunction forEachRange(const ForEachExecutionPolicy execution, TaskScheduler& taskScheduler,
                       InputIt first,
-                      InputIt last, UnaryFunction f)
+                      InputIt last, UnaryFunction f, const Partitioner& partitioner = {})
 {
     if (execution == ForEachExecutionPolicy::PARALLEL)
     {
-        return parallelForEachRange(taskScheduler, first, last, f);
+        return parallelForEachRange(taskScheduler, first, last, f, partitioner);
     }
     return forEachRange(first, last, f);
 }
@@ -217,11 +352,11 @@ UnaryFunction forEachRange(const ForEachExecutionPolicy execution, TaskScheduler
 template<class InputIt, class UnaryFunction>
 UnaryFunction forEach(const ForEachExecutionPolicy execution, TaskScheduler& taskScheduler,
                       InputIt first,
-                      InputIt last, UnaryFunction f)
+                      InputIt last, UnaryFunction f, const Partitioner& partitioner = {})
 {
     if (execution == ForEachExecutionPolicy::PARALLEL)
     {
-        return parallelForEach(taskScheduler, first, last, f);
+        return parallelForEach(taskScheduler, first, last, f, partitioner);
     }
     return forEach(first, last, f);
 }
@@ -0,0 +1,234 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/simulation/ParallelForEach.h>
+
+#include <type_traits>
+#include <vector>
+
+namespace sofa::simulation
+{
+
+namespace details
+{
+
+/// Partial result of a task, wrapped to avoid std::vector<bool> and false sharing between tasks
+template<class T>
+struct alignas(64) PartialResult
+{
+    T value;
+};
+
+/// Reduce sequentially the elements of a range: combine(...combine(combine(init, map(e0)), map(e1))..., map(en))
+template<class InputIt, class T, class MapFunction, class CombineFunction>
+T reduceRange(InputIt first, InputIt last, T init, MapFunction& map, CombineFunction& combine)
+{
+    for (; first != last; ++first)
+    {
+        if constexpr (std::is_integral_v<InputIt>)
+        {
+            init = combine(init, map(first));
+        }
+        else
+        {
+            init = combine(init, map(*first));
+        }
+    }
+    return init;
+}
+
+/// Reduce each range starting from identity, then combine the partial results in the order of the ranges
+template<class InputIt, class T, class MapFunction, class CombineFunction>
+T reduceRanges(const sofa::type::vector<Range<InputIt> >& ranges, T identity, MapFunction& map, CombineFunction& combine)
+{
+    T result = identity;
+    for (const Range<InputIt>& r : ranges)
+    {
+        result = combine(result, reduceRange(r.start, r.end, identity, map, combine));
+    }
+    return result;
+}
+
+}
+
+/**
+ * Applies the function object map to the result of dereferencing every iterator in the range
+ * [first, last) (or to every integer if the range is a range of integers), and combines the
+ * results with the function object combine, starting from identity.
+ *
+ * The signatures of the functions should be equivalent to the following:
+ * T map(const Type& a);
+ * T combine(const T& a, const T& b);
+ */
+template<class InputIt, class T, class MapFunction, class CombineFunction>
+T reduce(InputIt first, InputIt last, T identity, MapFunction map, CombineFunction combine)
+{
+    return details::reduceRange(first, last, identity, map, combine);
+}
+
+/**
+ * Sequential version of reduce using the same ranges and the same combination order as
+ * parallelReduce in deterministic mode (see TaskScheduler::isDeterministic): both give bitwise
+ * identical results.
+ */
+template<class InputIt, class T, class MapFunction, class CombineFunction>
+T deterministicReduce(InputIt first, InputIt last, T identity, MapFunction map, CombineFunction combine,
+                      const std::size_t grainSize = 1)
+{
+    const auto ranges = makeRangesForLoop<InputIt>(first, last, DeterministicNbRanges, grainSize);
+    return details::reduceRanges(ranges, identity, map, combine);
+}
+
+/**
+ * Parallel version of reduce.
+ *
+ * The range [first, last) is split into ranges (see makeRangesForReduction). Each range is reduced
+ * in a task, sequentially and starting from identity. The partial results are then combined on the
+ * calling thread, in the order of the ranges. Consequently, the result does not depend on the
+ * scheduling of the tasks: it is identical from one run to the next, as long as the number of
+ * threads of the task scheduler is the same. In deterministic mode, the ranges do not depend on the
+ * number of threads either, and the result is the same as deterministicReduce.
+ * identity must be the neutral element of combine, and combine must be associative.
+ *
+ * A task scheduler must be provided and correctly initialized.
+ */
+template<class InputIt, class T, class MapFunction, class CombineFunction>
+T parallelReduce(TaskScheduler& taskScheduler, InputIt first, InputIt last, T identity,
+                 MapFunction map, CombineFunction combine, const std::size_t grainSize = 1)
+{
+    if (first == last)
+    {
+        return identity;
+    }
+
+    const auto taskSchedulerThreadCount = taskScheduler.getThreadCount();
+    if (taskSchedulerThreadCount == 0)
+    {
+        msg_error("parallelReduce") << "Task scheduler does not appear to be initialized. Cannot perform parallel tasks.";
+        if (TaskScheduler::isDeterministic())
+        {
+            return deterministicReduce(first, last, identity, map, combine, grainSize);
+        }
+        return reduce(first, last, identity, map, combine);
+    }
+
+    const auto ranges = makeRangesForReduction<InputIt>(taskScheduler, first, last, grainSize);
+    if (ranges.size() == 1)
+    {
+        return reduce(first, last, identity, map, combine);
+    }
+
+    std::vector<details::PartialResult<T> > partialResults(ranges.size(), details::PartialResult<T>{identity});
+
+    CpuTaskStatus status;
+    for (std::size_t i = 0; i < ranges.size(); ++i)
+    {
+        taskScheduler.addTask(status, [&ranges, &partialResults, &map, &combine, i]()
+        {
+            const Range<InputIt>& r = ranges[i];
+            partialResults[i].value = details::reduceRange(r.start, r.end, partialResults[i].value, map, combine);
+        });
+    }
+    taskScheduler.workUntilDone(&status);
+
+    T result = identity;
+    for (const auto& partialResult : partialResults)
+    {
+        result = combine(result, partialResult.value);
+    }
+    return result;
+}
+
+/**
+ * Applies in parallel the function object f to the ranges generated from [first, last) (see
+ * makeRangesForReduction). f returns a partial result for its range. The partial results are then
+ * passed to the function object merge on the calling thread, in the order of the ranges.
+ * Contrary to merging the partial results from the tasks under a lock, the merge order does not
+ * depend on the scheduling of the tasks.
+ *
+ * The signatures of the functions should be equivalent to the following:
+ * R f(const Range<InputIt>& r);
+ * void merge(const Range<InputIt>& r, R& partialResult);
+ * R must be default constructible.
+ *
+ * A task scheduler must be provided and correctly initialized.
+ */
+template<class InputIt, class RangeFunction, class MergeFunction>
+void parallelForEachRangeWithMerge(TaskScheduler& taskScheduler, InputIt first, InputIt last,
+                                   RangeFunction f, MergeFunction merge, const std::size_t grainSize = 1)
+{
+    if (first == last)
+    {
+        return;
+    }
+
+    using R = std::decay_t<std::invoke_result_t<RangeFunction&, const Range<InputIt>&> >;
+
+    if (taskScheduler.getThreadCount() == 0)
+    {
+        msg_error("parallelForEachRangeWithMerge") << "Task scheduler does not appear to be initialized. Cannot perform parallel tasks.";
+        const unsigned int nbRanges = TaskScheduler::isDeterministic() ? DeterministicNbRanges : 1u;
+        for (const Range<InputIt>& r : makeRangesForLoop<InputIt>(first, last, nbRanges, grainSize))
+        {
+            R partialResult = f(r);
+            merge(r, partialResult);
+        }
+        return;
+    }
+
+    const auto ranges = makeRangesForReduction<InputIt>(taskScheduler, first, last, grainSize);
+    std::vector<details::PartialResult<R> > partialResults(ranges.size());
+
+    CpuTaskStatus status;
+    for (std::size_t i = 0; i < ranges.size(); ++i)
+    {
+        taskScheduler.addTask(status, [&ranges, &partialResults, &f, i]()
+        {
+            partialResults[i].value = f(ranges[i]);
+        });
+    }
+    taskScheduler.workUntilDone(&status);
+
+    for (std::size_t i = 0; i < ranges.size(); ++i)
+    {
+        merge(ranges[i], partialResults[i].value);
+    }
+}
+
+template<class InputIt, class T, class MapFunction, class CombineFunction>
+T reduce(const ForEachExecutionPolicy execution, TaskScheduler& taskScheduler,
+         InputIt first, InputIt last, T identity, MapFunction map, CombineFunction combine,
+         const std::size_t grainSize = 1)
+{
+    if (execution == ForEachExecutionPolicy::PARALLEL)
+    {
+        return parallelReduce(taskScheduler, first, last, identity, map, combine, grainSize);
+    }
+    if (TaskScheduler::isDeterministic())
+    {
+        return deterministicReduce(first, last, identity, map, combine, grainSize);
+    }
+    return reduce(first, last, identity, map, combine);
+}
+
+}
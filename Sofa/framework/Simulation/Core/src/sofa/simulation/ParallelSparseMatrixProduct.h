@@ -0,0 +1,67 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/simulation/ParallelForEach.h>
+#include <sofa/simulation/TaskScheduler.h>
+#include <sofa/linearalgebra/SparseMatrixProduct.h>
+
+namespace sofa::simulation
+{
+
+/// Default minimal number of values of the product computed by a task in parallelComputeProduct
+static constexpr std::size_t DefaultSparseMatrixProductGrainSize = 256;
+
+/**
+ * Computes the product of a SparseMatrixProduct, the numeric phase (the computation of the values
+ * of the product from the intersection) being executed in parallel. The values of the product are
+ * independent, so the tasks never write the same values, and the result does not depend on the
+ * number of threads.
+ *
+ * As in SparseMatrixProduct::computeProduct, the intersection is recomputed, sequentially, only if
+ * required.
+ *
+ * @param grainSize minimal number of values of the product computed by a task
+ */
+template<class TMatrix>
+void parallelComputeProduct(TaskScheduler& taskScheduler,
+                            linearalgebra::SparseMatrixProduct<TMatrix>& product,
+                            bool forceComputeIntersection = false,
+                            const std::size_t grainSize = DefaultSparseMatrixProductGrainSize)
+{
+    product.computeProduct(forceComputeIntersection,
+        [&taskScheduler, grainSize](const std::size_t nbValues, const auto& computeRange)
+        {
+            // the number of pairs of values to multiply varies from a value of the product to another
+            Partitioner partitioner;
+            partitioner.type = Partitioner::Type::AUTO;
+            partitioner.grainSize = grainSize;
+
+            parallelForEachRange(taskScheduler, std::size_t{0}, nbValues,
+                [&computeRange](const Range<std::size_t>& r)
+                {
+                    computeRange(r.start, r.end);
+                }, partitioner);
+        });
+}
+
+}
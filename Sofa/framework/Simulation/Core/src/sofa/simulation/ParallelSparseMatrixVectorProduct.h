@@ -0,0 +1,176 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/simulation/ParallelForEach.h>
+#include <sofa/simulation/TaskScheduler.h>
+#include <sofa/simulation/CpuTaskStatus.h>
+#include <sofa/linearalgebra/CompressedRowSparseMatrix.h>
+#include <sofa/type/vector.h>
+#include <algorithm>
+
+namespace sofa::simulation
+{
+
+/// Default minimal number of blocks processed by a task in the parallel sparse matrix-vector products
+static constexpr std::size_t DefaultSparseProductGrainSize = 512;
+
+namespace details
+{
+
+/**
+ * Split [0, n) into at most nbRanges ranges of consecutive indices, with about the same number of
+ * blocks in each range, begin being the prefix sum of the number of blocks (size n+1), such as
+ * CompressedRowSparseMatrix::rowBegin. A range contains at least grainSize blocks, except the last
+ * one.
+ */
+template<class TVecIndex>
+sofa::type::vector<Range<sofa::Index> > makeBalancedRanges(const TVecIndex& begin, const sofa::Index n,
+                                                           const unsigned int nbRanges, const std::size_t grainSize)
+{
+    sofa::type::vector<Range<sofa::Index> > ranges;
+    if (n == 0)
+    {
+        return ranges;
+    }
+
+    const std::size_t nbBlocks = begin[n] - begin[0];
+    const std::size_t blocksPerRange = std::max<std::size_t>({1, grainSize, (nbBlocks + nbRanges - 1) / std::max(1u, nbRanges)});
+
+    sofa::Index start = 0;
+    while (start < n)
+    {
+        // first index such that the range [start, end) contains at least blocksPerRange blocks
+        const auto target = begin[start] + blocksPerRange;
+        auto end = static_cast<sofa::Index>(std::lower_bound(begin.begin() + start + 1, begin.begin() + n, target) - begin.begin());
+        end = std::max(end, start + 1);
+        ranges.emplace_back(start, end);
+        start = end;
+    }
+    return ranges;
+}
+
+template<class Ranges, class RangeFunction>
+void runRanges(TaskScheduler& taskScheduler, const Ranges& ranges, RangeFunction& f)
+{
+    if (ranges.size() == 1)
+    {
+        f(ranges.front());
+        return;
+    }
+
+    CpuTaskStatus status;
+    for (const auto& r : ranges)
+    {
+        taskScheduler.addTask(status, [&r, &f]()
+        {
+            f(r);
+        });
+    }
+    taskScheduler.workUntilDone(&status);
+}
+
+}
+
+/**
+ * Computes res = matrix * vec in parallel. Each task computes a range of consecutive block rows,
+ * the ranges being balanced according to their number of non-empty blocks. A row of the result is
+ * computed by a single task, in the same order as the sequential product (CompressedRowSparseMatrix::mul),
+ * so that the result does not depend on the number of threads.
+ *
+ * @param grainSize minimal number of blocks processed by a task
+ */
+template<class TBlock, class TVecBlock, class TVecIndex, class V1, class V2>
+void parallelMul(TaskScheduler& taskScheduler,
+                 const linearalgebra::CompressedRowSparseMatrix<TBlock, TVecBlock, TVecIndex>& matrix,
+                 V1& res, const V2& vec, const std::size_t grainSize = DefaultSparseProductGrainSize)
+{
+    using Matrix = linearalgebra::CompressedRowSparseMatrix<TBlock, TVecBlock, TVecIndex>;
+    using Real = typename Matrix::template ProductReal<V1>;
+
+    const_cast<Matrix&>(matrix).compress();
+    matrix.resizeMulResult(res);
+
+    const auto nbRows = static_cast<sofa::Index>(matrix.getRowIndex().size());
+    const auto ranges = details::makeBalancedRanges(matrix.getRowBegin(), nbRows,
+        std::max(1u, taskScheduler.getThreadCount()), grainSize);
+
+    auto f = [&matrix, &res, &vec](const Range<sofa::Index>& r)
+    {
+        matrix.template tmulRows<Real>(res, vec, r.start, r.end);
+    };
+    details::runRanges(taskScheduler, ranges, f);
+}
+
+/**
+ * Computes res += matrix^T * vec in parallel, using the pattern of the transposed matrix (see
+ * CompressedRowSparseMatrix::buildTransposedPattern). Each task computes a range of consecutive
+ * block columns, i.e. a range of entries of the result: unlike a parallel loop on the rows of the
+ * matrix, the tasks never write the same entries, and no synchronization is required.
+ * The result does not depend on the number of threads.
+ *
+ * The pattern is usually built once and reused, as long as the pattern of the matrix does not
+ * change.
+ *
+ * @param grainSize minimal number of blocks processed by a task
+ */
+template<class TBlock, class TVecBlock, class TVecIndex, class V1, class V2>
+void parallelAddMulTranspose(TaskScheduler& taskScheduler,
+                             const linearalgebra::CompressedRowSparseMatrix<TBlock, TVecBlock, TVecIndex>& matrix,
+                             const typename linearalgebra::CompressedRowSparseMatrix<TBlock, TVecBlock, TVecIndex>::TransposedPattern& transposedPattern,
+                             V1& res, const V2& vec, const std::size_t grainSize = DefaultSparseProductGrainSize)
+{
+    using Matrix = linearalgebra::CompressedRowSparseMatrix<TBlock, TVecBlock, TVecIndex>;
+    using Real = typename Matrix::template ProductReal<V1>;
+
+    assert(transposedPattern.colBegin.size() == static_cast<std::size_t>(matrix.colBSize()) + 1);
+    matrix.resizeMulTransposeResult(res);
+
+    const auto nbCols = static_cast<sofa::Index>(matrix.colBSize());
+    const auto ranges = details::makeBalancedRanges(transposedPattern.colBegin, nbCols,
+        std::max(1u, taskScheduler.getThreadCount()), grainSize);
+
+    auto f = [&matrix, &transposedPattern, &res, &vec](const Range<sofa::Index>& r)
+    {
+        matrix.template taddMulTransposeColumns<Real>(res, vec, transposedPattern, r.start, r.end);
+    };
+    details::runRanges(taskScheduler, ranges, f);
+}
+
+/**
+ * Computes res += matrix^T * vec in parallel. The pattern of the transposed matrix is built at
+ * each call: prefer the overload taking the pattern if the product is computed several times.
+ */
+template<class TBlock, class TVecBlock, class TVecIndex, class V1, class V2>
+void parallelAddMulTranspose(TaskScheduler& taskScheduler,
+                             const linearalgebra::CompressedRowSparseMatrix<TBlock, TVecBlock, TVecIndex>& matrix,
+                             V1& res, const V2& vec, const std::size_t grainSize = DefaultSparseProductGrainSize)
+{
+    using Matrix = linearalgebra::CompressedRowSparseMatrix<TBlock, TVecBlock, TVecIndex>;
+
+    const_cast<Matrix&>(matrix).compress();
+    typename Matrix::TransposedPattern transposedPattern;
+    matrix.buildTransposedPattern(transposedPattern);
+    parallelAddMulTranspose(taskScheduler, matrix, transposedPattern, res, vec, grainSize);
+}
+
+}
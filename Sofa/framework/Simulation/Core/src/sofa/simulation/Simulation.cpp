@@ -37,6 +37,7 @@
 #include <sofa/simulation/CleanupVisitor.h>
 #include <sofa/simulation/DeleteVisitor.h>
 #include <sofa/simulation/UpdateBoundingBoxVisitor.h>
+#include <sofa/simulation/MemoryFootprintVisitor.h>
 #include <sofa/simulation/UpdateLinksVisitor.h>
 #include <sofa/simulation/init.h>
 #include <sofa/simulation/DefaultAnimationLoop.h>
@@ -248,6 +249,18 @@ void Simulation::animate ( Node* root, SReal dt )
         return;
     }
 
+    if (m_memoryProfiling)
+    {
+        // a pipelined step may still be resizing the vectors: it must be finished before reading them
+        DefaultAnimationLoop::waitForPendingStep(root);
+
+        sofa::helper::AdvancedTimer::stepBegin("MemoryFootprint");
+        MemoryFootprintVisitor memoryFootprint(params);
+        root->execute(memoryFootprint);
+        memoryFootprint.recordInAdvancedTimer();
+        sofa::helper::AdvancedTimer::stepEnd("MemoryFootprint");
+    }
+
     sofa::helper::AdvancedTimer::stepEnd("Simulation::animate");
 }
 
@@ -275,6 +288,7 @@ void Simulation::updateVisual ( Node* root)
 void Simulation::reset ( Node* root )
 {
     if ( !root ) return;
+    DefaultAnimationLoop::waitForPendingStep(root);
     sofa::core::ExecParams* params = sofa::core::execparams::defaultInstance();
 
     // start by resetting the time
@@ -323,6 +337,7 @@ void Simulation::initTextures ( Node* root )
 void Simulation::computeBBox ( Node* root, SReal* minBBox, SReal* maxBBox, bool init )
 {
     if ( !root ) return;
+    DefaultAnimationLoop::waitForPendingStep(root);
     sofa::core::visual::VisualParams* vparams = sofa::core::visual::visualparams::defaultInstance();
     sofa::core::visual::VisualLoop* vloop = root->getVisualLoop();
     if(vloop)
@@ -340,6 +355,7 @@ void Simulation::computeBBox ( Node* root, SReal* minBBox, SReal* maxBBox, bool
 void Simulation::computeTotalBBox ( Node* root, SReal* minBBox, SReal* maxBBox )
 {
     assert ( root!=nullptr );
+    DefaultAnimationLoop::waitForPendingStep(root);
     sofa::core::ExecParams* params = sofa::core::execparams::defaultInstance();
     root->execute<UpdateBoundingBoxVisitor>( params );
     type::BoundingBox bb = root->f_bbox.getValue();
@@ -353,6 +369,7 @@ void Simulation::computeTotalBBox ( Node* root, SReal* minBBox, SReal* maxBBox )
 void Simulation::updateContext ( Node* root )
 {
     if ( !root ) return;
+    DefaultAnimationLoop::waitForPendingStep(root);
     sofa::core::ExecParams* params = sofa::core::execparams::defaultInstance();
     root->execute<UpdateContextVisitor>(params);
 }
@@ -379,6 +396,10 @@ void Simulation::draw ( sofa::core::visual::VisualParams* vparams, Node* root )
 {
     sofa::helper::AdvancedTimer::stepBegin("Simulation::draw");
 
+    // the components drawing the simulation state (e.g. debug rendering of the mechanical states) are not double
+    // buffered: only the update of the visual models overlaps with a pipelined time step
+    DefaultAnimationLoop::waitForPendingStep(root);
+
     for(auto& visualLoop : root->getTreeObjects<sofa::core::visual::VisualLoop>())
     {
         if (!vparams) vparams = sofa::core::visual::visualparams::defaultInstance();
@@ -393,6 +414,7 @@ void Simulation::draw ( sofa::core::visual::VisualParams* vparams, Node* root )
 void Simulation::exportOBJ ( Node* root, const char* filename, bool exportMTL )
 {
     if ( !root ) return;
+    DefaultAnimationLoop::waitForPendingStep(root);
     sofa::core::ExecParams* params = sofa::core::execparams::defaultInstance();
     std::ofstream fout ( filename );
 
@@ -428,6 +450,7 @@ void Simulation::exportOBJ ( Node* root, const char* filename, bool exportMTL )
 void Simulation::dumpState ( Node* root, std::ofstream& out )
 {
     sofa::helper::ScopedAdvancedTimer dumpStateTimer("dumpState");
+    DefaultAnimationLoop::waitForPendingStep(root);
 
     sofa::core::ExecParams* params = sofa::core::execparams::defaultInstance();
     out<<root->getTime() <<" ";
@@ -135,6 +135,14 @@ public:
     /// Can the simulation handle a directed acyclic graph?
     virtual bool isDirectedAcyclicGraph() = 0;
 
+    /// If enabled, the memory footprint of each node is recorded in the AdvancedTimer values after each time step.
+    /// The pipelined steps of DefaultAnimationLoop are then finished before the footprint is collected.
+    void setMemoryProfiling(bool enabled) { m_memoryProfiling = enabled; }
+    bool isMemoryProfilingEnabled() const { return m_memoryProfiling; }
+
+protected:
+    bool m_memoryProfiling { false };
+
 };
 
 } // namespace simulation
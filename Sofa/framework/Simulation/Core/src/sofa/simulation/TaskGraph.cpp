@@ -0,0 +1,194 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/simulation/TaskGraph.h>
+
+#include <sofa/simulation/CpuTask.h>
+#include <sofa/simulation/TaskScheduler.h>
+#include <sofa/helper/logging/Messaging.h>
+
+#include <cassert>
+
+namespace sofa::simulation
+{
+
+TaskGraph::TaskGraph() = default;
+
+TaskGraph::~TaskGraph() = default;
+
+TaskGraph::TaskId TaskGraph::addTask(std::function<void()> task, std::string name)
+{
+    m_tasks.push_back({std::move(task), std::move(name), {}, 0});
+    return m_tasks.size() - 1;
+}
+
+void TaskGraph::addDependency(const TaskId predecessor, const TaskId successor)
+{
+    assert(predecessor < m_tasks.size());
+    assert(successor < m_tasks.size());
+
+    m_tasks[predecessor].successors.push_back(successor);
+    ++m_tasks[successor].nbPredecessors;
+}
+
+void TaskGraph::addDependencies(const std::vector<TaskId>& predecessors, const TaskId successor)
+{
+    for (const auto predecessor : predecessors)
+    {
+        addDependency(predecessor, successor);
+    }
+}
+
+void TaskGraph::clear()
+{
+    m_tasks.clear();
+}
+
+std::vector<TaskGraph::TaskId> TaskGraph::topologicalOrder() const
+{
+    // Kahn's algorithm
+    std::vector<std::size_t> nbPredecessors(m_tasks.size());
+    std::vector<TaskId> order;
+    order.reserve(m_tasks.size());
+
+    for (TaskId i = 0; i < m_tasks.size(); ++i)
+    {
+        nbPredecessors[i] = m_tasks[i].nbPredecessors;
+        if (nbPredecessors[i] == 0)
+        {
+            order.push_back(i);
+        }
+    }
+
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        for (const auto successor : m_tasks[order[i]].successors)
+        {
+            if (--nbPredecessors[successor] == 0)
+            {
+                order.push_back(successor);
+            }
+        }
+    }
+
+    return order;
+}
+
+bool TaskGraph::isAcyclic() const
+{
+    return topologicalOrder().size() == m_tasks.size();
+}
+
+bool TaskGraph::runSequential()
+{
+    const auto order = topologicalOrder();
+    if (order.size() != m_tasks.size())
+    {
+        msg_error("TaskGraph") << "The task graph contains a cycle: it cannot be run";
+        return false;
+    }
+
+    for (const auto id : order)
+    {
+        m_tasks[id].task();
+    }
+    return true;
+}
+
+bool TaskGraph::run(TaskScheduler& taskScheduler)
+{
+    if (taskScheduler.getThreadCount() < 2)
+    {
+        return runSequential();
+    }
+
+    if (!isAcyclic())
+    {
+        msg_error("TaskGraph") << "The task graph contains a cycle: it cannot be run";
+        return false;
+    }
+
+    if (m_pendingPredecessorsSize != m_tasks.size())
+    {
+        m_pendingPredecessors = std::make_unique<std::atomic<std::size_t>[]>(m_tasks.size());
+        m_pendingPredecessorsSize = m_tasks.size();
+    }
+
+    for (TaskId i = 0; i < m_tasks.size(); ++i)
+    {
+        m_pendingPredecessors[i].store(m_tasks[i].nbPredecessors, std::memory_order_relaxed);
+    }
+
+    CpuTask::Status status;
+    for (TaskId i = 0; i < m_tasks.size(); ++i)
+    {
+        if (m_tasks[i].nbPredecessors == 0)
+        {
+            taskScheduler.addTask(status, [this, i, &taskScheduler, &status]()
+            {
+                execute(i, taskScheduler, status);
+            });
+        }
+    }
+
+    taskScheduler.workUntilDone(&status);
+    return true;
+}
+
+void TaskGraph::execute(TaskId id, TaskScheduler& taskScheduler, CpuTaskStatus& status)
+{
+    while (true)
+    {
+        m_tasks[id].task();
+
+        // The successors which become ready are given to the scheduler, except one of them which
+        // is run directly by this thread: this saves a round trip through the task queues on the
+        // chains of the graph.
+        bool hasContinuation = false;
+        TaskId continuation = 0;
+        for (const auto successor : m_tasks[id].successors)
+        {
+            if (m_pendingPredecessors[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                if (!hasContinuation)
+                {
+                    hasContinuation = true;
+                    continuation = successor;
+                }
+                else
+                {
+                    taskScheduler.addTask(status, [this, successor, &taskScheduler, &status]()
+                    {
+                        execute(successor, taskScheduler, status);
+                    });
+                }
+            }
+        }
+
+        if (!hasContinuation)
+        {
+            return;
+        }
+        id = continuation;
+    }
+}
+
+} // namespace sofa::simulation
@@ -0,0 +1,126 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/simulation/config.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sofa::simulation
+{
+
+class TaskScheduler;
+class CpuTaskStatus;
+
+/**
+ * A graph of tasks with dependencies (a DAG).
+ *
+ * Each task declares the tasks it depends on (its predecessors). When the graph is run, a task
+ * is given to the task scheduler as soon as all its predecessors are finished, so independent
+ * branches of the graph overlap instead of being separated by fork-join barriers.
+ *
+ * Example:
+ * \code{.cpp}
+ * TaskGraph graph;
+ * const auto a = graph.addTask([]{ ... }, "A");
+ * const auto b = graph.addTask([]{ ... }, "B");
+ * const auto c = graph.addTask([]{ ... }, "C");
+ * graph.addDependency(a, c); // c runs after a
+ * graph.addDependency(b, c); // c runs after b
+ * graph.run(*taskScheduler); // a and b run concurrently, then c
+ * \endcode
+ *
+ * The graph can be run several times. It must not be modified while it is running.
+ */
+class SOFA_SIMULATION_CORE_API TaskGraph
+{
+public:
+    using TaskId = std::size_t;
+
+    TaskGraph();
+    ~TaskGraph();
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    /// Add a task to the graph, without dependency. Returns its identifier in the graph.
+    TaskId addTask(std::function<void()> task, std::string name = {});
+
+    /// Declare that the task 'successor' cannot start before the task 'predecessor' is finished
+    void addDependency(TaskId predecessor, TaskId successor);
+
+    /// Same as addDependency(predecessor, successor) for each of the predecessors
+    void addDependencies(const std::vector<TaskId>& predecessors, TaskId successor);
+
+    /// Remove all the tasks and dependencies
+    void clear();
+
+    std::size_t size() const { return m_tasks.size(); }
+    bool empty() const { return m_tasks.empty(); }
+
+    const std::string& getTaskName(TaskId id) const { return m_tasks[id].name; }
+    const std::vector<TaskId>& getSuccessors(TaskId id) const { return m_tasks[id].successors; }
+    std::size_t getNbPredecessors(TaskId id) const { return m_tasks[id].nbPredecessors; }
+
+    /// Returns an order in which the tasks can be run sequentially while respecting the
+    /// dependencies. The returned list is shorter than the graph if it contains a cycle.
+    std::vector<TaskId> topologicalOrder() const;
+
+    /// Returns false if the graph contains a cycle
+    bool isAcyclic() const;
+
+    /**
+     * Run all the tasks of the graph with the provided task scheduler, and wait until they are
+     * all finished. The calling thread takes part in the execution.
+     * If the scheduler has a single thread, the tasks are run sequentially in a topological order.
+     * Returns false, without running anything, if the graph contains a cycle.
+     */
+    bool run(TaskScheduler& taskScheduler);
+
+    /// Run all the tasks of the graph sequentially in a topological order
+    bool runSequential();
+
+private:
+
+    struct Node
+    {
+        std::function<void()> task;
+        std::string name;
+        std::vector<TaskId> successors;
+        std::size_t nbPredecessors { 0 };
+    };
+
+    /// Run the task id, then spawn the successors which become ready
+    void execute(TaskId id, TaskScheduler& taskScheduler, CpuTaskStatus& status);
+
+    std::vector<Node> m_tasks;
+
+    /// Number of predecessors not finished yet, for each task, during a run
+    std::unique_ptr<std::atomic<std::size_t>[]> m_pendingPredecessors;
+    std::size_t m_pendingPredecessorsSize { 0 };
+};
+
+} // namespace sofa::simulation
@@ -24,16 +24,30 @@
 #include <sofa/simulation/MainTaskSchedulerFactory.h>
 #include <sofa/simulation/MainTaskSchedulerRegistry.h>
 
+#include <algorithm>
+#include <atomic>
 #include <thread>
 
 namespace sofa::simulation
 {
+
+namespace
+{
+std::atomic<bool> s_isDeterministic { false };
+}
+
 unsigned TaskScheduler::GetHardwareThreadsCount()
 {
-    return std::thread::hardware_concurrency() / 2;
+    // at least one thread, even on a single core
+    return std::max(1u, std::thread::hardware_concurrency() / 2);
 }
 
 bool TaskScheduler::addTask(Task::Status& status, const std::function<void()>& task)
+{
+    return addTask(status, task, -1);
+}
+
+bool TaskScheduler::addTask(Task::Status& status, const std::function<void()>& task, const int scheduledThread)
 {
     class CallableTask final : public Task
     {
@@ -60,7 +74,17 @@ bool TaskScheduler::addTask(Task::Status& status, const std::function<void()>& t
         std::function<void()> m_task;
     };
 
-    return addTask(new CallableTask(-1, status, task)); //destructor should be called after run() because it returns MemoryAlloc::Dynamic
+    return addTask(new CallableTask(scheduledThread, status, task)); //destructor should be called after run() because it returns MemoryAlloc::Dynamic
+}
+
+void TaskScheduler::setDeterministic(const bool deterministic)
+{
+    s_isDeterministic = deterministic;
+}
+
+bool TaskScheduler::isDeterministic()
+{
+    return s_isDeterministic;
 }
 
 TaskScheduler* TaskScheduler::create(const char* name)
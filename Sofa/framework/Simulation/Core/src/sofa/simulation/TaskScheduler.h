@@ -65,10 +65,30 @@ public:
 
     virtual bool addTask(Task::Status& status, const std::function<void()>& task);
 
+    /**
+     * Same as addTask(status, task), with a hint of the thread which should run the task.
+     * Threads are numbered from 0 (the thread which created the scheduler) to getThreadCount() - 1.
+     * A negative value means that the task can be run by any thread. The hint is ignored by the
+     * schedulers which do not support it.
+     */
+    virtual bool addTask(Task::Status& status, const std::function<void()>& task, int scheduledThread);
+
     virtual void workUntilDone(Task::Status* status) = 0;
 
     virtual Task::Allocator* getTaskAllocator() = 0;
 
+    /**
+     * Deterministic mode, shared by all the task schedulers.
+     * When enabled, the parallel algorithms combining partial results (parallelReduce,
+     * ParallelElementAccumulator, ...) split the work into ranges which depend only on the number
+     * of elements, not on the number of threads, and combine the partial results in the order of
+     * the ranges, whatever the order in which the tasks are executed. Floating-point results are
+     * then bitwise identical from one run to the next, and whatever the number of threads.
+     * Disabled by default, since the number of partial results is larger than the number of threads.
+     */
+    static void setDeterministic(bool deterministic);
+    static bool isDeterministic();
+
 protected:
 
     friend class Task;
@@ -24,6 +24,8 @@
 #include <sofa/core/objectmodel/BaseObject.h>
 #include <sofa/simulation/Node.h>
 #include <sofa/helper/ScopedAdvancedTimer.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/ParallelReduce.h>
 
 namespace sofa
 {
@@ -36,20 +38,26 @@ UpdateBoundingBoxVisitor::UpdateBoundingBoxVisitor(const sofa::core::ExecParams*
 
 }
 
+UpdateBoundingBoxVisitor::UpdateBoundingBoxVisitor(const sofa::core::ExecParams* params, const ForEachExecutionPolicy execution)
+    : Visitor(params)
+    , m_execution(execution)
+{
+
+}
+
 Visitor::Result UpdateBoundingBoxVisitor::processNodeTopDown(Node* node)
 {
     std::string msg = "BoundingBoxVisitor - ProcessTopDown: " + node->getName();
     sofa::helper::ScopedAdvancedTimer timer(msg.c_str());
     using namespace sofa::core::objectmodel;
     type::vector<BaseObject*> objectList;
-    type::vector<BaseObject*>::iterator object;
     node->get<BaseObject>(&objectList,BaseContext::Local);
     sofa::type::BoundingBox* nodeBBox = node->f_bbox.beginEdit();
     if(!node->f_bbox.isSet()) // bmarques: Without invalidating the bbox, the node's bbox will only be sized up, and never down with this visitor, to my understanding..
         nodeBBox->invalidate();
-    for ( object = objectList.begin(); object != objectList.end(); ++object)
+
+    const auto computeObjectBBox = [this](BaseObject* object) -> sofa::type::BoundingBox
     {
-        sofa::helper::ScopedAdvancedTimer("ComputeBBox: " + (*object)->getName());
         // warning the second parameter should NOT be false
         // otherwise every object will participate to the bounding box
         // when it makes no sense for some of them
@@ -57,9 +65,33 @@ Visitor::Result UpdateBoundingBoxVisitor::processNodeTopDown(Node* node)
         // sometimes their values do not even have a spatial meaning (such as MechanicalObject representing constraint value)
         // if some objects does not participate to the bounding box where they should,
         // you should overload their computeBBox function to correct that
-        (*object)->computeBBox(params, true);
+        object->computeBBox(params, true);
+        return object->f_bbox.getValue();
+    };
+    const auto includeBBox = [](sofa::type::BoundingBox a, const sofa::type::BoundingBox& b)
+    {
+        a.include(b);
+        return a;
+    };
 
-        nodeBBox->include((*object)->f_bbox.getValue());
+    // the bounding boxes are included in the order of the objects, whatever the execution policy
+    TaskScheduler* taskScheduler = (m_execution == ForEachExecutionPolicy::PARALLEL) ?
+        MainTaskSchedulerFactory::createInRegistry() : nullptr;
+    if (taskScheduler)
+    {
+        nodeBBox->include(parallelReduce(*taskScheduler, objectList.begin(), objectList.end(),
+                                         sofa::type::BoundingBox(), computeObjectBBox, includeBBox));
+    }
+    else
+    {
+        // the timers are only used sequentially: AdvancedTimer is not thread-safe
+        const auto timedComputeObjectBBox = [&computeObjectBBox](BaseObject* object)
+        {
+            sofa::helper::ScopedAdvancedTimer timer("ComputeBBox: " + object->getName());
+            return computeObjectBBox(object);
+        };
+        nodeBBox->include(reduce(objectList.begin(), objectList.end(),
+                                 sofa::type::BoundingBox(), timedComputeObjectBBox, includeBBox));
     }
     node->f_bbox.endEdit();
     return RESULT_CONTINUE;
@@ -23,6 +23,7 @@
 #define SOFA_SIMULATION_CORE_COMPUTEBOUNDINGBOXVISITOR_H
 
 #include <sofa/simulation/Visitor.h>
+#include <sofa/simulation/ParallelForEach.h>
 
 namespace sofa
 {
@@ -35,10 +36,17 @@ public:
 
     UpdateBoundingBoxVisitor(const sofa::core::ExecParams* params);
 
+    /// In parallel mode, the bounding boxes of the objects of a node are computed concurrently,
+    /// using the main task scheduler. The objects must support a concurrent call to computeBBox.
+    UpdateBoundingBoxVisitor(const sofa::core::ExecParams* params, ForEachExecutionPolicy execution);
+
     Result processNodeTopDown(simulation::Node* node) override;
 
     void processNodeBottomUp(simulation::Node* node) override;
 
+protected:
+    ForEachExecutionPolicy m_execution { ForEachExecutionPolicy::SEQUENTIAL };
+
 };
 
 
@@ -165,6 +165,28 @@ void VisualInitVisitor::processVisualModel(simulation::Node*, core::visual::Visu
     vm->initVisual();
 }
 
+Visitor::Result VisualSetDoubleBufferedVisitor::processNodeTopDown(simulation::Node* node)
+{
+    for_each(this, node, node->visualModel,              &VisualSetDoubleBufferedVisitor::processVisualModel);
+
+    return RESULT_CONTINUE;
+}
+void VisualSetDoubleBufferedVisitor::processVisualModel(simulation::Node*, core::visual::VisualModel* vm)
+{
+    vm->setDoubleBuffered(m_enabled);
+}
+
+Visitor::Result VisualSwapStateVisitor::processNodeTopDown(simulation::Node* node)
+{
+    for_each(this, node, node->visualModel,              &VisualSwapStateVisitor::processVisualModel);
+
+    return RESULT_CONTINUE;
+}
+void VisualSwapStateVisitor::processVisualModel(simulation::Node*, core::visual::VisualModel* vm)
+{
+    vm->swapVisualState();
+}
+
 VisualComputeBBoxVisitor::VisualComputeBBoxVisitor(const core::ExecParams* params)
     : Visitor(params)
 {
@@ -100,6 +100,34 @@ public:
 
 
 
+/// Enable or disable the double buffering of the visual models (see VisualModel::setDoubleBuffered)
+class SOFA_SIMULATION_CORE_API VisualSetDoubleBufferedVisitor : public Visitor
+{
+public:
+    VisualSetDoubleBufferedVisitor(const core::ExecParams* params, bool enabled)
+        : Visitor(params), m_enabled(enabled) {}
+
+    virtual void processVisualModel(simulation::Node*, core::visual::VisualModel* vm);
+    Result processNodeTopDown(simulation::Node* node) override;
+    const char* getClassName() const override { return "VisualSetDoubleBufferedVisitor"; }
+
+protected:
+    bool m_enabled;
+};
+
+/// Publish the state computed by the simulation to the visual models (see VisualModel::swapVisualState)
+class SOFA_SIMULATION_CORE_API VisualSwapStateVisitor : public Visitor
+{
+public:
+    VisualSwapStateVisitor(const core::ExecParams* params) : Visitor(params) {}
+
+    virtual void processVisualModel(simulation::Node*, core::visual::VisualModel* vm);
+    Result processNodeTopDown(simulation::Node* node) override;
+    const char* getClassName() const override { return "VisualSwapStateVisitor"; }
+};
+
+
+
 class SOFA_SIMULATION_CORE_API VisualComputeBBoxVisitor : public Visitor
 {
 public:
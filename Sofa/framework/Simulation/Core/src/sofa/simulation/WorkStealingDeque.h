@@ -0,0 +1,200 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace sofa::simulation
+{
+
+/**
+ * Lock-free work-stealing deque (Chase-Lev).
+ *
+ * A single thread (the owner) pushes and pops items at the bottom of the deque, while any number
+ * of other threads (the thieves) steal items from the top. The owner never takes a lock, and
+ * thieves only compete with each other (and with the owner when one item is left) through a CAS
+ * on the top index.
+ *
+ * The storage is a circular buffer which grows without bound: when it is full, the owner copies
+ * the live items into a buffer twice as large. The previous buffers are kept alive until the deque
+ * is destroyed, because a thief may still be reading from them.
+ *
+ * Memory orderings follow "Correct and Efficient Work-Stealing for Weak Memory Models"
+ * (Le, Pop, Cohen, Zappa Nardelli, PPoPP 2013).
+ *
+ * T must be trivially copyable (typically a pointer).
+ */
+template<class T>
+class WorkStealingDeque
+{
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque requires a trivially copyable type");
+
+public:
+
+    explicit WorkStealingDeque(const std::int64_t initialCapacity = 256)
+        : m_top(0)
+        , m_bottom(0)
+    {
+        std::int64_t capacity = 1;
+        while (capacity < initialCapacity)
+        {
+            capacity <<= 1;
+        }
+        m_buffers.emplace_back(std::make_unique<Buffer>(capacity));
+        m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /// Add an item at the bottom of the deque. Owner thread only.
+    void push(T item)
+    {
+        const std::int64_t b = m_bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = m_top.load(std::memory_order_acquire);
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+
+        if (b - t > buffer->capacity - 1)
+        {
+            buffer = grow(buffer, t, b);
+        }
+
+        buffer->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    /// Remove the item at the bottom of the deque (LIFO). Owner thread only.
+    /// Returns false if the deque is empty.
+    bool pop(T& item)
+    {
+        const std::int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = m_top.load(std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            // empty deque
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        item = buffer->get(b);
+        if (t == b)
+        {
+            // last item: race against the thieves
+            const bool won = m_top.compare_exchange_strong(t, t + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed);
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /// Remove the item at the top of the deque (FIFO). Can be called from any thread.
+    /// Returns false if the deque is empty or if another thread took the item first.
+    bool steal(T& item)
+    {
+        std::int64_t t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t b = m_bottom.load(std::memory_order_acquire);
+
+        if (t >= b)
+        {
+            return false;
+        }
+
+        Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+        item = buffer->get(t);
+        return m_top.compare_exchange_strong(t, t + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    /// Approximate number of items in the deque (exact if called from the owner without thieves)
+    std::size_t size() const
+    {
+        const std::int64_t b = m_bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = m_top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<std::size_t>(b - t) : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    /// Current capacity of the circular buffer
+    std::int64_t capacity() const
+    {
+        return m_buffer.load(std::memory_order_relaxed)->capacity;
+    }
+
+private:
+
+    struct Buffer
+    {
+        explicit Buffer(const std::int64_t c)
+            : capacity(c), mask(c - 1), items(std::make_unique<std::atomic<T>[]>(c))
+        {}
+
+        T get(const std::int64_t i) const
+        {
+            return items[i & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(const std::int64_t i, T item)
+        {
+            items[i & mask].store(item, std::memory_order_relaxed);
+        }
+
+        const std::int64_t capacity;
+        const std::int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> items;
+    };
+
+    /// Owner thread only: replace the buffer by a new one twice as large
+    Buffer* grow(const Buffer* buffer, const std::int64_t top, const std::int64_t bottom)
+    {
+        auto newBuffer = std::make_unique<Buffer>(buffer->capacity * 2);
+        for (std::int64_t i = top; i < bottom; ++i)
+        {
+            newBuffer->put(i, buffer->get(i));
+        }
+
+        Buffer* result = newBuffer.get();
+        m_buffers.emplace_back(std::move(newBuffer));
+        m_buffer.store(result, std::memory_order_release);
+        return result;
+    }
+
+    alignas(64) std::atomic<std::int64_t> m_top;
+    alignas(64) std::atomic<std::int64_t> m_bottom;
+    alignas(64) std::atomic<Buffer*> m_buffer;
+
+    /// All the buffers allocated so far (owner thread only). The last one is the current buffer.
+    std::vector<std::unique_ptr<Buffer> > m_buffers;
+};
+
+} // namespace sofa::simulation
@@ -22,18 +22,31 @@
 #include <sofa/simulation/WorkerThread.h>
 #include <sofa/simulation/DefaultTaskScheduler.h>
 
+#include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <limits>
 #include <mutex>
 
+#include <sofa/helper/logging/Messaging.h>
+
 #ifdef WIN32
 #include <processthreadsapi.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
 #endif
 
 namespace sofa::simulation
 {
 
 WorkerThread::WorkerThread(DefaultTaskScheduler *const &taskScheduler, const int index, const std::string &name)
-        : m_name(name + std::to_string(index)), m_type(0), m_tasks(), m_taskScheduler(taskScheduler)
+        : m_name(name + std::to_string(index)), m_index(index), m_type(0), m_tasks(Initial_TasksPerThread), m_taskScheduler(taskScheduler)
 {
     assert(taskScheduler);
     m_finished.store(false, std::memory_order_relaxed);
@@ -71,15 +84,107 @@ std::thread *WorkerThread::create_and_attach(DefaultTaskScheduler *const &taskSc
     return &m_stdThread;
 }
 
-void WorkerThread::run(void)
+unsigned int WorkerThreadSettings::getMaxNbCpus()
 {
+#ifdef WIN32
+    return static_cast<unsigned int>(sizeof(DWORD_PTR) * 8);
+#elif defined(__linux__)
+    return CPU_SETSIZE;
+#else
+    return std::numeric_limits<unsigned int>::max();
+#endif
+}
+
+void WorkerThread::applyThreadSettings()
+{
+    const WorkerThreadSettings& settings = m_taskScheduler->getWorkerThreadSettings();
+
+    // an index out of the affinity mask would be an out-of-bounds write
+    std::vector<unsigned int> cpus;
+    std::copy_if(settings.cpuAffinity.begin(), settings.cpuAffinity.end(), std::back_inserter(cpus),
+                 [](const unsigned int cpu) { return cpu < WorkerThreadSettings::getMaxNbCpus(); });
+    msg_warning_when(cpus.size() != settings.cpuAffinity.size(), "WorkerThread")
+        << "The CPU indices greater than or equal to " << WorkerThreadSettings::getMaxNbCpus()
+        << " are ignored in the affinity of the thread " << m_name;
+    const auto pinnedCpu = [&]() { return cpus[static_cast<std::size_t>(m_index - 1) % cpus.size()]; };
+    const int priority = std::clamp(settings.priority, -2, 2);
+
 #ifdef WIN32
     const std::wstring widestr = std::wstring(m_name.begin(), m_name.end());
     HRESULT r = SetThreadDescription(
         GetCurrentThread(),
         widestr.c_str()
         );
+    SOFA_UNUSED(r);
+
+    if (!cpus.empty())
+    {
+        DWORD_PTR mask = 0;
+        if (settings.pinEachThread)
+        {
+            mask = DWORD_PTR(1) << pinnedCpu();
+        }
+        else
+        {
+            for (const auto cpu : cpus)
+            {
+                mask |= DWORD_PTR(1) << cpu;
+            }
+        }
+        if (SetThreadAffinityMask(GetCurrentThread(), mask) == 0)
+        {
+            msg_warning("WorkerThread") << "Cannot set the CPU affinity of the thread " << m_name;
+        }
+    }
+
+    if (priority != 0)
+    {
+        // THREAD_PRIORITY_LOWEST (-2) to THREAD_PRIORITY_HIGHEST (2)
+        SetThreadPriority(GetCurrentThread(), priority);
+    }
+#elif defined(__linux__)
+    pthread_setname_np(pthread_self(), m_name.substr(0, 15).c_str());
+
+    if (!cpus.empty())
+    {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        if (settings.pinEachThread)
+        {
+            CPU_SET(pinnedCpu(), &cpuSet);
+        }
+        else
+        {
+            for (const auto cpu : cpus)
+            {
+                CPU_SET(cpu, &cpuSet);
+            }
+        }
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) != 0)
+        {
+            msg_warning("WorkerThread") << "Cannot set the CPU affinity of the thread " << m_name;
+        }
+    }
+
+    if (priority != 0)
+    {
+        // on Linux, the nice value is per thread
+        const auto tid = static_cast<id_t>(syscall(SYS_gettid));
+        if (setpriority(PRIO_PROCESS, tid, getpriority(PRIO_PROCESS, tid) - 5 * priority) != 0)
+        {
+            msg_warning("WorkerThread") << "Cannot change the priority of the thread " << m_name;
+        }
+    }
+#elif defined(__APPLE__)
+    pthread_setname_np(m_name.c_str());
+    msg_warning_when(!cpus.empty(), "WorkerThread") << "The CPU affinity of the threads is not supported on this platform";
+    msg_warning_when(priority != 0, "WorkerThread") << "The priority of the threads is not supported on this platform";
 #endif
+}
+
+void WorkerThread::run(void)
+{
+    applyThreadSettings();
 
     //workerThreadIndex = this;
     //TaskSchedulerDefault::_threads[std::this_thread::get_id()] = this;
@@ -111,6 +216,16 @@ const std::thread::id WorkerThread::getId() const
 
 void WorkerThread::Idle()
 {
+    // spin a while before sleeping: the next tasks may come soon
+    for (unsigned int i = 0; i < m_taskScheduler->getWorkerThreadSettings().idleSpinCount; ++i)
+    {
+        if (!m_taskScheduler->m_workerThreadsIdle || m_taskScheduler->isClosing())
+        {
+            return;
+        }
+        std::this_thread::yield();
+    }
+
     std::unique_lock lock(m_taskScheduler->m_wakeUpMutex);
     m_taskScheduler->m_wakeUpEvent.wait(lock,
         [&] { return !m_taskScheduler->m_workerThreadsIdle; });
@@ -183,11 +298,12 @@ void WorkerThread::workUntilDone(Task::Status *status)
 
 bool WorkerThread::popTask(Task **task)
 {
-    simulation::ScopedLock lock(m_taskMutex);
-    if (!m_tasks.empty())
+    if (popAffinityTask(task))
+    {
+        return true;
+    }
+    if (m_tasks.pop(*task))
     {
-        *task = m_tasks.back();
-        m_tasks.pop_back();
         return true;
     }
     *task = nullptr;
@@ -203,11 +319,17 @@ bool WorkerThread::pushTask(Task *task)
         return false;
     }
 
+    // the status must be busy before the task becomes visible to the other threads
+    const int taskId = task->getStatus()->setBusy(true);
+    task->m_id = taskId;
+
+    if (WorkerThread* scheduledThread = m_taskScheduler->getScheduledWorkerThread(task))
     {
-        simulation::ScopedLock lock(m_taskMutex);
-        int taskId = task->getStatus()->setBusy(true);
-        task->m_id = taskId;
-        m_tasks.push_back(task);
+        scheduledThread->pushAffinityTask(task);
+    }
+    else
+    {
+        m_tasks.push(task);
     }
 
 
@@ -220,6 +342,31 @@ bool WorkerThread::pushTask(Task *task)
     return true;
 }
 
+void WorkerThread::pushAffinityTask(Task *task)
+{
+    simulation::ScopedLock lock(m_affinityTasksMutex);
+    m_affinityTasks.push_back(task);
+    m_nbAffinityTasks.store(m_affinityTasks.size(), std::memory_order_release);
+}
+
+bool WorkerThread::popAffinityTask(Task **task)
+{
+    if (m_nbAffinityTasks.load(std::memory_order_acquire) == 0)
+    {
+        return false;
+    }
+
+    simulation::ScopedLock lock(m_affinityTasksMutex);
+    if (!m_affinityTasks.empty())
+    {
+        *task = m_affinityTasks.front();
+        m_affinityTasks.pop_front();
+        m_nbAffinityTasks.store(m_affinityTasks.size(), std::memory_order_release);
+        return true;
+    }
+    return false;
+}
+
 bool WorkerThread::addTask(Task *task)
 {
     if (pushTask(task))
@@ -244,14 +391,9 @@ bool WorkerThread::stealTask(Task **task)
         }
 
         WorkerThread *otherThread = it.second;
+        if (otherThread->m_tasks.steal(*task))
         {
-            simulation::ScopedLock lock(otherThread->m_taskMutex);
-            if (!otherThread->m_tasks.empty())
-            {
-                *task = otherThread->m_tasks.front();
-                otherThread->m_tasks.pop_front();
-                return true;
-            }
+            return true;
         }
 
     }
@@ -25,8 +25,10 @@
 
 #include <sofa/simulation/Task.h>
 #include <sofa/simulation/Locks.h>
+#include <sofa/simulation/WorkStealingDeque.h>
 
 #include <thread>
+#include <atomic>
 #include <deque>
 #include <string>
 
@@ -57,7 +59,7 @@ public:
 
     const std::thread::id getId() const;
 
-    const std::deque<Task*>* getTasksQueue() { return &m_tasks; }
+    const WorkStealingDeque<Task*>* getTasksQueue() { return &m_tasks; }
 
     std::uint64_t getTaskCount() { return m_tasks.size(); }
 
@@ -69,12 +71,18 @@ private:
 
     void runTask(Task* task);
 
-    // queue task if there is space (or do nothing)
+    // queue task (or do nothing if the scheduler is single threaded)
     bool pushTask(Task* pTask);
 
     // pop task from queue
     bool popTask(Task** ppTask);
 
+    // queue a task which must be run by this thread (can be called from any thread)
+    void pushAffinityTask(Task* pTask);
+
+    // pop a task which must be run by this thread
+    bool popAffinityTask(Task** ppTask);
+
     // steal and queue some task from another thread
     bool stealTask(Task** task);
 
@@ -86,20 +94,32 @@ private:
     //void	ThreadProc(void);
     void	Idle(void);
 
+    // apply the WorkerThreadSettings of the scheduler (name, affinity, priority) to the calling thread
+    void applyThreadSettings();
+
     bool isFinished() const;
 
     enum
     {
-        Max_TasksPerThread = 256
+        Initial_TasksPerThread = 256
     };
 
     const std::string m_name;
 
+    const int m_index;
+
     const int m_type;
 
-    simulation::SpinLock m_taskMutex;
+    // pushed and popped by this thread only, stolen by the other threads
+    WorkStealingDeque<Task*> m_tasks;
+
+    // tasks scheduled on this thread: pushed by any thread, never stolen
+    simulation::SpinLock m_affinityTasksMutex;
+
+    std::deque<Task*> m_affinityTasks;
 
-    std::deque<Task*> m_tasks;
+    // size of m_affinityTasks, read without the lock so that popping a task does not lock when there are none
+    std::atomic<std::size_t> m_nbAffinityTasks { 0 };
 
     std::thread  m_stdThread;
 
@@ -46,6 +46,7 @@ namespace sofa::simulation
     class LocalStorage;
     class MutationListener;
     class Visitor;
+    class VisitorScheduler;
 
     class DefaultVisualManagerLoop;
 }
@@ -0,0 +1,110 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <sofa/core/objectmodel/BaseObject.h>
+#include <sofa/core/ExecParams.h>
+#include <sofa/simulation/MemoryFootprintVisitor.h>
+#include <sofa/simulation/Node.h>
+#include <sofa/simulation/graph/DAGSimulation.h>
+
+namespace sofa
+{
+
+namespace
+{
+class FootprintObject : public core::objectmodel::BaseObject
+{
+public:
+    SOFA_CLASS(FootprintObject, core::objectmodel::BaseObject);
+
+    std::size_t getMemoryFootprint() const override { return footprint; }
+
+    std::size_t footprint { 0 };
+};
+
+FootprintObject::SPtr addFootprintObject(const simulation::Node::SPtr& node, std::size_t footprint)
+{
+    auto object = core::objectmodel::New<FootprintObject>();
+    object->footprint = footprint;
+    node->addObject(object);
+    return object;
+}
+}
+
+TEST(MemoryFootprintVisitor, aggregatePerNode)
+{
+    simulation::Simulation* simulation = sofa::simulation::graph::getSimulation();
+    ASSERT_NE(simulation, nullptr);
+
+    const simulation::Node::SPtr root = simulation->createNewGraph("root");
+    const simulation::Node::SPtr child1 = root->createChild("child1");
+    const simulation::Node::SPtr child2 = root->createChild("child2");
+    const simulation::Node::SPtr grandChild = child1->createChild("grandChild");
+
+    addFootprintObject(root, 1);
+    addFootprintObject(child1, 10);
+    addFootprintObject(child1, 20);
+    addFootprintObject(child2, 100);
+    addFootprintObject(grandChild, 1000);
+
+    simulation::MemoryFootprintVisitor visitor(core::execparams::defaultInstance());
+    root->execute(visitor);
+
+    EXPECT_EQ(visitor.getTotalFootprint(), 1131u);
+    EXPECT_EQ(visitor.getNodeFootprint(root.get()), 1131u);
+    EXPECT_EQ(visitor.getNodeFootprint(child1.get()), 1030u);
+    EXPECT_EQ(visitor.getNodeFootprint(child2.get()), 100u);
+    EXPECT_EQ(visitor.getNodeFootprint(grandChild.get()), 1000u);
+    EXPECT_EQ(visitor.getNodeFootprints().size(), 4u);
+
+    simulation->unload(root);
+}
+
+TEST(MemoryFootprintVisitor, sharedNodeCountedOnce)
+{
+    simulation::Simulation* simulation = sofa::simulation::graph::getSimulation();
+    ASSERT_NE(simulation, nullptr);
+
+    const simulation::Node::SPtr root = simulation->createNewGraph("root");
+    const simulation::Node::SPtr child1 = root->createChild("child1");
+    const simulation::Node::SPtr child2 = root->createChild("child2");
+    const simulation::Node::SPtr shared = child1->createChild("shared");
+    child2->addChild(shared);
+
+    addFootprintObject(root, 1);
+    addFootprintObject(child1, 10);
+    addFootprintObject(child2, 100);
+    addFootprintObject(shared, 1000);
+
+    simulation::MemoryFootprintVisitor visitor(core::execparams::defaultInstance());
+    root->execute(visitor);
+
+    EXPECT_EQ(visitor.getTotalFootprint(), 1111u);
+    EXPECT_EQ(visitor.getNodeFootprint(root.get()), 1111u);
+    EXPECT_EQ(visitor.getNodeFootprint(child1.get()), 1010u);
+    EXPECT_EQ(visitor.getNodeFootprint(child2.get()), 1100u);
+    EXPECT_EQ(visitor.getNodeFootprint(shared.get()), 1000u);
+
+    simulation->unload(root);
+}
+
+}
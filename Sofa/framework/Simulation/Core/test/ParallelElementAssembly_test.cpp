@@ -0,0 +1,151 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/ParallelElementAssembly.h>
+
+namespace sofa
+{
+
+namespace
+{
+/// Each "edge" element i adds 1 to node i and node i+1
+void expectEdgeAccumulation(simulation::TaskScheduler* scheduler)
+{
+    constexpr std::size_t nbNodes = 5000;
+    sofa::type::vector<double> output(nbNodes, 1.0);
+
+    simulation::ParallelElementAccumulator<sofa::type::vector<double> > accumulator;
+    accumulator.elementGrainSize = 16;
+    accumulator.mergeGrainSize = 100;
+    accumulator.accumulate(scheduler, nbNodes - 1, output,
+        [](const std::size_t element, sofa::type::vector<double>& out)
+        {
+            out[element] += 1.0;
+            out[element + 1] += 1.0;
+        });
+
+    EXPECT_EQ(output.front(), 2.0);
+    EXPECT_EQ(output.back(), 2.0);
+    for (std::size_t i = 1; i < nbNodes - 1; ++i)
+    {
+        ASSERT_EQ(output[i], 3.0) << "node " << i;
+    }
+}
+}
+
+TEST(ParallelElementAccumulator, sequential)
+{
+    expectEdgeAccumulation(nullptr);
+}
+
+TEST(ParallelElementAccumulator, parallel)
+{
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    scheduler->init(4);
+    expectEdgeAccumulation(scheduler);
+
+    // the buffers are reused from a call to the next one
+    expectEdgeAccumulation(scheduler);
+}
+
+TEST(ParallelElementAccumulator, emptyOutput)
+{
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    scheduler->init(4);
+
+    sofa::type::vector<double> output;
+    simulation::ParallelElementAccumulator<sofa::type::vector<double> > accumulator;
+    std::size_t nbCalls = 0;
+    accumulator.accumulate(scheduler, 0, output,
+        [&nbCalls](std::size_t, sofa::type::vector<double>&) { ++nbCalls; });
+    EXPECT_EQ(nbCalls, 0u);
+}
+
+// in deterministic mode, the result does not depend on the number of threads, nor on the use of a
+// task scheduler
+TEST(ParallelElementAccumulator, deterministic)
+{
+    simulation::TaskScheduler::setDeterministic(true);
+
+    constexpr std::size_t nbNodes = 5000;
+    const auto accumulate = [](simulation::TaskScheduler* scheduler)
+    {
+        sofa::type::vector<double> output(nbNodes, 1.0);
+        simulation::ParallelElementAccumulator<sofa::type::vector<double> > accumulator;
+        accumulator.elementGrainSize = 16;
+        accumulator.mergeGrainSize = 100;
+        // each node receives contributions from all the elements, of very different magnitudes
+        accumulator.accumulate(scheduler, 1000, output,
+            [](const std::size_t element, sofa::type::vector<double>& out)
+            {
+                const double value = 1. / static_cast<double>(element + 1) * ((element % 2) ? -1e8 : 1.);
+                for (std::size_t i = 0; i < out.size(); i += 7)
+                {
+                    out[i] += value;
+                }
+            });
+        return output;
+    };
+
+    const auto reference = accumulate(nullptr);
+
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    for (const unsigned int nbThreads : {1u, 2u, 4u})
+    {
+        scheduler->init(nbThreads);
+        EXPECT_EQ(accumulate(scheduler), reference) << nbThreads << " threads";
+    }
+
+    simulation::TaskScheduler::setDeterministic(false);
+}
+
+TEST(ParallelElementAccumulator, coloredElements)
+{
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    scheduler->init(4);
+
+    // edges of a chain: even edges, then odd edges do not share any node
+    constexpr std::size_t nbNodes = 1001;
+    sofa::type::vector<sofa::type::vector<std::size_t> > colors(2);
+    for (std::size_t e = 0; e < nbNodes - 1; ++e)
+    {
+        colors[e % 2].push_back(e);
+    }
+
+    sofa::type::vector<int> output(nbNodes, 0);
+    simulation::forEachColoredElement(scheduler, colors,
+        [&output](const std::size_t e)
+        {
+            output[e] += 1;
+            output[e + 1] += 1;
+        }, 8);
+
+    EXPECT_EQ(output.front(), 1);
+    EXPECT_EQ(output.back(), 1);
+    for (std::size_t i = 1; i < nbNodes - 1; ++i)
+    {
+        ASSERT_EQ(output[i], 2);
+    }
+}
+
+} // namespace sofa
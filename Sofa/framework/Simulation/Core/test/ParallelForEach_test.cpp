@@ -25,7 +25,10 @@
 #include <sofa/simulation/ParallelForEach.h>
 #include <sofa/testing/TestMessageHandler.h>
 
+#include <atomic>
 #include <numeric>
+#include <set>
+#include <thread>
 
 
 namespace sofa
@@ -248,4 +251,85 @@ TEST(ParallelForEachRange, integers)
     }
 }
 
+TEST(ParallelForEach, makeRangesForLoopGrainSize)
+{
+    std::vector<int> integers = makeTestData();
+
+    // the grain size limits the number of ranges
+    auto ranges = simulation::makeRangesForLoop(integers.begin(), integers.end(), 8u, 256);
+    EXPECT_EQ(ranges.size(), 4);
+
+    for (const auto& r : ranges)
+    {
+        EXPECT_EQ(std::distance(r.start, r.end), 256);
+    }
+
+    // the grain size is larger than the container
+    ranges = simulation::makeRangesForLoop(integers.begin(), integers.end(), 8u, 4096);
+    ASSERT_EQ(ranges.size(), 1);
+    EXPECT_EQ(std::distance(ranges.front().start, ranges.front().end), integers.size());
+}
+
+TEST(ParallelForEachRange, autoPartitioner)
+{
+    std::vector<int> integers = makeTestData(10000);
+
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    scheduler->init(4);
+
+    std::atomic<std::size_t> nbRanges { 0 };
+    const simulation::Partitioner partitioner { simulation::Partitioner::Type::AUTO, 16 };
+    simulation::parallelForEachRange(*scheduler, integers.begin(), integers.end(),
+        [&nbRanges](const auto& range)
+        {
+            EXPECT_GE(std::distance(range.start, range.end), 16);
+            ++nbRanges;
+            for (auto it = range.start; it != range.end; ++it)
+            {
+                ++(*it);
+            }
+        }, partitioner);
+
+    EXPECT_GT(nbRanges.load(), 1);
+    for (std::size_t i = 0; i < integers.size(); ++i)
+    {
+        EXPECT_EQ(integers[i], i + 1);
+    }
+}
+
+TEST(ParallelForEachRange, affinityPartitioner)
+{
+    constexpr std::size_t nbElements = 1000;
+    constexpr unsigned int nbThreads = 4;
+
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    scheduler->init(nbThreads);
+
+    const simulation::Partitioner partitioner { simulation::Partitioner::Type::AFFINITY };
+
+    // thread which processed each element
+    std::vector<std::thread::id> threads(nbElements);
+    simulation::parallelForEachRange(*scheduler, static_cast<std::size_t>(0), nbElements,
+        [&threads](const auto& range)
+        {
+            for (auto i = range.start; i != range.end; ++i)
+            {
+                threads[i] = std::this_thread::get_id();
+            }
+        }, partitioner);
+
+    const std::set<std::thread::id> distinctThreads(threads.begin(), threads.end());
+    EXPECT_EQ(distinctThreads.size(), nbThreads);
+
+    // the same elements are processed by the same threads from a call to the next one
+    for (unsigned int step = 0; step < 10; ++step)
+    {
+        simulation::parallelForEach(*scheduler, static_cast<std::size_t>(0), nbElements,
+            [&threads](const std::size_t i)
+            {
+                EXPECT_EQ(threads[i], std::this_thread::get_id());
+            }, partitioner);
+    }
+}
+
 }
@@ -0,0 +1,174 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <sofa/simulation/DefaultTaskScheduler.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/ParallelReduce.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace sofa
+{
+
+TEST(ParallelReduce, sumIntegers)
+{
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    scheduler->init(4);
+
+    constexpr std::size_t N = 10000;
+    const auto sum = simulation::parallelReduce(*scheduler, static_cast<std::size_t>(0), N, std::size_t(0),
+        [](const std::size_t i) { return i; },
+        [](const std::size_t a, const std::size_t b) { return a + b; });
+
+    EXPECT_EQ(sum, N * (N - 1) / 2);
+}
+
+TEST(ParallelReduce, minMaxIterators)
+{
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    scheduler->init(4);
+
+    std::vector<int> integers(1000);
+    std::iota(integers.begin(), integers.end(), -500);
+    std::reverse(integers.begin(), integers.end());
+
+    using MinMax = std::pair<int, int>;
+    const MinMax identity { std::numeric_limits<int>::max(), std::numeric_limits<int>::lowest() };
+    const auto minMax = simulation::parallelReduce(*scheduler, integers.begin(), integers.end(), identity,
+        [](const int i) { return MinMax{i, i}; },
+        [](const MinMax& a, const MinMax& b) { return MinMax{std::min(a.first, b.first), std::max(a.second, b.second)}; });
+
+    EXPECT_EQ(minMax.first, -500);
+    EXPECT_EQ(minMax.second, 499);
+}
+
+TEST(ParallelReduce, emptyRange)
+{
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    scheduler->init(4);
+
+    std::vector<double> values;
+    const auto sum = simulation::parallelReduce(*scheduler, values.begin(), values.end(), 1.5,
+        [](const double v) { return v; },
+        [](const double a, const double b) { return a + b; });
+
+    EXPECT_EQ(sum, 1.5);
+}
+
+// the partial results are combined in a fixed order: the result is the same from a run to the next
+TEST(ParallelReduce, reproducible)
+{
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    scheduler->init(4);
+
+    std::vector<double> values(100000);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = 1. / static_cast<double>(i + 1) * ((i % 2) ? -1e8 : 1.);
+    }
+
+    const auto computeSum = [&values, scheduler]()
+    {
+        return simulation::parallelReduce(*scheduler, values.begin(), values.end(), 0.,
+            [](const double v) { return v; },
+            [](const double a, const double b) { return a + b; });
+    };
+
+    const double reference = computeSum();
+    for (unsigned int i = 0; i < 20; ++i)
+    {
+        EXPECT_EQ(computeSum(), reference);
+    }
+}
+
+TEST(ParallelReduce, executionPolicy)
+{
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    scheduler->init(4);
+
+    for (const auto execution : {simulation::ForEachExecutionPolicy::SEQUENTIAL, simulation::ForEachExecutionPolicy::PARALLEL})
+    {
+        const auto product = simulation::reduce(execution, *scheduler, 1, 11, 1ll,
+            [](const int i) { return static_cast<long long>(i); },
+            [](const long long a, const long long b) { return a * b; });
+        EXPECT_EQ(product, 3628800ll);
+    }
+}
+
+// in deterministic mode, the result does not depend on the number of threads, and is the same
+// sequentially
+TEST(ParallelReduce, deterministic)
+{
+    simulation::TaskScheduler::setDeterministic(true);
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+
+    std::vector<double> values(100000);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = 1. / static_cast<double>(i + 1) * ((i % 2) ? -1e8 : 1.);
+    }
+    const auto identity = [](const double v) { return v; };
+    const auto sum = [](const double a, const double b) { return a + b; };
+
+    const double reference = simulation::deterministicReduce(values.begin(), values.end(), 0., identity, sum, 16);
+
+    for (const unsigned int nbThreads : {1u, 2u, 3u, 4u})
+    {
+        scheduler->init(nbThreads);
+        EXPECT_EQ(simulation::parallelReduce(*scheduler, values.begin(), values.end(), 0., identity, sum, 16), reference)
+            << nbThreads << " threads";
+    }
+
+    EXPECT_EQ(simulation::reduce(simulation::ForEachExecutionPolicy::SEQUENTIAL, *scheduler,
+        values.begin(), values.end(), 0., identity, sum, 16), reference);
+
+    simulation::TaskScheduler::setDeterministic(false);
+}
+
+TEST(ParallelReduce, mergeInOrder)
+{
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    scheduler->init(4);
+
+    constexpr std::size_t N = 1000;
+    std::vector<std::size_t> merged;
+    simulation::parallelForEachRangeWithMerge(*scheduler, static_cast<std::size_t>(0), N,
+        [](const simulation::Range<std::size_t>& r)
+        {
+            std::vector<std::size_t> indices(r.end - r.start);
+            std::iota(indices.begin(), indices.end(), r.start);
+            return indices;
+        },
+        [&merged](const simulation::Range<std::size_t>& r, const std::vector<std::size_t>& indices)
+        {
+            EXPECT_EQ(indices.size(), r.end - r.start);
+            merged.insert(merged.end(), indices.begin(), indices.end());
+        }, 10);
+
+    std::vector<std::size_t> expected(N);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(merged, expected);
+}
+
+} // namespace sofa
@@ -0,0 +1,115 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/ParallelSparseMatrixProduct.h>
+#include <sofa/linearalgebra/SparseMatrixProduct[EigenSparseMatrix].h>
+#include <sofa/helper/RandomGenerator.h>
+
+namespace sofa
+{
+
+namespace
+{
+
+template<int Options>
+Eigen::SparseMatrix<double, Options> generateMatrix(Eigen::Index nbRows, Eigen::Index nbCols, Eigen::Index nbNonZeros, long seed)
+{
+    sofa::helper::RandomGenerator randomGenerator;
+    randomGenerator.initSeed(seed);
+
+    std::vector<Eigen::Triplet<double> > triplets;
+    for (Eigen::Index k = 0; k < nbNonZeros; ++k)
+    {
+        triplets.emplace_back(randomGenerator.random<Eigen::Index>(0, nbRows),
+                              randomGenerator.random<Eigen::Index>(0, nbCols),
+                              randomGenerator.random<double>(-1, 1));
+    }
+
+    Eigen::SparseMatrix<double, Options> matrix(nbRows, nbCols);
+    matrix.setFromTriplets(triplets.begin(), triplets.end());
+    return matrix;
+}
+
+template<class Matrix>
+void expectEqual(const Matrix& a, const Matrix& b)
+{
+    ASSERT_EQ(a.nonZeros(), b.nonZeros());
+    for (Eigen::Index k = 0; k < a.nonZeros(); ++k)
+    {
+        ASSERT_EQ(a.innerIndexPtr()[k], b.innerIndexPtr()[k]);
+        ASSERT_NEAR(a.valuePtr()[k], b.valuePtr()[k], 1e-12);
+    }
+}
+
+template<int Options>
+void checkParallelProduct()
+{
+    using Matrix = Eigen::SparseMatrix<double, Options>;
+
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+
+    Matrix A = generateMatrix<Options>(300, 200, 1500, 1);
+    const Matrix B = generateMatrix<Options>(200, 250, 1500, 2);
+
+    linearalgebra::SparseMatrixProduct<Matrix> product(&A, const_cast<Matrix*>(&B));
+
+    Matrix first;
+    for (const unsigned int nbThreads : {1u, 2u, 4u})
+    {
+        scheduler->init(nbThreads);
+        simulation::parallelComputeProduct(*scheduler, product, false, 16);
+
+        const Matrix reference = A * B;
+        expectEqual(product.getProductResult(), reference);
+
+        // the result does not depend on the number of threads
+        if (first.nonZeros() == 0)
+        {
+            first = product.getProductResult();
+        }
+        ASSERT_EQ(first.nonZeros(), product.getProductResult().nonZeros());
+        for (Eigen::Index k = 0; k < first.nonZeros(); ++k)
+        {
+            ASSERT_EQ(first.valuePtr()[k], product.getProductResult().valuePtr()[k]);
+        }
+    }
+
+    // new pattern: the intersection is recomputed automatically
+    A = generateMatrix<Options>(300, 200, 1000, 3);
+    simulation::parallelComputeProduct(*scheduler, product);
+    expectEqual(product.getProductResult(), Matrix(A * B));
+}
+
+}
+
+TEST(ParallelSparseMatrixProduct, columnMajor)
+{
+    checkParallelProduct<Eigen::ColMajor>();
+}
+
+TEST(ParallelSparseMatrixProduct, rowMajor)
+{
+    checkParallelProduct<Eigen::RowMajor>();
+}
+
+} // namespace sofa
@@ -0,0 +1,170 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/ParallelSparseMatrixVectorProduct.h>
+#include <sofa/linearalgebra/FullVector.h>
+#include <sofa/helper/RandomGenerator.h>
+
+namespace sofa
+{
+
+namespace
+{
+
+/// Random square matrix, with a band of blocks around the diagonal and a few blocks elsewhere
+template<class TMatrix>
+void generateMatrix(TMatrix& matrix, const sofa::Index nbBlocks)
+{
+    sofa::helper::RandomGenerator randomGenerator;
+    randomGenerator.initSeed(42);
+
+    constexpr auto NL = TMatrix::NL;
+    matrix.resize(nbBlocks * NL, nbBlocks * NL);
+    for (sofa::Index i = 0; i < nbBlocks; ++i)
+    {
+        for (sofa::Index j = (i > 2 ? i - 2 : 0); j < std::min(nbBlocks, i + 3); ++j)
+        {
+            for (sofa::Index k = 0; k < NL * NL; ++k)
+            {
+                matrix.add(i * NL + k / NL, j * NL + k % NL, randomGenerator.random<double>(-1, 1));
+            }
+        }
+        const auto j = randomGenerator.random<sofa::Index>(0, nbBlocks);
+        matrix.add(i * NL, j * NL, randomGenerator.random<double>(-1, 1));
+    }
+    matrix.compress();
+}
+
+template<class TMatrix>
+void checkProducts(simulation::TaskScheduler& scheduler)
+{
+    using Vector = linearalgebra::FullVector<double>;
+    TMatrix matrix;
+    generateMatrix(matrix, 1000);
+
+    Vector x(matrix.colSize());
+    sofa::helper::RandomGenerator randomGenerator;
+    randomGenerator.initSeed(7);
+    for (Vector::Index i = 0; i < x.size(); ++i)
+    {
+        x[i] = randomGenerator.random<double>(-1, 1);
+    }
+
+    Vector reference;
+    matrix.mul(reference, x);
+
+    Vector referenceTranspose(matrix.colSize());
+    matrix.addMultTranspose(referenceTranspose, x);
+
+    typename TMatrix::TransposedPattern transposedPattern;
+    matrix.buildTransposedPattern(transposedPattern);
+
+    Vector firstTranspose;
+    for (const unsigned int nbThreads : {1u, 2u, 3u, 4u})
+    {
+        scheduler.init(nbThreads);
+
+        // the rows are computed as in the sequential product
+        Vector y;
+        simulation::parallelMul(scheduler, matrix, y, x, 16);
+        ASSERT_EQ(y.size(), reference.size());
+        for (Vector::Index i = 0; i < y.size(); ++i)
+        {
+            ASSERT_EQ(y[i], reference[i]) << "row " << i << ", " << nbThreads << " threads";
+        }
+
+        Vector yt(matrix.colSize());
+        simulation::parallelAddMulTranspose(scheduler, matrix, transposedPattern, yt, x, 16);
+        ASSERT_EQ(yt.size(), referenceTranspose.size());
+        for (Vector::Index i = 0; i < yt.size(); ++i)
+        {
+            ASSERT_NEAR(yt[i], referenceTranspose[i], 1e-12) << "column " << i << ", " << nbThreads << " threads";
+        }
+
+        // the transposed product does not depend on the number of threads
+        if (firstTranspose.size() == 0)
+        {
+            firstTranspose = yt;
+        }
+        for (Vector::Index i = 0; i < yt.size(); ++i)
+        {
+            ASSERT_EQ(yt[i], firstTranspose[i]) << "column " << i << ", " << nbThreads << " threads";
+        }
+    }
+}
+
+}
+
+TEST(ParallelSparseMatrixVectorProduct, scalar)
+{
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    checkProducts<linearalgebra::CompressedRowSparseMatrix<double> >(*scheduler);
+}
+
+TEST(ParallelSparseMatrixVectorProduct, mat3x3)
+{
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    checkProducts<linearalgebra::CompressedRowSparseMatrix<type::Mat<3, 3, double> > >(*scheduler);
+}
+
+TEST(ParallelSparseMatrixVectorProduct, emptyMatrix)
+{
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    scheduler->init(4);
+
+    linearalgebra::CompressedRowSparseMatrix<type::Mat<3, 3, double> > matrix(30, 30);
+    linearalgebra::FullVector<double> x(30), y, yt(30);
+    x = 1.;
+    yt = 0.;
+    simulation::parallelMul(*scheduler, matrix, y, x);
+    simulation::parallelAddMulTranspose(*scheduler, matrix, yt, x);
+    EXPECT_EQ(y.size(), 30);
+    for (sofa::Index i = 0; i < 30; ++i)
+    {
+        EXPECT_EQ(yt[i], 0.);
+    }
+}
+
+TEST(ParallelSparseMatrixVectorProduct, balancedRanges)
+{
+    // a first row with 10 blocks, followed by 10 rows with 1 block
+    sofa::type::vector<sofa::Index> rowBegin { 0 };
+    for (sofa::Index i = 10; i <= 20; ++i)
+    {
+        rowBegin.push_back(i);
+    }
+    const auto ranges = simulation::details::makeBalancedRanges(rowBegin, 11, 2, 1);
+
+    ASSERT_EQ(ranges.size(), 2u);
+    EXPECT_EQ(ranges[0].start, 0u);
+    EXPECT_EQ(ranges[0].end, 1u);
+    EXPECT_EQ(ranges[1].start, 1u);
+    EXPECT_EQ(ranges[1].end, 11u);
+
+    // the grain size prevents splitting
+    EXPECT_EQ(simulation::details::makeBalancedRanges(rowBegin, 11, 2, 100).size(), 1u);
+
+    EXPECT_TRUE(simulation::details::makeBalancedRanges(rowBegin, 0, 2, 1).empty());
+}
+
+} // namespace sofa
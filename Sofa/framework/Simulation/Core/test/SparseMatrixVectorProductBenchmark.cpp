@@ -0,0 +1,173 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/DefaultTaskScheduler.h>
+#include <sofa/simulation/ParallelSparseMatrixVectorProduct.h>
+#include <sofa/linearalgebra/FullVector.h>
+#include <sofa/helper/logging/Messaging.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+namespace sofa
+{
+
+/**
+ * Micro-benchmark of the sparse matrix-vector products of a CompressedRowSparseMatrix of 3x3
+ * blocks, with a pattern similar to the stiffness matrix of a 3D mesh (27 blocks per row). The
+ * sequential products (mul and addMultTranspose) are compared to the parallel ones, from 1 thread
+ * up to the number of hardware threads.
+ *
+ * The matrix is kept small so that the benchmark can run along with the other tests.
+ * Increase gridSize to get more stable figures.
+ */
+namespace
+{
+
+using Matrix = linearalgebra::CompressedRowSparseMatrix<type::Mat<3, 3, SReal> >;
+using Vector = linearalgebra::FullVector<SReal>;
+
+/// Matrix of a regular grid of gridSize^3 nodes, where each node interacts with its 26 neighbors
+void generateGridMatrix(Matrix& matrix, const sofa::Index gridSize)
+{
+    const auto index = [gridSize](sofa::Index i, sofa::Index j, sofa::Index k)
+    {
+        return (k * gridSize + j) * gridSize + i;
+    };
+
+    const sofa::Index nbNodes = gridSize * gridSize * gridSize;
+    matrix.resize(3 * nbNodes, 3 * nbNodes);
+
+    type::Mat<3, 3, SReal> block;
+    for (sofa::Index n = 0; n < 9; ++n)
+    {
+        block[n / 3][n % 3] = static_cast<SReal>(n + 1) / 10;
+    }
+
+    for (sofa::Index k = 0; k < gridSize; ++k)
+    for (sofa::Index j = 0; j < gridSize; ++j)
+    for (sofa::Index i = 0; i < gridSize; ++i)
+    {
+        for (sofa::Index dk = (k > 0 ? k - 1 : k); dk <= std::min(k + 1, gridSize - 1); ++dk)
+        for (sofa::Index dj = (j > 0 ? j - 1 : j); dj <= std::min(j + 1, gridSize - 1); ++dj)
+        for (sofa::Index di = (i > 0 ? i - 1 : i); di <= std::min(i + 1, gridSize - 1); ++di)
+        {
+            *matrix.wbloc(index(i, j, k), index(di, dj, dk), true) += block;
+        }
+    }
+    matrix.compress();
+}
+
+template<class Product>
+double bestTimeOf(const int nbRepetitions, const Product& product)
+{
+    double bestTime = std::numeric_limits<double>::max();
+    for (int r = 0; r < nbRepetitions; ++r)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        product();
+        const auto end = std::chrono::steady_clock::now();
+        bestTime = std::min(bestTime, std::chrono::duration<double>(end - start).count());
+    }
+    return bestTime;
+}
+
+}
+
+TEST(SparseMatrixVectorProductBenchmark, mat3x3)
+{
+    constexpr sofa::Index gridSize = 24;
+    constexpr int nbRepetitions = 3;
+
+    const unsigned int maxThreads = std::max(2u, std::thread::hardware_concurrency());
+
+    Matrix matrix;
+    generateGridMatrix(matrix, gridSize);
+
+    Vector x(matrix.colSize());
+    for (Vector::Index i = 0; i < x.size(); ++i)
+    {
+        x[i] = static_cast<SReal>(i % 7) - 3;
+    }
+
+    Vector reference, referenceTranspose(matrix.colSize());
+    const double serialTime = bestTimeOf(nbRepetitions, [&]() { matrix.mul(reference, x); });
+    const double serialTransposeTime = bestTimeOf(nbRepetitions, [&]()
+    {
+        referenceTranspose.clear();
+        matrix.addMultTranspose(referenceTranspose, x);
+    });
+
+    Matrix::TransposedPattern transposedPattern;
+    matrix.buildTransposedPattern(transposedPattern);
+
+    const auto scheduler = std::unique_ptr<simulation::TaskScheduler>(
+        simulation::MainTaskSchedulerFactory::instantiate(simulation::DefaultTaskScheduler::name()));
+
+    std::stringstream report;
+    report << matrix.rowBSize() << " block rows, " << matrix.getColsValue().size() << " blocks" << msgendl;
+    report << "threads | mul (ms) | speedup | mulTranspose (ms) | speedup" << msgendl;
+    report << "serial | " << 1000 * serialTime << " | 1 | " << 1000 * serialTransposeTime << " | 1" << msgendl;
+
+    // 1, 2, 4, ..., maxThreads
+    std::vector<unsigned int> threadCounts;
+    for (unsigned int nbThreads = 1; nbThreads < maxThreads; nbThreads *= 2)
+    {
+        threadCounts.push_back(nbThreads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    Vector y, yt(matrix.colSize());
+    for (const unsigned int nbThreads : threadCounts)
+    {
+        scheduler->init(nbThreads);
+
+        const double time = bestTimeOf(nbRepetitions, [&]()
+        {
+            simulation::parallelMul(*scheduler, matrix, y, x);
+        });
+        const double transposeTime = bestTimeOf(nbRepetitions, [&]()
+        {
+            yt.clear();
+            simulation::parallelAddMulTranspose(*scheduler, matrix, transposedPattern, yt, x);
+        });
+
+        for (Vector::Index i = 0; i < y.size(); ++i)
+        {
+            ASSERT_EQ(y[i], reference[i]);
+            ASSERT_NEAR(yt[i], referenceTranspose[i], 1e-8);
+        }
+
+        report << nbThreads << " | " << 1000 * time << " | " << serialTime / time << " | "
+               << 1000 * transposeTime << " | " << serialTransposeTime / transposeTime << msgendl;
+    }
+    scheduler->stop();
+
+    msg_info("SparseMatrixVectorProductBenchmark") << report.str();
+}
+
+} // namespace sofa
@@ -0,0 +1,152 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/TaskGraph.h>
+#include <sofa/simulation/TaskScheduler.h>
+#include <sofa/testing/TestMessageHandler.h>
+
+#include <atomic>
+#include <vector>
+
+namespace sofa
+{
+
+TEST(TaskGraph, topologicalOrder)
+{
+    simulation::TaskGraph graph;
+    const auto a = graph.addTask([]{}, "a");
+    const auto b = graph.addTask([]{}, "b");
+    const auto c = graph.addTask([]{}, "c");
+    graph.addDependency(c, a);
+    graph.addDependency(b, a);
+    graph.addDependency(c, b);
+
+    const auto order = graph.topologicalOrder();
+    ASSERT_EQ(order.size(), 3);
+    EXPECT_EQ(order[0], c);
+    EXPECT_EQ(order[1], b);
+    EXPECT_EQ(order[2], a);
+    EXPECT_TRUE(graph.isAcyclic());
+}
+
+TEST(TaskGraph, cycle)
+{
+    simulation::TaskGraph graph;
+    bool hasRun = false;
+    const auto a = graph.addTask([&hasRun]{ hasRun = true; });
+    const auto b = graph.addTask([&hasRun]{ hasRun = true; });
+    graph.addDependency(a, b);
+    graph.addDependency(b, a);
+
+    EXPECT_FALSE(graph.isAcyclic());
+
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    scheduler->init(4);
+    {
+        EXPECT_MSG_EMIT(Error);
+        EXPECT_FALSE(graph.run(*scheduler));
+    }
+    EXPECT_FALSE(hasRun);
+}
+
+// every task checks that its predecessors are finished
+TEST(TaskGraph, dependenciesAreRespected)
+{
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    scheduler->init(4);
+
+    // layers of tasks: each task of a layer depends on all the tasks of the previous layer
+    constexpr std::size_t nbLayers = 10;
+    constexpr std::size_t layerSize = 16;
+
+    std::vector<std::atomic<int> > finished(nbLayers * layerSize);
+    for (auto& f : finished)
+    {
+        f = 0;
+    }
+    std::atomic<int> nbErrors { 0 };
+
+    simulation::TaskGraph graph;
+    for (std::size_t layer = 0; layer < nbLayers; ++layer)
+    {
+        for (std::size_t i = 0; i < layerSize; ++i)
+        {
+            graph.addTask([&finished, &nbErrors, layer, i]()
+            {
+                if (layer > 0)
+                {
+                    for (std::size_t j = 0; j < layerSize; ++j)
+                    {
+                        if (finished[(layer - 1) * layerSize + j] != 1)
+                        {
+                            ++nbErrors;
+                        }
+                    }
+                }
+                ++finished[layer * layerSize + i];
+            });
+        }
+    }
+    for (std::size_t layer = 1; layer < nbLayers; ++layer)
+    {
+        for (std::size_t i = 0; i < layerSize; ++i)
+        {
+            for (std::size_t j = 0; j < layerSize; ++j)
+            {
+                graph.addDependency((layer - 1) * layerSize + j, layer * layerSize + i);
+            }
+        }
+    }
+
+    for (int run = 0; run < 3; ++run)
+    {
+        for (auto& f : finished)
+        {
+            f = 0;
+        }
+        EXPECT_TRUE(graph.run(*scheduler));
+
+        EXPECT_EQ(nbErrors, 0);
+        for (const auto& f : finished)
+        {
+            EXPECT_EQ(f, 1);
+        }
+    }
+}
+
+TEST(TaskGraph, singleThread)
+{
+    simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    scheduler->init(1);
+
+    std::vector<int> sequence;
+    simulation::TaskGraph graph;
+    const auto a = graph.addTask([&sequence]{ sequence.push_back(0); });
+    const auto b = graph.addTask([&sequence]{ sequence.push_back(1); });
+    graph.addDependency(b, a);
+
+    EXPECT_TRUE(graph.run(*scheduler));
+    EXPECT_EQ(sequence, std::vector<int>({1, 0}));
+}
+
+} // namespace sofa
@@ -0,0 +1,139 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/CpuTask.h>
+#include <sofa/simulation/DefaultTaskScheduler.h>
+#include <sofa/helper/logging/Messaging.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+namespace sofa
+{
+
+/**
+ * Micro-benchmark of the task scheduler: a flood of very small tasks is queued by the main thread
+ * and consumed by the worker threads through work stealing. It reports the number of tasks
+ * processed per second, from 1 thread up to the number of hardware threads.
+ *
+ * The number of tasks is kept small so that the benchmark can run along with the other tests.
+ * Increase nbTasks to get more stable figures.
+ */
+namespace
+{
+
+class SmallTask : public simulation::CpuTask
+{
+public:
+    SmallTask(simulation::CpuTask::Status* status, double* result)
+        : CpuTask(status), m_result(result)
+    {}
+
+    MemoryAlloc run() final
+    {
+        double sum = 0;
+        for (int i = 1; i <= 32; ++i)
+        {
+            sum += std::sqrt(static_cast<double>(i));
+        }
+        *m_result = sum;
+        return MemoryAlloc::Stack;
+    }
+
+private:
+    double* m_result;
+};
+
+double runSmallTasks(simulation::TaskScheduler* scheduler, const std::size_t nbTasks, std::vector<double>& results)
+{
+    simulation::CpuTask::Status status;
+
+    std::vector<SmallTask> tasks;
+    tasks.reserve(nbTasks);
+    for (std::size_t i = 0; i < nbTasks; ++i)
+    {
+        tasks.emplace_back(&status, &results[i]);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (auto& task : tasks)
+    {
+        scheduler->addTask(&task);
+    }
+    scheduler->workUntilDone(&status);
+    const auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+}
+
+TEST(TaskSchedulerBenchmark, smallTasksThroughput)
+{
+    constexpr std::size_t nbTasks = 1 << 16;
+    constexpr int nbRepetitions = 3;
+
+    const unsigned int maxThreads = std::max(2u, std::thread::hardware_concurrency());
+
+    const auto scheduler = std::unique_ptr<simulation::TaskScheduler>(
+        simulation::MainTaskSchedulerFactory::instantiate(simulation::DefaultTaskScheduler::name()));
+
+    std::stringstream report;
+    report << "threads | tasks/s" << msgendl;
+
+    // 1, 2, 4, ..., maxThreads
+    std::vector<unsigned int> threadCounts;
+    for (unsigned int nbThreads = 1; nbThreads < maxThreads; nbThreads *= 2)
+    {
+        threadCounts.push_back(nbThreads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    std::vector<double> results(nbTasks);
+    for (const unsigned int nbThreads : threadCounts)
+    {
+        scheduler->init(nbThreads);
+
+        double bestTime = std::numeric_limits<double>::max();
+        for (int r = 0; r < nbRepetitions; ++r)
+        {
+            std::fill(results.begin(), results.end(), 0.);
+            bestTime = std::min(bestTime, runSmallTasks(scheduler.get(), nbTasks, results));
+
+            // all the tasks must have been executed
+            EXPECT_EQ(std::count(results.begin(), results.end(), 0.), 0);
+        }
+
+        report << nbThreads << " | " << static_cast<double>(nbTasks) / bestTime << msgendl;
+    }
+    scheduler->stop();
+
+    msg_info("TaskSchedulerBenchmark") << report.str();
+}
+
+} // namespace sofa
@@ -0,0 +1,149 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/simulation/WorkStealingDeque.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace sofa
+{
+
+TEST(WorkStealingDeque, popIsLIFO)
+{
+    simulation::WorkStealingDeque<int> deque(4);
+    EXPECT_TRUE(deque.empty());
+
+    for (int i = 0; i < 3; ++i)
+    {
+        deque.push(i);
+    }
+    EXPECT_EQ(deque.size(), 3);
+
+    int item = -1;
+    for (int i = 2; i >= 0; --i)
+    {
+        ASSERT_TRUE(deque.pop(item));
+        EXPECT_EQ(item, i);
+    }
+    EXPECT_FALSE(deque.pop(item));
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDeque, stealIsFIFO)
+{
+    simulation::WorkStealingDeque<int> deque(4);
+    for (int i = 0; i < 3; ++i)
+    {
+        deque.push(i);
+    }
+
+    int item = -1;
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(deque.steal(item));
+        EXPECT_EQ(item, i);
+    }
+    EXPECT_FALSE(deque.steal(item));
+}
+
+TEST(WorkStealingDeque, unboundedGrowth)
+{
+    simulation::WorkStealingDeque<int> deque(2);
+    EXPECT_EQ(deque.capacity(), 2);
+
+    constexpr int nbItems = 10000;
+    for (int i = 0; i < nbItems; ++i)
+    {
+        deque.push(i);
+    }
+    EXPECT_EQ(deque.size(), nbItems);
+    EXPECT_GE(deque.capacity(), nbItems);
+
+    // mix steal and pop after the growth
+    int item = -1;
+    ASSERT_TRUE(deque.steal(item));
+    EXPECT_EQ(item, 0);
+    ASSERT_TRUE(deque.pop(item));
+    EXPECT_EQ(item, nbItems - 1);
+    EXPECT_EQ(deque.size(), nbItems - 2);
+}
+
+// The owner pushes and pops while several thieves steal concurrently:
+// every item must be consumed exactly once.
+TEST(WorkStealingDeque, concurrentStealing)
+{
+    constexpr int nbItems = 100000;
+    constexpr int nbThieves = 4;
+
+    simulation::WorkStealingDeque<int> deque(16);
+    std::vector<std::atomic<int> > consumed(nbItems);
+    for (auto& c : consumed)
+    {
+        c.store(0);
+    }
+
+    std::atomic<bool> done { false };
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < nbThieves; ++t)
+    {
+        thieves.emplace_back([&]()
+        {
+            int item;
+            while (!done.load())
+            {
+                if (deque.steal(item))
+                {
+                    consumed[item].fetch_add(1);
+                }
+            }
+        });
+    }
+
+    int item;
+    for (int i = 0; i < nbItems; ++i)
+    {
+        deque.push(i);
+        if (i % 3 == 0 && deque.pop(item))
+        {
+            consumed[item].fetch_add(1);
+        }
+    }
+    while (deque.pop(item))
+    {
+        consumed[item].fetch_add(1);
+    }
+
+    done.store(true);
+    for (auto& t : thieves)
+    {
+        t.join();
+    }
+
+    for (int i = 0; i < nbItems; ++i)
+    {
+        EXPECT_EQ(consumed[i].load(), 1) << "item " << i;
+    }
+}
+
+} // namespace sofa
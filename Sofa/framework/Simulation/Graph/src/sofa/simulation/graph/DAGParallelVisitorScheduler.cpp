@@ -0,0 +1,303 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/simulation/graph/DAGParallelVisitorScheduler.h>
+
+#include <sofa/simulation/BaseMechanicalVisitor.h>
+#include <sofa/simulation/CpuTask.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/Node.h>
+#include <sofa/simulation/TaskScheduler.h>
+#include <sofa/core/BaseMapping.h>
+#include <sofa/core/ObjectFactory.h>
+#include <sofa/core/behavior/BaseMechanicalState.h>
+#include <sofa/core/behavior/StateAccessor.h>
+#include <sofa/helper/cast.h>
+
+#include <numeric>
+
+namespace sofa::simulation::graph
+{
+
+DAGParallelVisitorScheduler::DAGParallelVisitorScheduler()
+    : ParallelVisitorScheduler(false)
+{
+    m_listener.scheduler = this;
+}
+
+DAGParallelVisitorScheduler::~DAGParallelVisitorScheduler()
+{
+    if (m_listenedRoot)
+    {
+        m_listenedRoot->removeListener(&m_listener);
+    }
+}
+
+void DAGParallelVisitorScheduler::init()
+{
+    auto* taskScheduler = MainTaskSchedulerFactory::createInRegistry();
+    if (taskScheduler->getThreadCount() < 1)
+    {
+        taskScheduler->init(0);
+        msg_info() << "Task scheduler initialized on " << taskScheduler->getThreadCount() << " threads";
+    }
+
+    if (!m_listenedRoot)
+    {
+        m_listenedRoot = down_cast<simulation::Node>(this->getContext()->getRootContext()->toBaseNode());
+        if (m_listenedRoot)
+        {
+            m_listenedRoot->addListener(&m_listener);
+        }
+    }
+    invalidateGroups();
+}
+
+void DAGParallelVisitorScheduler::cleanup()
+{
+    if (m_listenedRoot)
+    {
+        m_listenedRoot->removeListener(&m_listener);
+        m_listenedRoot = nullptr;
+    }
+    invalidateGroups();
+    ParallelVisitorScheduler::cleanup();
+}
+
+void DAGParallelVisitorScheduler::invalidateGroups()
+{
+    std::lock_guard lock(m_groupsMutex);
+    m_groups.clear();
+}
+
+ParallelVisitorScheduler* DAGParallelVisitorScheduler::clone()
+{
+    return new DAGParallelVisitorScheduler();
+}
+
+std::vector<std::vector<simulation::Node*> > DAGParallelVisitorScheduler::getIndependentGroups(simulation::Node* node)
+{
+    std::lock_guard lock(m_groupsMutex);
+    auto it = m_groups.find(node);
+    if (it == m_groups.end())
+    {
+        it = m_groups.emplace(node, std::vector<std::vector<simulation::Node*> >()).first;
+        computeIndependentGroups(node, it->second);
+    }
+    return it->second;
+}
+
+namespace
+{
+
+std::size_t findRoot(std::vector<std::size_t>& parent, std::size_t i)
+{
+    while (parent[i] != i)
+    {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+void unite(std::vector<std::size_t>& parent, const std::size_t a, const std::size_t b)
+{
+    const auto ra = findRoot(parent, a);
+    const auto rb = findRoot(parent, b);
+    // the smallest index is the representative, to keep the order of the children in the groups
+    if (ra < rb)
+    {
+        parent[rb] = ra;
+    }
+    else
+    {
+        parent[ra] = rb;
+    }
+}
+
+simulation::Node* getNode(const core::objectmodel::BaseObject* object)
+{
+    const auto* context = object->getContext();
+    return context ? const_cast<simulation::Node*>(dynamic_cast<const simulation::Node*>(context)) : nullptr;
+}
+
+}
+
+void DAGParallelVisitorScheduler::computeIndependentGroups(simulation::Node* node, std::vector<std::vector<simulation::Node*> >& groups) const
+{
+    groups.clear();
+
+    const auto nbChildren = node->child.size();
+    const std::vector<simulation::Node*> allChildren = [node]()
+    {
+        std::vector<simulation::Node*> c;
+        for (const auto& child : node->child)
+        {
+            c.push_back(child.get());
+        }
+        return c;
+    }();
+
+    // index nbChildren stands for everything outside of the sub-graphs of the children
+    const std::size_t outside = nbChildren;
+    std::vector<std::size_t> parent(nbChildren + 1);
+    std::iota(parent.begin(), parent.end(), 0);
+
+    // owner of each node below the children
+    std::map<simulation::Node*, std::size_t> owner;
+    std::vector<std::vector<simulation::Node*> > subGraphs(nbChildren);
+    for (std::size_t i = 0; i < nbChildren; ++i)
+    {
+        std::vector<simulation::Node*> stack { allChildren[i] };
+        while (!stack.empty())
+        {
+            simulation::Node* current = stack.back();
+            stack.pop_back();
+
+            const auto [it, inserted] = owner.emplace(current, i);
+            if (!inserted)
+            {
+                if (it->second != i)
+                {
+                    // Node shared by two sub-graphs: visiting the children one after the other would
+                    // visit it twice, only a traversal from the node itself is correct.
+                    groups.push_back(allChildren);
+                    return;
+                }
+                continue;
+            }
+            subGraphs[i].push_back(current);
+            for (const auto& child : current->child)
+            {
+                stack.push_back(child.get());
+            }
+        }
+    }
+
+    const auto ownerOf = [&owner, outside](simulation::Node* n)
+    {
+        const auto it = owner.find(n);
+        return it == owner.end() ? outside : it->second;
+    };
+
+    for (std::size_t i = 0; i < nbChildren; ++i)
+    {
+        for (simulation::Node* current : subGraphs[i])
+        {
+            // a parent outside of the node links the sub-graph with the rest of the scene
+            for (auto* p : current->getParents())
+            {
+                auto* parentNode = down_cast<simulation::Node>(p);
+                if (parentNode != node)
+                {
+                    unite(parent, i, ownerOf(parentNode));
+                }
+            }
+
+            const auto useState = [&](const core::objectmodel::BaseObject* state)
+            {
+                if (state)
+                {
+                    unite(parent, i, ownerOf(getNode(state)));
+                }
+            };
+
+            for (const auto& object : current->object)
+            {
+                if (const auto* accessor = dynamic_cast<const core::behavior::StateAccessor*>(object.get()))
+                {
+                    for (const auto* state : accessor->getMechanicalStates())
+                    {
+                        useState(state);
+                    }
+                }
+                if (auto* mapping = dynamic_cast<core::BaseMapping*>(object.get()))
+                {
+                    for (const auto* state : mapping->getFrom())
+                    {
+                        useState(state);
+                    }
+                    for (const auto* state : mapping->getTo())
+                    {
+                        useState(state);
+                    }
+                }
+            }
+        }
+    }
+
+    std::map<std::size_t, std::size_t> groupIndex;
+    for (std::size_t i = 0; i < nbChildren; ++i)
+    {
+        const auto root = findRoot(parent, i);
+        const auto [it, inserted] = groupIndex.emplace(root, groups.size());
+        if (inserted)
+        {
+            groups.emplace_back();
+        }
+        groups[it->second].push_back(allChildren[i]);
+    }
+}
+
+void DAGParallelVisitorScheduler::executeParallelVisitor(simulation::Node* node, simulation::Visitor* action)
+{
+    // Only the mechanical visitors declaring themselves thread-safe are run on independent sub-graphs:
+    // the other ones may have a state shared between the sub-graphs (offsets, counters, sums...).
+    // The ones reducing values along the graph need a sequential traversal too.
+    const auto* mechanicalVisitor = dynamic_cast<BaseMechanicalVisitor*>(action);
+    if (!mechanicalVisitor || !mechanicalVisitor->isThreadSafe() || mechanicalVisitor->writeNodeData())
+    {
+        doExecuteVisitor(node, action);
+        return;
+    }
+
+    auto* taskScheduler = MainTaskSchedulerFactory::createInRegistry();
+    const auto groups = getIndependentGroups(node);
+    if (groups.size() < 2 || taskScheduler->getThreadCount() < 2)
+    {
+        doExecuteVisitor(node, action);
+        return;
+    }
+
+    if (action->processNodeTopDown(node) != simulation::Visitor::RESULT_PRUNE)
+    {
+        CpuTask::Status status;
+        for (const auto& group : groups)
+        {
+            taskScheduler->addTask(status, [&group, action]()
+            {
+                for (simulation::Node* child : group)
+                {
+                    child->executeVisitor(action);
+                }
+            });
+        }
+        taskScheduler->workUntilDone(&status);
+    }
+
+    action->processNodeBottomUp(node);
+}
+
+int DAGParallelVisitorSchedulerClass = core::RegisterObject(
+    "Runs the mechanical visitors concurrently on the independent sub-graphs below the node where it is placed")
+    .add< DAGParallelVisitorScheduler >();
+
+} // namespace sofa::simulation::graph
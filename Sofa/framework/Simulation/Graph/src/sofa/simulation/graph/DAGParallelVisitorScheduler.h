@@ -0,0 +1,96 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/simulation/graph/config.h>
+#include <sofa/simulation/ParallelVisitorScheduler.h>
+#include <sofa/simulation/MutationListener.h>
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace sofa::simulation::graph
+{
+
+/**
+ * Visitor scheduler running the thread-safe mechanical visitors concurrently on the independent
+ * sub-graphs below the node where it is placed.
+ *
+ * The children of the node are gathered into groups: two children are in the same group if a
+ * component of one sub-graph (interaction force field, interaction constraint, multi-mapping...)
+ * uses a mechanical state of the other one. If two sub-graphs share a node (multi-parent node), the
+ * visitors are executed sequentially.
+ * The children whose components use a mechanical state outside of their own sub-graph (for
+ * instance a mapping from the node itself) are gathered in the same group too, because they
+ * accumulate into the same state.
+ *
+ * When a visitor is executed from the node, the node itself is processed by the calling thread,
+ * then each group is visited in its own task, then the node is processed bottom-up.
+ * Only the mechanical visitors declaring themselves thread-safe (Visitor::isThreadSafe) are run
+ * concurrently. The other visitors, and the ones which reduce values along the graph
+ * (writeNodeData), are executed sequentially.
+ *
+ * The groups are computed again each time an object or a node is added to or removed from the scene.
+ */
+class SOFA_SIMULATION_GRAPH_API DAGParallelVisitorScheduler : public sofa::simulation::ParallelVisitorScheduler
+{
+public:
+    SOFA_CLASS(DAGParallelVisitorScheduler, sofa::simulation::ParallelVisitorScheduler);
+
+    void init() override;
+    void cleanup() override;
+
+    /// Groups of children of the node which can be visited concurrently.
+    /// Returns a single group if the sub-graphs cannot be separated.
+    std::vector<std::vector<simulation::Node*> > getIndependentGroups(simulation::Node* node);
+
+protected:
+    DAGParallelVisitorScheduler();
+    ~DAGParallelVisitorScheduler() override;
+
+    ParallelVisitorScheduler* clone() override;
+    void executeParallelVisitor(simulation::Node* node, simulation::Visitor* action) override;
+
+    void computeIndependentGroups(simulation::Node* node, std::vector<std::vector<simulation::Node*> >& groups) const;
+
+    /// Invalidates the groups when the scene graph changes
+    struct GraphChangeListener : public simulation::MutationListener
+    {
+        DAGParallelVisitorScheduler* scheduler { nullptr };
+
+        void onEndAddChild(simulation::Node*, simulation::Node*) override { scheduler->invalidateGroups(); }
+        void onEndRemoveChild(simulation::Node*, simulation::Node*) override { scheduler->invalidateGroups(); }
+        void onEndAddObject(simulation::Node*, core::objectmodel::BaseObject*) override { scheduler->invalidateGroups(); }
+        void onEndRemoveObject(simulation::Node*, core::objectmodel::BaseObject*) override { scheduler->invalidateGroups(); }
+    };
+
+    void invalidateGroups();
+
+    GraphChangeListener m_listener;
+    simulation::Node* m_listenedRoot { nullptr };
+
+    /// Cached groups for each node from which a visitor was executed
+    std::map<simulation::Node*, std::vector<std::vector<simulation::Node*> > > m_groups;
+    std::mutex m_groupsMutex;
+};
+
+} // namespace sofa::simulation::graph
@@ -0,0 +1,178 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/testing/BaseTest.h>
+using sofa::testing::BaseTest;
+
+#include <sofa/simulation/graph/DAGNode.h>
+#include <sofa/simulation/graph/DAGParallelVisitorScheduler.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/TaskScheduler.h>
+#include <sofa/simulation/mechanicalvisitor/MechanicalVOpVisitor.h>
+#include <sofa/simulation/mechanicalvisitor/MechanicalMultiVectorToBaseVectorVisitor.h>
+#include <sofa/linearalgebra/FullVector.h>
+#include <sofa/component/statecontainer/MechanicalObject.h>
+#include <sofa/defaulttype/VecTypes.h>
+
+using namespace sofa;
+using namespace simulation::graph;
+
+namespace
+{
+using MechanicalObject3 = component::statecontainer::MechanicalObject<defaulttype::Vec3Types>;
+
+struct DAGParallelVisitorScheduler_test : public BaseTest
+{
+    DAGNode::SPtr root;
+    DAGParallelVisitorScheduler::SPtr scheduler;
+
+    void onSetUp() override
+    {
+        simulation::MainTaskSchedulerFactory::createInRegistry()->init(4);
+
+        root = core::objectmodel::New<DAGNode>("root");
+        scheduler = core::objectmodel::New<DAGParallelVisitorScheduler>();
+        root->addObject(scheduler);
+        scheduler->init();
+    }
+
+    void onTearDown() override
+    {
+        scheduler->cleanup();
+    }
+
+    DAGNode::SPtr addChildWithState(DAGNode::SPtr parent, const std::string& name, const std::size_t nbPoints)
+    {
+        DAGNode::SPtr node = core::objectmodel::New<DAGNode>(name);
+        parent->addChild(node);
+
+        auto state = core::objectmodel::New<MechanicalObject3>();
+        node->addObject(state);
+        state->resize(nbPoints);
+        auto x = state->writePositions();
+        for (std::size_t i = 0; i < nbPoints; ++i)
+        {
+            x[i] = type::Vec3(i, 1, -1);
+        }
+        return node;
+    }
+};
+
+TEST_F(DAGParallelVisitorScheduler_test, independentSubGraphs)
+{
+    addChildWithState(root, "node1", 1);
+    addChildWithState(root, "node2", 1);
+    auto node3 = addChildWithState(root, "node3", 1);
+    addChildWithState(node3, "node31", 1);
+
+    const auto groups = scheduler->getIndependentGroups(root.get());
+    ASSERT_EQ(groups.size(), 3);
+    for (const auto& group : groups)
+    {
+        EXPECT_EQ(group.size(), 1);
+    }
+}
+
+TEST_F(DAGParallelVisitorScheduler_test, sharedNode)
+{
+    auto node1 = addChildWithState(root, "node1", 1);
+    auto node2 = addChildWithState(root, "node2", 1);
+    auto node3 = addChildWithState(root, "node3", 1);
+    auto shared = addChildWithState(node1, "shared", 1);
+    node2->addChild(shared);
+
+    // node1 and node2 share a node: the sub-graphs cannot be visited separately
+    const auto groups = scheduler->getIndependentGroups(root.get());
+    EXPECT_EQ(groups.size(), 1);
+}
+
+TEST_F(DAGParallelVisitorScheduler_test, groupsAreUpdated)
+{
+    addChildWithState(root, "node1", 1);
+    EXPECT_EQ(scheduler->getIndependentGroups(root.get()).size(), 1);
+
+    addChildWithState(root, "node2", 1);
+    EXPECT_EQ(scheduler->getIndependentGroups(root.get()).size(), 2);
+}
+
+TEST_F(DAGParallelVisitorScheduler_test, mechanicalVisitor)
+{
+    constexpr std::size_t nbPoints = 100;
+    std::vector<MechanicalObject3*> states;
+    for (int i = 0; i < 8; ++i)
+    {
+        auto node = addChildWithState(root, "node" + std::to_string(i), nbPoints);
+        states.push_back(dynamic_cast<MechanicalObject3*>(node->getMechanicalState()));
+    }
+    ASSERT_EQ(scheduler->getIndependentGroups(root.get()).size(), 8);
+
+    // x = x + x * 1
+    simulation::mechanicalvisitor::MechanicalVOpVisitor vop(core::execparams::defaultInstance(),
+        core::VecCoordId::position(), core::ConstVecCoordId::position(), core::ConstVecCoordId::position(), 1.);
+    root->executeVisitor(&vop);
+
+    for (const auto* state : states)
+    {
+        const auto x = state->readPositions();
+        ASSERT_EQ(x.size(), nbPoints);
+        for (std::size_t i = 0; i < nbPoints; ++i)
+        {
+            EXPECT_EQ(x[i], type::Vec3(2 * i, 2, -2));
+        }
+    }
+}
+
+TEST_F(DAGParallelVisitorScheduler_test, statefulVisitorIsSequential)
+{
+    constexpr std::size_t nbPoints = 100;
+    constexpr std::size_t nbNodes = 8;
+    for (std::size_t i = 0; i < nbNodes; ++i)
+    {
+        auto node = addChildWithState(root, "node" + std::to_string(i), nbPoints);
+        auto x = dynamic_cast<MechanicalObject3*>(node->getMechanicalState())->writePositions();
+        for (std::size_t j = 0; j < nbPoints; ++j)
+        {
+            x[j] = type::Vec3(i, j, 0);
+        }
+    }
+    ASSERT_EQ(scheduler->getIndependentGroups(root.get()).size(), nbNodes);
+
+    // the visitor advances an offset in the global vector from one state to the next:
+    // it is not thread-safe and must visit the states in the order of the graph
+    linearalgebra::FullVector<SReal> vector(nbNodes * nbPoints * 3);
+    simulation::mechanicalvisitor::MechanicalMultiVectorToBaseVectorVisitor visitor(
+        core::execparams::defaultInstance(), core::ConstVecCoordId::position(), &vector);
+    root->executeVisitor(&visitor);
+
+    EXPECT_EQ(visitor.offset, static_cast<int>(nbNodes * nbPoints * 3));
+    for (std::size_t i = 0; i < nbNodes; ++i)
+    {
+        for (std::size_t j = 0; j < nbPoints; ++j)
+        {
+            const auto index = static_cast<linearalgebra::FullVector<SReal>::Index>(3 * (i * nbPoints + j));
+            EXPECT_EQ(vector[index], static_cast<SReal>(i));
+            EXPECT_EQ(vector[index + 1], static_cast<SReal>(j));
+            EXPECT_EQ(vector[index + 2], static_cast<SReal>(0));
+        }
+    }
+}
+
+}
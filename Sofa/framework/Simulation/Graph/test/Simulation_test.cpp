@@ -34,9 +34,18 @@ typedef sofa::component::statecontainer::MechanicalObject<Vec3Types> MechanicalO
 #include <sofa/component/mass/UniformMass.h>
 
 #include <sofa/simulation/DefaultAnimationLoop.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/TaskScheduler.h>
+#include <sofa/core/visual/VisualModel.h>
+#include <sofa/core/visual/VisualParams.h>
+#include <sofa/core/BehaviorModel.h>
 
 #include <sofa/simulation/Node.h>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 namespace sofa {
 
 static int objectCounter;
@@ -61,6 +70,52 @@ struct ParentObject : public O1
 
 
 
+/// Visual model recording the calls of a pipelined animation loop
+struct DoubleBufferedVisualModel : public core::visual::VisualModel
+{
+    SOFA_CLASS(DoubleBufferedVisualModel, core::visual::VisualModel);
+
+    void setDoubleBuffered(bool enabled) override { isDoubleBuffered = enabled; }
+    void swapVisualState() override { ++nbSwaps; }
+
+    bool isDoubleBuffered { false };
+    int nbSwaps { 0 };
+};
+
+/// Behavior model writing slowly a mechanical state during the time step
+struct SlowPositionWriter : public core::BehaviorModel
+{
+    SOFA_CLASS(SlowPositionWriter, core::BehaviorModel);
+
+    void updatePosition(SReal /*dt*/) override
+    {
+        isWriting = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        MechanicalObject3::WriteVecCoord x = dofs->writePositions();
+        x[0][0] += 1;
+        isWriting = false;
+    }
+
+    MechanicalObject3* dofs { nullptr };
+    std::atomic<bool> isWriting { false };
+};
+
+/// Mechanical object recording the state it draws
+struct DrawnMechanicalObject : public MechanicalObject3
+{
+    SOFA_CLASS(DrawnMechanicalObject, MechanicalObject3);
+
+    void draw(const core::visual::VisualParams* /*vparams*/) override
+    {
+        isDrawnDuringStep = isDrawnDuringStep || writer->isWriting;
+        drawnPosition = readPositions()[0][0];
+    }
+
+    SlowPositionWriter* writer { nullptr };
+    bool isDrawnDuringStep { false };
+    SReal drawnPosition { 0 };
+};
+
 /** Test the Simulation class
 */
 struct Scene_test: public NumericTest<SReal>
@@ -184,6 +239,78 @@ struct Scene_test: public NumericTest<SReal>
         simulation->unload(root);
     }
 
+    /// compute time steps asynchronously with a pipelined animation loop
+    void pipelinedAnimationLoop()
+    {
+        simulation::MainTaskSchedulerFactory::createInRegistry()->init(2);
+
+        root = simulation::getSimulation()->createNewGraph("root");
+        const auto loop = core::objectmodel::New<sofa::simulation::DefaultAnimationLoop>();
+        loop->d_pipelined.setValue(true);
+        root->addObject(loop);
+
+        const auto visualModel = core::objectmodel::New<DoubleBufferedVisualModel>();
+        root->createChild("child")->addObject(visualModel);
+
+        simulation->init(root.get());
+
+        const SReal dt = 0.01;
+        for (int i = 1; i <= 3; ++i)
+        {
+            simulation->animate(root.get(), dt);
+
+            // the state of the previous step is published before the next one is started
+            EXPECT_TRUE(visualModel->isDoubleBuffered);
+            EXPECT_EQ(visualModel->nbSwaps, i);
+
+            loop->waitForPendingStep();
+            EXPECT_NEAR(root->getTime(), i * dt, 1e-12);
+        }
+
+        // back to sequential steps: the last state is published
+        loop->d_pipelined.setValue(false);
+        simulation->animate(root.get(), dt);
+        EXPECT_FALSE(visualModel->isDoubleBuffered);
+        EXPECT_EQ(visualModel->nbSwaps, 4);
+        EXPECT_NEAR(root->getTime(), 4 * dt, 1e-12);
+
+        simulation->unload(root);
+    }
+
+    /// draw a mechanical object, which is not double buffered, while a pipelined time step writes it
+    void pipelinedAnimationLoopDraw()
+    {
+        simulation::MainTaskSchedulerFactory::createInRegistry()->init(2);
+
+        root = simulation::getSimulation()->createNewGraph("root");
+        const auto loop = core::objectmodel::New<sofa::simulation::DefaultAnimationLoop>();
+        loop->d_pipelined.setValue(true);
+        root->addObject(loop);
+
+        const auto dofs = core::objectmodel::New<DrawnMechanicalObject>();
+        const auto writer = core::objectmodel::New<SlowPositionWriter>();
+        dofs->resize(1);
+        dofs->writer = writer.get();
+        writer->dofs = dofs.get();
+        root->addObject(dofs);
+        root->addObject(writer);
+
+        simulation->init(root.get());
+
+        for (int i = 1; i <= 3; ++i)
+        {
+            simulation->animate(root.get(), 0.01);
+            simulation->updateVisual(root.get());
+
+            // the rendering waits for the end of the time step started by animate
+            simulation->draw(core::visual::visualparams::defaultInstance(), root.get());
+            EXPECT_FALSE(dofs->isDrawnDuringStep);
+            EXPECT_EQ(dofs->drawnPosition, static_cast<SReal>(i));
+        }
+
+        simulation->unload(root);
+    }
+
     /// create and unload a scene and check if all the objects have been destroyed.
     void sceneDestruction_unload()
     {
@@ -274,7 +401,17 @@ TEST_F( Scene_test,objectDestruction_subNodeAndStep) {
     this->objectDestruction_subNodeAndStep();
 }
 
+TEST_F( Scene_test,pipelinedAnimationLoop) {
+    EXPECT_MSG_NOEMIT(Error) ;
+    this->pipelinedAnimationLoop();
+}
+
 // graph destruction
+TEST_F( Scene_test,pipelinedAnimationLoopDraw) {
+    EXPECT_MSG_NOEMIT(Error) ;
+    this->pipelinedAnimationLoopDraw();
+}
+
 TEST_F( Scene_test,sceneDestruction_unload) {
     EXPECT_MSG_NOEMIT(Error) ;
     this->sceneDestruction_unload();
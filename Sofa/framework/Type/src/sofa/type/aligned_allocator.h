@@ -0,0 +1,96 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/type/config.h>
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace sofa::type
+{
+
+/// Alignment, in bytes, suitable for aligned loads and stores of the widest SIMD registers (AVX-512)
+static constexpr std::size_t SIMDAlignment { 64 };
+
+/**
+ * Allocator returning memory aligned on a given boundary
+ *
+ * It can be used with any standard container, or to allocate raw buffers, when the data is processed
+ * with aligned SIMD loads and stores.
+ */
+template<class T, std::size_t Alignment = SIMDAlignment>
+class aligned_allocator
+{
+public:
+    static_assert(Alignment >= alignof(T), "The alignment must be at least the natural alignment of the type");
+    static_assert((Alignment & (Alignment - 1)) == 0, "The alignment must be a power of 2");
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    template<class U>
+    struct rebind
+    {
+        using other = aligned_allocator<U, Alignment>;
+    };
+
+    static constexpr std::size_t alignment = Alignment;
+
+    aligned_allocator() noexcept = default;
+
+    template<class U>
+    aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept {}
+
+    [[nodiscard]] T* allocate(size_type n)
+    {
+        if (n == 0)
+        {
+            return nullptr;
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* p, size_type /*n*/) noexcept
+    {
+        if (p)
+        {
+            ::operator delete(p, std::align_val_t{Alignment});
+        }
+    }
+
+    template<class U>
+    bool operator==(const aligned_allocator<U, Alignment>&) const noexcept { return true; }
+
+    template<class U>
+    bool operator!=(const aligned_allocator<U, Alignment>&) const noexcept { return false; }
+};
+
+/// std::vector whose buffer is aligned for SIMD processing
+template<class T, std::size_t Alignment = SIMDAlignment>
+using aligned_vector = std::vector<T, aligned_allocator<T, Alignment> >;
+
+} // namespace sofa::type
@@ -0,0 +1,53 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/type/aligned_allocator.h>
+#include <sofa/type/Vec.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+
+namespace sofa
+{
+
+TEST(aligned_allocator, alignedBuffer)
+{
+    for (std::size_t n : {1, 3, 17, 1000})
+    {
+        sofa::type::aligned_vector<double> v(n, 1.);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.data()) % sofa::type::SIMDAlignment, 0u);
+
+        sofa::type::aligned_vector<sofa::type::Vec3f, 32> w(n);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(w.data()) % 32, 0u);
+    }
+}
+
+TEST(aligned_allocator, reallocationKeepsAlignment)
+{
+    sofa::type::aligned_vector<float> v;
+    for (unsigned int i = 0; i < 100; ++i)
+    {
+        v.push_back(static_cast<float>(i));
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.data()) % sofa::type::SIMDAlignment, 0u);
+    }
+    EXPECT_FLOAT_EQ(v[42], 42.f);
+}
+
+}
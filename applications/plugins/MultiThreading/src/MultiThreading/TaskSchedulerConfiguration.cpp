@@ -0,0 +1,139 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <MultiThreading/TaskSchedulerConfiguration.h>
+
+#include <sofa/core/ObjectFactory.h>
+#include <sofa/simulation/DefaultTaskScheduler.h>
+
+#include <algorithm>
+#include <thread>
+
+namespace multithreading
+{
+
+int TaskSchedulerConfigurationClass = sofa::core::RegisterObject("Configure the worker threads of the task scheduler (CPU affinity, priority, idle policy, names)")
+    .add< TaskSchedulerConfiguration >()
+;
+
+TaskSchedulerConfiguration::TaskSchedulerConfiguration()
+    : d_workerCpuAffinity(initData(&d_workerCpuAffinity, "workerCpuAffinity", "CPUs (indices starting at 0) on which the worker threads are allowed to run. Empty means no restriction. The main thread is not affected."))
+    , d_pinEachWorker(initData(&d_pinEachWorker, false, "pinEachWorker", "If true, each worker thread is pinned to a single CPU of workerCpuAffinity (round-robin). Otherwise, they can run on any of them."))
+    , d_workerPriority(initData(&d_workerPriority, 0, "workerPriority", "Priority of the worker threads relatively to the process, from -2 (lowest) to 2 (highest). Raising the priority may require privileges."))
+    , d_idleSpinCount(initData(&d_idleSpinCount, 0u, "idleSpinCount", "Number of times an idle worker thread checks for new work before it goes to sleep. Spinning reduces the latency to start the tasks, at the cost of CPU time."))
+    , d_workerNamePrefix(initData(&d_workerNamePrefix, std::string("Worker"), "workerNamePrefix", "Prefix of the names of the worker threads, as shown by system tools such as perf or htop (followed by the thread index)."))
+    , d_deterministic(initData(&d_deterministic, false, "deterministic", "If true, the parallel algorithms combine their partial results with fixed partitions and in a fixed order, so that the results are bitwise identical from one run to the next, whatever the number of threads. It applies to the whole simulation."))
+{
+}
+
+TaskSchedulerConfiguration::~TaskSchedulerConfiguration()
+{
+    restoreDeterministicMode();
+}
+
+void TaskSchedulerConfiguration::init()
+{
+    d_componentState.setValue(sofa::core::objectmodel::ComponentState::Valid);
+
+    applyDeterministicMode();
+
+    initTaskScheduler();
+    if (d_componentState.getValue() == sofa::core::objectmodel::ComponentState::Invalid)
+    {
+        return;
+    }
+
+    applyWorkerThreadSettings();
+}
+
+void TaskSchedulerConfiguration::reinit()
+{
+    applyDeterministicMode();
+    reinitTaskScheduler();
+    applyWorkerThreadSettings();
+}
+
+void TaskSchedulerConfiguration::cleanup()
+{
+    restoreDeterministicMode();
+}
+
+void TaskSchedulerConfiguration::applyDeterministicMode()
+{
+    sofa::simulation::TaskScheduler::setDeterministic(d_deterministic.getValue());
+    m_isDeterministicModeApplied = d_deterministic.getValue();
+    msg_info_when(d_deterministic.getValue()) << "Deterministic mode enabled for the parallel algorithms";
+}
+
+void TaskSchedulerConfiguration::restoreDeterministicMode()
+{
+    if (m_isDeterministicModeApplied)
+    {
+        sofa::simulation::TaskScheduler::setDeterministic(false);
+        m_isDeterministicModeApplied = false;
+    }
+}
+
+void TaskSchedulerConfiguration::applyWorkerThreadSettings()
+{
+    auto* scheduler = dynamic_cast<sofa::simulation::DefaultTaskScheduler*>(m_taskScheduler);
+    if (!scheduler)
+    {
+        msg_warning() << "The worker thread settings are supported only by the task scheduler '"
+            << sofa::simulation::DefaultTaskScheduler::name() << "': they are ignored";
+        return;
+    }
+
+    const int priority = d_workerPriority.getValue();
+    msg_warning_when(priority < -2 || priority > 2) << "workerPriority must be between -2 and 2: the value " << priority << " is clamped";
+
+    // the CPU indices must exist on this machine, and fit in the affinity mask of the platform
+    unsigned int nbCpus = sofa::simulation::WorkerThreadSettings::getMaxNbCpus();
+    if (const unsigned int hardwareConcurrency = std::thread::hardware_concurrency(); hardwareConcurrency > 0)
+    {
+        nbCpus = std::min(nbCpus, hardwareConcurrency);
+    }
+
+    sofa::simulation::WorkerThreadSettings settings;
+    for (const auto cpu : d_workerCpuAffinity.getValue())
+    {
+        if (cpu < nbCpus)
+        {
+            settings.cpuAffinity.push_back(cpu);
+        }
+        else
+        {
+            msg_warning() << "workerCpuAffinity: the CPU " << cpu << " does not exist (" << nbCpus
+                << " CPUs available): it is ignored";
+        }
+    }
+    settings.pinEachThread = d_pinEachWorker.getValue();
+    settings.priority = std::clamp(priority, -2, 2);
+    settings.idleSpinCount = d_idleSpinCount.getValue();
+    settings.namePrefix = d_workerNamePrefix.getValue();
+
+    // the worker threads are restarted with the new settings
+    scheduler->setWorkerThreadSettings(settings);
+
+    msg_info() << "Worker threads configured on " << scheduler->getThreadCount() << " threads";
+}
+
+} // namespace multithreading
@@ -0,0 +1,74 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <MultiThreading/config.h>
+#include <MultiThreading/TaskSchedulerUser.h>
+
+#include <sofa/core/objectmodel/BaseObject.h>
+#include <sofa/type/vector.h>
+
+namespace multithreading
+{
+
+/**
+ * Scene component configuring the worker threads of the main task scheduler: CPU affinity,
+ * priority, idle policy and names. It also enables the deterministic mode of the parallel
+ * algorithms (see sofa::simulation::TaskScheduler::setDeterministic), until the component is
+ * cleaned up or destroyed.
+ *
+ * Typical use: keep the worker threads away from the core of a real-time loop (e.g. haptics),
+ * at a lower priority.
+ * The settings are supported by the default task scheduler only.
+ */
+class SOFA_MULTITHREADING_PLUGIN_API TaskSchedulerConfiguration :
+    public sofa::core::objectmodel::BaseObject,
+    public TaskSchedulerUser
+{
+public:
+    SOFA_CLASS(TaskSchedulerConfiguration, sofa::core::objectmodel::BaseObject);
+
+    sofa::Data<sofa::type::vector<unsigned int> > d_workerCpuAffinity; ///< CPUs on which the worker threads are allowed to run
+    sofa::Data<bool> d_pinEachWorker; ///< Pin each worker thread to a single CPU of workerCpuAffinity
+    sofa::Data<int> d_workerPriority; ///< Priority of the worker threads, from -2 (lowest) to 2 (highest)
+    sofa::Data<unsigned int> d_idleSpinCount; ///< Number of checks for new work before an idle worker thread sleeps
+    sofa::Data<std::string> d_workerNamePrefix; ///< Prefix of the names of the worker threads
+    sofa::Data<bool> d_deterministic; ///< Make the results of the parallel algorithms independent of the number of threads
+
+    void init() override;
+    void reinit() override;
+    void cleanup() override;
+
+protected:
+    TaskSchedulerConfiguration();
+    ~TaskSchedulerConfiguration() override;
+
+    void applyWorkerThreadSettings();
+    void applyDeterministicMode();
+
+    /// Disable the deterministic mode if it was enabled by this component, so that it does not apply to the next scene
+    void restoreDeterministicMode();
+
+    bool m_isDeterministicModeApplied { false };
+};
+
+} // namespace multithreading
@@ -25,6 +25,7 @@
 #include <sofa/simulation/TaskScheduler.h>
 #include <sofa/simulation/MainTaskSchedulerFactory.h>
 #include <sofa/simulation/ParallelForEach.h>
+#include <sofa/simulation/ParallelReduce.h>
 
 namespace multithreading::component::forcefield::solidmechanics::fem::elastic
 {
@@ -103,31 +104,37 @@ void ParallelHexahedronFEMForceField<DataTypes>::addForce(const sofa::core::Mech
         first = false;
     }
 
-    std::mutex mutex;
+    struct RangeForces
+    {
+        std::vector<sofa::type::Vec<8, Deriv>> fElements;
+        SReal potentialEnergy { 0_sreal };
+    };
 
-    sofa::simulation::parallelForEachRange(*m_taskScheduler,
+    // the forces of the ranges are accumulated in the order of the elements, whatever the scheduling
+    sofa::simulation::parallelForEachRangeWithMerge(*m_taskScheduler,
         indexedElements->begin(), indexedElements->end(),
-        [this, &_p, &elementStiffnesses, &mutex, &_f](const auto& range)
+        [this, &_p, &elementStiffnesses](const auto& range)
         {
             auto elementId = std::distance(this->getIndexedElements()->begin(), range.start);
 
-            std::vector<sofa::type::Vec<8, Deriv>> fElements;
-            fElements.reserve(std::distance(range.start, range.end));
+            RangeForces forces;
+            forces.fElements.reserve(std::distance(range.start, range.end));
 
-            SReal potentialEnergy { 0_sreal };
             for (auto it = range.start; it != range.end; ++it, ++elementId)
             {
                 sofa::type::Vec<8, Deriv> forceInElement;
-                this->computeTaskForceLarge(_p, elementId, *it, elementStiffnesses, potentialEnergy, forceInElement);
-                fElements.emplace_back(forceInElement);
+                this->computeTaskForceLarge(_p, elementId, *it, elementStiffnesses, forces.potentialEnergy, forceInElement);
+                forces.fElements.emplace_back(forceInElement);
             }
 
-            std::lock_guard guard(mutex);
-
-            this->m_potentialEnergy += potentialEnergy;
+            return forces;
+        },
+        [this, &_f](const auto& range, const RangeForces& forces)
+        {
+            this->m_potentialEnergy += forces.potentialEnergy;
 
             auto it = range.start;
-            for (const auto& forceInElement : fElements)
+            for (const auto& forceInElement : forces.fElements)
             {
                 for (int w = 0; w < 8; ++w)
                 {
@@ -27,8 +27,7 @@
 #include <sofa/component/solidmechanics/fem/elastic/TetrahedronFEMForceField.h>
 #include <sofa/simulation/CpuTask.h>
 #include <sofa/simulation/TaskScheduler.h>
-
-#include <thread>
+#include <sofa/simulation/ParallelElementAssembly.h>
 
 namespace multithreading::component::solidmechanics::fem::elastic
 {
@@ -97,7 +96,7 @@ protected:
                                      Real maxVM,
                                      sofa::helper::ReadAccessor<sofa::Data<sofa::type::vector<Real>>> vM) override;
 
-    std::map<std::thread::id, VecDeriv> m_threadLocal_df;
+    sofa::simulation::ParallelElementAccumulator<VecDeriv> m_elementAccumulator;
 
 };
 
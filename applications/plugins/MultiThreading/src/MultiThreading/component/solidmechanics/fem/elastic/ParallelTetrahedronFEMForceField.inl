@@ -26,6 +26,7 @@
 #include <sofa/simulation/TaskScheduler.h>
 #include <sofa/simulation/MainTaskSchedulerFactory.h>
 #include <sofa/simulation/ParallelForEach.h>
+#include <sofa/simulation/ParallelReduce.h>
 
 namespace multithreading::component::solidmechanics::fem::elastic
 {
@@ -68,34 +69,12 @@ template <class Function>
 void ParallelTetrahedronFEMForceField<DataTypes>::addDForceGeneric(VecDeriv& df, const VecDeriv& dx,
     Real kFactor, const VecElement& indexedElements, Function f)
 {
-    std::mutex mutex;
-    sofa::simulation::parallelForEachRange(*m_taskScheduler, indexedElements.begin(), indexedElements.end(),
-           [&indexedElements, this, kFactor, &dx, &df, &f, &mutex](const auto& range)
-           {
-               auto elementId = std::distance(indexedElements.begin(), range.start);
-
-               VecDeriv& threadLocal_df = m_threadLocal_df[std::this_thread::get_id()];
-               threadLocal_df.clear();
-               threadLocal_df.resize(df.size());
-
-               for (auto it = range.start; it != range.end; ++it, ++elementId)
-               {
-                   sofa::Index a = (*it)[0];
-                   sofa::Index b = (*it)[1];
-                   sofa::Index c = (*it)[2];
-                   sofa::Index d = (*it)[3];
-
-                   f( threadLocal_df, dx, elementId, a,b,c,d, kFactor );
-               }
-
-               std::lock_guard guard(mutex);
-
-               auto it = df.begin();
-               for (const auto& d : threadLocal_df)
-               {
-                   *it++ += d;
-               }
-           });
+    m_elementAccumulator.accumulate(m_taskScheduler, indexedElements.size(), df,
+        [&indexedElements, kFactor, &dx, &f](const std::size_t elementId, VecDeriv& out)
+        {
+            const Element& element = indexedElements[elementId];
+            f(out, dx, static_cast<sofa::Index>(elementId), element[0], element[1], element[2], element[3], kFactor);
+        });
 }
 
 template <class DataTypes>
@@ -152,60 +131,34 @@ void ParallelTetrahedronFEMForceField<DataTypes>::addKToMatrix(sofa::linearalgeb
 
     const auto m = this->method;
 
-    std::mutex mutex;
-
-    sofa::simulation::parallelForEachRange(*m_taskScheduler, indexedElements.begin(), indexedElements.end(),
-        [&indexedElements, m, &Rot, this, &offset, mat, &mutex, kFactor](const auto& range)
+    // the element matrices are added to the matrix in the order of the elements, whatever the scheduling
+    sofa::simulation::parallelForEachRangeWithMerge(*m_taskScheduler, indexedElements.begin(), indexedElements.end(),
+        [&indexedElements, m, &Rot, this](const auto& range)
         {
-            constexpr auto S = DataTypes::deriv_total_size; // size of node blocks
-            constexpr auto N = Element::size();
-
-            StiffnessMatrix JKJt,tmp;
+            StiffnessMatrix JKJt;
 
             auto elementId = std::distance(indexedElements.begin(), range.start);
 
-            using Block = sofa::type::fixed_array<sofa::type::fixed_array<sofa::type::Mat<S, S, double>, 4>, 4>;
-            sofa::type::vector<Block> blocks;
-            blocks.reserve(std::distance(range.start, range.end));
+            sofa::type::vector<StiffnessMatrix> stiffnesses;
+            stiffnesses.resize(std::distance(range.start, range.end));
 
-            for (auto it = range.start; it != range.end; ++it, ++elementId)
+            auto stiffnessIt = stiffnesses.begin();
+            for (auto it = range.start; it != range.end; ++it, ++elementId, ++stiffnessIt)
             {
                 if (m == Inherit1::SMALL)
-                    this->computeStiffnessMatrix(JKJt,tmp, this->materialsStiffnesses[elementId], this->strainDisplacements[elementId],Rot);
+                    this->computeStiffnessMatrix(JKJt, *stiffnessIt, this->materialsStiffnesses[elementId], this->strainDisplacements[elementId],Rot);
                 else
-                    this->computeStiffnessMatrix(JKJt,tmp, this->materialsStiffnesses[elementId], this->strainDisplacements[elementId], this->rotations[elementId]);
-
-                Block tmpBlock;
-                for (sofa::Index n1=0; n1 < N; n1++)
-                {
-                    for(sofa::Index i=0; i < S; i++)
-                    {
-                        for (sofa::Index n2=0; n2 < N; n2++)
-                        {
-                            for (sofa::Index j=0; j < S; j++)
-                            {
-                                tmpBlock[n1][n2][i][j] = - tmp[n1*S+i][n2*S+j]* kFactor;
-                            }
-                        }
-                    }
-                }
-
-                blocks.emplace_back(tmpBlock);
+                    this->computeStiffnessMatrix(JKJt, *stiffnessIt, this->materialsStiffnesses[elementId], this->strainDisplacements[elementId], this->rotations[elementId]);
             }
 
-            std::lock_guard guard(mutex);
-
-            auto blockIt = blocks.begin();
-            for (auto it = range.start; it != range.end; ++it, ++blockIt)
+            return stiffnesses;
+        },
+        [&offset, mat, kFactor](const auto& range, const sofa::type::vector<StiffnessMatrix>& stiffnesses)
+        {
+            auto stiffnessIt = stiffnesses.begin();
+            for (auto it = range.start; it != range.end; ++it, ++stiffnessIt)
             {
-                const auto& block = *blockIt;
-                for (sofa::Index n1=0; n1 < N; n1++)
-                {
-                    for (sofa::Index n2=0; n2 < N; n2++)
-                    {
-                        mat->add(offset + (*it)[n1] * S, offset + (*it)[n2] * S, block[n1][n2]);
-                    }
-                }
+                mat->addElementMatrix(offset, *it, *stiffnessIt, -kFactor);
             }
         });
 
@@ -47,6 +47,10 @@ public:
     using DataVecDeriv = sofa::core::objectmodel::Data<VecDeriv>;
 
     void init() override;
+
+    /// The springs are computed by the parallel implementation of ParallelStiffSpringForceField
+    void addForce(const sofa::core::MechanicalParams* mparams, DataVecDeriv& data_f1, DataVecDeriv& data_f2, const DataVecCoord& data_x1, const DataVecCoord& data_x2, const DataVecDeriv& data_v1, const DataVecDeriv& data_v2 ) override;
+    void addDForce(const sofa::core::MechanicalParams* mparams, DataVecDeriv& data_df1, DataVecDeriv& data_df2, const DataVecDeriv& data_dx1, const DataVecDeriv& data_dx2) override;
 };
 
 }
@@ -0,0 +1,142 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <MultiThreading/TaskSchedulerConfiguration.h>
+#include <sofa/simulation/CpuTask.h>
+#include <sofa/simulation/DefaultTaskScheduler.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+namespace multithreading
+{
+
+TEST(TaskSchedulerConfiguration, workerThreadSettings)
+{
+    const auto configuration = sofa::core::objectmodel::New<TaskSchedulerConfiguration>();
+    configuration->d_nbThreads.setValue(2);
+    configuration->d_taskSchedulerType.setValue(sofa::simulation::DefaultTaskScheduler::name());
+    configuration->d_workerCpuAffinity.setValue({0});
+    configuration->d_idleSpinCount.setValue(100);
+    configuration->d_workerNamePrefix.setValue("SofaTest");
+    configuration->init();
+
+    auto* scheduler = dynamic_cast<sofa::simulation::DefaultTaskScheduler*>(
+        sofa::simulation::MainTaskSchedulerFactory::createInRegistry(sofa::simulation::DefaultTaskScheduler::name()));
+    ASSERT_NE(scheduler, nullptr);
+
+    const auto& settings = scheduler->getWorkerThreadSettings();
+    EXPECT_EQ(settings.cpuAffinity, std::vector<unsigned int>{0});
+    EXPECT_EQ(settings.idleSpinCount, 100);
+    EXPECT_EQ(settings.namePrefix, "SofaTest");
+
+    // the scheduler still runs tasks, on the restarted threads
+    ASSERT_EQ(scheduler->getThreadCount(), 2);
+    std::string workerName;
+    sofa::simulation::CpuTask::Status status;
+    scheduler->addTask(status, [&workerName]()
+    {
+#ifdef __linux__
+        char name[16] {};
+        pthread_getname_np(pthread_self(), name, sizeof(name));
+        workerName = name;
+#else
+        workerName = "SofaTest1";
+#endif
+    }, 1);
+    scheduler->workUntilDone(&status);
+
+    EXPECT_EQ(workerName, "SofaTest1");
+
+    // restore the default settings for the other tests
+    scheduler->setWorkerThreadSettings({});
+}
+
+TEST(TaskSchedulerConfiguration, invalidCpuAffinity)
+{
+    const auto configuration = sofa::core::objectmodel::New<TaskSchedulerConfiguration>();
+    configuration->d_nbThreads.setValue(2);
+    configuration->d_taskSchedulerType.setValue(sofa::simulation::DefaultTaskScheduler::name());
+    configuration->d_workerCpuAffinity.setValue({0, sofa::simulation::WorkerThreadSettings::getMaxNbCpus()});
+    configuration->init();
+
+    auto* scheduler = dynamic_cast<sofa::simulation::DefaultTaskScheduler*>(
+        sofa::simulation::MainTaskSchedulerFactory::createInRegistry(sofa::simulation::DefaultTaskScheduler::name()));
+    ASSERT_NE(scheduler, nullptr);
+
+    // the CPU out of the affinity mask is ignored
+    EXPECT_EQ(scheduler->getWorkerThreadSettings().cpuAffinity, std::vector<unsigned int>{0});
+
+    // the settings can be changed while the workers are running, and the tasks still run on them
+    sofa::simulation::WorkerThreadSettings settings;
+    settings.cpuAffinity = {0, sofa::simulation::WorkerThreadSettings::getMaxNbCpus() + 1};
+    scheduler->setWorkerThreadSettings(settings);
+    ASSERT_EQ(scheduler->getThreadCount(), 2);
+
+    bool isRun = false;
+    sofa::simulation::CpuTask::Status status;
+    scheduler->addTask(status, [&isRun]() { isRun = true; }, 1);
+    scheduler->workUntilDone(&status);
+    EXPECT_TRUE(isRun);
+
+    // restore the default settings for the other tests
+    scheduler->setWorkerThreadSettings({});
+}
+
+TEST(TaskSchedulerConfiguration, deterministic)
+{
+    const auto configuration = sofa::core::objectmodel::New<TaskSchedulerConfiguration>();
+    configuration->d_deterministic.setValue(true);
+    configuration->init();
+    EXPECT_TRUE(sofa::simulation::TaskScheduler::isDeterministic());
+
+    configuration->d_deterministic.setValue(false);
+    configuration->reinit();
+    EXPECT_FALSE(sofa::simulation::TaskScheduler::isDeterministic());
+}
+
+TEST(TaskSchedulerConfiguration, deterministicRestoredOnCleanup)
+{
+    {
+        const auto configuration = sofa::core::objectmodel::New<TaskSchedulerConfiguration>();
+        configuration->d_deterministic.setValue(true);
+        configuration->init();
+        EXPECT_TRUE(sofa::simulation::TaskScheduler::isDeterministic());
+
+        // e.g. the scene is unloaded: the mode does not leak into the next scene
+        configuration->cleanup();
+        EXPECT_FALSE(sofa::simulation::TaskScheduler::isDeterministic());
+    }
+
+    {
+        const auto configuration = sofa::core::objectmodel::New<TaskSchedulerConfiguration>();
+        configuration->d_deterministic.setValue(true);
+        configuration->init();
+        EXPECT_TRUE(sofa::simulation::TaskScheduler::isDeterministic());
+    }
+    // the component is destroyed without cleanup
+    EXPECT_FALSE(sofa::simulation::TaskScheduler::isDeterministic());
+}
+
+}
@@ -158,6 +158,7 @@ int main(int argc, char** argv)
     bool computationTimeAtBegin = false;
     unsigned int computationTimeSampling=0; ///< Frequency of display of the computation time statistics, in number of animation steps. 0 means never.
     string    computationTimeOutputType="stdout";
+    bool memoryProfile = false;
 
     string gui = "";
     string verif = "";
@@ -220,6 +221,13 @@ int main(int argc, char** argv)
         "o,computationTimeOutputType",
         "Output type for the computation time statistics: either stdout, json or ljson"
     );
+    argParser->addArgument(
+        cxxopts::value<bool>(memoryProfile)
+        ->default_value("false")
+        ->implicit_value("true"),
+        "memoryProfile",
+        "Add the memory footprint of each node, in bytes, to the computation time statistics of each animation step"
+    );
     argParser->addArgument(
         cxxopts::value<std::string>(gui)->default_value(""),
         "g,gui",
@@ -515,6 +523,15 @@ int main(int argc, char** argv)
         sofa::helper::AdvancedTimer::setOutputType("Animate", computationTimeOutputType);
     }
 
+    if (memoryProfile)
+    {
+        if (computationTimeSampling == 0)
+        {
+            msg_warning("") << "The memory profile is only output with the computation time statistics: set computationTimeSampling to a non-zero value.";
+        }
+        sofa::simulation::getSimulation()->setMemoryProfiling(true);
+    }
+
     //=======================================
     // Run the main loop
     if (int err = GUIManager::MainLoop(groot,fileName.c_str()))